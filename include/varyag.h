@@ -84,9 +84,13 @@ VG_DECLARE_HANDLE(VgSwapChain, D3D12SwapChain, VulkanSwapChain);
 VG_DECLARE_OPAQUE_HANDLE(VgFence);
 VG_DECLARE_OPAQUE_HANDLE(VgSampler);
 VG_DECLARE_OPAQUE_HANDLE(VgSurface);
+VG_DECLARE_OPAQUE_HANDLE(VgReadbackPool);
+VG_DECLARE_OPAQUE_HANDLE(VgQueueScheduler);
+VG_DECLARE_OPAQUE_HANDLE(VgConstantAllocator);
 
 typedef uint32_t VgView;
 typedef uint32_t VgAttachmentView;
+typedef uint64_t VgReadbackTicket;
 
 #undef VG_OBJECT_DEF
 
@@ -97,6 +101,9 @@ typedef uint32_t VgAttachmentView;
 #define VG_QUEUE_IGNORE ((VgQueue)-1)
 #define VG_REMAINING_MIP_LAYERS (~0U)
 #define VG_NO_VIEW (VG_INVALID_INDEX)
+#define VG_INVALID_READBACK_TICKET ((VgReadbackTicket)0)
+#define VG_CONSTANT_ALLOCATION_ALIGNMENT 256u
+#define VG_MAX_CONSTANT_ALLOCATION_SIZE 65536u
 #if !defined(__cplusplus)
 #define VG_DEFAULT_COMPONENT_SWIZZLE ((ComponentSwizzle){ VG_COMPONENT_MAPPING_IDENTITY, \
 	VG_COMPONENT_MAPPING_IDENTITY, VG_COMPONENT_MAPPING_IDENTITY,VG_COMPONENT_MAPPING_IDENTITY })
@@ -112,6 +119,7 @@ typedef uint32_t VgAttachmentView;
 #define VG_NUM_MAX_ADAPTER_NAME_LENGTH 256u
 #define VG_NUM_MAX_VERTEX_BUFFERS 16u
 #define VG_NUM_MAX_VERTEX_ATTRIBUTES 16u
+#define VG_NUM_MAX_MEMORY_HEAPS 16u
 
 #ifdef __cplusplus
 extern "C" {
@@ -123,6 +131,7 @@ extern "C" {
 	static const uint32_t vg_num_max_adapter_name_length = VG_NUM_MAX_ADAPTER_NAME_LENGTH;
 	static const uint32_t vg_num_max_vertex_buffers = VG_NUM_MAX_VERTEX_BUFFERS;
 	static const uint32_t vg_num_max_vertex_attributes = VG_NUM_MAX_VERTEX_ATTRIBUTES;
+	static const uint32_t vg_num_max_memory_heaps = VG_NUM_MAX_MEMORY_HEAPS;
 
 	typedef enum VgGraphicsApi : uint64_t
 	{
@@ -143,8 +152,11 @@ extern "C" {
 	// ---------------------------------------------------------
 	// independentBlend
 	// dualSrcBlend
+	// multiDrawIndirect
+	// drawIndirectFirstInstance
 	// core 1.1: shaderDrawParameters
 	//           multiview
+	// core 1.2: drawIndirectCount
 	// =========================================================
 
 	typedef enum VgResult : uint64_t
@@ -155,7 +167,10 @@ extern "C" {
 		VG_ALREADY_INITIALIZED = 3,
 		VG_FAILURE = 4,
 		VG_ILLEGAL_OPERATION = 5,
-		VG_DEVICE_LOST = 6
+		VG_DEVICE_LOST = 6,
+		VG_NOT_READY = 7,
+		VG_OUT_OF_MEMORY = 8,
+		VG_NOT_SUPPORTED = 9
 	} VgResult;
 
 	typedef enum VgMessageSeverity : uint64_t
@@ -302,7 +317,9 @@ extern "C" {
 		VG_INIT_NONE = 0,
 		VG_INIT_DEBUG = 1,
 		VG_INIT_ENABLE_MESSAGE_CALLBACK = 2,
-		VG_INIT_USE_PROVIDED_ALLOCATOR = 4
+		VG_INIT_USE_PROVIDED_ALLOCATOR = 4,
+		// Record every call into the file at VgConfig::capture_path, see varyag_capture.h
+		VG_INIT_ENABLE_CAPTURE = 8
 	} VgInitFlags;
 	VG_ENUM_FLAGS(VgInitFlags);
 
@@ -336,6 +353,11 @@ extern "C" {
 	{
 		VG_COMMAND_POOL_FLAG_NONE = 0,
 		VG_COMMAND_POOL_FLAG_TRANSIENT = 1,
+		// Command lists record vgCmdTransition() against tracked resource states, see VgTransitionInfo
+		VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES = 2,
+		// Command lists are bundles, recorded once with vgCmdBeginBundle() and executed many times with vgCmdExecuteBundle().
+		// Only allowed on VG_QUEUE_GRAPHICS
+		VG_COMMAND_POOL_FLAG_BUNDLE = 4,
 	} VgCommandPoolFlags;
 	VG_ENUM_FLAGS(VgCommandPoolFlags);
 
@@ -498,7 +520,11 @@ extern "C" {
 		VG_TEXTURE_USAGE_UNORDERED_ACCESS = 2,
 		VG_TEXTURE_USAGE_COLOR_ATTACHMENT = 4,
 		VG_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT = 8,
-		VG_TEXTURE_USAGE_ALLOW_SIMULTANEOUS_ACCESS = 16
+		VG_TEXTURE_USAGE_ALLOW_SIMULTANEOUS_ACCESS = 16,
+		// Color or depth stencil attachment whose contents never leave tile memory, e.g. MSAA or depth targets
+		// which are resolved or discarded at the end of rendering. Uses lazily allocated memory where available,
+		// it cannot be copied, read back or viewed by shaders
+		VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT = 32
 	} VgTextureUsageFlags;
 	VG_ENUM_FLAGS(VgTextureUsageFlags);
 
@@ -553,6 +579,14 @@ extern "C" {
 		VG_ATTACHMENT_OP_DONT_CARE = 2
 	} VgAttachmentOp;
 
+	typedef enum VgRenderingFlags : uint64_t
+	{
+		VG_RENDERING_FLAG_NONE = 0,
+		// Everything is drawn by vgCmdExecuteBundle(), draws can't be recorded directly until vgCmdEndRendering()
+		VG_RENDERING_FLAG_BUNDLES = 1
+	} VgRenderingFlags;
+	VG_ENUM_FLAGS(VgRenderingFlags);
+
 	typedef enum VgTextureDescriptorType : uint64_t
 	{
 		VG_TEXTURE_DESCRIPTOR_TYPE_SRV = 0,
@@ -706,6 +740,22 @@ extern "C" {
 	} VgColorComponentFlags;
 	VG_ENUM_FLAGS(VgColorComponentFlags);
 
+	// Parts of a graphics pipeline which are compiled separately by vgDeviceCreateGraphicsPipelineLibrary()
+	// and linked into a complete pipeline by vgDeviceLinkGraphicsPipeline(), values match VkGraphicsPipelineLibraryFlagBitsEXT
+	typedef enum VgGraphicsPipelineLibraryFlags : uint64_t
+	{
+		VG_GRAPHICS_PIPELINE_LIBRARY_NONE = 0,
+		// fixed_function.vertex_attributes, primitive_topology, primitive_restart_enable
+		VG_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT = 1,
+		// vertex_pipeline_type, the vertex, tesselation, geometry or mesh shaders, tesselation_control_points, rasterization_state
+		VG_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION = 2,
+		// pixel_shader, depth_stencil_state
+		VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER = 4,
+		// Attachment formats, multisampling_state, blend_state
+		VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT = 8
+	} VgGraphicsPipelineLibraryFlags;
+	VG_ENUM_FLAGS(VgGraphicsPipelineLibraryFlags);
+
 	typedef void* (*VgAllocPFN)(void* user_data, size_t size, size_t alignment);
 	typedef void* (*VgReallocPFN)(void* user_data, void* original, size_t size, size_t alignment);
 	typedef void(*VgFreePFN)(void* user_data, void* memory);
@@ -726,6 +776,7 @@ extern "C" {
 		VgInitFlags flags;
 		VgMessageCallbackPFN message_callback;
 		VgAllocator allocator;
+		const char* capture_path;
 	} VgConfig;
 
 	typedef struct VgAdapterProperties
@@ -769,6 +820,46 @@ extern "C" {
 		uint64_t value;
 	} VgFenceOperation;
 
+	// Completion of a submit scheduled with vgDeviceScheduleCommandLists(), value 0 is always complete
+	typedef struct VgSyncPoint
+	{
+		VgQueue queue;
+		uint64_t value;
+	} VgSyncPoint;
+
+	typedef struct VgReadbackResult
+	{
+		const void* data;
+		uint64_t size;
+		// Bytes between the starts of two rows of texture readbacks, 0 for buffer readbacks
+		uint64_t row_pitch;
+	} VgReadbackResult;
+
+	typedef void(*VgReadbackCallbackPFN)(void* user_data, VgReadbackTicket ticket, const VgReadbackResult* result);
+
+	typedef struct VgReadbackRequest
+	{
+		// Signaled by the application once the command list recording the readback has executed
+		VgFence fence;
+		uint64_t fence_value;
+		// Optional, called by vgDeviceProcessReadbacks() once the data is available. The ticket is released when it returns
+		VgReadbackCallbackPFN callback;
+		void* user_data;
+	} VgReadbackRequest;
+
+	typedef struct VgConstantAllocation
+	{
+		// Persistently mapped, written by the application before the command lists reading it execute
+		void* data;
+		// Upload buffer of the allocator, offset is aligned to VG_CONSTANT_ALLOCATION_ALIGNMENT
+		VgBuffer buffer;
+		uint64_t offset;
+		// GPU virtual address on D3D12, buffer device address on Vulkan
+		uint64_t gpu_address;
+		// Constant buffer view starting at the allocation, shared with later allocations at the same offset
+		VgView view;
+	} VgConstantAllocation;
+
 	typedef struct VgSubmitInfo
 	{
 		uint32_t num_wait_fences;
@@ -827,6 +918,34 @@ extern "C" {
 		VgTextureBarrier* texture_barriers;
 	} VgDependencyInfo;
 
+	typedef struct VgBufferTransition
+	{
+		VgPipelineStageFlags stage;
+		VgAccessFlags access;
+		VgBuffer buffer;
+	} VgBufferTransition;
+
+	typedef struct VgTextureTransition
+	{
+		VgPipelineStageFlags stage;
+		VgAccessFlags access;
+		VgTextureLayout layout;
+		VgTexture texture;
+		VgTextureSubresourceRange subresource_range;
+	} VgTextureTransition;
+
+	// Only the state the resources are used in next is specified. The previous state of every buffer and texture
+	// subresource is tracked per command list, and barriers are only recorded for writes and layout changes.
+	// The first use of a resource in a list is patched against the state left by previously submitted lists
+	// when the list is submitted, which requires it to be submitted at most once per reset of its pool.
+	typedef struct VgTransitionInfo
+	{
+		uint32_t num_buffer_transitions;
+		VgBufferTransition* buffer_transitions;
+		uint32_t num_texture_transitions;
+		VgTextureTransition* texture_transitions;
+	} VgTransitionInfo;
+
 	typedef struct VgSamplerDesc
 	{
 		VgFilter mag_filter;
@@ -901,6 +1020,7 @@ extern "C" {
 		uint32_t num_color_attachments;
 		VgAttachmentInfo* color_attachments;
 		VgAttachmentInfo depth_stencil_attachment;
+		VgRenderingFlags flags;
 	} VgRenderingInfo;
 
 	typedef struct VgComponentSwizzle
@@ -941,6 +1061,28 @@ extern "C" {
 		uint32_t depth;
 	} VgRegion;
 
+	// Region of vgCmdCopyBufferToBufferRegions(), VG_WHOLE_SIZE is not allowed as size
+	typedef struct VgBufferCopyRegion
+	{
+		uint64_t dst_offset;
+		uint64_t src_offset;
+		uint64_t size;
+	} VgBufferCopyRegion;
+
+	// Region of vgCmdCopyBufferToTextureRegions() and vgCmdCopyTextureToBufferRegions(), rows in the buffer are laid out
+	// like in the single region copies
+	typedef struct VgBufferTextureCopyRegion
+	{
+		uint64_t buffer_offset;
+		VgRegion texture_region;
+	} VgBufferTextureCopyRegion;
+
+	typedef struct VgTextureCopyRegion
+	{
+		VgRegion dst_region;
+		VgRegion src_region;
+	} VgTextureCopyRegion;
+
 	typedef struct VgSwapChainDesc
 	{
 		uint32_t width;
@@ -1075,6 +1217,23 @@ extern "C" {
 		uint32_t height;
 	} VgScissor;
 
+	// Describes the rendering a bundle is going to be executed in. Bundles inherit the attachments, viewports and
+	// scissors of the command list executing them, but have to set their pipeline, vertex and index buffers and root
+	// constants themselves. Barriers, renderings, viewports, scissors, copies, readbacks and indirect draws cannot be
+	// recorded into bundles
+	typedef struct VgBundleInheritanceInfo
+	{
+		uint32_t num_color_attachments;
+		VgFormat color_attachment_formats[vg_num_max_color_attachments];
+		VgFormat depth_stencil_format;
+		VgSampleCount sample_count;
+		// Vulkan devices without VK_NV_inherited_viewport_scissor cannot inherit viewports and scissors, bundles
+		// recorded on them start with these instead. Ignored everywhere else
+		uint32_t num_viewports;
+		const VgViewport* viewports;
+		const VgScissor* scissors;
+	} VgBundleInheritanceInfo;
+
 	typedef struct VgMemoryStatistics
 	{
 		uint64_t num_buffers;
@@ -1083,6 +1242,68 @@ extern "C" {
 		uint64_t used_vram;
 	} VgMemoryStatistics;
 
+	typedef enum VgMemoryHeapFlags : uint64_t
+	{
+		VG_MEMORY_HEAP_NONE = 0,
+		VG_MEMORY_HEAP_DEVICE_LOCAL = 1
+	} VgMemoryHeapFlags;
+	VG_ENUM_FLAGS(VgMemoryHeapFlags);
+
+	typedef struct VgMemoryHeapBudget
+	{
+		VgMemoryHeapFlags flags;
+		// Amount of memory the OS lets the process use from this heap before it starts paging
+		uint64_t budget;
+		// Process wide usage reported by the OS, includes memory not allocated through varyag
+		uint64_t usage;
+	} VgMemoryHeapBudget;
+
+	typedef struct VgMemoryBudget
+	{
+		uint32_t num_heaps;
+		VgMemoryHeapBudget heaps[vg_num_max_memory_heaps];
+	} VgMemoryBudget;
+
+	typedef void(*VgMemoryBudgetCallbackPFN)(void* user_data, uint32_t heap_index, const VgMemoryHeapBudget* heap);
+
+	typedef struct VgMemoryBudgetNotification
+	{
+		// Fraction of the budget, the callback fires once when usage rises above it and is re-armed when it falls below
+		float threshold;
+		VgMemoryBudgetCallbackPFN callback;
+		void* user_data;
+	} VgMemoryBudgetNotification;
+
+	typedef enum VgDescriptorHeapType : uint64_t
+	{
+		VG_DESCRIPTOR_HEAP_TYPE_RESOURCE = 0,
+		VG_DESCRIPTOR_HEAP_TYPE_SAMPLER = 1,
+		// Only exist on D3D12, Vulkan attachments do not use descriptors
+		VG_DESCRIPTOR_HEAP_TYPE_RENDER_TARGET = 2,
+		VG_DESCRIPTOR_HEAP_TYPE_DEPTH_STENCIL = 3
+	} VgDescriptorHeapType;
+
+	typedef struct VgDescriptorHeapStatistics
+	{
+		uint32_t capacity;
+		uint32_t live_descriptors;
+		// Peak number of live descriptors since device creation
+		uint32_t high_water_mark;
+		// Freed slots below the high-water mark waiting to be reused
+		uint32_t free_list_length;
+		// Running totals, sample them once per frame to get the churn rate
+		uint64_t total_allocations;
+		uint64_t total_frees;
+	} VgDescriptorHeapStatistics;
+
+	// Counted since the last vgCmdBegin() or vgCmdBeginBundle(). State commands are pipeline, vertex and index buffer,
+	// root constant, viewport and scissor binds. Binds which would not change the state of the list are filtered
+	typedef struct VgCommandListStatistics
+	{
+		uint64_t num_state_commands;
+		uint64_t num_filtered_state_commands;
+	} VgCommandListStatistics;
+
 	typedef struct VgDrawIndirectCommand
 	{
 		uint32_t vertex_count;
@@ -1107,6 +1328,31 @@ extern "C" {
 		uint32_t groups_z;
 	} VgDispatchIndirectCommand;
 
+	// Layout matches VkMultiDrawInfoEXT
+	typedef struct VgMultiDrawInfo
+	{
+		uint32_t first_vertex;
+		uint32_t vertex_count;
+	} VgMultiDrawInfo;
+
+	// Layout matches VkMultiDrawIndexedInfoEXT
+	typedef struct VgMultiDrawIndexedInfo
+	{
+		uint32_t first_index;
+		uint32_t index_count;
+		uint32_t vertex_offset;
+	} VgMultiDrawIndexedInfo;
+
+	// Graphics root constants set before every draw of a multi draw, draw i reads num_32bit_values
+	// values from data + i * stride
+	typedef struct VgMultiDrawRootConstants
+	{
+		uint32_t offset_in_32bit_values;
+		uint32_t num_32bit_values;
+		const void* data;
+		uint32_t stride;
+	} VgMultiDrawRootConstants;
+
 	typedef struct VgVulkanObjects
 	{
 		struct VkInstance_T* instance;
@@ -1126,6 +1372,9 @@ extern "C" {
 	VG_API VgResult vgDeviceGetAdapter(VgDevice device, VgAdapter* out_adapter);
 	VG_API VgResult vgDeviceGetGraphicsApi(VgDevice device, VgGraphicsApi* out_api);
 	VG_API VgResult vgDeviceGetMemoryStatistics(VgDevice device, VgMemoryStatistics* out_memory_stats);
+	VG_API VgResult vgDeviceGetMemoryBudget(VgDevice device, VgMemoryBudget* out_budget);
+	VG_API VgResult vgDeviceSetMemoryBudgetNotification(VgDevice device, const VgMemoryBudgetNotification* notification);
+	VG_API VgResult vgDeviceGetDescriptorHeapStatistics(VgDevice device, VgDescriptorHeapType type, VgDescriptorHeapStatistics* out_stats);
 	VG_API void vgDeviceWaitQueueIdle(VgDevice device, VgQueue queue);
 	VG_API void vgDeviceWaitIdle(VgDevice device);
 	VG_API VgResult vgDeviceCreateBuffer(VgDevice device, const VgBufferDesc* desc, VgBuffer* out_buffer);
@@ -1133,6 +1382,11 @@ extern "C" {
 	VG_API VgResult vgDeviceCreateShaderModule(VgDevice device, const void* data, uint64_t size, VgShaderModule* out_module);
 	VG_API void vgDeviceDestroyShaderModule(VgDevice device, VgShaderModule shader_module);
 	VG_API VgResult vgDeviceCreateGraphicsPipeline(VgDevice device, const VgGraphicsPipelineDesc* desc, VgPipeline* out_pipeline);
+	// Only the fields of desc which belong to parts are read, the library can only be used with vgDeviceLinkGraphicsPipeline().
+	// Its shader modules have to stay alive until it is destroyed. Returns VG_NOT_SUPPORTED on Vulkan
+	VG_API VgResult vgDeviceCreateGraphicsPipelineLibrary(VgDevice device, VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc* desc, VgPipeline* out_library);
+	// Each part has to be provided by exactly one of the libraries, which may be destroyed after linking
+	VG_API VgResult vgDeviceLinkGraphicsPipeline(VgDevice device, uint32_t num_libraries, const VgPipeline* libraries, VgPipeline* out_pipeline);
 	VG_API VgResult vgDeviceCreateComputePipeline(VgDevice device, VgShaderModule shader_module, VgPipeline* out_pipeline);
 	VG_API void vgDeviceDestroyPipeline(VgDevice device, VgPipeline pipeline);
 	VG_API VgResult vgDeviceCreateFence(VgDevice device, uint64_t initial_value, VgFence* out_fence);
@@ -1149,6 +1403,23 @@ extern "C" {
 	VG_API VgResult vgDeviceGetFenceValue(VgDevice device, VgFence fence, uint64_t* out_value);
 	VG_API VgResult vgDeviceCreateSwapChain(VgDevice device, const VgSwapChainDesc* desc, VgSwapChain* out_swap_chain);
 	VG_API void vgDeviceDestroySwapChain(VgDevice device, VgSwapChain swap_chain);
+	VG_API VgResult vgDeviceCreateReadbackPool(VgDevice device, uint64_t size, VgReadbackPool* out_pool);
+	VG_API void vgDeviceDestroyReadbackPool(VgDevice device, VgReadbackPool pool);
+	VG_API VgResult vgDeviceGetReadbackResult(VgDevice device, VgReadbackPool pool, VgReadbackTicket ticket, VgReadbackResult* out_result);
+	VG_API void vgDeviceReleaseReadback(VgDevice device, VgReadbackPool pool, VgReadbackTicket ticket);
+	VG_API void vgDeviceProcessReadbacks(VgDevice device, VgReadbackPool pool);
+	// Ring of upload memory for transient constant data. Allocations are recycled by frame, a frame is closed with
+	// vgDeviceEndConstantFrame() and its memory reused once the fence reaches the value passed there. The allocator
+	// creates one view per VG_CONSTANT_ALLOCATION_ALIGNMENT bytes of size up front, allocations create none.
+	VG_API VgResult vgDeviceCreateConstantAllocator(VgDevice device, uint64_t size, VgConstantAllocator* out_allocator);
+	VG_API void vgDeviceDestroyConstantAllocator(VgDevice device, VgConstantAllocator allocator);
+	// size is at most VG_MAX_CONSTANT_ALLOCATION_SIZE, VG_OUT_OF_MEMORY if the frames in flight use up the ring
+	VG_API VgResult vgDeviceAllocateConstants(VgDevice device, VgConstantAllocator allocator, uint64_t size, VgConstantAllocation* out_allocation);
+	VG_API void vgDeviceEndConstantFrame(VgDevice device, VgConstantAllocator allocator, VgFence fence, uint64_t fence_value);
+	VG_API VgResult vgDeviceCreateQueueScheduler(VgDevice device, VgQueueScheduler* out_scheduler);
+	VG_API void vgDeviceDestroyQueueScheduler(VgDevice device, VgQueueScheduler scheduler);
+	VG_API VgResult vgDeviceScheduleCommandLists(VgDevice device, VgQueueScheduler scheduler, uint32_t num_command_lists, VgCommandList* command_lists, uint32_t num_dependencies, const VgSyncPoint* dependencies, VgSyncPoint* out_sync_point);
+	VG_API VgResult vgDeviceGetSyncPointFence(VgDevice device, VgQueueScheduler scheduler, const VgSyncPoint* sync_point, VgFenceOperation* out_fence);
 
 	VG_API VgResult vgCommandPoolGetApiObject(VgCommandPool pool, void** out_obj);
 	VG_API void vgCommandPoolSetName(VgCommandPool pool, const char* name);
@@ -1164,33 +1435,56 @@ extern "C" {
 	VG_API VgResult vgCommandListGetDevice(VgCommandList cmd, VgDevice* out_device);
 	VG_API VgResult vgCommandListGetCommandPool(VgCommandList cmd, VgCommandPool* out_pool);
 	VG_API VgResult vgCommandListGetQueue(VgCommandList cmd, VgQueue* out_queue);
+	VG_API VgResult vgCommandListGetStatistics(VgCommandList cmd, VgCommandListStatistics* out_statistics);
 	VG_API void vgCommandListRestoreDescriptorState(VgCommandList cmd);
 
 	VG_API void vgCmdBegin(VgCommandList cmd);
+	VG_API VgResult vgCmdBeginBundle(VgCommandList cmd, const VgBundleInheritanceInfo* inheritance_info);
 	VG_API void vgCmdEnd(VgCommandList cmd);
 	VG_API void vgCmdSetVertexBuffers(VgCommandList cmd, uint32_t start_slot, uint32_t num_buffers, const VgVertexBufferView* buffers);
 	VG_API void vgCmdSetIndexBuffer(VgCommandList cmd, VgIndexType index_type, uint64_t offset, VgBuffer index_buffer);
+	// On Vulkan the root constants of graphics and compute pipelines are the same push constants
 	VG_API void vgCmdSetRootConstants(VgCommandList cmd, VgPipelineType pipeline_type, uint32_t offset_in_32bit_values, uint32_t num_32bit_values, const void* data);
 	VG_API void vgCmdSetPipeline(VgCommandList cmd, VgPipeline pipeline);
+	// Alternative to vgCmdSetPipeline() without creating pipelines up front: sets the fields of parts from desc, every part
+	// has to be set once after vgCmdBegin(). The next draw binds the state, vgCmdSetPipeline() replaces it until it is set again.
+	// Its shader modules have to stay alive until the command list finished executing. Not supported on Vulkan, where draws
+	// which would bind the state are dropped
+	VG_API void vgCmdSetGraphicsState(VgCommandList cmd, VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc* desc);
 	VG_API void vgCmdBarrier(VgCommandList cmd, const VgDependencyInfo* dependency_info);
+	VG_API void vgCmdTransition(VgCommandList cmd, const VgTransitionInfo* transition_info);
 	VG_API VgResult vgCmdBeginRendering(VgCommandList cmd, const VgRenderingInfo* info);
 	VG_API void vgCmdEndRendering(VgCommandList cmd);
 	VG_API void vgCmdSetViewport(VgCommandList cmd, uint32_t first_viewport, uint32_t num_viewports, VgViewport* viewports);
 	VG_API void vgCmdSetScissor(VgCommandList cmd, uint32_t first_scissor, uint32_t num_scissors, VgScissor* scissors);
+	// Only allowed in rendering started with VG_RENDERING_FLAG_BUNDLES.
+	// Pipeline, vertex and index buffers and root constants of cmd have to be set again after executing a bundle
+	VG_API void vgCmdExecuteBundle(VgCommandList cmd, VgCommandList bundle);
 
 	VG_API void vgCmdDraw(VgCommandList cmd, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
 	VG_API void vgCmdDrawIndexed(VgCommandList cmd, uint32_t index_count, uint32_t instance_count, uint32_t first_index, uint32_t vertex_offset, uint32_t first_instance);
+	// Records draw_count draws sharing the instance range, root_constants is optional
+	VG_API void vgCmdDrawMulti(VgCommandList cmd, uint32_t draw_count, const VgMultiDrawInfo* draws, uint32_t instance_count, uint32_t first_instance, const VgMultiDrawRootConstants* root_constants);
+	VG_API void vgCmdDrawIndexedMulti(VgCommandList cmd, uint32_t draw_count, const VgMultiDrawIndexedInfo* draws, uint32_t instance_count, uint32_t first_instance, const VgMultiDrawRootConstants* root_constants);
 	VG_API void vgCmdDispatch(VgCommandList cmd, uint32_t groups_x, uint32_t groups_y, uint32_t groups_z);
 	VG_API void vgCmdDrawIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offset, uint32_t draw_count, uint32_t stride);
 	VG_API void vgCmdDrawIndirectCount(VgCommandList cmd, VgBuffer buffer, uint64_t offset, VgBuffer count_buffer, uint64_t count_buffer_offset, uint32_t max_draw_count, uint32_t stride);
 	VG_API void vgCmdDrawIndexedIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offset, uint32_t draw_count, uint32_t stride);
 	VG_API void vgCmdDrawIndexedIndirectCount(VgCommandList cmd, VgBuffer buffer, uint64_t offset, VgBuffer count_buffer, uint64_t count_buffer_offset, uint32_t max_draw_count, uint32_t stride);
 	VG_API void vgCmdDispatchIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offset);
+	VG_API void vgCmdDispatchMesh(VgCommandList cmd, uint32_t groups_x, uint32_t groups_y, uint32_t groups_z);
 
 	VG_API void vgCmdCopyBufferToBuffer(VgCommandList cmd, VgBuffer dst, uint64_t dst_offset, VgBuffer src, uint64_t src_offset, uint64_t size);
 	VG_API void vgCmdCopyBufferToTexture(VgCommandList cmd, VgTexture dst, const VgRegion* dst_region, VgBuffer src, uint64_t src_offset);
 	VG_API void vgCmdCopyTextureToBuffer(VgCommandList cmd, VgBuffer dst, uint64_t dst_offset, VgTexture src, const VgRegion* src_region);
 	VG_API void vgCmdCopyTextureToTexture(VgCommandList cmd, VgTexture dst, const VgRegion* dst_region, VgTexture src, const VgRegion* src_region);
+	// Copy num_regions regions between the same two resources as one command, e.g. all mips of a texture from a staging buffer
+	VG_API void vgCmdCopyBufferToBufferRegions(VgCommandList cmd, VgBuffer dst, VgBuffer src, uint32_t num_regions, const VgBufferCopyRegion* regions);
+	VG_API void vgCmdCopyBufferToTextureRegions(VgCommandList cmd, VgTexture dst, VgBuffer src, uint32_t num_regions, const VgBufferTextureCopyRegion* regions);
+	VG_API void vgCmdCopyTextureToBufferRegions(VgCommandList cmd, VgBuffer dst, VgTexture src, uint32_t num_regions, const VgBufferTextureCopyRegion* regions);
+	VG_API void vgCmdCopyTextureToTextureRegions(VgCommandList cmd, VgTexture dst, VgTexture src, uint32_t num_regions, const VgTextureCopyRegion* regions);
+	VG_API VgResult vgCmdReadbackBuffer(VgCommandList cmd, VgReadbackPool pool, VgBuffer src, uint64_t src_offset, uint64_t size, const VgReadbackRequest* request, VgReadbackTicket* out_ticket);
+	VG_API VgResult vgCmdReadbackTexture(VgCommandList cmd, VgReadbackPool pool, VgTexture src, const VgRegion* src_region, const VgReadbackRequest* request, VgReadbackTicket* out_ticket);
 
 	VG_API void vgCmdBeginMarker(VgCommandList cmd, const char* name, float color[3]);
 	VG_API void vgCmdEndMarker(VgCommandList cmd);
@@ -1200,6 +1494,7 @@ extern "C" {
 	VG_API void vgBufferSetName(VgBuffer buffer, const char* name);
 	VG_API VgResult vgBufferGetDevice(VgBuffer buffer, VgDevice* out_device);
 	VG_API VgResult vgBufferGetDesc(VgBuffer buffer, VgBufferDesc* out_desc);
+	// SRV and UAV views with VG_BUFFER_VIEW_TYPE_BUFFER return VG_NOT_SUPPORTED on Vulkan
 	VG_API VgResult vgBufferCreateView(VgBuffer buffer, const VgBufferViewDesc* desc, VgView* out_descriptor);
 	VG_API void vgBufferDestroyViews(VgBuffer buffer);
 	VG_API VgResult vgBufferMap(VgBuffer buffer, void** out_data);
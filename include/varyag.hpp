@@ -14,6 +14,10 @@ namespace vg
 	using Fence = VgFence;
 	using Sampler = VgSampler;
 	using Surface = VgSurface;
+	using ReadbackPool = VgReadbackPool;
+	using ReadbackTicket = VgReadbackTicket;
+	using ConstantAllocator = VgConstantAllocator;
+	using QueueScheduler = VgQueueScheduler;
 	using View = VgView;
 	using AttachmentView = VgAttachmentView;
 
@@ -50,6 +54,9 @@ namespace vg
 		Failure            = VG_FAILURE,
 		IllegalOperation   = VG_ILLEGAL_OPERATION,
 		DeviceLost         = VG_DEVICE_LOST,
+		NotReady           = VG_NOT_READY,
+		OutOfMemory        = VG_OUT_OF_MEMORY,
+		NotSupported       = VG_NOT_SUPPORTED,
 	};
 
 	enum class MessageSeverity : uint64_t
@@ -197,6 +204,7 @@ namespace vg
 		Debug                 = VG_INIT_DEBUG,
 		EnableMessageCallback = VG_INIT_ENABLE_MESSAGE_CALLBACK,
 		UseProvidedAllocator  = VG_INIT_USE_PROVIDED_ALLOCATOR,
+		EnableCapture         = VG_INIT_ENABLE_CAPTURE,
 	};
 
 	enum class IndexType : uint64_t
@@ -227,8 +235,10 @@ namespace vg
 
 	enum class CommandPoolFlags : uint64_t
 	{
-		FlagNone      = VG_COMMAND_POOL_FLAG_NONE,
-		FlagTransient = VG_COMMAND_POOL_FLAG_TRANSIENT,
+		FlagNone                = VG_COMMAND_POOL_FLAG_NONE,
+		FlagTransient           = VG_COMMAND_POOL_FLAG_TRANSIENT,
+		FlagTrackResourceStates = VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES,
+		FlagBundle              = VG_COMMAND_POOL_FLAG_BUNDLE,
 	};
 
 	enum class PipelineStageFlags : uint64_t
@@ -379,6 +389,7 @@ namespace vg
 		ColorAttachment         = VG_TEXTURE_USAGE_COLOR_ATTACHMENT,
 		DepthStencilAttachment  = VG_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT,
 		AllowSimultaneousAccess = VG_TEXTURE_USAGE_ALLOW_SIMULTANEOUS_ACCESS,
+		TransientAttachment     = VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT,
 	};
 
 	enum class TextureTiling : uint64_t
@@ -432,6 +443,12 @@ namespace vg
 		DontCare = VG_ATTACHMENT_OP_DONT_CARE,
 	};
 
+	enum class RenderingFlags : uint64_t
+	{
+		FlagNone    = VG_RENDERING_FLAG_NONE,
+		FlagBundles = VG_RENDERING_FLAG_BUNDLES,
+	};
+
 	enum class TextureDescriptorType : uint64_t
 	{
 		Srv = VG_TEXTURE_DESCRIPTOR_TYPE_SRV,
@@ -584,10 +601,35 @@ namespace vg
 		A = VG_COLOR_COMPONENT_A,
 	};
 
+	enum class GraphicsPipelineLibraryFlags : uint64_t
+	{
+		None             = VG_GRAPHICS_PIPELINE_LIBRARY_NONE,
+		VertexInput      = VG_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT,
+		PreRasterization = VG_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION,
+		FragmentShader   = VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER,
+		FragmentOutput   = VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT,
+	};
+
+	enum class MemoryHeapFlags : uint64_t
+	{
+		None        = VG_MEMORY_HEAP_NONE,
+		DeviceLocal = VG_MEMORY_HEAP_DEVICE_LOCAL,
+	};
+
+	enum class DescriptorHeapType : uint64_t
+	{
+		Resource     = VG_DESCRIPTOR_HEAP_TYPE_RESOURCE,
+		Sampler      = VG_DESCRIPTOR_HEAP_TYPE_SAMPLER,
+		RenderTarget = VG_DESCRIPTOR_HEAP_TYPE_RENDER_TARGET,
+		DepthStencil = VG_DESCRIPTOR_HEAP_TYPE_DEPTH_STENCIL,
+	};
+
 	using AllocPFN = VgAllocPFN;
 	using ReallocPFN = VgReallocPFN;
 	using FreePFN = VgFreePFN;
 	using MessageCallbackPFN = VgMessageCallbackPFN;
+	using ReadbackCallbackPFN = VgReadbackCallbackPFN;
+	using MemoryBudgetCallbackPFN = VgMemoryBudgetCallbackPFN;
 
 	struct Allocator;
 	struct Config;
@@ -596,12 +638,19 @@ namespace vg
 	struct VertexBufferView;
 	struct BufferViewDesc;
 	struct FenceOperation;
+	struct SyncPoint;
+	struct ReadbackResult;
+	struct ReadbackRequest;
+	struct ConstantAllocation;
 	struct SubmitInfo;
 	struct TextureSubresourceRange;
 	struct MemoryBarrier;
 	struct BufferBarrier;
 	struct TextureBarrier;
 	struct DependencyInfo;
+	struct BufferTransition;
+	struct TextureTransition;
+	struct TransitionInfo;
 	struct SamplerDesc;
 	struct TextureDesc;
 	struct AttachmentViewDesc;
@@ -612,6 +661,9 @@ namespace vg
 	struct TextureViewDesc;
 	struct Offset;
 	struct Region;
+	struct BufferCopyRegion;
+	struct BufferTextureCopyRegion;
+	struct TextureCopyRegion;
 	struct SwapChainDesc;
 	struct VertexAttribute;
 	struct FixedFunctionState;
@@ -625,10 +677,19 @@ namespace vg
 	struct GraphicsPipelineDesc;
 	struct Viewport;
 	struct Scissor;
+	struct BundleInheritanceInfo;
 	struct MemoryStatistics;
+	struct MemoryHeapBudget;
+	struct MemoryBudget;
+	struct MemoryBudgetNotification;
+	struct DescriptorHeapStatistics;
+	struct CommandListStatistics;
 	struct DrawIndirectCommand;
 	struct DrawIndexedIndirectCommand;
 	struct DispatchIndirectCommand;
+	struct MultiDrawInfo;
+	struct MultiDrawIndexedInfo;
+	struct MultiDrawRootConstants;
 	struct VulkanObjects;
 
 	vg::Result Init                (const vg::Config* cfg);
@@ -717,6 +778,13 @@ namespace vg
 
 		vg::Result GetMemoryStatistics   (vg::MemoryStatistics* outMemoryStats) const;
 
+		vg::Result GetMemoryBudget       (vg::MemoryBudget* outBudget) const;
+
+		vg::Result SetMemoryBudgetNotification(const vg::MemoryBudgetNotification* notification);
+
+		vg::Result GetDescriptorHeapStatistics(vg::DescriptorHeapType type,
+		                                  vg::DescriptorHeapStatistics* outStats) const;
+
 		void       WaitQueueIdle         (vg::Queue queue);
 
 		void       WaitIdle              ();
@@ -738,6 +806,14 @@ namespace vg
 		vg::Result CreateComputePipeline (vg::ShaderModule shaderModule,
 		                                  vg::Pipeline* outPipeline);
 
+		vg::Result CreateGraphicsPipelineLibrary(vg::GraphicsPipelineLibraryFlags parts,
+		                                  const vg::GraphicsPipelineDesc* desc,
+		                                  vg::Pipeline* outLibrary);
+
+		vg::Result LinkGraphicsPipeline  (uint32_t numLibraries,
+		                                  const vg::Pipeline* libraries,
+		                                  vg::Pipeline* outPipeline);
+
 		void       DestroyPipeline       (vg::Pipeline pipeline);
 
 		vg::Result CreateFence           (uint64_t initialValue,
@@ -781,6 +857,48 @@ namespace vg
 		vg::Result GetSamplerIndex       (vg::Sampler sampler,
 		                                  uint32_t* outIndex) const;
 
+		vg::Result CreateReadbackPool    (uint64_t size,
+		                                  vg::ReadbackPool* outPool);
+
+		void       DestroyReadbackPool   (vg::ReadbackPool pool);
+
+		vg::Result GetReadbackResult     (vg::ReadbackPool pool,
+		                                  vg::ReadbackTicket ticket,
+		                                  vg::ReadbackResult* outResult) const;
+
+		void       ReleaseReadback       (vg::ReadbackPool pool,
+		                                  vg::ReadbackTicket ticket);
+
+		void       ProcessReadbacks      (vg::ReadbackPool pool);
+
+		vg::Result CreateConstantAllocator(uint64_t size,
+		                                  vg::ConstantAllocator* outAllocator);
+
+		void       DestroyConstantAllocator(vg::ConstantAllocator allocator);
+
+		vg::Result AllocateConstants     (vg::ConstantAllocator allocator,
+		                                  uint64_t size,
+		                                  vg::ConstantAllocation* outAllocation);
+
+		void       EndConstantFrame      (vg::ConstantAllocator allocator,
+		                                  vg::Fence fence,
+		                                  uint64_t fenceValue);
+
+		vg::Result CreateQueueScheduler  (vg::QueueScheduler* outScheduler);
+
+		void       DestroyQueueScheduler (vg::QueueScheduler scheduler);
+
+		vg::Result ScheduleCommandLists  (vg::QueueScheduler scheduler,
+		                                  uint32_t numCommandLists,
+		                                  vg::CommandList* commandLists,
+		                                  uint32_t numDependencies,
+		                                  const vg::SyncPoint* dependencies,
+		                                  vg::SyncPoint* outSyncPoint);
+
+		vg::Result GetSyncPointFence     (vg::QueueScheduler scheduler,
+		                                  const vg::SyncPoint* syncPoint,
+		                                  vg::FenceOperation* outFence) const;
+
 	private:
 		VgDevice _handle;
 	};
@@ -859,10 +977,14 @@ namespace vg
 
 		vg::Result GetQueue                (vg::Queue* outQueue) const;
 
+		vg::Result GetStatistics           (vg::CommandListStatistics* outStatistics) const;
+
 		void       RestoreDescriptorState  ();
 
 		void       Begin                   ();
 
+		vg::Result BeginBundle             (const vg::BundleInheritanceInfo* inheritanceInfo);
+
 		void       End                     ();
 
 		void       SetVertexBuffers        (uint32_t startSlot,
@@ -880,8 +1002,13 @@ namespace vg
 
 		void       SetPipeline             (vg::Pipeline pipeline);
 
+		void       SetGraphicsState        (vg::GraphicsPipelineLibraryFlags parts,
+		                                    const vg::GraphicsPipelineDesc* desc);
+
 		void       Barrier                 (const vg::DependencyInfo* dependencyInfo);
 
+		void       Transition              (const vg::TransitionInfo* transitionInfo);
+
 		vg::Result BeginRendering          (const vg::RenderingInfo* info);
 
 		void       EndRendering            ();
@@ -894,6 +1021,8 @@ namespace vg
 		                                    uint32_t numScissors,
 		                                    vg::Scissor* scissors);
 
+		void       ExecuteBundle           (vg::CommandList bundle);
+
 		void       Draw                    (uint32_t vertexCount,
 		                                    uint32_t instanceCount,
 		                                    uint32_t firstVertex,
@@ -905,6 +1034,18 @@ namespace vg
 		                                    uint32_t vertexOffset,
 		                                    uint32_t firstInstance);
 
+		void       DrawMulti               (uint32_t drawCount,
+		                                    const vg::MultiDrawInfo* draws,
+		                                    uint32_t instanceCount,
+		                                    uint32_t firstInstance,
+		                                    const vg::MultiDrawRootConstants* rootConstants);
+
+		void       DrawIndexedMulti        (uint32_t drawCount,
+		                                    const vg::MultiDrawIndexedInfo* draws,
+		                                    uint32_t instanceCount,
+		                                    uint32_t firstInstance,
+		                                    const vg::MultiDrawRootConstants* rootConstants);
+
 		void       Dispatch                (uint32_t groupsX,
 		                                    uint32_t groupsY,
 		                                    uint32_t groupsZ);
@@ -936,6 +1077,10 @@ namespace vg
 		void       DispatchIndirect        (vg::Buffer buffer,
 		                                    uint64_t offset);
 
+		void       DispatchMesh            (uint32_t groupsX,
+		                                    uint32_t groupsY,
+		                                    uint32_t groupsZ);
+
 		void       CopyBufferToBuffer      (vg::Buffer dst,
 		                                    uint64_t dstOffset,
 		                                    vg::Buffer src,
@@ -957,6 +1102,39 @@ namespace vg
 		                                    vg::Texture src,
 		                                    const vg::Region* srcRegion);
 
+		void       CopyBufferToBufferRegions(vg::Buffer dst,
+		                                    vg::Buffer src,
+		                                    uint32_t numRegions,
+		                                    const vg::BufferCopyRegion* regions);
+
+		void       CopyBufferToTextureRegions(vg::Texture dst,
+		                                    vg::Buffer src,
+		                                    uint32_t numRegions,
+		                                    const vg::BufferTextureCopyRegion* regions);
+
+		void       CopyTextureToBufferRegions(vg::Buffer dst,
+		                                    vg::Texture src,
+		                                    uint32_t numRegions,
+		                                    const vg::BufferTextureCopyRegion* regions);
+
+		void       CopyTextureToTextureRegions(vg::Texture dst,
+		                                    vg::Texture src,
+		                                    uint32_t numRegions,
+		                                    const vg::TextureCopyRegion* regions);
+
+		vg::Result ReadbackBuffer          (vg::ReadbackPool pool,
+		                                    vg::Buffer src,
+		                                    uint64_t srcOffset,
+		                                    uint64_t size,
+		                                    const vg::ReadbackRequest* request,
+		                                    vg::ReadbackTicket* outTicket);
+
+		vg::Result ReadbackTexture         (vg::ReadbackPool pool,
+		                                    vg::Texture src,
+		                                    const vg::Region* srcRegion,
+		                                    const vg::ReadbackRequest* request,
+		                                    vg::ReadbackTicket* outTicket);
+
 		void       BeginMarker             (const char* name,
 		                                    std::array<float, 3> color);
 
@@ -1233,6 +1411,7 @@ namespace vg
 		InitFlags flags;
 		MessageCallbackPFN messageCallback;
 		Allocator allocator;
+		const char* capturePath;
 
 		Config() = default;
 
@@ -1241,12 +1420,14 @@ namespace vg
 			const char*        engineName_= {},
 			InitFlags          flags_= {},
 			MessageCallbackPFN messageCallback_= {},
-			Allocator          allocator_= {})
+			Allocator          allocator_= {},
+			const char*        capturePath_= {})
 		  : applicationName{ applicationName_ }
 		  , engineName{ engineName_ }
 		  , flags{ flags_ }
 		  , messageCallback{ messageCallback_ }
-		  , allocator{ allocator_ } {}
+		  , allocator{ allocator_ }
+		  , capturePath{ capturePath_ } {}
 		Config(const Config& other) = default;
 		Config(const VgConfig& other)
 		  : Config(*reinterpret_cast<Config const*>(&other))
@@ -1500,6 +1681,180 @@ namespace vg
 		auto operator<=>(FenceOperation const& other) const = default;
 	};
 
+	struct SyncPoint
+	{
+		using NativeType = VgSyncPoint;
+
+		Queue queue;
+		uint64_t value;
+
+		SyncPoint() = default;
+
+		SyncPoint(
+			Queue    queue_,
+			uint64_t value_= {})
+		  : queue{ queue_ }
+		  , value{ value_ } {}
+		SyncPoint(const SyncPoint& other) = default;
+		SyncPoint(const VgSyncPoint& other)
+		  : SyncPoint(*reinterpret_cast<SyncPoint const*>(&other))
+		{
+		}
+
+		constexpr SyncPoint& operator=(vg::SyncPoint const& other) noexcept = default;
+		inline SyncPoint& operator=(VgSyncPoint const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::SyncPoint const*>(&other);
+			return *this;
+		}
+
+		operator VgSyncPoint&() noexcept
+		{
+			return *reinterpret_cast<VgSyncPoint*>(this);
+		}
+		operator const VgSyncPoint&() const noexcept
+		{
+			return *reinterpret_cast<VgSyncPoint const*>(this);
+		}
+
+		auto operator<=>(SyncPoint const& other) const = default;
+	};
+
+	struct ReadbackResult
+	{
+		using NativeType = VgReadbackResult;
+
+		const void* data;
+		uint64_t size;
+		uint64_t rowPitch;
+
+		ReadbackResult() = default;
+
+		ReadbackResult(
+			const void* data_,
+			uint64_t    size_= {},
+			uint64_t    rowPitch_= {})
+		  : data{ data_ }
+		  , size{ size_ }
+		  , rowPitch{ rowPitch_ } {}
+		ReadbackResult(const ReadbackResult& other) = default;
+		ReadbackResult(const VgReadbackResult& other)
+		  : ReadbackResult(*reinterpret_cast<ReadbackResult const*>(&other))
+		{
+		}
+
+		constexpr ReadbackResult& operator=(vg::ReadbackResult const& other) noexcept = default;
+		inline ReadbackResult& operator=(VgReadbackResult const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::ReadbackResult const*>(&other);
+			return *this;
+		}
+
+		operator VgReadbackResult&() noexcept
+		{
+			return *reinterpret_cast<VgReadbackResult*>(this);
+		}
+		operator const VgReadbackResult&() const noexcept
+		{
+			return *reinterpret_cast<VgReadbackResult const*>(this);
+		}
+
+		auto operator<=>(ReadbackResult const& other) const = default;
+	};
+
+	struct ReadbackRequest
+	{
+		using NativeType = VgReadbackRequest;
+
+		Fence fence;
+		uint64_t fenceValue;
+		ReadbackCallbackPFN callback;
+		void* userData;
+
+		ReadbackRequest() = default;
+
+		ReadbackRequest(
+			Fence               fence_,
+			uint64_t            fenceValue_= {},
+			ReadbackCallbackPFN callback_= {},
+			void*               userData_= {})
+		  : fence{ fence_ }
+		  , fenceValue{ fenceValue_ }
+		  , callback{ callback_ }
+		  , userData{ userData_ } {}
+		ReadbackRequest(const ReadbackRequest& other) = default;
+		ReadbackRequest(const VgReadbackRequest& other)
+		  : ReadbackRequest(*reinterpret_cast<ReadbackRequest const*>(&other))
+		{
+		}
+
+		constexpr ReadbackRequest& operator=(vg::ReadbackRequest const& other) noexcept = default;
+		inline ReadbackRequest& operator=(VgReadbackRequest const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::ReadbackRequest const*>(&other);
+			return *this;
+		}
+
+		operator VgReadbackRequest&() noexcept
+		{
+			return *reinterpret_cast<VgReadbackRequest*>(this);
+		}
+		operator const VgReadbackRequest&() const noexcept
+		{
+			return *reinterpret_cast<VgReadbackRequest const*>(this);
+		}
+
+		auto operator<=>(ReadbackRequest const& other) const = default;
+	};
+
+	struct ConstantAllocation
+	{
+		using NativeType = VgConstantAllocation;
+
+		void* data;
+		Buffer buffer;
+		uint64_t offset;
+		uint64_t gpuAddress;
+		View view;
+
+		ConstantAllocation() = default;
+
+		ConstantAllocation(
+			void*    data_,
+			Buffer   buffer_= {},
+			uint64_t offset_= {},
+			uint64_t gpuAddress_= {},
+			View     view_= {})
+		  : data{ data_ }
+		  , buffer{ buffer_ }
+		  , offset{ offset_ }
+		  , gpuAddress{ gpuAddress_ }
+		  , view{ view_ } {}
+		ConstantAllocation(const ConstantAllocation& other) = default;
+		ConstantAllocation(const VgConstantAllocation& other)
+		  : ConstantAllocation(*reinterpret_cast<ConstantAllocation const*>(&other))
+		{
+		}
+
+		constexpr ConstantAllocation& operator=(vg::ConstantAllocation const& other) noexcept = default;
+		inline ConstantAllocation& operator=(VgConstantAllocation const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::ConstantAllocation const*>(&other);
+			return *this;
+		}
+
+		operator VgConstantAllocation&() noexcept
+		{
+			return *reinterpret_cast<VgConstantAllocation*>(this);
+		}
+		operator const VgConstantAllocation&() const noexcept
+		{
+			return *reinterpret_cast<VgConstantAllocation const*>(this);
+		}
+
+		auto operator<=>(ConstantAllocation const& other) const = default;
+	};
+
 	struct SubmitInfo
 	{
 		using NativeType = VgSubmitInfo;
@@ -1797,6 +2152,141 @@ namespace vg
 		auto operator<=>(DependencyInfo const& other) const = default;
 	};
 
+	struct BufferTransition
+	{
+		using NativeType = VgBufferTransition;
+
+		PipelineStageFlags stage;
+		AccessFlags access;
+		Buffer buffer;
+
+		BufferTransition() = default;
+
+		BufferTransition(
+			PipelineStageFlags stage_,
+			AccessFlags        access_= {},
+			Buffer             buffer_= {})
+		  : stage{ stage_ }
+		  , access{ access_ }
+		  , buffer{ buffer_ } {}
+		BufferTransition(const BufferTransition& other) = default;
+		BufferTransition(const VgBufferTransition& other)
+		  : BufferTransition(*reinterpret_cast<BufferTransition const*>(&other))
+		{
+		}
+
+		constexpr BufferTransition& operator=(vg::BufferTransition const& other) noexcept = default;
+		inline BufferTransition& operator=(VgBufferTransition const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::BufferTransition const*>(&other);
+			return *this;
+		}
+
+		operator VgBufferTransition&() noexcept
+		{
+			return *reinterpret_cast<VgBufferTransition*>(this);
+		}
+		operator const VgBufferTransition&() const noexcept
+		{
+			return *reinterpret_cast<VgBufferTransition const*>(this);
+		}
+
+		auto operator<=>(BufferTransition const& other) const = default;
+	};
+
+	struct TextureTransition
+	{
+		using NativeType = VgTextureTransition;
+
+		PipelineStageFlags stage;
+		AccessFlags access;
+		TextureLayout layout;
+		Texture texture;
+		TextureSubresourceRange subresourceRange;
+
+		TextureTransition() = default;
+
+		TextureTransition(
+			PipelineStageFlags      stage_,
+			AccessFlags             access_= {},
+			TextureLayout           layout_= {},
+			Texture                 texture_= {},
+			TextureSubresourceRange subresourceRange_= {})
+		  : stage{ stage_ }
+		  , access{ access_ }
+		  , layout{ layout_ }
+		  , texture{ texture_ }
+		  , subresourceRange{ subresourceRange_ } {}
+		TextureTransition(const TextureTransition& other) = default;
+		TextureTransition(const VgTextureTransition& other)
+		  : TextureTransition(*reinterpret_cast<TextureTransition const*>(&other))
+		{
+		}
+
+		constexpr TextureTransition& operator=(vg::TextureTransition const& other) noexcept = default;
+		inline TextureTransition& operator=(VgTextureTransition const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::TextureTransition const*>(&other);
+			return *this;
+		}
+
+		operator VgTextureTransition&() noexcept
+		{
+			return *reinterpret_cast<VgTextureTransition*>(this);
+		}
+		operator const VgTextureTransition&() const noexcept
+		{
+			return *reinterpret_cast<VgTextureTransition const*>(this);
+		}
+
+		auto operator<=>(TextureTransition const& other) const = default;
+	};
+
+	struct TransitionInfo
+	{
+		using NativeType = VgTransitionInfo;
+
+		uint32_t numBufferTransitions;
+		BufferTransition* bufferTransitions;
+		uint32_t numTextureTransitions;
+		TextureTransition* textureTransitions;
+
+		TransitionInfo() = default;
+
+		TransitionInfo(
+			uint32_t           numBufferTransitions_,
+			BufferTransition*  bufferTransitions_= {},
+			uint32_t           numTextureTransitions_= {},
+			TextureTransition* textureTransitions_= {})
+		  : numBufferTransitions{ numBufferTransitions_ }
+		  , bufferTransitions{ bufferTransitions_ }
+		  , numTextureTransitions{ numTextureTransitions_ }
+		  , textureTransitions{ textureTransitions_ } {}
+		TransitionInfo(const TransitionInfo& other) = default;
+		TransitionInfo(const VgTransitionInfo& other)
+		  : TransitionInfo(*reinterpret_cast<TransitionInfo const*>(&other))
+		{
+		}
+
+		constexpr TransitionInfo& operator=(vg::TransitionInfo const& other) noexcept = default;
+		inline TransitionInfo& operator=(VgTransitionInfo const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::TransitionInfo const*>(&other);
+			return *this;
+		}
+
+		operator VgTransitionInfo&() noexcept
+		{
+			return *reinterpret_cast<VgTransitionInfo*>(this);
+		}
+		operator const VgTransitionInfo&() const noexcept
+		{
+			return *reinterpret_cast<VgTransitionInfo const*>(this);
+		}
+
+		auto operator<=>(TransitionInfo const& other) const = default;
+	};
+
 	struct SamplerDesc
 	{
 		using NativeType = VgSamplerDesc;
@@ -2047,16 +2537,19 @@ namespace vg
 		uint32_t numColorAttachments;
 		AttachmentInfo* colorAttachments;
 		AttachmentInfo depthStencilAttachment;
+		RenderingFlags flags;
 
 		RenderingInfo() = default;
 
 		RenderingInfo(
 			uint32_t        numColorAttachments_,
 			AttachmentInfo* colorAttachments_= {},
-			AttachmentInfo  depthStencilAttachment_= {})
+			AttachmentInfo  depthStencilAttachment_= {},
+			RenderingFlags  flags_= {})
 		  : numColorAttachments{ numColorAttachments_ }
 		  , colorAttachments{ colorAttachments_ }
-		  , depthStencilAttachment{ depthStencilAttachment_ } {}
+		  , depthStencilAttachment{ depthStencilAttachment_ }
+		  , flags{ flags_ } {}
 		RenderingInfo(const RenderingInfo& other) = default;
 		RenderingInfo(const VgRenderingInfo& other)
 		  : RenderingInfo(*reinterpret_cast<RenderingInfo const*>(&other))
@@ -2280,6 +2773,126 @@ namespace vg
 		auto operator<=>(Region const& other) const = default;
 	};
 
+	struct BufferCopyRegion
+	{
+		using NativeType = VgBufferCopyRegion;
+
+		uint64_t dstOffset;
+		uint64_t srcOffset;
+		uint64_t size;
+
+		BufferCopyRegion() = default;
+
+		BufferCopyRegion(
+			uint64_t dstOffset_,
+			uint64_t srcOffset_= {},
+			uint64_t size_= {})
+		  : dstOffset{ dstOffset_ }
+		  , srcOffset{ srcOffset_ }
+		  , size{ size_ } {}
+		BufferCopyRegion(const BufferCopyRegion& other) = default;
+		BufferCopyRegion(const VgBufferCopyRegion& other)
+		  : BufferCopyRegion(*reinterpret_cast<BufferCopyRegion const*>(&other))
+		{
+		}
+
+		constexpr BufferCopyRegion& operator=(vg::BufferCopyRegion const& other) noexcept = default;
+		inline BufferCopyRegion& operator=(VgBufferCopyRegion const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::BufferCopyRegion const*>(&other);
+			return *this;
+		}
+
+		operator VgBufferCopyRegion&() noexcept
+		{
+			return *reinterpret_cast<VgBufferCopyRegion*>(this);
+		}
+		operator const VgBufferCopyRegion&() const noexcept
+		{
+			return *reinterpret_cast<VgBufferCopyRegion const*>(this);
+		}
+
+		auto operator<=>(BufferCopyRegion const& other) const = default;
+	};
+
+	struct BufferTextureCopyRegion
+	{
+		using NativeType = VgBufferTextureCopyRegion;
+
+		uint64_t bufferOffset;
+		Region textureRegion;
+
+		BufferTextureCopyRegion() = default;
+
+		BufferTextureCopyRegion(
+			uint64_t bufferOffset_,
+			Region   textureRegion_= {})
+		  : bufferOffset{ bufferOffset_ }
+		  , textureRegion{ textureRegion_ } {}
+		BufferTextureCopyRegion(const BufferTextureCopyRegion& other) = default;
+		BufferTextureCopyRegion(const VgBufferTextureCopyRegion& other)
+		  : BufferTextureCopyRegion(*reinterpret_cast<BufferTextureCopyRegion const*>(&other))
+		{
+		}
+
+		constexpr BufferTextureCopyRegion& operator=(vg::BufferTextureCopyRegion const& other) noexcept = default;
+		inline BufferTextureCopyRegion& operator=(VgBufferTextureCopyRegion const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::BufferTextureCopyRegion const*>(&other);
+			return *this;
+		}
+
+		operator VgBufferTextureCopyRegion&() noexcept
+		{
+			return *reinterpret_cast<VgBufferTextureCopyRegion*>(this);
+		}
+		operator const VgBufferTextureCopyRegion&() const noexcept
+		{
+			return *reinterpret_cast<VgBufferTextureCopyRegion const*>(this);
+		}
+
+		auto operator<=>(BufferTextureCopyRegion const& other) const = default;
+	};
+
+	struct TextureCopyRegion
+	{
+		using NativeType = VgTextureCopyRegion;
+
+		Region dstRegion;
+		Region srcRegion;
+
+		TextureCopyRegion() = default;
+
+		TextureCopyRegion(
+			Region dstRegion_,
+			Region srcRegion_= {})
+		  : dstRegion{ dstRegion_ }
+		  , srcRegion{ srcRegion_ } {}
+		TextureCopyRegion(const TextureCopyRegion& other) = default;
+		TextureCopyRegion(const VgTextureCopyRegion& other)
+		  : TextureCopyRegion(*reinterpret_cast<TextureCopyRegion const*>(&other))
+		{
+		}
+
+		constexpr TextureCopyRegion& operator=(vg::TextureCopyRegion const& other) noexcept = default;
+		inline TextureCopyRegion& operator=(VgTextureCopyRegion const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::TextureCopyRegion const*>(&other);
+			return *this;
+		}
+
+		operator VgTextureCopyRegion&() noexcept
+		{
+			return *reinterpret_cast<VgTextureCopyRegion*>(this);
+		}
+		operator const VgTextureCopyRegion&() const noexcept
+		{
+			return *reinterpret_cast<VgTextureCopyRegion const*>(this);
+		}
+
+		auto operator<=>(TextureCopyRegion const& other) const = default;
+	};
+
 	struct SwapChainDesc
 	{
 		using NativeType = VgSwapChainDesc;
@@ -2952,6 +3565,60 @@ namespace vg
 		auto operator<=>(Scissor const& other) const = default;
 	};
 
+	struct BundleInheritanceInfo
+	{
+		using NativeType = VgBundleInheritanceInfo;
+
+		uint32_t numColorAttachments;
+		Format colorAttachmentFormats[vg_num_max_color_attachments];
+		Format depthStencilFormat;
+		SampleCount sampleCount;
+		uint32_t numViewports;
+		const Viewport* viewports;
+		const Scissor* scissors;
+
+		BundleInheritanceInfo() = default;
+
+		BundleInheritanceInfo(
+			uint32_t        numColorAttachments_,
+			Format          colorAttachmentFormats_= {},
+			Format          depthStencilFormat_= {},
+			SampleCount     sampleCount_= {},
+			uint32_t        numViewports_= {},
+			const Viewport* viewports_= {},
+			const Scissor*  scissors_= {})
+		  : numColorAttachments{ numColorAttachments_ }
+		  , colorAttachmentFormats{ colorAttachmentFormats_ }
+		  , depthStencilFormat{ depthStencilFormat_ }
+		  , sampleCount{ sampleCount_ }
+		  , numViewports{ numViewports_ }
+		  , viewports{ viewports_ }
+		  , scissors{ scissors_ } {}
+		BundleInheritanceInfo(const BundleInheritanceInfo& other) = default;
+		BundleInheritanceInfo(const VgBundleInheritanceInfo& other)
+		  : BundleInheritanceInfo(*reinterpret_cast<BundleInheritanceInfo const*>(&other))
+		{
+		}
+
+		constexpr BundleInheritanceInfo& operator=(vg::BundleInheritanceInfo const& other) noexcept = default;
+		inline BundleInheritanceInfo& operator=(VgBundleInheritanceInfo const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::BundleInheritanceInfo const*>(&other);
+			return *this;
+		}
+
+		operator VgBundleInheritanceInfo&() noexcept
+		{
+			return *reinterpret_cast<VgBundleInheritanceInfo*>(this);
+		}
+		operator const VgBundleInheritanceInfo&() const noexcept
+		{
+			return *reinterpret_cast<VgBundleInheritanceInfo const*>(this);
+		}
+
+		auto operator<=>(BundleInheritanceInfo const& other) const = default;
+	};
+
 	struct MemoryStatistics
 	{
 		using NativeType = VgMemoryStatistics;
@@ -2997,6 +3664,219 @@ namespace vg
 		auto operator<=>(MemoryStatistics const& other) const = default;
 	};
 
+	struct MemoryHeapBudget
+	{
+		using NativeType = VgMemoryHeapBudget;
+
+		MemoryHeapFlags flags;
+		uint64_t budget;
+		uint64_t usage;
+
+		MemoryHeapBudget() = default;
+
+		MemoryHeapBudget(
+			MemoryHeapFlags flags_,
+			uint64_t        budget_= {},
+			uint64_t        usage_= {})
+		  : flags{ flags_ }
+		  , budget{ budget_ }
+		  , usage{ usage_ } {}
+		MemoryHeapBudget(const MemoryHeapBudget& other) = default;
+		MemoryHeapBudget(const VgMemoryHeapBudget& other)
+		  : MemoryHeapBudget(*reinterpret_cast<MemoryHeapBudget const*>(&other))
+		{
+		}
+
+		constexpr MemoryHeapBudget& operator=(vg::MemoryHeapBudget const& other) noexcept = default;
+		inline MemoryHeapBudget& operator=(VgMemoryHeapBudget const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::MemoryHeapBudget const*>(&other);
+			return *this;
+		}
+
+		operator VgMemoryHeapBudget&() noexcept
+		{
+			return *reinterpret_cast<VgMemoryHeapBudget*>(this);
+		}
+		operator const VgMemoryHeapBudget&() const noexcept
+		{
+			return *reinterpret_cast<VgMemoryHeapBudget const*>(this);
+		}
+
+		auto operator<=>(MemoryHeapBudget const& other) const = default;
+	};
+
+	struct MemoryBudget
+	{
+		using NativeType = VgMemoryBudget;
+
+		uint32_t numHeaps;
+		MemoryHeapBudget heaps[vg_num_max_memory_heaps];
+
+		MemoryBudget() = default;
+
+		MemoryBudget(
+			uint32_t         numHeaps_,
+			MemoryHeapBudget heaps_= {})
+		  : numHeaps{ numHeaps_ }
+		  , heaps{ heaps_ } {}
+		MemoryBudget(const MemoryBudget& other) = default;
+		MemoryBudget(const VgMemoryBudget& other)
+		  : MemoryBudget(*reinterpret_cast<MemoryBudget const*>(&other))
+		{
+		}
+
+		constexpr MemoryBudget& operator=(vg::MemoryBudget const& other) noexcept = default;
+		inline MemoryBudget& operator=(VgMemoryBudget const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::MemoryBudget const*>(&other);
+			return *this;
+		}
+
+		operator VgMemoryBudget&() noexcept
+		{
+			return *reinterpret_cast<VgMemoryBudget*>(this);
+		}
+		operator const VgMemoryBudget&() const noexcept
+		{
+			return *reinterpret_cast<VgMemoryBudget const*>(this);
+		}
+
+		auto operator<=>(MemoryBudget const& other) const = default;
+	};
+
+	struct MemoryBudgetNotification
+	{
+		using NativeType = VgMemoryBudgetNotification;
+
+		float threshold;
+		MemoryBudgetCallbackPFN callback;
+		void* userData;
+
+		MemoryBudgetNotification() = default;
+
+		MemoryBudgetNotification(
+			float                   threshold_,
+			MemoryBudgetCallbackPFN callback_= {},
+			void*                   userData_= {})
+		  : threshold{ threshold_ }
+		  , callback{ callback_ }
+		  , userData{ userData_ } {}
+		MemoryBudgetNotification(const MemoryBudgetNotification& other) = default;
+		MemoryBudgetNotification(const VgMemoryBudgetNotification& other)
+		  : MemoryBudgetNotification(*reinterpret_cast<MemoryBudgetNotification const*>(&other))
+		{
+		}
+
+		constexpr MemoryBudgetNotification& operator=(vg::MemoryBudgetNotification const& other) noexcept = default;
+		inline MemoryBudgetNotification& operator=(VgMemoryBudgetNotification const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::MemoryBudgetNotification const*>(&other);
+			return *this;
+		}
+
+		operator VgMemoryBudgetNotification&() noexcept
+		{
+			return *reinterpret_cast<VgMemoryBudgetNotification*>(this);
+		}
+		operator const VgMemoryBudgetNotification&() const noexcept
+		{
+			return *reinterpret_cast<VgMemoryBudgetNotification const*>(this);
+		}
+
+		auto operator<=>(MemoryBudgetNotification const& other) const = default;
+	};
+
+	struct DescriptorHeapStatistics
+	{
+		using NativeType = VgDescriptorHeapStatistics;
+
+		uint32_t capacity;
+		uint32_t liveDescriptors;
+		uint32_t highWaterMark;
+		uint32_t freeListLength;
+		uint64_t totalAllocations;
+		uint64_t totalFrees;
+
+		DescriptorHeapStatistics() = default;
+
+		DescriptorHeapStatistics(
+			uint32_t capacity_,
+			uint32_t liveDescriptors_= {},
+			uint32_t highWaterMark_= {},
+			uint32_t freeListLength_= {},
+			uint64_t totalAllocations_= {},
+			uint64_t totalFrees_= {})
+		  : capacity{ capacity_ }
+		  , liveDescriptors{ liveDescriptors_ }
+		  , highWaterMark{ highWaterMark_ }
+		  , freeListLength{ freeListLength_ }
+		  , totalAllocations{ totalAllocations_ }
+		  , totalFrees{ totalFrees_ } {}
+		DescriptorHeapStatistics(const DescriptorHeapStatistics& other) = default;
+		DescriptorHeapStatistics(const VgDescriptorHeapStatistics& other)
+		  : DescriptorHeapStatistics(*reinterpret_cast<DescriptorHeapStatistics const*>(&other))
+		{
+		}
+
+		constexpr DescriptorHeapStatistics& operator=(vg::DescriptorHeapStatistics const& other) noexcept = default;
+		inline DescriptorHeapStatistics& operator=(VgDescriptorHeapStatistics const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::DescriptorHeapStatistics const*>(&other);
+			return *this;
+		}
+
+		operator VgDescriptorHeapStatistics&() noexcept
+		{
+			return *reinterpret_cast<VgDescriptorHeapStatistics*>(this);
+		}
+		operator const VgDescriptorHeapStatistics&() const noexcept
+		{
+			return *reinterpret_cast<VgDescriptorHeapStatistics const*>(this);
+		}
+
+		auto operator<=>(DescriptorHeapStatistics const& other) const = default;
+	};
+
+	struct CommandListStatistics
+	{
+		using NativeType = VgCommandListStatistics;
+
+		uint64_t numStateCommands;
+		uint64_t numFilteredStateCommands;
+
+		CommandListStatistics() = default;
+
+		CommandListStatistics(
+			uint64_t numStateCommands_,
+			uint64_t numFilteredStateCommands_= {})
+		  : numStateCommands{ numStateCommands_ }
+		  , numFilteredStateCommands{ numFilteredStateCommands_ } {}
+		CommandListStatistics(const CommandListStatistics& other) = default;
+		CommandListStatistics(const VgCommandListStatistics& other)
+		  : CommandListStatistics(*reinterpret_cast<CommandListStatistics const*>(&other))
+		{
+		}
+
+		constexpr CommandListStatistics& operator=(vg::CommandListStatistics const& other) noexcept = default;
+		inline CommandListStatistics& operator=(VgCommandListStatistics const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::CommandListStatistics const*>(&other);
+			return *this;
+		}
+
+		operator VgCommandListStatistics&() noexcept
+		{
+			return *reinterpret_cast<VgCommandListStatistics*>(this);
+		}
+		operator const VgCommandListStatistics&() const noexcept
+		{
+			return *reinterpret_cast<VgCommandListStatistics const*>(this);
+		}
+
+		auto operator<=>(CommandListStatistics const& other) const = default;
+	};
+
 	struct DrawIndirectCommand
 	{
 		using NativeType = VgDrawIndirectCommand;
@@ -3132,6 +4012,132 @@ namespace vg
 		auto operator<=>(DispatchIndirectCommand const& other) const = default;
 	};
 
+	struct MultiDrawInfo
+	{
+		using NativeType = VgMultiDrawInfo;
+
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+
+		MultiDrawInfo() = default;
+
+		MultiDrawInfo(
+			uint32_t firstVertex_,
+			uint32_t vertexCount_= {})
+		  : firstVertex{ firstVertex_ }
+		  , vertexCount{ vertexCount_ } {}
+		MultiDrawInfo(const MultiDrawInfo& other) = default;
+		MultiDrawInfo(const VgMultiDrawInfo& other)
+		  : MultiDrawInfo(*reinterpret_cast<MultiDrawInfo const*>(&other))
+		{
+		}
+
+		constexpr MultiDrawInfo& operator=(vg::MultiDrawInfo const& other) noexcept = default;
+		inline MultiDrawInfo& operator=(VgMultiDrawInfo const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::MultiDrawInfo const*>(&other);
+			return *this;
+		}
+
+		operator VgMultiDrawInfo&() noexcept
+		{
+			return *reinterpret_cast<VgMultiDrawInfo*>(this);
+		}
+		operator const VgMultiDrawInfo&() const noexcept
+		{
+			return *reinterpret_cast<VgMultiDrawInfo const*>(this);
+		}
+
+		auto operator<=>(MultiDrawInfo const& other) const = default;
+	};
+
+	struct MultiDrawIndexedInfo
+	{
+		using NativeType = VgMultiDrawIndexedInfo;
+
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t vertexOffset;
+
+		MultiDrawIndexedInfo() = default;
+
+		MultiDrawIndexedInfo(
+			uint32_t firstIndex_,
+			uint32_t indexCount_= {},
+			uint32_t vertexOffset_= {})
+		  : firstIndex{ firstIndex_ }
+		  , indexCount{ indexCount_ }
+		  , vertexOffset{ vertexOffset_ } {}
+		MultiDrawIndexedInfo(const MultiDrawIndexedInfo& other) = default;
+		MultiDrawIndexedInfo(const VgMultiDrawIndexedInfo& other)
+		  : MultiDrawIndexedInfo(*reinterpret_cast<MultiDrawIndexedInfo const*>(&other))
+		{
+		}
+
+		constexpr MultiDrawIndexedInfo& operator=(vg::MultiDrawIndexedInfo const& other) noexcept = default;
+		inline MultiDrawIndexedInfo& operator=(VgMultiDrawIndexedInfo const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::MultiDrawIndexedInfo const*>(&other);
+			return *this;
+		}
+
+		operator VgMultiDrawIndexedInfo&() noexcept
+		{
+			return *reinterpret_cast<VgMultiDrawIndexedInfo*>(this);
+		}
+		operator const VgMultiDrawIndexedInfo&() const noexcept
+		{
+			return *reinterpret_cast<VgMultiDrawIndexedInfo const*>(this);
+		}
+
+		auto operator<=>(MultiDrawIndexedInfo const& other) const = default;
+	};
+
+	struct MultiDrawRootConstants
+	{
+		using NativeType = VgMultiDrawRootConstants;
+
+		uint32_t offsetIn32bitValues;
+		uint32_t num32bitValues;
+		const void* data;
+		uint32_t stride;
+
+		MultiDrawRootConstants() = default;
+
+		MultiDrawRootConstants(
+			uint32_t    offsetIn32bitValues_,
+			uint32_t    num32bitValues_= {},
+			const void* data_= {},
+			uint32_t    stride_= {})
+		  : offsetIn32bitValues{ offsetIn32bitValues_ }
+		  , num32bitValues{ num32bitValues_ }
+		  , data{ data_ }
+		  , stride{ stride_ } {}
+		MultiDrawRootConstants(const MultiDrawRootConstants& other) = default;
+		MultiDrawRootConstants(const VgMultiDrawRootConstants& other)
+		  : MultiDrawRootConstants(*reinterpret_cast<MultiDrawRootConstants const*>(&other))
+		{
+		}
+
+		constexpr MultiDrawRootConstants& operator=(vg::MultiDrawRootConstants const& other) noexcept = default;
+		inline MultiDrawRootConstants& operator=(VgMultiDrawRootConstants const& other) noexcept
+		{
+			*this = *reinterpret_cast<vg::MultiDrawRootConstants const*>(&other);
+			return *this;
+		}
+
+		operator VgMultiDrawRootConstants&() noexcept
+		{
+			return *reinterpret_cast<VgMultiDrawRootConstants*>(this);
+		}
+		operator const VgMultiDrawRootConstants&() const noexcept
+		{
+			return *reinterpret_cast<VgMultiDrawRootConstants const*>(this);
+		}
+
+		auto operator<=>(MultiDrawRootConstants const& other) const = default;
+	};
+
 	struct VulkanObjects
 	{
 		using NativeType = VgVulkanObjects;
@@ -3248,6 +4254,21 @@ namespace vg
 	constexpr TextureUsageFlags operator~(TextureUsageFlags a) { return static_cast<TextureUsageFlags>(~static_cast<std::underlying_type_t<TextureUsageFlags>>(a)); }
 
 
+	constexpr RenderingFlags operator|(RenderingFlags a, RenderingFlags b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) | static_cast<std::underlying_type_t<RenderingFlags>>(b)); }
+	constexpr RenderingFlags& operator|=(RenderingFlags& a, RenderingFlags b) { a = a | b; return a; }
+	constexpr RenderingFlags operator&(RenderingFlags a, RenderingFlags b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) & static_cast<std::underlying_type_t<RenderingFlags>>(b)); }
+	constexpr RenderingFlags& operator&=(RenderingFlags& a, RenderingFlags b) { a = a & b; return a; }
+	constexpr RenderingFlags operator^(RenderingFlags a, RenderingFlags b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) ^ static_cast<std::underlying_type_t<RenderingFlags>>(b)); }
+	constexpr RenderingFlags& operator^=(RenderingFlags& a, RenderingFlags b) { a = a ^ b; return a; }
+	constexpr RenderingFlags operator<<(RenderingFlags a, std::underlying_type_t<RenderingFlags> b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) << b); }
+	constexpr RenderingFlags operator<<(RenderingFlags a, RenderingFlags b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) << static_cast<std::underlying_type_t<RenderingFlags>>(b)); }
+	constexpr RenderingFlags& operator<<=(RenderingFlags& a, RenderingFlags b) { a = a << b; return a; }
+	constexpr RenderingFlags operator>>(RenderingFlags a, std::underlying_type_t<RenderingFlags> b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) >> b); }
+	constexpr RenderingFlags operator>>(RenderingFlags a, RenderingFlags b) { return static_cast<RenderingFlags>(static_cast<std::underlying_type_t<RenderingFlags>>(a) >> static_cast<std::underlying_type_t<RenderingFlags>>(b)); }
+	constexpr RenderingFlags& operator>>=(RenderingFlags& a, RenderingFlags b) { a = a >> b; return a; }
+	constexpr RenderingFlags operator~(RenderingFlags a) { return static_cast<RenderingFlags>(~static_cast<std::underlying_type_t<RenderingFlags>>(a)); }
+
+
 	constexpr ColorComponentFlags operator|(ColorComponentFlags a, ColorComponentFlags b) { return static_cast<ColorComponentFlags>(static_cast<std::underlying_type_t<ColorComponentFlags>>(a) | static_cast<std::underlying_type_t<ColorComponentFlags>>(b)); }
 	constexpr ColorComponentFlags& operator|=(ColorComponentFlags& a, ColorComponentFlags b) { a = a | b; return a; }
 	constexpr ColorComponentFlags operator&(ColorComponentFlags a, ColorComponentFlags b) { return static_cast<ColorComponentFlags>(static_cast<std::underlying_type_t<ColorComponentFlags>>(a) & static_cast<std::underlying_type_t<ColorComponentFlags>>(b)); }
@@ -3263,6 +4284,36 @@ namespace vg
 	constexpr ColorComponentFlags operator~(ColorComponentFlags a) { return static_cast<ColorComponentFlags>(~static_cast<std::underlying_type_t<ColorComponentFlags>>(a)); }
 
 
+	constexpr GraphicsPipelineLibraryFlags operator|(GraphicsPipelineLibraryFlags a, GraphicsPipelineLibraryFlags b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) | static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(b)); }
+	constexpr GraphicsPipelineLibraryFlags& operator|=(GraphicsPipelineLibraryFlags& a, GraphicsPipelineLibraryFlags b) { a = a | b; return a; }
+	constexpr GraphicsPipelineLibraryFlags operator&(GraphicsPipelineLibraryFlags a, GraphicsPipelineLibraryFlags b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) & static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(b)); }
+	constexpr GraphicsPipelineLibraryFlags& operator&=(GraphicsPipelineLibraryFlags& a, GraphicsPipelineLibraryFlags b) { a = a & b; return a; }
+	constexpr GraphicsPipelineLibraryFlags operator^(GraphicsPipelineLibraryFlags a, GraphicsPipelineLibraryFlags b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) ^ static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(b)); }
+	constexpr GraphicsPipelineLibraryFlags& operator^=(GraphicsPipelineLibraryFlags& a, GraphicsPipelineLibraryFlags b) { a = a ^ b; return a; }
+	constexpr GraphicsPipelineLibraryFlags operator<<(GraphicsPipelineLibraryFlags a, std::underlying_type_t<GraphicsPipelineLibraryFlags> b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) << b); }
+	constexpr GraphicsPipelineLibraryFlags operator<<(GraphicsPipelineLibraryFlags a, GraphicsPipelineLibraryFlags b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) << static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(b)); }
+	constexpr GraphicsPipelineLibraryFlags& operator<<=(GraphicsPipelineLibraryFlags& a, GraphicsPipelineLibraryFlags b) { a = a << b; return a; }
+	constexpr GraphicsPipelineLibraryFlags operator>>(GraphicsPipelineLibraryFlags a, std::underlying_type_t<GraphicsPipelineLibraryFlags> b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) >> b); }
+	constexpr GraphicsPipelineLibraryFlags operator>>(GraphicsPipelineLibraryFlags a, GraphicsPipelineLibraryFlags b) { return static_cast<GraphicsPipelineLibraryFlags>(static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a) >> static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(b)); }
+	constexpr GraphicsPipelineLibraryFlags& operator>>=(GraphicsPipelineLibraryFlags& a, GraphicsPipelineLibraryFlags b) { a = a >> b; return a; }
+	constexpr GraphicsPipelineLibraryFlags operator~(GraphicsPipelineLibraryFlags a) { return static_cast<GraphicsPipelineLibraryFlags>(~static_cast<std::underlying_type_t<GraphicsPipelineLibraryFlags>>(a)); }
+
+
+	constexpr MemoryHeapFlags operator|(MemoryHeapFlags a, MemoryHeapFlags b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) | static_cast<std::underlying_type_t<MemoryHeapFlags>>(b)); }
+	constexpr MemoryHeapFlags& operator|=(MemoryHeapFlags& a, MemoryHeapFlags b) { a = a | b; return a; }
+	constexpr MemoryHeapFlags operator&(MemoryHeapFlags a, MemoryHeapFlags b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) & static_cast<std::underlying_type_t<MemoryHeapFlags>>(b)); }
+	constexpr MemoryHeapFlags& operator&=(MemoryHeapFlags& a, MemoryHeapFlags b) { a = a & b; return a; }
+	constexpr MemoryHeapFlags operator^(MemoryHeapFlags a, MemoryHeapFlags b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) ^ static_cast<std::underlying_type_t<MemoryHeapFlags>>(b)); }
+	constexpr MemoryHeapFlags& operator^=(MemoryHeapFlags& a, MemoryHeapFlags b) { a = a ^ b; return a; }
+	constexpr MemoryHeapFlags operator<<(MemoryHeapFlags a, std::underlying_type_t<MemoryHeapFlags> b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) << b); }
+	constexpr MemoryHeapFlags operator<<(MemoryHeapFlags a, MemoryHeapFlags b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) << static_cast<std::underlying_type_t<MemoryHeapFlags>>(b)); }
+	constexpr MemoryHeapFlags& operator<<=(MemoryHeapFlags& a, MemoryHeapFlags b) { a = a << b; return a; }
+	constexpr MemoryHeapFlags operator>>(MemoryHeapFlags a, std::underlying_type_t<MemoryHeapFlags> b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) >> b); }
+	constexpr MemoryHeapFlags operator>>(MemoryHeapFlags a, MemoryHeapFlags b) { return static_cast<MemoryHeapFlags>(static_cast<std::underlying_type_t<MemoryHeapFlags>>(a) >> static_cast<std::underlying_type_t<MemoryHeapFlags>>(b)); }
+	constexpr MemoryHeapFlags& operator>>=(MemoryHeapFlags& a, MemoryHeapFlags b) { a = a >> b; return a; }
+	constexpr MemoryHeapFlags operator~(MemoryHeapFlags a) { return static_cast<MemoryHeapFlags>(~static_cast<std::underlying_type_t<MemoryHeapFlags>>(a)); }
+
+
 	inline vg::Result vg::Init(const vg::Config* cfg)
 	{
 		return static_cast<vg::Result>(vgInit(*reinterpret_cast<const VgConfig**>(&cfg)));
@@ -3325,6 +4376,18 @@ namespace vg
 	{
 		return static_cast<vg::Result>(vgDeviceGetMemoryStatistics(_handle, *reinterpret_cast<VgMemoryStatistics**>(&outMemoryStats)));
 	}
+	inline vg::Result vg::Device::GetMemoryBudget(vg::MemoryBudget* outBudget) const
+	{
+		return static_cast<vg::Result>(vgDeviceGetMemoryBudget(_handle, *reinterpret_cast<VgMemoryBudget**>(&outBudget)));
+	}
+	inline vg::Result vg::Device::SetMemoryBudgetNotification(const vg::MemoryBudgetNotification* notification)
+	{
+		return static_cast<vg::Result>(vgDeviceSetMemoryBudgetNotification(_handle, *reinterpret_cast<const VgMemoryBudgetNotification**>(&notification)));
+	}
+	inline vg::Result vg::Device::GetDescriptorHeapStatistics(vg::DescriptorHeapType type, vg::DescriptorHeapStatistics* outStats) const
+	{
+		return static_cast<vg::Result>(vgDeviceGetDescriptorHeapStatistics(_handle, *reinterpret_cast<VgDescriptorHeapType*>(&type), *reinterpret_cast<VgDescriptorHeapStatistics**>(&outStats)));
+	}
 	inline void vg::Device::WaitQueueIdle(vg::Queue queue)
 	{
 		vgDeviceWaitQueueIdle(_handle, *reinterpret_cast<VgQueue*>(&queue));
@@ -3357,6 +4420,14 @@ namespace vg
 	{
 		return static_cast<vg::Result>(vgDeviceCreateComputePipeline(_handle, *reinterpret_cast<VgShaderModule*>(&shaderModule), *reinterpret_cast<VgPipeline**>(&outPipeline)));
 	}
+	inline vg::Result vg::Device::CreateGraphicsPipelineLibrary(vg::GraphicsPipelineLibraryFlags parts, const vg::GraphicsPipelineDesc* desc, vg::Pipeline* outLibrary)
+	{
+		return static_cast<vg::Result>(vgDeviceCreateGraphicsPipelineLibrary(_handle, *reinterpret_cast<VgGraphicsPipelineLibraryFlags*>(&parts), *reinterpret_cast<const VgGraphicsPipelineDesc**>(&desc), *reinterpret_cast<VgPipeline**>(&outLibrary)));
+	}
+	inline vg::Result vg::Device::LinkGraphicsPipeline(uint32_t numLibraries, const vg::Pipeline* libraries, vg::Pipeline* outPipeline)
+	{
+		return static_cast<vg::Result>(vgDeviceLinkGraphicsPipeline(_handle, numLibraries, *reinterpret_cast<const VgPipeline**>(&libraries), *reinterpret_cast<VgPipeline**>(&outPipeline)));
+	}
 	inline void vg::Device::DestroyPipeline(vg::Pipeline pipeline)
 	{
 		vgDeviceDestroyPipeline(_handle, *reinterpret_cast<VgPipeline*>(&pipeline));
@@ -3421,6 +4492,58 @@ namespace vg
 	{
 		return static_cast<vg::Result>(vgDeviceGetSamplerIndex(_handle, *reinterpret_cast<VgSampler*>(&sampler), outIndex));
 	}
+	inline vg::Result vg::Device::CreateReadbackPool(uint64_t size, vg::ReadbackPool* outPool)
+	{
+		return static_cast<vg::Result>(vgDeviceCreateReadbackPool(_handle, size, *reinterpret_cast<VgReadbackPool**>(&outPool)));
+	}
+	inline void vg::Device::DestroyReadbackPool(vg::ReadbackPool pool)
+	{
+		vgDeviceDestroyReadbackPool(_handle, *reinterpret_cast<VgReadbackPool*>(&pool));
+	}
+	inline vg::Result vg::Device::GetReadbackResult(vg::ReadbackPool pool, vg::ReadbackTicket ticket, vg::ReadbackResult* outResult) const
+	{
+		return static_cast<vg::Result>(vgDeviceGetReadbackResult(_handle, *reinterpret_cast<VgReadbackPool*>(&pool), ticket, *reinterpret_cast<VgReadbackResult**>(&outResult)));
+	}
+	inline void vg::Device::ReleaseReadback(vg::ReadbackPool pool, vg::ReadbackTicket ticket)
+	{
+		vgDeviceReleaseReadback(_handle, *reinterpret_cast<VgReadbackPool*>(&pool), ticket);
+	}
+	inline void vg::Device::ProcessReadbacks(vg::ReadbackPool pool)
+	{
+		vgDeviceProcessReadbacks(_handle, *reinterpret_cast<VgReadbackPool*>(&pool));
+	}
+	inline vg::Result vg::Device::CreateConstantAllocator(uint64_t size, vg::ConstantAllocator* outAllocator)
+	{
+		return static_cast<vg::Result>(vgDeviceCreateConstantAllocator(_handle, size, *reinterpret_cast<VgConstantAllocator**>(&outAllocator)));
+	}
+	inline void vg::Device::DestroyConstantAllocator(vg::ConstantAllocator allocator)
+	{
+		vgDeviceDestroyConstantAllocator(_handle, *reinterpret_cast<VgConstantAllocator*>(&allocator));
+	}
+	inline vg::Result vg::Device::AllocateConstants(vg::ConstantAllocator allocator, uint64_t size, vg::ConstantAllocation* outAllocation)
+	{
+		return static_cast<vg::Result>(vgDeviceAllocateConstants(_handle, *reinterpret_cast<VgConstantAllocator*>(&allocator), size, *reinterpret_cast<VgConstantAllocation**>(&outAllocation)));
+	}
+	inline void vg::Device::EndConstantFrame(vg::ConstantAllocator allocator, vg::Fence fence, uint64_t fenceValue)
+	{
+		vgDeviceEndConstantFrame(_handle, *reinterpret_cast<VgConstantAllocator*>(&allocator), *reinterpret_cast<VgFence*>(&fence), fenceValue);
+	}
+	inline vg::Result vg::Device::CreateQueueScheduler(vg::QueueScheduler* outScheduler)
+	{
+		return static_cast<vg::Result>(vgDeviceCreateQueueScheduler(_handle, *reinterpret_cast<VgQueueScheduler**>(&outScheduler)));
+	}
+	inline void vg::Device::DestroyQueueScheduler(vg::QueueScheduler scheduler)
+	{
+		vgDeviceDestroyQueueScheduler(_handle, *reinterpret_cast<VgQueueScheduler*>(&scheduler));
+	}
+	inline vg::Result vg::Device::ScheduleCommandLists(vg::QueueScheduler scheduler, uint32_t numCommandLists, vg::CommandList* commandLists, uint32_t numDependencies, const vg::SyncPoint* dependencies, vg::SyncPoint* outSyncPoint)
+	{
+		return static_cast<vg::Result>(vgDeviceScheduleCommandLists(_handle, *reinterpret_cast<VgQueueScheduler*>(&scheduler), numCommandLists, *reinterpret_cast<VgCommandList**>(&commandLists), numDependencies, *reinterpret_cast<const VgSyncPoint**>(&dependencies), *reinterpret_cast<VgSyncPoint**>(&outSyncPoint)));
+	}
+	inline vg::Result vg::Device::GetSyncPointFence(vg::QueueScheduler scheduler, const vg::SyncPoint* syncPoint, vg::FenceOperation* outFence) const
+	{
+		return static_cast<vg::Result>(vgDeviceGetSyncPointFence(_handle, *reinterpret_cast<VgQueueScheduler*>(&scheduler), *reinterpret_cast<const VgSyncPoint**>(&syncPoint), *reinterpret_cast<VgFenceOperation**>(&outFence)));
+	}
 
 	inline vg::Result vg::CommandPool::GetApiObject(void** outObj) const
 	{
@@ -3471,6 +4594,10 @@ namespace vg
 	{
 		return static_cast<vg::Result>(vgCommandListGetQueue(_handle, *reinterpret_cast<VgQueue**>(&outQueue)));
 	}
+	inline vg::Result vg::CommandList::GetStatistics(vg::CommandListStatistics* outStatistics) const
+	{
+		return static_cast<vg::Result>(vgCommandListGetStatistics(_handle, *reinterpret_cast<VgCommandListStatistics**>(&outStatistics)));
+	}
 	inline void vg::CommandList::RestoreDescriptorState()
 	{
 		vgCommandListRestoreDescriptorState(_handle);
@@ -3479,6 +4606,10 @@ namespace vg
 	{
 		vgCmdBegin(_handle);
 	}
+	inline vg::Result vg::CommandList::BeginBundle(const vg::BundleInheritanceInfo* inheritanceInfo)
+	{
+		return static_cast<vg::Result>(vgCmdBeginBundle(_handle, *reinterpret_cast<const VgBundleInheritanceInfo**>(&inheritanceInfo)));
+	}
 	inline void vg::CommandList::End()
 	{
 		vgCmdEnd(_handle);
@@ -3499,10 +4630,18 @@ namespace vg
 	{
 		vgCmdSetPipeline(_handle, *reinterpret_cast<VgPipeline*>(&pipeline));
 	}
+	inline void vg::CommandList::SetGraphicsState(vg::GraphicsPipelineLibraryFlags parts, const vg::GraphicsPipelineDesc* desc)
+	{
+		vgCmdSetGraphicsState(_handle, *reinterpret_cast<VgGraphicsPipelineLibraryFlags*>(&parts), *reinterpret_cast<const VgGraphicsPipelineDesc**>(&desc));
+	}
 	inline void vg::CommandList::Barrier(const vg::DependencyInfo* dependencyInfo)
 	{
 		vgCmdBarrier(_handle, *reinterpret_cast<const VgDependencyInfo**>(&dependencyInfo));
 	}
+	inline void vg::CommandList::Transition(const vg::TransitionInfo* transitionInfo)
+	{
+		vgCmdTransition(_handle, *reinterpret_cast<const VgTransitionInfo**>(&transitionInfo));
+	}
 	inline vg::Result vg::CommandList::BeginRendering(const vg::RenderingInfo* info)
 	{
 		return static_cast<vg::Result>(vgCmdBeginRendering(_handle, *reinterpret_cast<const VgRenderingInfo**>(&info)));
@@ -3519,6 +4658,10 @@ namespace vg
 	{
 		vgCmdSetScissor(_handle, firstScissor, numScissors, *reinterpret_cast<VgScissor**>(&scissors));
 	}
+	inline void vg::CommandList::ExecuteBundle(vg::CommandList bundle)
+	{
+		vgCmdExecuteBundle(_handle, *reinterpret_cast<VgCommandList*>(&bundle));
+	}
 	inline void vg::CommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
 	{
 		vgCmdDraw(_handle, vertexCount, instanceCount, firstVertex, firstInstance);
@@ -3527,6 +4670,14 @@ namespace vg
 	{
 		vgCmdDrawIndexed(_handle, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
+	inline void vg::CommandList::DrawMulti(uint32_t drawCount, const vg::MultiDrawInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const vg::MultiDrawRootConstants* rootConstants)
+	{
+		vgCmdDrawMulti(_handle, drawCount, *reinterpret_cast<const VgMultiDrawInfo**>(&draws), instanceCount, firstInstance, *reinterpret_cast<const VgMultiDrawRootConstants**>(&rootConstants));
+	}
+	inline void vg::CommandList::DrawIndexedMulti(uint32_t drawCount, const vg::MultiDrawIndexedInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const vg::MultiDrawRootConstants* rootConstants)
+	{
+		vgCmdDrawIndexedMulti(_handle, drawCount, *reinterpret_cast<const VgMultiDrawIndexedInfo**>(&draws), instanceCount, firstInstance, *reinterpret_cast<const VgMultiDrawRootConstants**>(&rootConstants));
+	}
 	inline void vg::CommandList::Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
 	{
 		vgCmdDispatch(_handle, groupsX, groupsY, groupsZ);
@@ -3551,6 +4702,10 @@ namespace vg
 	{
 		vgCmdDispatchIndirect(_handle, *reinterpret_cast<VgBuffer*>(&buffer), offset);
 	}
+	inline void vg::CommandList::DispatchMesh(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		vgCmdDispatchMesh(_handle, groupsX, groupsY, groupsZ);
+	}
 	inline void vg::CommandList::CopyBufferToBuffer(vg::Buffer dst, uint64_t dstOffset, vg::Buffer src, uint64_t srcOffset, uint64_t size)
 	{
 		vgCmdCopyBufferToBuffer(_handle, *reinterpret_cast<VgBuffer*>(&dst), dstOffset, *reinterpret_cast<VgBuffer*>(&src), srcOffset, size);
@@ -3567,6 +4722,30 @@ namespace vg
 	{
 		vgCmdCopyTextureToTexture(_handle, *reinterpret_cast<VgTexture*>(&dst), *reinterpret_cast<const VgRegion**>(&dstRegion), *reinterpret_cast<VgTexture*>(&src), *reinterpret_cast<const VgRegion**>(&srcRegion));
 	}
+	inline void vg::CommandList::CopyBufferToBufferRegions(vg::Buffer dst, vg::Buffer src, uint32_t numRegions, const vg::BufferCopyRegion* regions)
+	{
+		vgCmdCopyBufferToBufferRegions(_handle, *reinterpret_cast<VgBuffer*>(&dst), *reinterpret_cast<VgBuffer*>(&src), numRegions, *reinterpret_cast<const VgBufferCopyRegion**>(&regions));
+	}
+	inline void vg::CommandList::CopyBufferToTextureRegions(vg::Texture dst, vg::Buffer src, uint32_t numRegions, const vg::BufferTextureCopyRegion* regions)
+	{
+		vgCmdCopyBufferToTextureRegions(_handle, *reinterpret_cast<VgTexture*>(&dst), *reinterpret_cast<VgBuffer*>(&src), numRegions, *reinterpret_cast<const VgBufferTextureCopyRegion**>(&regions));
+	}
+	inline void vg::CommandList::CopyTextureToBufferRegions(vg::Buffer dst, vg::Texture src, uint32_t numRegions, const vg::BufferTextureCopyRegion* regions)
+	{
+		vgCmdCopyTextureToBufferRegions(_handle, *reinterpret_cast<VgBuffer*>(&dst), *reinterpret_cast<VgTexture*>(&src), numRegions, *reinterpret_cast<const VgBufferTextureCopyRegion**>(&regions));
+	}
+	inline void vg::CommandList::CopyTextureToTextureRegions(vg::Texture dst, vg::Texture src, uint32_t numRegions, const vg::TextureCopyRegion* regions)
+	{
+		vgCmdCopyTextureToTextureRegions(_handle, *reinterpret_cast<VgTexture*>(&dst), *reinterpret_cast<VgTexture*>(&src), numRegions, *reinterpret_cast<const VgTextureCopyRegion**>(&regions));
+	}
+	inline vg::Result vg::CommandList::ReadbackBuffer(vg::ReadbackPool pool, vg::Buffer src, uint64_t srcOffset, uint64_t size, const vg::ReadbackRequest* request, vg::ReadbackTicket* outTicket)
+	{
+		return static_cast<vg::Result>(vgCmdReadbackBuffer(_handle, *reinterpret_cast<VgReadbackPool*>(&pool), *reinterpret_cast<VgBuffer*>(&src), srcOffset, size, *reinterpret_cast<const VgReadbackRequest**>(&request), outTicket));
+	}
+	inline vg::Result vg::CommandList::ReadbackTexture(vg::ReadbackPool pool, vg::Texture src, const vg::Region* srcRegion, const vg::ReadbackRequest* request, vg::ReadbackTicket* outTicket)
+	{
+		return static_cast<vg::Result>(vgCmdReadbackTexture(_handle, *reinterpret_cast<VgReadbackPool*>(&pool), *reinterpret_cast<VgTexture*>(&src), *reinterpret_cast<const VgRegion**>(&srcRegion), *reinterpret_cast<const VgReadbackRequest**>(&request), outTicket));
+	}
 	inline void vg::CommandList::BeginMarker(const char* name, std::array<float, 3> color)
 	{
 		vgCmdBeginMarker(_handle, name, color.data());
@@ -3686,12 +4865,16 @@ namespace vg
 	static_assert(sizeof(VertexBufferView) == sizeof(VgVertexBufferView));
 	static_assert(sizeof(BufferViewDesc) == sizeof(VgBufferViewDesc));
 	static_assert(sizeof(FenceOperation) == sizeof(VgFenceOperation));
+	static_assert(sizeof(SyncPoint) == sizeof(VgSyncPoint));
 	static_assert(sizeof(SubmitInfo) == sizeof(VgSubmitInfo));
 	static_assert(sizeof(TextureSubresourceRange) == sizeof(VgTextureSubresourceRange));
 	static_assert(sizeof(MemoryBarrier) == sizeof(VgMemoryBarrier));
 	static_assert(sizeof(BufferBarrier) == sizeof(VgBufferBarrier));
 	static_assert(sizeof(TextureBarrier) == sizeof(VgTextureBarrier));
 	static_assert(sizeof(DependencyInfo) == sizeof(VgDependencyInfo));
+	static_assert(sizeof(BufferTransition) == sizeof(VgBufferTransition));
+	static_assert(sizeof(TextureTransition) == sizeof(VgTextureTransition));
+	static_assert(sizeof(TransitionInfo) == sizeof(VgTransitionInfo));
 	static_assert(sizeof(SamplerDesc) == sizeof(VgSamplerDesc));
 	static_assert(sizeof(TextureDesc) == sizeof(VgTextureDesc));
 	static_assert(sizeof(AttachmentViewDesc) == sizeof(VgAttachmentViewDesc));
@@ -3701,6 +4884,9 @@ namespace vg
 	static_assert(sizeof(TextureViewDesc) == sizeof(VgTextureViewDesc));
 	static_assert(sizeof(Offset) == sizeof(VgOffset));
 	static_assert(sizeof(Region) == sizeof(VgRegion));
+	static_assert(sizeof(BufferCopyRegion) == sizeof(VgBufferCopyRegion));
+	static_assert(sizeof(BufferTextureCopyRegion) == sizeof(VgBufferTextureCopyRegion));
+	static_assert(sizeof(TextureCopyRegion) == sizeof(VgTextureCopyRegion));
 	static_assert(sizeof(SwapChainDesc) == sizeof(VgSwapChainDesc));
 	static_assert(sizeof(VertexAttribute) == sizeof(VgVertexAttribute));
 	static_assert(sizeof(FixedFunctionState) == sizeof(VgFixedFunctionState));
@@ -3714,10 +4900,20 @@ namespace vg
 	static_assert(sizeof(GraphicsPipelineDesc) == sizeof(VgGraphicsPipelineDesc));
 	static_assert(sizeof(Viewport) == sizeof(VgViewport));
 	static_assert(sizeof(Scissor) == sizeof(VgScissor));
+	static_assert(sizeof(BundleInheritanceInfo) == sizeof(VgBundleInheritanceInfo));
 	static_assert(sizeof(MemoryStatistics) == sizeof(VgMemoryStatistics));
+	static_assert(sizeof(MemoryHeapBudget) == sizeof(VgMemoryHeapBudget));
+	static_assert(sizeof(MemoryBudget) == sizeof(VgMemoryBudget));
+	static_assert(sizeof(MemoryBudgetNotification) == sizeof(VgMemoryBudgetNotification));
+	static_assert(sizeof(DescriptorHeapStatistics) == sizeof(VgDescriptorHeapStatistics));
+	static_assert(sizeof(CommandListStatistics) == sizeof(VgCommandListStatistics));
 	static_assert(sizeof(DrawIndirectCommand) == sizeof(VgDrawIndirectCommand));
 	static_assert(sizeof(DrawIndexedIndirectCommand) == sizeof(VgDrawIndexedIndirectCommand));
 	static_assert(sizeof(DispatchIndirectCommand) == sizeof(VgDispatchIndirectCommand));
+	static_assert(sizeof(MultiDrawInfo) == sizeof(VgMultiDrawInfo));
+	static_assert(sizeof(MultiDrawIndexedInfo) == sizeof(VgMultiDrawIndexedInfo));
+	static_assert(sizeof(MultiDrawRootConstants) == sizeof(VgMultiDrawRootConstants));
+	static_assert(sizeof(ConstantAllocation) == sizeof(VgConstantAllocation));
 	static_assert(sizeof(VulkanObjects) == sizeof(VgVulkanObjects));
 
 }
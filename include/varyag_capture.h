@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+
+// Binary layout of the files written when vgInit() is called with VG_INIT_ENABLE_CAPTURE.
+//
+// A capture is a VgCaptureFileHeader followed by a stream of records. Every record is a VgCaptureRecordHeader
+// followed by `size` bytes of payload holding the arguments of the call in declaration order:
+//  - scalars, enums and pointer-free structs are stored as-is (little endian, native struct layout)
+//  - handles are stored as uint64_t object ids assigned at creation, 0 is NULL
+//  - strings and byte blobs are stored as a uint32_t length followed by the data
+//  - arrays are stored as a uint32_t count followed by the elements
+//  - structs holding pointers or handles are flattened field by field
+// Objects created by a call (out_* handles) are written as the id they were assigned, view indices returned
+// by the library are written after the arguments so a replay can detect and remap mismatches.
+//
+// Contents of mapped VG_HEAP_TYPE_UPLOAD buffers are not known to the library when they are written, so mapped
+// ranges are snapshotted on vgBufferUnmap() and before every vgDeviceSubmitCommandLists(). Only pages which changed
+// since the last snapshot are written as VG_CAPTURE_OP_BUFFER_DATA records.
+//
+// The format is tied to the library version which wrote it, readers should reject any other version.
+
+#define VG_CAPTURE_MAGIC 0x50434756u /* "VGCP" */
+#define VG_CAPTURE_VERSION 1u
+#define VG_CAPTURE_PAGE_SIZE 65536u
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	typedef enum VgCaptureOp : uint32_t
+	{
+		VG_CAPTURE_OP_ADAPTER_CREATE_DEVICE = 1,
+		VG_CAPTURE_OP_ADAPTER_DESTROY_DEVICE = 2,
+
+		VG_CAPTURE_OP_DEVICE_WAIT_QUEUE_IDLE = 10,
+		VG_CAPTURE_OP_DEVICE_WAIT_IDLE = 11,
+		VG_CAPTURE_OP_DEVICE_CREATE_BUFFER = 12,
+		VG_CAPTURE_OP_DEVICE_DESTROY_BUFFER = 13,
+		VG_CAPTURE_OP_DEVICE_CREATE_SHADER_MODULE = 14,
+		VG_CAPTURE_OP_DEVICE_DESTROY_SHADER_MODULE = 15,
+		VG_CAPTURE_OP_DEVICE_CREATE_GRAPHICS_PIPELINE = 16,
+		VG_CAPTURE_OP_DEVICE_CREATE_COMPUTE_PIPELINE = 17,
+		VG_CAPTURE_OP_DEVICE_DESTROY_PIPELINE = 18,
+		VG_CAPTURE_OP_DEVICE_CREATE_FENCE = 19,
+		VG_CAPTURE_OP_DEVICE_DESTROY_FENCE = 20,
+		VG_CAPTURE_OP_DEVICE_CREATE_COMMAND_POOL = 21,
+		VG_CAPTURE_OP_DEVICE_DESTROY_COMMAND_POOL = 22,
+		VG_CAPTURE_OP_DEVICE_CREATE_SAMPLER = 23,
+		VG_CAPTURE_OP_DEVICE_DESTROY_SAMPLER = 24,
+		VG_CAPTURE_OP_DEVICE_CREATE_TEXTURE = 25,
+		VG_CAPTURE_OP_DEVICE_DESTROY_TEXTURE = 26,
+		VG_CAPTURE_OP_DEVICE_SUBMIT_COMMAND_LISTS = 27,
+		VG_CAPTURE_OP_DEVICE_SIGNAL_FENCE = 28,
+		VG_CAPTURE_OP_DEVICE_WAIT_FENCE = 29,
+		VG_CAPTURE_OP_DEVICE_CREATE_SWAP_CHAIN = 30,
+		VG_CAPTURE_OP_DEVICE_DESTROY_SWAP_CHAIN = 31,
+		VG_CAPTURE_OP_DEVICE_CREATE_READBACK_POOL = 32,
+		VG_CAPTURE_OP_DEVICE_DESTROY_READBACK_POOL = 33,
+		VG_CAPTURE_OP_DEVICE_RELEASE_READBACK = 34,
+		VG_CAPTURE_OP_DEVICE_PROCESS_READBACKS = 35,
+		VG_CAPTURE_OP_DEVICE_CREATE_GRAPHICS_PIPELINE_LIBRARY = 36,
+		VG_CAPTURE_OP_DEVICE_LINK_GRAPHICS_PIPELINE = 37,
+		VG_CAPTURE_OP_DEVICE_CREATE_CONSTANT_ALLOCATOR = 38,
+		VG_CAPTURE_OP_DEVICE_DESTROY_CONSTANT_ALLOCATOR = 39,
+
+		VG_CAPTURE_OP_COMMAND_POOL_SET_NAME = 40,
+		VG_CAPTURE_OP_COMMAND_POOL_ALLOCATE_COMMAND_LIST = 41,
+		VG_CAPTURE_OP_COMMAND_POOL_FREE_COMMAND_LIST = 42,
+		VG_CAPTURE_OP_COMMAND_POOL_RESET = 43,
+
+		VG_CAPTURE_OP_COMMAND_LIST_SET_NAME = 50,
+		VG_CAPTURE_OP_COMMAND_LIST_RESTORE_DESCRIPTOR_STATE = 51,
+
+		VG_CAPTURE_OP_CMD_BEGIN = 60,
+		VG_CAPTURE_OP_CMD_END = 61,
+		VG_CAPTURE_OP_CMD_SET_VERTEX_BUFFERS = 62,
+		VG_CAPTURE_OP_CMD_SET_INDEX_BUFFER = 63,
+		VG_CAPTURE_OP_CMD_SET_ROOT_CONSTANTS = 64,
+		VG_CAPTURE_OP_CMD_SET_PIPELINE = 65,
+		VG_CAPTURE_OP_CMD_BARRIER = 66,
+		VG_CAPTURE_OP_CMD_BEGIN_RENDERING = 67,
+		VG_CAPTURE_OP_CMD_END_RENDERING = 68,
+		VG_CAPTURE_OP_CMD_SET_VIEWPORT = 69,
+		VG_CAPTURE_OP_CMD_SET_SCISSOR = 70,
+		VG_CAPTURE_OP_CMD_DRAW = 71,
+		VG_CAPTURE_OP_CMD_DRAW_INDEXED = 72,
+		VG_CAPTURE_OP_CMD_DISPATCH = 73,
+		VG_CAPTURE_OP_CMD_DRAW_INDIRECT = 74,
+		VG_CAPTURE_OP_CMD_DRAW_INDIRECT_COUNT = 75,
+		VG_CAPTURE_OP_CMD_DRAW_INDEXED_INDIRECT = 76,
+		VG_CAPTURE_OP_CMD_DRAW_INDEXED_INDIRECT_COUNT = 77,
+		VG_CAPTURE_OP_CMD_DISPATCH_INDIRECT = 78,
+		VG_CAPTURE_OP_CMD_DISPATCH_MESH = 79,
+		VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_BUFFER = 80,
+		VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_TEXTURE = 81,
+		VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_BUFFER = 82,
+		VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_TEXTURE = 83,
+		VG_CAPTURE_OP_CMD_BEGIN_MARKER = 84,
+		VG_CAPTURE_OP_CMD_END_MARKER = 85,
+		VG_CAPTURE_OP_CMD_READBACK_BUFFER = 86,
+		VG_CAPTURE_OP_CMD_READBACK_TEXTURE = 87,
+		VG_CAPTURE_OP_CMD_TRANSITION = 88,
+		VG_CAPTURE_OP_CMD_BEGIN_BUNDLE = 89,
+		VG_CAPTURE_OP_CMD_EXECUTE_BUNDLE = 90,
+		VG_CAPTURE_OP_CMD_DRAW_MULTI = 91,
+		VG_CAPTURE_OP_CMD_DRAW_INDEXED_MULTI = 92,
+		VG_CAPTURE_OP_CMD_SET_GRAPHICS_STATE = 93,
+		VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_BUFFER_REGIONS = 94,
+		VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_TEXTURE_REGIONS = 95,
+		VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_BUFFER_REGIONS = 96,
+		VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_TEXTURE_REGIONS = 97,
+
+		VG_CAPTURE_OP_BUFFER_SET_NAME = 100,
+		VG_CAPTURE_OP_BUFFER_CREATE_VIEW = 101,
+		VG_CAPTURE_OP_BUFFER_DESTROY_VIEWS = 102,
+		VG_CAPTURE_OP_BUFFER_MAP = 103,
+		VG_CAPTURE_OP_BUFFER_UNMAP = 104,
+		VG_CAPTURE_OP_BUFFER_DATA = 105,
+
+		VG_CAPTURE_OP_PIPELINE_SET_NAME = 110,
+
+		VG_CAPTURE_OP_TEXTURE_SET_NAME = 120,
+		VG_CAPTURE_OP_TEXTURE_CREATE_ATTACHMENT_VIEW = 121,
+		VG_CAPTURE_OP_TEXTURE_CREATE_VIEW = 122,
+		VG_CAPTURE_OP_TEXTURE_DESTROY_VIEWS = 123,
+
+		VG_CAPTURE_OP_SWAP_CHAIN_ACQUIRE_NEXT_IMAGE = 130,
+		VG_CAPTURE_OP_SWAP_CHAIN_GET_BACK_BUFFER = 131,
+		VG_CAPTURE_OP_SWAP_CHAIN_PRESENT = 132,
+
+		// Device calls added after the device range above was used up
+		VG_CAPTURE_OP_DEVICE_ALLOCATE_CONSTANTS = 140,
+		VG_CAPTURE_OP_DEVICE_END_CONSTANT_FRAME = 141
+	} VgCaptureOp;
+
+	typedef struct VgCaptureFileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t pointer_size;
+		uint32_t page_size;
+	} VgCaptureFileHeader;
+
+	typedef struct VgCaptureRecordHeader
+	{
+		VgCaptureOp op;
+		uint32_t size;
+	} VgCaptureRecordHeader;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+#include "shader_bundle.h"
+#include "shader_compiler.h"
+#include "shader_permutations.h"
+
+#include <iostream>
+
+// Compiles every permutation in shader_permutations.h for all targets and writes them to one bundle:
+//   model_viewer_bundler <data directory> <output bundle>
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		std::cerr << "usage: model_viewer_bundler <data directory> <output bundle>\n";
+		return 1;
+	}
+	const std::filesystem::path dataDir = argv[1];
+	const std::filesystem::path output = argv[2];
+
+	// Rebuilds only recompile permutations whose inputs changed
+	ShaderCache cache(output.parent_path() / "shader_cache");
+	ShaderBundle::Builder builder;
+	try
+	{
+		for (const auto& permutation : pipelinePermutations)
+		{
+			ShaderBundle::PipelineEntry pipeline = {
+				ShaderBundle::PipelineKey(permutation.name), permutation.meshShader, permutation.numStages
+			};
+			const std::wstring file = (dataDir / permutation.file).wstring();
+			for (uint32_t target = 0; target < ShaderBundle::numTargets; target++)
+			{
+				for (uint32_t i = 0; i < permutation.numStages; i++)
+				{
+					const auto& stage = permutation.stages[i];
+					const std::wstring profile(stage.profile.begin(), stage.profile.end());
+					const std::wstring entryPoint(stage.entryPoint.begin(), stage.entryPoint.end());
+					const auto key = ShaderBundle::ShaderKey(permutation.file, stage.profile, stage.entryPoint,
+						static_cast<ShaderTarget>(target));
+
+					builder.AddShader(key, CompileShader(file, profile, entryPoint, target == uint32_t(ShaderTarget::Spirv), &cache));
+					pipeline.stages[target][i] = key;
+				}
+			}
+			builder.AddPipeline(pipeline);
+		}
+	}
+	catch (const std::exception& ex)
+	{
+		std::cerr << ex.what() << "\n";
+		return 1;
+	}
+
+	if (!builder.Write(output))
+	{
+		std::cerr << "Unable to write " << output.generic_string() << "\n";
+		return 1;
+	}
+	std::cout << "Wrote " << std::size(pipelinePermutations) << " pipelines to " << output.generic_string() << "\n";
+	return 0;
+}
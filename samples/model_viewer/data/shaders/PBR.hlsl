@@ -1,4 +1,5 @@
-#include "Common.hlsli"
+#include "Scene.hlsli"
+#include "PackedVertex.hlsli"
 
 struct CameraData
 {
@@ -7,17 +8,6 @@ struct CameraData
     float2 jitter;
 };
 
-struct BindData
-{
-    float4x4 worldMatrix;
-    float4 normalMatrix0;
-    float4 normalMatrix1;
-    float4 normalMatrix2;
-    uint cameraData;
-    uint material;
-};
-PushConstants(BindData, bindData);
-
 struct MeshVertex
 {
     float3 position : ATTRIBUTE0;
@@ -26,6 +16,14 @@ struct MeshVertex
     float2 uv0 : ATTRIBUTE3;
 };
 
+// Single interleaved stream of PackedVertex
+struct PackedMeshVertex
+{
+    float4 position : ATTRIBUTE0;
+    float4 normalTangent : ATTRIBUTE1;
+    float2 uv0 : ATTRIBUTE2;
+};
+
 struct VSOut
 {
     float4 positionCS : SV_Position;
@@ -35,23 +33,39 @@ struct VSOut
     float2 uv0 : TEXCOORD0;
 };
 
-[RootSignature(RS)]
-VSOut Vertex(MeshVertex vertex RHI_VERTEX_DATA)
+VSOut TransformVertex(float3 position, float3 normal, float3 tangent, float2 uv0)
 {
     ConstantBuffer<CameraData> cameraData = ResourceDescriptorHeap[bindData.cameraData];
-    float4 positionWS = mul(bindData.worldMatrix, float4(vertex.position, 1.0));
+    InstanceData instance = LoadInstance();
 
-    float3x3 normalMatrix = float3x3(bindData.normalMatrix0.xyz, bindData.normalMatrix1.xyz, bindData.normalMatrix2.xyz);
+    // Identity for full precision vertices
+    position = instance.positionOffset + position * instance.positionScale;
+    float4 positionWS = mul(instance.worldMatrix, float4(position, 1.0));
+
+    float3x3 normalMatrix = GetNormalMatrix(instance);
 
     VSOut output;
     output.positionCS = mul(cameraData.viewProjection, positionWS) + float4(cameraData.jitter, 0, 0);
     output.positionWS = positionWS.xyz;
-    output.normal = mul(normalMatrix, vertex.normal);
-    output.tangent = mul(normalMatrix, vertex.tangent);
-    output.uv0 = vertex.uv0;
+    output.normal = mul(normalMatrix, normal);
+    output.tangent = mul(normalMatrix, tangent);
+    output.uv0 = uv0;
     return output;
 }
 
+[RootSignature(RS)]
+VSOut Vertex(MeshVertex vertex RHI_VERTEX_DATA)
+{
+    return TransformVertex(vertex.position, vertex.normal, vertex.tangent, vertex.uv0);
+}
+
+[RootSignature(RS)]
+VSOut VertexPacked(PackedMeshVertex vertex RHI_VERTEX_DATA)
+{
+    return TransformVertex(vertex.position.xyz, OctahedralDecode(vertex.normalTangent.xy),
+        OctahedralDecode(vertex.normalTangent.zw), vertex.uv0);
+}
+
 [RootSignature(RS)]
 float4 Pixel(VSOut input) : SV_Target0
 {
@@ -62,10 +76,12 @@ float4 Pixel(VSOut input) : SV_Target0
 
     float3 diffuse = max(dot(N, -L), 0.4);
 
+    MaterialData material = LoadMaterial(LoadInstance().material);
+
     float4 color = 1.xxxx;
-    if (bindData.material != -1)
+    if (material.baseColor != -1)
     {
-        Texture2D<float4> baseColor = ResourceDescriptorHeap[bindData.material];
+        Texture2D<float4> baseColor = ResourceDescriptorHeap[material.baseColor];
         color = baseColor.SampleLevel(linearWrap, input.uv0, 0);
         clip(color.a - 0.5);
     }
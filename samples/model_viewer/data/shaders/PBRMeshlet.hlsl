@@ -0,0 +1,196 @@
+#include "Scene.hlsli"
+#include "PackedVertex.hlsli"
+
+#define MESHLET_MAX_VERTICES 64
+#define MESHLET_MAX_PRIMITIVES 124
+#define MESHLETS_PER_TASK 32
+
+struct CameraData
+{
+    float4x4 viewProjection;
+    float4 forward;
+    float2 jitter;
+    float4 position;
+    float4 frustumPlanes[6];
+};
+
+// Matches MeshletBufferHeader in mesh.cpp
+struct MeshletBufferHeader
+{
+    uint meshletCount;
+    uint vertexCount;
+    uint meshletsOffset;
+    uint boundsOffset;
+    uint vertexIndicesOffset;
+    uint primitivesOffset;
+    uint vertexFormat;
+    float3 positionOffset;
+    float3 positionScale;
+};
+
+MeshletBufferHeader LoadHeader(ByteAddressBuffer meshlets)
+{
+    uint4 a = meshlets.Load4(0);
+    uint3 b = meshlets.Load3(16);
+
+    MeshletBufferHeader header;
+    header.meshletCount = a.x;
+    header.vertexCount = a.y;
+    header.meshletsOffset = a.z;
+    header.boundsOffset = a.w;
+    header.vertexIndicesOffset = b.x;
+    header.primitivesOffset = b.y;
+    header.vertexFormat = b.z;
+    header.positionOffset = asfloat(meshlets.Load3(32));
+    header.positionScale = asfloat(meshlets.Load3(48));
+    return header;
+}
+
+struct Payload
+{
+    uint meshletIndices[MESHLETS_PER_TASK];
+};
+
+struct VSOut
+{
+    float4 positionCS : SV_Position;
+    float3 positionWS : POSITION0;
+    float3 normal : NORMAL0;
+    float3 tangent : TANGENT0;
+    float2 uv0 : TEXCOORD0;
+};
+
+groupshared Payload sharedPayload;
+groupshared uint sharedVisibleCount;
+
+[RootSignature(RS)]
+[numthreads(MESHLETS_PER_TASK, 1, 1)]
+void Amplification(uint dispatchThreadId : SV_DispatchThreadID, uint groupThreadId : SV_GroupThreadID)
+{
+    InstanceData instance = LoadInstance();
+    ByteAddressBuffer meshlets = ResourceDescriptorHeap[instance.meshlets];
+    ConstantBuffer<CameraData> cameraData = ResourceDescriptorHeap[bindData.cameraData];
+    MeshletBufferHeader header = LoadHeader(meshlets);
+
+    if (groupThreadId == 0) sharedVisibleCount = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    bool visible = false;
+    if (dispatchThreadId < header.meshletCount)
+    {
+        float4 sphere = asfloat(meshlets.Load4(header.boundsOffset + dispatchThreadId * 32));
+        float4 cone = asfloat(meshlets.Load4(header.boundsOffset + dispatchThreadId * 32 + 16));
+
+        float3 center = mul(instance.worldMatrix, float4(sphere.xyz, 1.0)).xyz;
+        float3 axisX = float3(instance.worldMatrix._11, instance.worldMatrix._21, instance.worldMatrix._31);
+        float3 axisY = float3(instance.worldMatrix._12, instance.worldMatrix._22, instance.worldMatrix._32);
+        float3 axisZ = float3(instance.worldMatrix._13, instance.worldMatrix._23, instance.worldMatrix._33);
+        float radius = sphere.w * sqrt(max(dot(axisX, axisX), max(dot(axisY, axisY), dot(axisZ, axisZ))));
+
+        visible = true;
+        [unroll]
+        for (uint i = 0; i < 6; i++)
+        {
+            visible = visible && dot(cameraData.frustumPlanes[i].xyz, center) + cameraData.frustumPlanes[i].w >= -radius;
+        }
+
+        if (visible && !(instance.flags & INSTANCE_FLAG_TWO_SIDED) && cone.w < 1.0)
+        {
+            float3 axis = normalize(mul(GetNormalMatrix(instance), cone.xyz));
+            float3 view = center - cameraData.position.xyz;
+            visible = dot(view, axis) < cone.w * length(view) + radius;
+        }
+    }
+
+    if (visible)
+    {
+        uint index;
+        InterlockedAdd(sharedVisibleCount, 1, index);
+        sharedPayload.meshletIndices[index] = dispatchThreadId;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    DispatchMesh(sharedVisibleCount, 1, 1, sharedPayload);
+}
+
+[RootSignature(RS)]
+[outputtopology("triangle")]
+[numthreads(128, 1, 1)]
+void Mesh(uint groupThreadId : SV_GroupThreadID, uint groupId : SV_GroupID, in payload Payload payload,
+    out vertices VSOut outVertices[MESHLET_MAX_VERTICES], out indices uint3 outTriangles[MESHLET_MAX_PRIMITIVES])
+{
+    InstanceData instance = LoadInstance();
+    ByteAddressBuffer meshlets = ResourceDescriptorHeap[instance.meshlets];
+    ByteAddressBuffer vertexData = ResourceDescriptorHeap[instance.vertices];
+    ConstantBuffer<CameraData> cameraData = ResourceDescriptorHeap[bindData.cameraData];
+    MeshletBufferHeader header = LoadHeader(meshlets);
+
+    // x - vertex offset, y - vertex count, z - primitive offset, w - primitive count
+    uint4 meshlet = meshlets.Load4(header.meshletsOffset + payload.meshletIndices[groupId] * 16);
+    SetMeshOutputCounts(meshlet.y, meshlet.w);
+
+    if (groupThreadId < meshlet.y)
+    {
+        uint vertexIndex = meshlets.Load(header.vertexIndicesOffset + (meshlet.x + groupThreadId) * 4);
+
+        float3 position, normal, tangent;
+        float2 uv0;
+        if (header.vertexFormat == VERTEX_FORMAT_COMPRESSED)
+        {
+            DecodedVertex decoded = DecodePackedVertex(vertexData.Load4(vertexIndex * PACKED_VERTEX_STRIDE),
+                header.positionOffset, header.positionScale);
+            position = decoded.position;
+            normal = decoded.normal;
+            tangent = decoded.tangent;
+            uv0 = decoded.uv0;
+        }
+        else
+        {
+            // Non-interleaved layout of the vertex buffer: positions, normals, tangents, uvs
+            position = asfloat(vertexData.Load3(vertexIndex * 12));
+            normal = asfloat(vertexData.Load3(header.vertexCount * 12 + vertexIndex * 12));
+            tangent = asfloat(vertexData.Load3(header.vertexCount * 24 + vertexIndex * 12));
+            uv0 = asfloat(vertexData.Load2(header.vertexCount * 36 + vertexIndex * 8));
+        }
+
+        float4 positionWS = mul(instance.worldMatrix, float4(position, 1.0));
+        float3x3 normalMatrix = GetNormalMatrix(instance);
+
+        VSOut output;
+        output.positionCS = mul(cameraData.viewProjection, positionWS) + float4(cameraData.jitter, 0, 0);
+        output.positionWS = positionWS.xyz;
+        output.normal = mul(normalMatrix, normal);
+        output.tangent = mul(normalMatrix, tangent);
+        output.uv0 = uv0;
+        outVertices[groupThreadId] = output;
+    }
+
+    if (groupThreadId < meshlet.w)
+    {
+        uint packed = meshlets.Load(header.primitivesOffset + (meshlet.z + groupThreadId) * 4);
+        outTriangles[groupThreadId] = uint3(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF);
+    }
+}
+
+[RootSignature(RS)]
+float4 Pixel(VSOut input) : SV_Target0
+{
+    float3 N = normalize(input.normal);
+
+    ConstantBuffer<CameraData> cameraData = ResourceDescriptorHeap[bindData.cameraData];
+    float3 L = cameraData.forward.xyz;
+
+    float3 diffuse = max(dot(N, -L), 0.4);
+
+    MaterialData material = LoadMaterial(LoadInstance().material);
+
+    float4 color = 1.xxxx;
+    if (material.baseColor != -1)
+    {
+        Texture2D<float4> baseColor = ResourceDescriptorHeap[material.baseColor];
+        color = baseColor.SampleLevel(linearWrap, input.uv0, 0);
+        clip(color.a - 0.5);
+    }
+
+    return float4(diffuse * color.rgb, 1);
+}
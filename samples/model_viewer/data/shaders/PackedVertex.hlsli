@@ -0,0 +1,43 @@
+#ifndef PACKED_VERTEX_HLSLI
+#define PACKED_VERTEX_HLSLI
+
+// Matches VertexFormat in mesh.h
+#define VERTEX_FORMAT_FULL 0
+#define VERTEX_FORMAT_COMPRESSED 1
+
+// PackedVertex in mesh.h: uint16 position[4], int8 normalTangent[4], half uv[2]
+#define PACKED_VERTEX_STRIDE 16
+
+float3 OctahedralDecode(float2 e)
+{
+    float3 n = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+struct DecodedVertex
+{
+    float3 position;
+    float3 normal;
+    float3 tangent;
+    float2 uv0;
+};
+
+// For vertex pulling, the input assembler path gets already normalized values through vertex attribute formats
+DecodedVertex DecodePackedVertex(uint4 raw, float3 positionOffset, float3 positionScale)
+{
+    float3 unorm = float3(raw.x & 0xFFFF, raw.x >> 16, raw.y & 0xFFFF) / 65535.0;
+    int4 snorm = int4(asint(raw.z << 24), asint(raw.z << 16), asint(raw.z << 8), asint(raw.z)) >> 24;
+    float4 normalTangent = max(float4(snorm) / 127.0, -1.0);
+
+    DecodedVertex vertex;
+    vertex.position = positionOffset + unorm * positionScale;
+    vertex.normal = OctahedralDecode(normalTangent.xy);
+    vertex.tangent = OctahedralDecode(normalTangent.zw);
+    vertex.uv0 = f16tof32(uint2(raw.w & 0xFFFF, raw.w >> 16));
+    return vertex;
+}
+
+#endif
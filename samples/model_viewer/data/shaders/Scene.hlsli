@@ -0,0 +1,60 @@
+#ifndef SCENE_HLSLI
+#define SCENE_HLSLI
+
+#include "Common.hlsli"
+
+// Matches InstanceFlags in common.h
+#define INSTANCE_FLAG_TWO_SIDED 1
+
+// Matches InstanceData in gpu_scene.h
+struct InstanceData
+{
+    float4x4 worldMatrix;
+    float3 normalMatrix0;
+    uint material;
+    float3 normalMatrix1;
+    uint meshlets;
+    float3 normalMatrix2;
+    uint vertices;
+    float3 positionOffset;
+    uint flags;
+    float3 positionScale;
+    uint padding;
+};
+
+// Matches MaterialData in gpu_scene.h
+struct MaterialData
+{
+    uint baseColor;
+    uint flags;
+    uint2 padding;
+};
+
+// Matches SceneBindData in common.h
+struct BindData
+{
+    uint instance;
+    uint cameraData;
+    uint instances;
+    uint materials;
+};
+PushConstants(BindData, bindData);
+
+InstanceData LoadInstance()
+{
+    StructuredBuffer<InstanceData> instances = ResourceDescriptorHeap[bindData.instances];
+    return instances[bindData.instance];
+}
+
+MaterialData LoadMaterial(uint material)
+{
+    StructuredBuffer<MaterialData> materials = ResourceDescriptorHeap[bindData.materials];
+    return materials[material];
+}
+
+float3x3 GetNormalMatrix(InstanceData instance)
+{
+    return float3x3(instance.normalMatrix0, instance.normalMatrix1, instance.normalMatrix2);
+}
+
+#endif
@@ -5,6 +5,9 @@
 #include "shader.h"
 #include "model.h"
 #include "camera.h"
+#include "thread_pool.h"
+#include "gpu_scene.h"
+#include "bvh.h"
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <vector>
@@ -18,6 +21,15 @@ struct CameraData
 	glm::mat4 viewProjection;
 	glm::vec4 forward;
 	glm::vec2 jitter;
+	glm::vec2 padding;
+	glm::vec4 position;
+	std::array<glm::vec4, 6> frustumPlanes;
+};
+
+struct SceneInstance
+{
+	std::shared_ptr<Mesh> mesh;
+	uint32_t id;
 };
 
 class Application
@@ -30,16 +42,22 @@ public:
 	vg::SwapChain GetSwapChain() const { return _swapChain.Get(); }
 	
 	vg::Format GetDepthBufferFormat() const { return _depthBufferFormat; }
+	bool MeshShadersSupported() const { return _meshShaders; }
+	VertexFormat GetVertexFormat() const { return _vertexFormat; }
+	ThreadPool& GetThreadPool() { return _threadPool; }
 
 	void SubmitImmediately(std::function<void(vg::CommandList)>&& action);
 
 private:
 	GLFWwindow* _window;
 	vg::Ref<vg::Device> _device;
+	bool _meshShaders{ false };
+	VertexFormat _vertexFormat{ VertexFormat::Compressed };
 	vg::Surface _surface;
 	vg::Ref<vg::SwapChain> _swapChain;
 
 	vg::Ref<vg::CommandPool> _immediateCommandPool;
+	ThreadPool _threadPool;
 
 	vg::Format _depthBufferFormat;
 	vg::Ref<vg::Texture> _depthBuffer;
@@ -47,14 +65,24 @@ private:
 
 	Camera _camera;
 	Frustum _frustum;
-	std::unique_ptr<PerFrameConstantBuffer<CameraData>> _cameraData;
+	vg::ConstantAllocator _constantAllocator;
 
 	std::vector<FrameData> _frames;
 	std::unordered_map<std::string, std::shared_ptr<Texture>> _textures;
 
 	std::shared_ptr<MeshShader> _pbr;
+	std::shared_ptr<MeshShader> _pbrCompressed;
+	std::shared_ptr<MeshShader> _pbrMeshlets;
 	std::shared_ptr<Model> _model;
 	std::shared_ptr<Model> _model2;
+	std::unique_ptr<GpuScene> _scene;
+	std::vector<SceneInstance> _instances;
+	// World bounds of _instances, same order
+	AABBArray _bounds;
+	BVH _bvh;
+	std::vector<uint32_t> _visibleInstances;
+
+	void AddModel(const std::shared_ptr<Model>& model, const glm::mat4& worldMatrix);
 
 	void Run();
 	void DoFrame(uint64_t frameIndex, const FrameData& frame);
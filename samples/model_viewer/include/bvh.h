@@ -0,0 +1,50 @@
+#pragma once
+
+#include "frustum.h"
+#include <cstdint>
+#include <vector>
+
+// Bounding volume hierarchy over a set of boxes (scene instances), items are indices into the AABBArray it was built from
+class BVH
+{
+public:
+	static constexpr uint32_t MaxLeafSize = 4;
+
+	// Top-down build with binned surface area heuristic
+	void Build(const AABBArray& bounds);
+	// Recomputes all node bounds bottom-up, tree topology is kept
+	void Refit(const AABBArray& bounds);
+	// Recomputes bounds of the leaf containing item and its ancestors only
+	void Refit(const AABBArray& bounds, uint32_t item);
+
+	// Writes items intersecting the frustum to outVisible (room for all items needed), returns their count.
+	// Subtrees outside of the frustum are skipped, subtrees fully inside are emitted without further tests
+	size_t Cull(const Frustum& frustum, const AABBArray& bounds, uint32_t* outVisible) const;
+	// Appends items whose bounds overlap aabb
+	void Query(const AABB& aabb, const AABBArray& bounds, std::vector<uint32_t>& outItems) const;
+
+	bool Empty() const { return _nodes.empty(); }
+	size_t GetNodeCount() const { return _nodes.size(); }
+
+private:
+	struct Node
+	{
+		AABB bounds;
+		// Items of the whole subtree are contiguous in _items
+		uint32_t first;
+		uint32_t count;
+		// Right child follows the left one, 0 for leaves since the root is never a child
+		uint32_t left;
+		uint32_t parent;
+
+		bool IsLeaf() const { return left == 0; }
+	};
+
+	std::vector<Node> _nodes;
+	std::vector<uint32_t> _items;
+	// Leaf node of every item
+	std::vector<uint32_t> _itemLeaves;
+
+	void Subdivide(uint32_t nodeIndex, const AABBArray& bounds, std::vector<glm::vec3>& centroids);
+	void UpdateLeafBounds(Node& node, const AABBArray& bounds) const;
+};
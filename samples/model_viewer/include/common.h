@@ -11,46 +11,6 @@
 #define vgCheck(x) do { x; } while (false)
 #endif
 
-template <class T, uint32_t NumFrames = 3>
-struct PerFrameConstantBuffer
-{
-	vg::Buffer buffer;
-	void* mapped;
-	std::array<uint32_t, NumFrames> views;
-	T data;
-
-	PerFrameConstantBuffer(vg::Device device, std::string_view name)
-	{
-		uint32_t singleBufferSize = (sizeof(T) + 255) & ~255;
-		vg::BufferDesc desc = { singleBufferSize * NumFrames, vg::BufferUsage::Constant, vg::HeapType::Upload };
-		vg::BufferViewDesc viewDesc = { vg::BufferDescriptorType::Cbv, vg::BufferViewType::Buffer, vg::Format::Unknown,
-			0, singleBufferSize, 0 };
-
-		device.CreateBuffer(&desc, &buffer);
-		buffer.SetName(name.data());
-		buffer.Map(&mapped);
-		for (uint64_t i = 0; i < views.size(); i++)
-		{
-			viewDesc.offset = singleBufferSize * i;
-			buffer.CreateView(&viewDesc, &views[i]);
-		}
-	}
-
-	void upload(uint64_t frameIndex)
-	{
-		memcpy(getDataPtr(frameIndex), &data, sizeof(data));
-	}
-
-	void destroy(vg::Device device)
-	{
-		device.DestroyBuffer(buffer);
-	}
-
-	vg::Buffer getBuffer() const { return buffer; }
-	void* getDataPtr(uint64_t frameIndex) const { return static_cast<uint8_t*>(mapped) + ((sizeof(T) + 255) & ~255) * (frameIndex % views.size()); }
-	uint32_t getView(uint64_t frameIndex) const { return views[frameIndex % views.size()]; }
-};
-
 namespace vg
 {
 	struct Library
@@ -203,12 +163,17 @@ struct FrameData
 	vg::Texture backBuffer;
 };
 
-struct MeshBindData
+// Root constants shared by PBR.hlsl and PBRMeshlet.hlsl, only instance changes per draw
+struct SceneBindData
 {
-	float worldMatrix[16];
-	float normalMatrix0[4];
-	float normalMatrix1[4];
-	float normalMatrix2[4];
+	uint32_t instance;
 	uint32_t cameraData;
-	uint32_t material;
+	uint32_t instances;
+	uint32_t materials;
+};
+
+enum InstanceFlags : uint32_t
+{
+	INSTANCE_FLAG_NONE = 0,
+	INSTANCE_FLAG_TWO_SIDED = 1
 };
\ No newline at end of file
@@ -1,18 +1,26 @@
 #pragma once
 
 #include "common.h"
+#include "mapped_file.h"
 #include <filesystem>
+#include <span>
+#include <vector>
 
 struct DDSData
 {
 	uint32_t width;
 	uint32_t height;
 	vg::Format format;
-	std::vector<std::vector<uint8_t>> mips;
+	// Keeps the mapping alive, mips point straight into it
+	std::shared_ptr<MappedFile> file;
+	std::vector<std::span<const uint8_t>> mips;
 };
 
 class DDSLoader
 {
 public:
 	static bool Load(const std::filesystem::path& path, DDSData& data);
-};
\ No newline at end of file
+
+	// Size in bytes of a 4x4 block for supported block compressed formats
+	static uint32_t GetBlockSize(vg::Format format);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 #define GLM_FORCE_LEFT_HANDED
 #include <glm/glm.hpp>
 
@@ -19,6 +20,18 @@ struct AABB
 	}
 };
 
+// Many boxes in structure-of-arrays form for batched culling
+struct AABBArray
+{
+	std::vector<float> minX, minY, minZ;
+	std::vector<float> maxX, maxY, maxZ;
+
+	size_t Size() const { return minX.size(); }
+	void Reserve(size_t count);
+	void Add(const AABB& aabb);
+	void Set(size_t index, const AABB& aabb);
+};
+
 struct Frustum
 {
 	std::array<glm::vec4, 6> planes;
@@ -27,4 +40,13 @@ struct Frustum
 	Frustum(const glm::mat4& viewProjection);
 
 	bool IsAABBInside(const AABB& aabb) const;
+
+	// Writes indices of boxes intersecting the frustum in ascending order, outVisible needs room for bounds.Size() indices.
+	// Tests 8 (AVX2) or 4 (SSE2) boxes at a time depending on the target, returns the number of visible boxes
+	size_t Cull(const AABBArray& bounds, uint32_t* outVisible) const;
+	// Reference for Cull(), one box at a time
+	size_t CullScalar(const AABBArray& bounds, uint32_t* outVisible) const;
+
+private:
+	size_t CullScalar(const AABBArray& bounds, size_t begin, size_t end, uint32_t* outVisible) const;
 };
\ No newline at end of file
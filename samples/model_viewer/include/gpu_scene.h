@@ -0,0 +1,91 @@
+#pragma once
+
+#include "common.h"
+#include "mesh.h"
+#include <unordered_map>
+#include <vector>
+#define GLM_FORCE_LEFT_HANDED
+#include <glm/glm.hpp>
+
+// Matches InstanceData in Scene.hlsli
+struct InstanceData
+{
+	float worldMatrix[16];
+	float normalMatrix0[3];
+	uint32_t material;
+	float normalMatrix1[3];
+	uint32_t meshlets;
+	float normalMatrix2[3];
+	uint32_t vertices;
+	// position = positionOffset + position * positionScale, identity for VertexFormat::Full
+	float positionOffset[3];
+	uint32_t flags;
+	float positionScale[3];
+	uint32_t padding;
+};
+static_assert(sizeof(InstanceData) == 144);
+
+// Matches MaterialData in Scene.hlsli
+struct MaterialData
+{
+	uint32_t baseColor;
+	uint32_t flags;
+	uint32_t padding[2];
+};
+
+// Persistent GPU tables of instances and materials, shaders index them with SceneBindData::instance.
+// CPU copies are kept and only the dirty range is copied to the GPU in Upload()
+class GpuScene
+{
+public:
+	static constexpr uint32_t NumFrames = 3;
+
+	GpuScene(vg::Device device, uint32_t maxInstances, uint32_t maxMaterials);
+	~GpuScene();
+
+	GpuScene(const GpuScene&) = delete;
+	GpuScene& operator=(const GpuScene&) = delete;
+
+	// Materials with the same textures and flags share an entry
+	uint32_t AddMaterial(const Material& material);
+	uint32_t AddInstance(const Mesh& mesh, const glm::mat4& worldMatrix);
+	void SetTransform(uint32_t instance, const glm::mat4& worldMatrix);
+
+	// Records copies of everything changed since the last call, must be outside of rendering
+	void Upload(vg::CommandList cmd, uint64_t frameIndex);
+
+	uint32_t GetInstanceCount() const { return static_cast<uint32_t>(_instances.size()); }
+	uint32_t GetInstancesView() const { return _instancesView; }
+	uint32_t GetMaterialsView() const { return _materialsView; }
+
+private:
+	struct DirtyRange
+	{
+		uint32_t begin{ UINT32_MAX };
+		uint32_t end{ 0 };
+
+		void Add(uint32_t index) { begin = std::min(begin, index); end = std::max(end, index + 1); }
+		bool Empty() const { return begin >= end; }
+	};
+
+	vg::Device _device;
+	uint32_t _maxInstances;
+	uint32_t _maxMaterials;
+
+	vg::Buffer _instanceBuffer;
+	vg::Buffer _materialBuffer;
+	uint32_t _instancesView;
+	uint32_t _materialsView;
+
+	// NumFrames slots of [instances | materials]
+	vg::Buffer _stagingBuffer;
+	uint8_t* _staging;
+
+	std::vector<InstanceData> _instances;
+	std::vector<MaterialData> _materials;
+	std::unordered_map<uint64_t, uint32_t> _materialIndices;
+	DirtyRange _dirtyInstances;
+	DirtyRange _dirtyMaterials;
+
+	uint64_t StagingSlotSize() const;
+};
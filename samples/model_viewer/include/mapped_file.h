@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+// Read-only memory mapping of a whole file, unmapped when the last reference goes away
+class MappedFile
+{
+public:
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	static std::shared_ptr<MappedFile> Open(const std::filesystem::path& path);
+
+	const uint8_t* GetData() const { return _data; }
+	uint64_t GetSize() const { return _size; }
+
+private:
+	const uint8_t* _data;
+	uint64_t _size;
+
+	MappedFile(const uint8_t* data, uint64_t size);
+};
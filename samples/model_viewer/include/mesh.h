@@ -7,6 +7,7 @@
 #include <string_view>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
@@ -19,6 +20,64 @@ struct Vertex
 	float uv[2];
 };
 
+enum class VertexFormat : uint32_t
+{
+	// Separate float streams: positions, normals, tangents, uvs
+	Full,
+	// Single interleaved stream of PackedVertex
+	Compressed,
+};
+
+struct PackedVertex
+{
+	// UNORM relative to the mesh AABB, w is unused
+	uint16_t position[4];
+	// SNORM octahedral encoded normal (xy) and tangent (zw)
+	int8_t normalTangent[4];
+	// Half floats
+	uint16_t uv[2];
+};
+static_assert(sizeof(PackedVertex) == 16);
+
+inline uint32_t GetVertexStride(VertexFormat format)
+{
+	return format == VertexFormat::Compressed ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+struct Meshlet
+{
+	uint32_t vertexOffset;
+	uint32_t vertexCount;
+	uint32_t primitiveOffset;
+	uint32_t primitiveCount;
+};
+
+struct MeshletBounds
+{
+	float center[3];
+	float radius;
+	// Normal cone: culled when dot(center - camera, axis) >= coneCutoff * length(center - camera) + radius
+	float coneAxis[3];
+	float coneCutoff;
+};
+
+struct MeshletData
+{
+	static constexpr uint32_t MaxVertices = 64;
+	static constexpr uint32_t MaxPrimitives = 124;
+
+	std::vector<Meshlet> meshlets;
+	std::vector<MeshletBounds> bounds;
+	std::vector<uint32_t> vertexIndices;
+	// 3 meshlet-local 8-bit vertex indices per triangle
+	std::vector<uint32_t> primitives;
+
+	static MeshletData Build(const aiVector3D* positions, const aiVector3D* normals, const std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+	// Layout expected by PBRMeshlet.hlsl: MeshletBufferHeader followed by meshlets, bounds, vertex indices and primitives
+	std::vector<uint8_t> Pack(uint32_t vertexCount, VertexFormat vertexFormat, const AABB& aabb) const;
+};
+
 struct Material
 {
 	bool twoSided{ false };
@@ -30,13 +89,36 @@ struct Material
 	std::shared_ptr<Texture> baseColorTexture;
 };
 
+// CPU side of a mesh, produced on a worker thread before any GPU resource exists
+struct MeshImport
+{
+	const aiMesh* mesh{ nullptr };
+	std::vector<uint32_t> indices;
+	std::vector<uint8_t> meshletData;
+	uint32_t meshletCount{ 0 };
+	VertexFormat vertexFormat{ VertexFormat::Full };
+	Material material;
+	AABB aabb;
+
+	uint64_t VertexDataSize() const { return mesh->mNumVertices * GetVertexStride(vertexFormat) + indices.size() * sizeof(uint32_t); }
+	uint64_t UploadSize() const { return VertexDataSize() + meshletData.size(); }
+	// Thread safe, dst should have at least UploadSize() bytes
+	void WriteUploadData(void* dst) const;
+};
+
 class Application;
 class Mesh
 {
 public:
 	~Mesh();
 
-	static std::shared_ptr<Mesh> From(Application& app, aiMesh* mesh, const aiScene* scene, const std::filesystem::path& modelPath);
+	// Thread safe, does not touch the device. mesh and scene should outlive the returned import
+	static MeshImport Import(const aiMesh* mesh, const aiScene* scene, bool buildMeshlets, VertexFormat vertexFormat);
+	// Creates GPU buffers, contents are written by RecordUpload()
+	static std::shared_ptr<Mesh> Create(Application& app, const MeshImport& meshImport, std::shared_ptr<Texture> baseColor);
+
+	// Copies data written by MeshImport::WriteUploadData() at offset of uploadBuffer
+	void RecordUpload(vg::CommandList cmd, vg::Buffer uploadBuffer, uint64_t offset) const;
 
 	const Material& GetMaterial() const { return _material; }
 	vg::Buffer GetVertexBuffer() const { return _vertexBuffer; }
@@ -44,11 +126,20 @@ public:
 	uint32_t GetIndexCount() const { return _indexCount; }
 	uint32_t GetVertexCount() const { return _vertexCount; }
 	const AABB& GetAABB() const { return _aabb; }
+	VertexFormat GetVertexFormat() const { return _vertexFormat; }
+	// Maps compressed positions back to mesh space, to be applied before the world matrix
+	glm::mat4 GetDequantizationMatrix() const;
 	
 	const vg::VertexBufferView& GetPositionsVB() const { return _positionsVB; }
 	const vg::VertexBufferView& GetNormalsVB() const { return _normalsVB; }
 	const vg::VertexBufferView& GetTangentsVB() const { return _tangentsVB; }
 	const vg::VertexBufferView& GetUVsVB() const { return _uvsVB; }
+	const vg::VertexBufferView& GetPackedVB() const { return _packedVB; }
+
+	vg::Buffer GetMeshletBuffer() const { return _meshletBuffer; }
+	uint32_t GetMeshletCount() const { return _meshletCount; }
+	uint32_t GetMeshletsView() const { return _meshletsView; }
+	uint32_t GetVerticesView() const { return _verticesView; }
 
 private:
 	std::string _name;
@@ -58,11 +149,19 @@ private:
 	uint64_t _indexOffset;
 	Material _material;
 	AABB _aabb;
+	VertexFormat _vertexFormat;
 
 	vg::VertexBufferView _positionsVB;
 	vg::VertexBufferView _normalsVB;
 	vg::VertexBufferView _tangentsVB;
 	vg::VertexBufferView _uvsVB;
+	vg::VertexBufferView _packedVB;
+
+	vg::Buffer _meshletBuffer;
+	uint32_t _meshletCount;
+	uint32_t _meshletsView;
+	uint32_t _verticesView;
 
-	Mesh(std::string_view name, vg::Buffer vertexBuffer, uint32_t indexCount, const AABB& aabb, const Material& material);
+	Mesh(std::string_view name, vg::Buffer vertexBuffer, uint32_t indexCount, const AABB& aabb, VertexFormat vertexFormat,
+		const Material& material, vg::Buffer meshletBuffer, uint32_t meshletCount);
 };
\ No newline at end of file
@@ -5,12 +5,16 @@
 #include <memory>
 
 class Application;
+enum class VertexFormat : uint32_t;
 class MeshShader
 {
 public:
 	~MeshShader();
 
-	static std::shared_ptr<MeshShader> From(Application& app, const std::filesystem::path& path);
+	// Vertex input layout matches meshes imported with vertexFormat
+	static std::shared_ptr<MeshShader> From(Application& app, const std::filesystem::path& path, VertexFormat vertexFormat);
+	// Amplification + mesh shader pipeline drawing Mesh meshlets, see PBRMeshlet.hlsl
+	static std::shared_ptr<MeshShader> FromMeshlets(Application& app, const std::filesystem::path& path);
 
 	vg::Pipeline GetPipeline() const { return _pipeline; }
 	vg::Pipeline GetPipelineTwoSided() const { return _pipelineTwoSided; }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+enum class ShaderTarget : uint32_t
+{
+	Dxil,
+	Spirv,
+	Count
+};
+
+// Precompiled shaders and pipeline stage tables written by model_viewer_bundler. Layout:
+//   Header | ShaderEntry[numShaders] sorted by key | PipelineEntry[numPipelines] sorted by key | binaries
+// Offsets are relative to the start of the file, the whole file is loaded with a single read.
+class ShaderBundle
+{
+public:
+	static constexpr uint32_t magic = 0x4C444E42; // "BNDL"
+	static constexpr uint32_t version = 1;
+	static constexpr uint32_t maxStages = 3;
+	static constexpr uint32_t numTargets = static_cast<uint32_t>(ShaderTarget::Count);
+
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t numShaders;
+		uint32_t numPipelines;
+	};
+
+	struct ShaderEntry
+	{
+		uint64_t key;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	struct PipelineEntry
+	{
+		uint64_t key;
+		uint32_t meshShader;
+		uint32_t numStages;
+		// Shader keys in pipeline stage order, per ShaderTarget
+		uint64_t stages[numTargets][maxStages];
+	};
+
+	static constexpr uint64_t Hash(std::string_view str, uint64_t hash = 0xCBF29CE484222325ull)
+	{
+		for (char c : str) hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ull;
+		return hash;
+	}
+
+	static constexpr uint64_t ShaderKey(std::string_view file, std::string_view profile, std::string_view entryPoint,
+		ShaderTarget target)
+	{
+		const uint64_t hash = Hash(entryPoint, Hash(profile, Hash(file) ^ 0xFF) ^ 0xFF);
+		return (hash ^ static_cast<uint64_t>(target)) * 0x100000001B3ull;
+	}
+
+	static constexpr uint64_t PipelineKey(std::string_view name) { return Hash(name); }
+
+	// nullptr if the file does not exist or was written by another bundle version
+	static std::shared_ptr<ShaderBundle> Open(const std::filesystem::path& path);
+
+	// Empty if the bundle does not contain the shader
+	std::span<const uint8_t> FindShader(uint64_t key) const;
+	const PipelineEntry* FindPipeline(uint64_t key) const;
+
+	class Builder
+	{
+	public:
+		void AddShader(uint64_t key, std::vector<uint8_t> binary);
+		void AddPipeline(const PipelineEntry& pipeline);
+		bool Write(const std::filesystem::path& path) const;
+
+	private:
+		std::vector<std::pair<uint64_t, std::vector<uint8_t>>> _shaders;
+		std::vector<PipelineEntry> _pipelines;
+	};
+
+private:
+	std::vector<uint8_t> _data;
+	std::span<const ShaderEntry> _shaders;
+	std::span<const PipelineEntry> _pipelines;
+
+	explicit ShaderBundle(std::vector<uint8_t> data);
+};
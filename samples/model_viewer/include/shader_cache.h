@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Content-addressed cache of compiled shader binaries. Keys hash everything that affects the output of the
+// compiler, so entries never need to be invalidated: a changed source, include, define, profile or compiler
+// version simply produces a different key. Lookups hit an in-memory layer first, then <directory>/<key>.bin.
+class ShaderCache
+{
+public:
+	explicit ShaderCache(std::filesystem::path directory);
+
+	// Hashes the source at path, every file it (transitively) includes with #include "...", the compiler
+	// arguments (entry point, profile, defines, target flags) and the compiler version
+	static std::string Key(const std::filesystem::path& path, std::span<const std::filesystem::path> includeDirs,
+		std::span<const std::wstring_view> arguments, std::string_view compilerVersion);
+
+	std::optional<std::vector<uint8_t>> Find(const std::string& key);
+	void Store(const std::string& key, const std::vector<uint8_t>& binary);
+
+private:
+	std::filesystem::path _directory;
+	std::mutex _mutex;
+	std::unordered_map<std::string, std::vector<uint8_t>> _memory;
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "shader_cache.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Compiles one entry point of an HLSL file with DXC, to SPIR-V for Vulkan or DXIL otherwise.
+// Results are looked up in and stored to cache when one is given. Throws on compilation errors.
+std::vector<uint8_t> CompileShader(std::wstring_view path, std::wstring_view profile, std::wstring_view entryPoint, bool spirv,
+	ShaderCache* cache = nullptr);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+struct ShaderStagePermutation
+{
+	std::string_view profile;
+	std::string_view entryPoint;
+};
+
+// Shader stages of one pipeline created by MeshShader. Read by the runtime and by model_viewer_bundler,
+// so every permutation listed here is available from shaders.bundle.
+struct PipelinePermutation
+{
+	std::string_view name;
+	// Relative to the run directory
+	std::string_view file;
+	bool meshShader;
+	uint32_t numStages;
+	std::array<ShaderStagePermutation, 3> stages;
+};
+
+inline constexpr PipelinePermutation pipelinePermutations[] = {
+	{ "PBR", "shaders/PBR.hlsl", false, 2, {{ { "vs_6_6", "Vertex" }, { "ps_6_6", "Pixel" } }} },
+	{ "PBRPacked", "shaders/PBR.hlsl", false, 2, {{ { "vs_6_6", "VertexPacked" }, { "ps_6_6", "Pixel" } }} },
+	{ "PBRMeshlet", "shaders/PBRMeshlet.hlsl", true, 3, {{ { "as_6_6", "Amplification" }, { "ms_6_6", "Mesh" }, { "ps_6_6", "Pixel" } }} },
+};
+
+inline const PipelinePermutation* FindPipelinePermutation(std::string_view name)
+{
+	for (const auto& permutation : pipelinePermutations)
+	{
+		if (permutation.name == name) return &permutation;
+	}
+	return nullptr;
+}
@@ -1,18 +1,38 @@
 #pragma once
 
 #include "common.h"
+#include "dds_loader.h"
 #include <memory>
 #include <optional>
 #include <filesystem>
 
+// CPU side of a texture, parsed on a worker thread before any GPU resource exists
+struct TextureImport
+{
+	std::filesystem::path path;
+	DDSData data;
+	std::vector<uint64_t> mipOffsets;
+	uint64_t uploadSize{ 0 };
+
+	// Thread safe, dst should have at least uploadSize bytes
+	void WriteUploadData(void* dst) const;
+};
+
 class Application;
 class Texture
 {
 public:
 	~Texture();
 
+	// Thread safe, does not touch the device
+	static std::optional<TextureImport> Import(const std::filesystem::path& path);
+	// Creates the texture in TransferDest layout, contents are written by RecordUpload()
+	static std::shared_ptr<Texture> Create(Application& app, const TextureImport& textureImport);
 	static std::optional<std::shared_ptr<Texture>> From(Application& app, const std::filesystem::path& path);
 
+	// Copies data written by TextureImport::WriteUploadData() at offset of uploadBuffer and transitions to ShaderResource
+	void RecordUpload(vg::CommandList cmd, const TextureImport& textureImport, vg::Buffer uploadBuffer, uint64_t offset) const;
+
 	uint32_t GetSrv() { return _srv; }
 
 private:
@@ -20,4 +40,4 @@ private:
 	uint32_t _srv;
 
 	Texture(vg::Texture texture);
-};
\ No newline at end of file
+};
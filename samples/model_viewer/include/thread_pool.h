@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	// hardware_concurrency() may return 0, which leaves a single worker
+	explicit ThreadPool(uint32_t numThreads = std::max(2u, std::thread::hardware_concurrency()) - 1);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	uint32_t GetNumThreads() const { return static_cast<uint32_t>(_workers.size()); }
+
+	// Runs func(i) for every i in [0, count) on the workers and the calling thread, returns when all calls are done
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func);
+
+private:
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void()>> _jobs;
+	std::mutex _mutex;
+	std::condition_variable _jobAvailable;
+	bool _stop{ false };
+
+	void WorkerLoop();
+};
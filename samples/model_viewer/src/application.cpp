@@ -14,6 +14,58 @@
 #include <glm/gtx/projection.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+// Compares per-box culling against the batched SoA culler on copies of the scene bounds from a few camera directions
+static void BenchmarkCulling(const AABBArray& sceneBounds)
+{
+	constexpr size_t MinBoxes = 1 << 20;
+	constexpr int Iterations = 20;
+
+	std::vector<AABB> boxes;
+	AABBArray bounds;
+	for (size_t i = 0; boxes.size() < MinBoxes && sceneBounds.Size() > 0; i = (i + 1) % sceneBounds.Size())
+	{
+		boxes.emplace_back(glm::vec3(sceneBounds.minX[i], sceneBounds.minY[i], sceneBounds.minZ[i]),
+			glm::vec3(sceneBounds.maxX[i], sceneBounds.maxY[i], sceneBounds.maxZ[i]));
+		bounds.Add(boxes.back());
+	}
+	if (boxes.empty()) return;
+
+	std::vector<uint32_t> visible(boxes.size());
+	const auto projection = glm::perspectiveLH(glm::radians(90.0f), 1.6f / 0.9f, 0.01f, 100.0f);
+
+	const auto measure = [&](const char* name, auto&& cull)
+	{
+		size_t numVisible = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < Iterations; i++)
+		{
+			float angle = glm::two_pi<float>() * i / Iterations;
+			auto view = glm::lookAtLH(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(std::cos(angle), 1.0f, std::sin(angle)), glm::vec3(0.0f, 1.0f, 0.0f));
+			numVisible += cull(Frustum(projection * view));
+		}
+		auto seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		std::cout << name << ": " << seconds * 1e9 / (double(boxes.size()) * Iterations) << " ns/box, "
+			<< numVisible / Iterations << " visible on average\n";
+	};
+
+	std::cout << "Culling " << boxes.size() << " boxes, " << Iterations << " iterations\n";
+	measure("IsAABBInside", [&](const Frustum& frustum)
+	{
+		size_t numVisible = 0;
+		for (size_t i = 0; i < boxes.size(); i++)
+		{
+			if (frustum.IsAABBInside(boxes[i])) visible[numVisible++] = static_cast<uint32_t>(i);
+		}
+		return numVisible;
+	});
+	measure("CullScalar", [&](const Frustum& frustum) { return frustum.CullScalar(bounds, visible.data()); });
+	measure("Cull", [&](const Frustum& frustum) { return frustum.Cull(bounds, visible.data()); });
+}
 
 Application::Application(int argc, char** argv)
 {
@@ -22,6 +74,13 @@ Application::Application(int argc, char** argv)
 	_window = glfwCreateWindow(1920, 1080, "Varyag Model Viewer", nullptr, nullptr);
 	glfwSetWindowUserPointer(_window, this);
 
+	bool benchmarkCulling = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string_view(argv[i]) == "--full-vertices") _vertexFormat = VertexFormat::Full;
+		if (std::string_view(argv[i]) == "--benchmark-culling") benchmarkCulling = true;
+	}
+
 	auto api = vg::GraphicsApi::Vulkan;
 
 	if (api == vg::GraphicsApi::D3d12)
@@ -51,6 +110,10 @@ Application::Application(int argc, char** argv)
 
 	vgCheck(adapters.front().CreateDevice(&_device));
 
+	vg::AdapterProperties adapterProperties;
+	vgCheck(adapters.front().GetProperties(&adapterProperties));
+	_meshShaders = adapterProperties.meshShaders;
+
 	glfwSetScrollCallback(_window, [](GLFWwindow* window, double xoffset, double yoffset)
 		{ static_cast<Application*>(glfwGetWindowUserPointer(window))->OnScroll(yoffset); });
 	glfwSetCursorPosCallback(_window, [](GLFWwindow* window, double xPos, double yPos)
@@ -79,7 +142,8 @@ Application::Application(int argc, char** argv)
 	vgCheck(_device->CreateCommandPool(vg::CommandPoolFlags::FlagTransient, vg::Queue::Graphics, &_immediateCommandPool));
 
 	_camera = { {-3, 1, 2}, 1.0f };
-	_cameraData = std::make_unique<PerFrameConstantBuffer<CameraData>>(*_device, "CameraData");
+	// Room for the constants of every frame in flight
+	vgCheck(_device->CreateConstantAllocator(64 * 1024, &_constantAllocator));
 
 	_depthBufferFormat = vg::Format::D32Float;
 
@@ -91,10 +155,32 @@ Application::Application(int argc, char** argv)
 	vg::AttachmentViewDesc depthBufferAttachmentDesc = { depthBufferDesc.format, vg::TextureAttachmentViewType::e2d, 0, 0, 1 };
 	vgCheck(_depthBuffer->CreateAttachmentView(&depthBufferAttachmentDesc, &_depthBufferAttachment));
 
-	_pbr = MeshShader::From(*this, "shaders/PBR.hlsl");
+	_pbr = MeshShader::From(*this, "shaders/PBR.hlsl", VertexFormat::Full);
+	_pbrCompressed = MeshShader::From(*this, "shaders/PBR.hlsl", VertexFormat::Compressed);
+	if (_meshShaders)
+	{
+		_pbrMeshlets = MeshShader::FromMeshlets(*this, "shaders/PBRMeshlet.hlsl");
+		_meshShaders = _pbrMeshlets != nullptr;
+	}
 
 	_model = Model::From(*this, "models/Bistro_v5_2/BistroExterior.fbx").value();
 	//_model2 = Model::From(*this, "models/Bistro_v5_2/BistroInterior.fbx").value();
+
+	uint32_t numMeshes = 0;
+	for (const auto& model : { _model, _model2 })
+	{
+		if (model) numMeshes += static_cast<uint32_t>(model->GetMeshes().size());
+	}
+	_scene = std::make_unique<GpuScene>(*_device, numMeshes, numMeshes);
+
+	auto worldMatrix = glm::scale(glm::mat4{ 1.0f }, glm::vec3{ 0.01f });
+	AddModel(_model, worldMatrix);
+	AddModel(_model2, worldMatrix);
+	_visibleInstances.resize(_instances.size());
+	_bvh.Build(_bounds);
+	std::cout << "BVH: " << _bvh.GetNodeCount() << " nodes over " << _instances.size() << " instances\n";
+
+	if (benchmarkCulling) BenchmarkCulling(_bounds);
 	
 	vg::MemoryStatistics stats;
 	_device->GetMemoryStatistics(&stats);
@@ -111,7 +197,8 @@ Application::~Application()
 		_device->DestroyFence(frame.renderingFence);
 	}
 
-	_cameraData->destroy(*_device);
+	_device->DestroyConstantAllocator(_constantAllocator);
+	_scene = nullptr;
 	_swapChain = nullptr;
 	vg::GraphicsApi graphicsApi;
 	vgCheck(_device->GetGraphicsApi(&graphicsApi));
@@ -175,12 +262,23 @@ void Application::Run()
 		vg::FenceOperation renderingFenceSignal = { frameData.renderingFence, frameData.fenceValue };
 		vg::SubmitInfo submit = { 0, nullptr, 1, &renderingFenceSignal, 1, &cmd };
 		_device->SubmitCommandLists(1, &submit);
+		_device->EndConstantFrame(_constantAllocator, frameData.renderingFence, frameData.fenceValue);
 
 		vgCheck(_swapChain->Present(0, nullptr));
 		frameIndex++;
 	}
 }
 
+void Application::AddModel(const std::shared_ptr<Model>& model, const glm::mat4& worldMatrix)
+{
+	if (!model) return;
+	for (const auto& mesh : model->GetMeshes())
+	{
+		_instances.push_back({ mesh, _scene->AddInstance(*mesh, worldMatrix) });
+		_bounds.Add(mesh->GetAABB().TransformToWorld(worldMatrix));
+	}
+}
+
 void Application::DoFrame(uint64_t frameIndex, const FrameData& frame)
 {
 	auto viewMatrix = _camera.GetViewMatrix();
@@ -190,14 +288,25 @@ void Application::DoFrame(uint64_t frameIndex, const FrameData& frame)
 	cameraMatrix *= glm::mat4(1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
 	auto jitter = glm::vec2(0.0f);
 
-	_cameraData->data = { cameraMatrix, glm::vec4(_camera.GetForwardVector(), 0.0), jitter };
-	_cameraData->upload(frameIndex);
-
 	if (glfwGetKey(_window, GLFW_KEY_F1) != GLFW_PRESS)
 	{
 		_frustum = { cameraMatrix };
 	}
 
+	// cameraMatrix flips world Y, the eye is uploaded in the same space as the geometry it is tested against
+	const auto position = _camera.GetPosition();
+	const auto eye = glm::vec4(position.x, -position.y, position.z, 1.0);
+
+	vg::ConstantAllocation cameraData;
+	vgCheck(_device->AllocateConstants(_constantAllocator, sizeof(CameraData), &cameraData));
+	*static_cast<CameraData*>(cameraData.data) = { cameraMatrix, glm::vec4(_camera.GetForwardVector(), 0.0), jitter, glm::vec2(0.0f),
+		eye, _frustum.planes };
+
+	// Hold F2 to compare against the vertex shader path
+	const bool useMeshlets = _pbrMeshlets && glfwGetKey(_window, GLFW_KEY_F2) != GLFW_PRESS;
+
+	_scene->Upload(*frame.cmd, frameIndex);
+
 	vg::TextureBarrier presentToColorAttachment = { vg::PipelineStageFlags::TopOfPipe,
 			vg::AccessFlags::None,
 			vg::PipelineStageFlags::ColorAttachmentOutput,
@@ -232,48 +341,59 @@ void Application::DoFrame(uint64_t frameIndex, const FrameData& frame)
 
 	//frame.cmd->SetPipeline(_pbr->GetPipeline());
 
-	auto worldMatrix = glm::mat4{ 1.0f };
-	worldMatrix = glm::scale(worldMatrix, glm::vec3{ 0.01f });
-
 	vg::Pipeline boundPipeline = nullptr;
 
-	MeshBindData bindData;
-	bindData.cameraData = _cameraData->getView(frameIndex);
+	// Per-frame part of the root constants, draws only overwrite the instance index
+	SceneBindData bindData = { 0, cameraData.view, _scene->GetInstancesView(), _scene->GetMaterialsView() };
+	frame.cmd->SetRootConstants(vg::PipelineType::Graphics, 0, sizeof(bindData) / sizeof(uint32_t), &bindData);
 
-	const auto drawModel = [&](std::shared_ptr<Model> model, const glm::mat4& worldMatrix)
+	// Hold F3 to compare against flat culling of every instance
+	size_t numVisible;
+	if (glfwGetKey(_window, GLFW_KEY_F3) != GLFW_PRESS)
 	{
-		auto normalMatrix = glm::mat3(transpose(inverse(worldMatrix)));
-		if (model)
+		numVisible = _bvh.Cull(_frustum, _bounds, _visibleInstances.data());
+		// Back to instance order, it keeps meshes sharing a pipeline together
+		std::sort(_visibleInstances.begin(), _visibleInstances.begin() + numVisible);
+	}
+	else
+	{
+		numVisible = _frustum.Cull(_bounds, _visibleInstances.data());
+	}
+	for (size_t i = 0; i < numVisible; i++)
+	{
+		const auto& instance = _instances[_visibleInstances[i]];
+		const auto& mesh = instance.mesh;
+		const bool useMeshletPath = useMeshlets && mesh->GetMeshletCount() > 0;
+		const bool compressed = mesh->GetVertexFormat() == VertexFormat::Compressed;
+		const auto& shader = useMeshletPath ? _pbrMeshlets : compressed ? _pbrCompressed : _pbr;
+		auto pipeline = mesh->GetMaterial().twoSided ? shader->GetPipelineTwoSided() : shader->GetPipeline();
+		if (pipeline != boundPipeline)
 		{
-			const auto& meshes = model->GetMeshes();
-			for (auto& mesh : meshes)
-			{
-				if (!_frustum.IsAABBInside(mesh->GetAABB().TransformToWorld(worldMatrix))) continue;
-
-				auto pipeline = mesh->GetMaterial().twoSided ? _pbr->GetPipelineTwoSided() : _pbr->GetPipeline();
-				if (pipeline != boundPipeline)
-				{
-					frame.cmd->SetPipeline(pipeline);
-					boundPipeline = pipeline;
-				}
-
-				memcpy(bindData.worldMatrix, glm::value_ptr(worldMatrix), sizeof(bindData.worldMatrix));
-				memcpy(bindData.normalMatrix0, &normalMatrix[0], sizeof(glm::vec3));
-				memcpy(bindData.normalMatrix1, &normalMatrix[1], sizeof(glm::vec3));
-				memcpy(bindData.normalMatrix2, &normalMatrix[2], sizeof(glm::vec3));
-				bindData.material = mesh->GetMaterial().baseColorTexture ? mesh->GetMaterial().baseColorTexture->GetSrv() : -1;
-				frame.cmd->SetRootConstants(vg::PipelineType::Graphics, 0, sizeof(bindData) / sizeof(uint32_t), &bindData);
-
-				std::array vertexBuffers = { mesh->GetPositionsVB(), mesh->GetNormalsVB(), mesh->GetTangentsVB(), mesh->GetUVsVB() };
-				frame.cmd->SetVertexBuffers(0, static_cast<uint32_t>(vertexBuffers.size()), vertexBuffers.data());
-				frame.cmd->SetIndexBuffer(vg::IndexType::Uint32, mesh->GetIndexOffset(), mesh->GetVertexBuffer());
-				frame.cmd->DrawIndexed(mesh->GetIndexCount(), 1, 0, 0, 0);
-			}
+			frame.cmd->SetPipeline(pipeline);
+			boundPipeline = pipeline;
 		}
-	};
 
-	drawModel(_model, worldMatrix);
-	drawModel(_model2, worldMatrix);
+		frame.cmd->SetRootConstants(vg::PipelineType::Graphics, offsetof(SceneBindData, instance) / sizeof(uint32_t), 1, &instance.id);
+
+		if (useMeshletPath)
+		{
+			// One amplification group culls 32 meshlets, see MESHLETS_PER_TASK in PBRMeshlet.hlsl
+			frame.cmd->DispatchMesh((mesh->GetMeshletCount() + 31) / 32, 1, 1);
+			continue;
+		}
+
+		if (compressed)
+		{
+			frame.cmd->SetVertexBuffers(0, 1, &mesh->GetPackedVB());
+		}
+		else
+		{
+			std::array vertexBuffers = { mesh->GetPositionsVB(), mesh->GetNormalsVB(), mesh->GetTangentsVB(), mesh->GetUVsVB() };
+			frame.cmd->SetVertexBuffers(0, static_cast<uint32_t>(vertexBuffers.size()), vertexBuffers.data());
+		}
+		frame.cmd->SetIndexBuffer(vg::IndexType::Uint32, mesh->GetIndexOffset(), mesh->GetVertexBuffer());
+		frame.cmd->DrawIndexed(mesh->GetIndexCount(), 1, 0, 0, 0);
+	}
 
 	frame.cmd->EndRendering();
 
@@ -0,0 +1,295 @@
+#include "bvh.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+static constexpr uint32_t NumBins = 16;
+static constexpr uint32_t InvalidNode = UINT32_MAX;
+
+static AABB GetItemBounds(const AABBArray& bounds, uint32_t item)
+{
+    return { { bounds.minX[item], bounds.minY[item], bounds.minZ[item] }, { bounds.maxX[item], bounds.maxY[item], bounds.maxZ[item] } };
+}
+
+static AABB EmptyBounds()
+{
+    return { glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+}
+
+static void Grow(AABB& aabb, const AABB& other)
+{
+    aabb.min = glm::min(aabb.min, other.min);
+    aabb.max = glm::max(aabb.max, other.max);
+}
+
+static float SurfaceArea(const AABB& aabb)
+{
+    glm::vec3 extent = glm::max(aabb.max - aabb.min, glm::vec3(0.0f));
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+void BVH::Build(const AABBArray& bounds)
+{
+    _nodes.clear();
+    _items.resize(bounds.Size());
+    _itemLeaves.resize(bounds.Size());
+    if (bounds.Size() == 0) return;
+
+    std::vector<glm::vec3> centroids(bounds.Size());
+    for (uint32_t i = 0; i < bounds.Size(); i++)
+    {
+        _items[i] = i;
+        AABB aabb = GetItemBounds(bounds, i);
+        centroids[i] = (aabb.min + aabb.max) * 0.5f;
+    }
+
+    _nodes.reserve(bounds.Size() * 2);
+    _nodes.push_back({ {}, 0, static_cast<uint32_t>(bounds.Size()), 0, InvalidNode });
+    UpdateLeafBounds(_nodes[0], bounds);
+    Subdivide(0, bounds, centroids);
+}
+
+void BVH::UpdateLeafBounds(Node& node, const AABBArray& bounds) const
+{
+    node.bounds = EmptyBounds();
+    for (uint32_t i = 0; i < node.count; i++)
+    {
+        Grow(node.bounds, GetItemBounds(bounds, _items[node.first + i]));
+    }
+}
+
+void BVH::Subdivide(uint32_t nodeIndex, const AABBArray& bounds, std::vector<glm::vec3>& centroids)
+{
+    const uint32_t first = _nodes[nodeIndex].first;
+    const uint32_t count = _nodes[nodeIndex].count;
+
+    const auto makeLeaf = [&]()
+    {
+        for (uint32_t i = 0; i < count; i++) _itemLeaves[_items[first + i]] = nodeIndex;
+    };
+    if (count <= MaxLeafSize)
+    {
+        makeLeaf();
+        return;
+    }
+
+    AABB centroidBounds = EmptyBounds();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const glm::vec3& centroid = centroids[_items[first + i]];
+        Grow(centroidBounds, { centroid, centroid });
+    }
+
+    // Binned SAH: for each axis, sweep bin boundaries and keep the cheapest split
+    float bestCost = FLT_MAX;
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const float minCentroid = centroidBounds.min[axis];
+        const float extent = centroidBounds.max[axis] - minCentroid;
+        if (extent <= 0.0f) continue;
+
+        struct Bin { AABB bounds = EmptyBounds(); uint32_t count = 0; };
+        std::array<Bin, NumBins> bins;
+        const float scale = NumBins / extent;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const uint32_t item = _items[first + i];
+            const uint32_t bin = std::min(NumBins - 1, static_cast<uint32_t>((centroids[item][axis] - minCentroid) * scale));
+            bins[bin].count++;
+            Grow(bins[bin].bounds, GetItemBounds(bounds, item));
+        }
+
+        std::array<float, NumBins - 1> leftArea, rightArea;
+        std::array<uint32_t, NumBins - 1> leftCount, rightCount;
+        AABB left = EmptyBounds(), right = EmptyBounds();
+        uint32_t leftSum = 0, rightSum = 0;
+        for (uint32_t i = 0; i < NumBins - 1; i++)
+        {
+            leftSum += bins[i].count;
+            leftCount[i] = leftSum;
+            Grow(left, bins[i].bounds);
+            leftArea[i] = SurfaceArea(left);
+
+            rightSum += bins[NumBins - 1 - i].count;
+            rightCount[NumBins - 2 - i] = rightSum;
+            Grow(right, bins[NumBins - 1 - i].bounds);
+            rightArea[NumBins - 2 - i] = SurfaceArea(right);
+        }
+
+        for (uint32_t i = 0; i < NumBins - 1; i++)
+        {
+            if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+            const float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    uint32_t leftCount;
+    if (bestAxis >= 0)
+    {
+        // Splitting has to beat testing every item of this node directly
+        if (bestCost >= count * SurfaceArea(_nodes[nodeIndex].bounds) && count <= MaxLeafSize * 4)
+        {
+            makeLeaf();
+            return;
+        }
+
+        const float minCentroid = centroidBounds.min[bestAxis];
+        const float scale = NumBins / (centroidBounds.max[bestAxis] - minCentroid);
+        auto middle = std::partition(_items.begin() + first, _items.begin() + first + count, [&](uint32_t item)
+        {
+            return std::min(NumBins - 1, static_cast<uint32_t>((centroids[item][bestAxis] - minCentroid) * scale)) <= bestSplit;
+        });
+        leftCount = static_cast<uint32_t>(middle - (_items.begin() + first));
+    }
+    else
+    {
+        // All centroids coincide, any split is as good as another
+        leftCount = count / 2;
+    }
+
+    const uint32_t leftIndex = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back({ {}, first, leftCount, 0, nodeIndex });
+    _nodes.push_back({ {}, first + leftCount, count - leftCount, 0, nodeIndex });
+    UpdateLeafBounds(_nodes[leftIndex], bounds);
+    UpdateLeafBounds(_nodes[leftIndex + 1], bounds);
+    _nodes[nodeIndex].left = leftIndex;
+
+    Subdivide(leftIndex, bounds, centroids);
+    Subdivide(leftIndex + 1, bounds, centroids);
+}
+
+void BVH::Refit(const AABBArray& bounds)
+{
+    // Children are always stored after their parent
+    for (size_t i = _nodes.size(); i-- > 0;)
+    {
+        Node& node = _nodes[i];
+        if (node.IsLeaf())
+        {
+            UpdateLeafBounds(node, bounds);
+            continue;
+        }
+        node.bounds = _nodes[node.left].bounds;
+        Grow(node.bounds, _nodes[node.left + 1].bounds);
+    }
+}
+
+void BVH::Refit(const AABBArray& bounds, uint32_t item)
+{
+    uint32_t nodeIndex = _itemLeaves[item];
+    UpdateLeafBounds(_nodes[nodeIndex], bounds);
+
+    for (nodeIndex = _nodes[nodeIndex].parent; nodeIndex != InvalidNode; nodeIndex = _nodes[nodeIndex].parent)
+    {
+        Node& node = _nodes[nodeIndex];
+        AABB refitted = _nodes[node.left].bounds;
+        Grow(refitted, _nodes[node.left + 1].bounds);
+        if (refitted.min == node.bounds.min && refitted.max == node.bounds.max) break;
+        node.bounds = refitted;
+    }
+}
+
+// Tests aabb against planes still set in planeMask, clears planes the box is fully in front of. Returns false if outside
+static bool TestPlanes(const Frustum& frustum, const AABB& aabb, uint32_t& planeMask)
+{
+    for (uint32_t i = 0; i < frustum.planes.size(); i++)
+    {
+        if (!(planeMask & (1u << i))) continue;
+        const glm::vec4& plane = frustum.planes[i];
+
+        glm::vec3 positiveVertex = aabb.min;
+        glm::vec3 negativeVertex = aabb.max;
+        if (plane.x >= 0) std::swap(positiveVertex.x, negativeVertex.x);
+        if (plane.y >= 0) std::swap(positiveVertex.y, negativeVertex.y);
+        if (plane.z >= 0) std::swap(positiveVertex.z, negativeVertex.z);
+
+        if (glm::dot(glm::vec3(plane), positiveVertex) + plane.w < 0) return false;
+        if (glm::dot(glm::vec3(plane), negativeVertex) + plane.w >= 0) planeMask &= ~(1u << i);
+    }
+    return true;
+}
+
+size_t BVH::Cull(const Frustum& frustum, const AABBArray& bounds, uint32_t* outVisible) const
+{
+    if (_nodes.empty()) return 0;
+
+    struct Entry { uint32_t node; uint32_t planeMask; };
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({ 0, (1u << frustum.planes.size()) - 1 });
+
+    size_t numVisible = 0;
+    while (!stack.empty())
+    {
+        Entry entry = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[entry.node];
+        if (!TestPlanes(frustum, node.bounds, entry.planeMask)) continue;
+
+        if (entry.planeMask == 0)
+        {
+            // Fully inside, the whole subtree is visible
+            memcpy(outVisible + numVisible, _items.data() + node.first, node.count * sizeof(uint32_t));
+            numVisible += node.count;
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = 0; i < node.count; i++)
+            {
+                const uint32_t item = _items[node.first + i];
+                uint32_t planeMask = entry.planeMask;
+                if (node.count == 1 || TestPlanes(frustum, GetItemBounds(bounds, item), planeMask))
+                    outVisible[numVisible++] = item;
+            }
+            continue;
+        }
+
+        stack.push_back({ node.left + 1, entry.planeMask });
+        stack.push_back({ node.left, entry.planeMask });
+    }
+    return numVisible;
+}
+
+void BVH::Query(const AABB& aabb, const AABBArray& bounds, std::vector<uint32_t>& outItems) const
+{
+    if (_nodes.empty()) return;
+
+    const auto overlaps = [&](const AABB& other)
+    {
+        return glm::all(glm::lessThanEqual(aabb.min, other.max)) && glm::all(glm::lessThanEqual(other.min, aabb.max));
+    };
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (!overlaps(node.bounds)) continue;
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = 0; i < node.count; i++)
+            {
+                const uint32_t item = _items[node.first + i];
+                if (overlaps(GetItemBounds(bounds, item))) outItems.push_back(item);
+            }
+            continue;
+        }
+
+        stack.push_back(node.left + 1);
+        stack.push_back(node.left);
+    }
+}
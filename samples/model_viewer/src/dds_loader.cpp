@@ -1,5 +1,5 @@
 #include "dds_loader.h"
-#include <fstream>
+#include <cstring>
 
 #pragma pack(push, 1)
 struct DDSHeader
@@ -25,6 +25,15 @@ struct DDSHeader
     uint32_t caps[4];
     uint32_t reserved2;
 };
+
+struct DDSHeaderDXT10
+{
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+};
 #pragma pack(pop)
 
 constexpr uint32_t DDS_MAGIC = 0x20534444; // "DDS "
@@ -32,40 +41,113 @@ constexpr uint32_t DDPF_FOURCC = 0x4;
 constexpr uint32_t FOURCC_DXT1 = 0x31545844; // "DXT1"
 constexpr uint32_t FOURCC_DXT3 = 0x33545844; // "DXT3"
 constexpr uint32_t FOURCC_DXT5 = 0x35545844; // "DXT5"
-constexpr uint32_t FOURCC_BC5 = 0x55344342; // "BC5 "
+constexpr uint32_t FOURCC_BC4U = 0x55344342; // "BC4U"
+constexpr uint32_t FOURCC_BC4S = 0x53344342; // "BC4S"
+constexpr uint32_t FOURCC_ATI1 = 0x31495441; // "ATI1" (alternative BC4)
+constexpr uint32_t FOURCC_BC5U = 0x55354342; // "BC5U"
+constexpr uint32_t FOURCC_BC5S = 0x53354342; // "BC5S"
 constexpr uint32_t FOURCC_ATI2 = 0x32495441; // "ATI2" (alternative BC5)
+constexpr uint32_t FOURCC_DX10 = 0x30315844; // "DX10", followed by DDSHeaderDXT10
+
+constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+static vg::Format GetFormatFromFourCC(uint32_t fourCC)
+{
+    switch (fourCC)
+    {
+    case FOURCC_DXT1: return vg::Format::Bc1Unorm;
+    case FOURCC_DXT3: return vg::Format::Bc2Unorm;
+    case FOURCC_DXT5: return vg::Format::Bc3Unorm;
+    case FOURCC_BC4U:
+    case FOURCC_ATI1:
+        return vg::Format::Bc4Unorm;
+    case FOURCC_BC4S: return vg::Format::Bc4Snorm;
+    case FOURCC_BC5U:
+    case FOURCC_ATI2:
+        return vg::Format::Bc5Unorm;
+    case FOURCC_BC5S: return vg::Format::Bc5Snorm;
+    default: return vg::Format::Unknown;
+    }
+}
 
+static vg::Format GetFormatFromDXGI(uint32_t dxgiFormat)
+{
+    // Values of DXGI_FORMAT
+    switch (dxgiFormat)
+    {
+    case 71: return vg::Format::Bc1Unorm;
+    case 72: return vg::Format::Bc1Srgb;
+    case 74: return vg::Format::Bc2Unorm;
+    case 75: return vg::Format::Bc2Srgb;
+    case 77: return vg::Format::Bc3Unorm;
+    case 78: return vg::Format::Bc3Srgb;
+    case 80: return vg::Format::Bc4Unorm;
+    case 81: return vg::Format::Bc4Snorm;
+    case 83: return vg::Format::Bc5Unorm;
+    case 84: return vg::Format::Bc5Snorm;
+    case 95: return vg::Format::Bc6hUf16;
+    case 96: return vg::Format::Bc6hSf16;
+    case 98: return vg::Format::Bc7Unorm;
+    case 99: return vg::Format::Bc7Srgb;
+    default: return vg::Format::Unknown;
+    }
+}
+
+uint32_t DDSLoader::GetBlockSize(vg::Format format)
+{
+    switch (format)
+    {
+    case vg::Format::Bc1Unorm:
+    case vg::Format::Bc1Srgb:
+    case vg::Format::Bc4Unorm:
+    case vg::Format::Bc4Snorm:
+        return 8;
+    default:
+        return 16;
+    }
+}
 
 bool DDSLoader::Load(const std::filesystem::path& path, DDSData& data)
 {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) return false;
+    auto file = MappedFile::Open(path);
+    if (!file) return false;
+
+    const uint8_t* bytes = file->GetData();
+    const uint64_t fileSize = file->GetSize();
+    uint64_t offset = sizeof(uint32_t) + sizeof(DDSHeader);
+    if (fileSize < offset) return false;
 
     uint32_t magic;
-    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    memcpy(&magic, bytes, sizeof(magic));
     if (magic != DDS_MAGIC) return false;
 
     DDSHeader header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    memcpy(&header, bytes + sizeof(uint32_t), sizeof(header));
 
-    data.width = header.width;
-    data.height = header.height;
-    auto mips = (header.mipMapCount > 0) ? header.mipMapCount : 1;
+    if (!(header.pixelFormat.flags & DDPF_FOURCC)) return false; // Unsupported format
 
-    if (header.pixelFormat.flags & DDPF_FOURCC)
+    if (header.pixelFormat.fourCC == FOURCC_DX10)
     {
-        switch (header.pixelFormat.fourCC)
-        {
-        case FOURCC_DXT1: data.format = vg::Format::Bc1Unorm; break;
-        case FOURCC_DXT3: data.format = vg::Format::Bc2Unorm; break;
-        case FOURCC_DXT5: data.format = vg::Format::Bc3Unorm; break;
-        case FOURCC_BC5: 
-        case FOURCC_ATI2:
-            data.format = vg::Format::Bc5Unorm; break;
-        default: return false;
-        }
+        if (fileSize < offset + sizeof(DDSHeaderDXT10)) return false;
+
+        DDSHeaderDXT10 headerDXT10;
+        memcpy(&headerDXT10, bytes + offset, sizeof(headerDXT10));
+        offset += sizeof(DDSHeaderDXT10);
+
+        // Only single 2D textures are supported
+        if (headerDXT10.resourceDimension != DDS_DIMENSION_TEXTURE2D || headerDXT10.arraySize > 1) return false;
+        data.format = GetFormatFromDXGI(headerDXT10.dxgiFormat);
     }
-    else return false; // Unsupported format
+    else
+    {
+        data.format = GetFormatFromFourCC(header.pixelFormat.fourCC);
+    }
+    if (data.format == vg::Format::Unknown) return false;
+
+    data.width = header.width;
+    data.height = header.height;
+    auto mips = (header.mipMapCount > 0) ? header.mipMapCount : 1;
+    const uint32_t blockSize = GetBlockSize(data.format);
 
     data.mips.resize(mips);
     uint32_t mipWidth = data.width;
@@ -73,13 +155,16 @@ bool DDSLoader::Load(const std::filesystem::path& path, DDSData& data)
 
     for (uint32_t i = 0; i < mips; ++i)
     {
-        size_t mipSize = std::max(1u, (mipWidth * mipHeight/* * 4*/) / (header.pixelFormat.fourCC == FOURCC_DXT1 ? 2 : 1));
-        data.mips[i].resize(mipSize);
-        file.read(reinterpret_cast<char*>(data.mips[i].data()), mipSize);
+        uint64_t mipSize = uint64_t(std::max(1u, (mipWidth + 3) / 4)) * std::max(1u, (mipHeight + 3) / 4) * blockSize;
+        if (offset + mipSize > fileSize) return false;
+
+        data.mips[i] = { bytes + offset, mipSize };
+        offset += mipSize;
 
         mipWidth = std::max(1u, mipWidth / 2);
         mipHeight = std::max(1u, mipHeight / 2);
     }
 
+    data.file = std::move(file);
     return true;
 }
@@ -34,6 +34,12 @@ int main(int argc, char** argv)
 			}
 		}
 	};
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (std::string_view(argv[i]) != "--capture") continue;
+		cfg.flags |= vg::InitFlags::EnableCapture;
+		cfg.capturePath = argv[i + 1];
+	}
 	vg::Library library(cfg);
 	FreeImage_Initialise();
 
@@ -1,5 +1,11 @@
 #include "frustum.h"
 
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#endif
+
 AABB::AABB(const glm::mat4& worldMatrix, glm::vec3 localMin, glm::vec3 localMax)
 {
     glm::vec3 worldMin(FLT_MAX);
@@ -61,3 +67,149 @@ bool Frustum::IsAABBInside(const AABB& aabb) const
     }
     return true;
 }
+
+void AABBArray::Reserve(size_t count)
+{
+    for (auto* v : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ }) v->reserve(count);
+}
+
+void AABBArray::Add(const AABB& aabb)
+{
+    minX.push_back(aabb.min.x);
+    minY.push_back(aabb.min.y);
+    minZ.push_back(aabb.min.z);
+    maxX.push_back(aabb.max.x);
+    maxY.push_back(aabb.max.y);
+    maxZ.push_back(aabb.max.z);
+}
+
+void AABBArray::Set(size_t index, const AABB& aabb)
+{
+    minX[index] = aabb.min.x;
+    minY[index] = aabb.min.y;
+    minZ[index] = aabb.min.z;
+    maxX[index] = aabb.max.x;
+    maxY[index] = aabb.max.y;
+    maxZ[index] = aabb.max.z;
+}
+
+size_t Frustum::CullScalar(const AABBArray& bounds, uint32_t* outVisible) const
+{
+    return CullScalar(bounds, 0, bounds.Size(), outVisible);
+}
+
+size_t Frustum::CullScalar(const AABBArray& bounds, size_t begin, size_t end, uint32_t* outVisible) const
+{
+    size_t numVisible = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        bool inside = true;
+        for (const auto& plane : planes)
+        {
+            // Same positive vertex test as IsAABBInside()
+            float x = plane.x >= 0 ? bounds.maxX[i] : bounds.minX[i];
+            float y = plane.y >= 0 ? bounds.maxY[i] : bounds.minY[i];
+            float z = plane.z >= 0 ? bounds.maxZ[i] : bounds.minZ[i];
+            inside &= plane.x * x + plane.y * y + plane.z * z + plane.w >= 0;
+        }
+        outVisible[numVisible] = static_cast<uint32_t>(i);
+        numVisible += inside;
+    }
+    return numVisible;
+}
+
+#if defined(__AVX2__)
+
+size_t Frustum::Cull(const AABBArray& bounds, uint32_t* outVisible) const
+{
+    const size_t count = bounds.Size();
+    const size_t simdCount = count & ~size_t(7);
+    size_t numVisible = 0;
+
+    for (size_t i = 0; i < simdCount; i += 8)
+    {
+        const __m256 minX = _mm256_loadu_ps(bounds.minX.data() + i);
+        const __m256 minY = _mm256_loadu_ps(bounds.minY.data() + i);
+        const __m256 minZ = _mm256_loadu_ps(bounds.minZ.data() + i);
+        const __m256 maxX = _mm256_loadu_ps(bounds.maxX.data() + i);
+        const __m256 maxY = _mm256_loadu_ps(bounds.maxY.data() + i);
+        const __m256 maxZ = _mm256_loadu_ps(bounds.maxZ.data() + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : planes)
+        {
+            // Plane signs are the same for every box, so the positive vertex is picked per plane, not per lane
+            const __m256 x = plane.x >= 0 ? maxX : minX;
+            const __m256 y = plane.y >= 0 ? maxY : minY;
+            const __m256 z = plane.z >= 0 ? maxZ : minZ;
+
+            // Separate mul and add, FMA is not implied by AVX2 (-mavx2 alone does not enable it)
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), x), _mm256_set1_ps(plane.w));
+            distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.y), y), distance);
+            distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), z), distance);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        // Branchless compaction: every lane is stored, only visible ones advance the output
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+        for (uint32_t lane = 0; lane < 8; lane++)
+        {
+            outVisible[numVisible] = static_cast<uint32_t>(i + lane);
+            numVisible += (mask >> lane) & 1;
+        }
+    }
+
+    return numVisible + CullScalar(bounds, simdCount, count, outVisible + numVisible);
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+size_t Frustum::Cull(const AABBArray& bounds, uint32_t* outVisible) const
+{
+    const size_t count = bounds.Size();
+    const size_t simdCount = count & ~size_t(3);
+    size_t numVisible = 0;
+
+    for (size_t i = 0; i < simdCount; i += 4)
+    {
+        const __m128 minX = _mm_loadu_ps(bounds.minX.data() + i);
+        const __m128 minY = _mm_loadu_ps(bounds.minY.data() + i);
+        const __m128 minZ = _mm_loadu_ps(bounds.minZ.data() + i);
+        const __m128 maxX = _mm_loadu_ps(bounds.maxX.data() + i);
+        const __m128 maxY = _mm_loadu_ps(bounds.maxY.data() + i);
+        const __m128 maxZ = _mm_loadu_ps(bounds.maxZ.data() + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : planes)
+        {
+            // Plane signs are the same for every box, so the positive vertex is picked per plane, not per lane
+            const __m128 x = plane.x >= 0 ? maxX : minX;
+            const __m128 y = plane.y >= 0 ? maxY : minY;
+            const __m128 z = plane.z >= 0 ? maxZ : minZ;
+
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), x), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.y), y), distance);
+            distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), z), distance);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        // Branchless compaction: every lane is stored, only visible ones advance the output
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(inside));
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            outVisible[numVisible] = static_cast<uint32_t>(i + lane);
+            numVisible += (mask >> lane) & 1;
+        }
+    }
+
+    return numVisible + CullScalar(bounds, simdCount, count, outVisible + numVisible);
+}
+
+#else
+
+size_t Frustum::Cull(const AABBArray& bounds, uint32_t* outVisible) const
+{
+    return CullScalar(bounds, outVisible);
+}
+
+#endif
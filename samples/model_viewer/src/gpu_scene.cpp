@@ -0,0 +1,146 @@
+#include "gpu_scene.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+GpuScene::GpuScene(vg::Device device, uint32_t maxInstances, uint32_t maxMaterials)
+	: _device(device), _maxInstances(std::max(1u, maxInstances)), _maxMaterials(std::max(1u, maxMaterials))
+{
+	vg::BufferDesc bufferDesc = { _maxInstances * sizeof(InstanceData), vg::BufferUsage::General, vg::HeapType::Gpu };
+	vgCheck(_device.CreateBuffer(&bufferDesc, &_instanceBuffer));
+	_instanceBuffer.SetName("Instances");
+
+	bufferDesc.size = _maxMaterials * sizeof(MaterialData);
+	vgCheck(_device.CreateBuffer(&bufferDesc, &_materialBuffer));
+	_materialBuffer.SetName("Materials");
+
+	vg::BufferViewDesc viewDesc = { vg::BufferDescriptorType::Srv, vg::BufferViewType::StructuredBuffer, vg::Format::Unknown,
+		0, _maxInstances * sizeof(InstanceData), sizeof(InstanceData) };
+	vgCheck(_instanceBuffer.CreateView(&viewDesc, &_instancesView));
+
+	viewDesc.size = _maxMaterials * sizeof(MaterialData);
+	viewDesc.elementSize = sizeof(MaterialData);
+	vgCheck(_materialBuffer.CreateView(&viewDesc, &_materialsView));
+
+	bufferDesc = { StagingSlotSize() * NumFrames, vg::BufferUsage::General, vg::HeapType::Upload };
+	vgCheck(_device.CreateBuffer(&bufferDesc, &_stagingBuffer));
+	_stagingBuffer.SetName("Scene staging");
+	void* mapped;
+	vgCheck(_stagingBuffer.Map(&mapped));
+	_staging = static_cast<uint8_t*>(mapped);
+
+	_instances.reserve(_maxInstances);
+	_materials.reserve(_maxMaterials);
+}
+
+GpuScene::~GpuScene()
+{
+	_stagingBuffer.Unmap();
+	_device.DestroyBuffer(_stagingBuffer);
+	_device.DestroyBuffer(_materialBuffer);
+	_device.DestroyBuffer(_instanceBuffer);
+}
+
+uint64_t GpuScene::StagingSlotSize() const
+{
+	return _maxInstances * sizeof(InstanceData) + _maxMaterials * sizeof(MaterialData);
+}
+
+uint32_t GpuScene::AddMaterial(const Material& material)
+{
+	MaterialData data = {};
+	data.baseColor = material.baseColorTexture ? material.baseColorTexture->GetSrv() : VG_NO_VIEW;
+	data.flags = material.twoSided ? INSTANCE_FLAG_TWO_SIDED : INSTANCE_FLAG_NONE;
+
+	const uint64_t key = (static_cast<uint64_t>(data.flags) << 32) | data.baseColor;
+	auto it = _materialIndices.find(key);
+	if (it != _materialIndices.end()) return it->second;
+
+	assert(_materials.size() < _maxMaterials);
+	const uint32_t index = static_cast<uint32_t>(_materials.size());
+	_materials.push_back(data);
+	_materialIndices.emplace(key, index);
+	_dirtyMaterials.Add(index);
+	return index;
+}
+
+uint32_t GpuScene::AddInstance(const Mesh& mesh, const glm::mat4& worldMatrix)
+{
+	assert(_instances.size() < _maxInstances);
+	const uint32_t index = static_cast<uint32_t>(_instances.size());
+
+	InstanceData& instance = _instances.emplace_back();
+	instance.material = AddMaterial(mesh.GetMaterial());
+	instance.meshlets = mesh.GetMeshletsView();
+	instance.vertices = mesh.GetVerticesView();
+	instance.flags = mesh.GetMaterial().twoSided ? INSTANCE_FLAG_TWO_SIDED : INSTANCE_FLAG_NONE;
+
+	// The vertex path applies this itself, meshlets read their own copy from MeshletBufferHeader
+	const glm::mat4 dequantization = mesh.GetDequantizationMatrix();
+	memcpy(instance.positionOffset, &dequantization[3], sizeof(glm::vec3));
+	instance.positionScale[0] = dequantization[0][0];
+	instance.positionScale[1] = dequantization[1][1];
+	instance.positionScale[2] = dequantization[2][2];
+	instance.padding = 0;
+
+	SetTransform(index, worldMatrix);
+	return index;
+}
+
+void GpuScene::SetTransform(uint32_t instance, const glm::mat4& worldMatrix)
+{
+	InstanceData& data = _instances[instance];
+	const auto normalMatrix = glm::mat3(transpose(inverse(worldMatrix)));
+
+	memcpy(data.worldMatrix, glm::value_ptr(worldMatrix), sizeof(data.worldMatrix));
+	memcpy(data.normalMatrix0, &normalMatrix[0], sizeof(glm::vec3));
+	memcpy(data.normalMatrix1, &normalMatrix[1], sizeof(glm::vec3));
+	memcpy(data.normalMatrix2, &normalMatrix[2], sizeof(glm::vec3));
+	_dirtyInstances.Add(instance);
+}
+
+void GpuScene::Upload(vg::CommandList cmd, uint64_t frameIndex)
+{
+	if (_dirtyInstances.Empty() && _dirtyMaterials.Empty()) return;
+
+	const uint64_t slotOffset = StagingSlotSize() * (frameIndex % NumFrames);
+	const uint64_t materialsOffset = slotOffset + _maxInstances * sizeof(InstanceData);
+
+	std::array<vg::BufferBarrier, 2> barriers;
+	uint32_t numBarriers = 0;
+	if (!_dirtyInstances.Empty())
+	{
+		barriers[numBarriers++] = { vg::PipelineStageFlags::AllGraphics, vg::AccessFlags::ShaderRead,
+			vg::PipelineStageFlags::AllTransfer, vg::AccessFlags::TransferWrite, _instanceBuffer };
+	}
+	if (!_dirtyMaterials.Empty())
+	{
+		barriers[numBarriers++] = { vg::PipelineStageFlags::AllGraphics, vg::AccessFlags::ShaderRead,
+			vg::PipelineStageFlags::AllTransfer, vg::AccessFlags::TransferWrite, _materialBuffer };
+	}
+	vg::DependencyInfo dependency = { 0, nullptr, numBarriers, barriers.data(), 0, nullptr };
+	cmd.Barrier(&dependency);
+
+	if (!_dirtyInstances.Empty())
+	{
+		const uint64_t offset = _dirtyInstances.begin * sizeof(InstanceData);
+		const uint64_t size = (_dirtyInstances.end - _dirtyInstances.begin) * sizeof(InstanceData);
+		memcpy(_staging + slotOffset + offset, _instances.data() + _dirtyInstances.begin, size);
+		cmd.CopyBufferToBuffer(_instanceBuffer, offset, _stagingBuffer, slotOffset + offset, size);
+		_dirtyInstances = {};
+	}
+	if (!_dirtyMaterials.Empty())
+	{
+		const uint64_t offset = _dirtyMaterials.begin * sizeof(MaterialData);
+		const uint64_t size = (_dirtyMaterials.end - _dirtyMaterials.begin) * sizeof(MaterialData);
+		memcpy(_staging + materialsOffset + offset, _materials.data() + _dirtyMaterials.begin, size);
+		cmd.CopyBufferToBuffer(_materialBuffer, offset, _stagingBuffer, materialsOffset + offset, size);
+		_dirtyMaterials = {};
+	}
+
+	for (uint32_t i = 0; i < numBarriers; i++)
+	{
+		std::swap(barriers[i].srcStage, barriers[i].dstStage);
+		std::swap(barriers[i].srcAccess, barriers[i].dstAccess);
+	}
+	cmd.Barrier(&dependency);
+}
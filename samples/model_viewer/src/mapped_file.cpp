@@ -0,0 +1,70 @@
+#include "mapped_file.h"
+
+#if _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <Windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::filesystem::path& path)
+{
+    // The view keeps the mapping alive, so file handles are closed right after mapping on both platforms
+#if _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return nullptr;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) return nullptr;
+
+    return std::shared_ptr<MappedFile>(new MappedFile(static_cast<const uint8_t*>(data), size.QuadPart));
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    return std::shared_ptr<MappedFile>(new MappedFile(static_cast<const uint8_t*>(data), st.st_size));
+#endif
+}
+
+MappedFile::MappedFile(const uint8_t* data, uint64_t size) : _data(data), _size(size)
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+#if _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+}
@@ -1,12 +1,187 @@
 #include "mesh.h"
 #include "application.h"
 
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 Mesh::~Mesh()
 {
     if (!_vertexBuffer) return;
     vg::Device device;
     _vertexBuffer.GetDevice(&device);
     device.DestroyBuffer(_vertexBuffer);
+    if (_meshletBuffer) device.DestroyBuffer(_meshletBuffer);
+}
+
+struct MeshletBufferHeader
+{
+    uint32_t meshletCount;
+    uint32_t vertexCount;
+    uint32_t meshletsOffset;
+    uint32_t boundsOffset;
+    uint32_t vertexIndicesOffset;
+    uint32_t primitivesOffset;
+    VertexFormat vertexFormat;
+    uint32_t padding;
+    // Dequantization of compressed positions: position = positionOffset + unorm * positionScale
+    float positionOffset[4];
+    float positionScale[4];
+};
+
+static MeshletBounds ComputeMeshletBounds(const MeshletData& data, const Meshlet& meshlet, const aiVector3D* positions, float windingSign)
+{
+    const auto position = [&](uint32_t localIndex)
+    {
+        const auto& p = positions[data.vertexIndices[meshlet.vertexOffset + localIndex]];
+        return glm::vec3(p.x, p.y, p.z);
+    };
+
+    glm::vec3 min(FLT_MAX);
+    glm::vec3 max(-FLT_MAX);
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+    {
+        min = glm::min(min, position(i));
+        max = glm::max(max, position(i));
+    }
+
+    const glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+    {
+        radius = std::max(radius, glm::length(position(i) - center));
+    }
+
+    MeshletBounds bounds = { { center.x, center.y, center.z }, radius, { 0.0f, 0.0f, 0.0f }, 1.0f };
+
+    std::array<glm::vec3, MeshletData::MaxPrimitives> faceNormals;
+    uint32_t numFaceNormals = 0;
+    glm::vec3 axis(0.0f);
+    for (uint32_t i = 0; i < meshlet.primitiveCount; i++)
+    {
+        const uint32_t packed = data.primitives[meshlet.primitiveOffset + i];
+        const glm::vec3 p0 = position(packed & 0xFF);
+        const glm::vec3 p1 = position((packed >> 8) & 0xFF);
+        const glm::vec3 p2 = position((packed >> 16) & 0xFF);
+
+        const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0) * windingSign;
+        const float length = glm::length(normal);
+        if (length <= 0.0f) continue;
+
+        faceNormals[numFaceNormals++] = normal / length;
+        axis += normal / length;
+    }
+
+    const float axisLength = glm::length(axis);
+    if (numFaceNormals == 0 || axisLength < 1e-6f) return bounds;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (uint32_t i = 0; i < numFaceNormals; i++)
+    {
+        minDot = std::min(minDot, glm::dot(axis, faceNormals[i]));
+    }
+
+    // Normals spread over more than a hemisphere, the meshlet is visible from any direction
+    if (minDot <= 0.0f) return bounds;
+
+    memcpy(bounds.coneAxis, glm::value_ptr(axis), sizeof(bounds.coneAxis));
+    bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    return bounds;
+}
+
+MeshletData MeshletData::Build(const aiVector3D* positions, const aiVector3D* normals, const std::vector<uint32_t>& indices, uint32_t vertexCount)
+{
+    // aiProcess_FlipWindingOrder and the Y flip in the camera matrix make the sign of cross(p1 - p0, p2 - p0)
+    // ambiguous, so orient face normals by the imported vertex normals. Without normals cone culling is disabled
+    float windingSign = 0.0f;
+    if (normals)
+    {
+        double orientation = 0.0;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const auto& p0 = positions[indices[i + 0]];
+            const auto& p1 = positions[indices[i + 1]];
+            const auto& p2 = positions[indices[i + 2]];
+            const auto faceNormal = (p1 - p0) ^ (p2 - p0);
+            orientation += faceNormal * (normals[indices[i + 0]] + normals[indices[i + 1]] + normals[indices[i + 2]]);
+        }
+        windingSign = orientation >= 0.0 ? 1.0f : -1.0f;
+    }
+
+    constexpr uint8_t noLocalIndex = 0xFF;
+    static_assert(MaxVertices < noLocalIndex);
+
+    MeshletData data;
+    std::vector<uint8_t> localIndices(vertexCount, noLocalIndex);
+    Meshlet current = {};
+
+    const auto flush = [&]()
+    {
+        if (current.primitiveCount == 0) return;
+
+        data.bounds.push_back(ComputeMeshletBounds(data, current, positions, windingSign));
+        data.meshlets.push_back(current);
+        for (uint32_t i = 0; i < current.vertexCount; i++)
+        {
+            localIndices[data.vertexIndices[current.vertexOffset + i]] = noLocalIndex;
+        }
+        current = { static_cast<uint32_t>(data.vertexIndices.size()), 0, static_cast<uint32_t>(data.primitives.size()), 0 };
+    };
+
+    const auto toLocal = [&](uint32_t index) -> uint32_t
+    {
+        if (localIndices[index] == noLocalIndex)
+        {
+            localIndices[index] = static_cast<uint8_t>(current.vertexCount++);
+            data.vertexIndices.push_back(index);
+        }
+        return localIndices[index];
+    };
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const uint32_t newVertices = (localIndices[indices[i + 0]] == noLocalIndex)
+            + (localIndices[indices[i + 1]] == noLocalIndex)
+            + (localIndices[indices[i + 2]] == noLocalIndex);
+        if (current.vertexCount + newVertices > MaxVertices || current.primitiveCount + 1 > MaxPrimitives)
+            flush();
+
+        const uint32_t a = toLocal(indices[i + 0]);
+        const uint32_t b = toLocal(indices[i + 1]);
+        const uint32_t c = toLocal(indices[i + 2]);
+        data.primitives.push_back(a | (b << 8) | (c << 16));
+        current.primitiveCount++;
+    }
+    flush();
+
+    return data;
+}
+
+std::vector<uint8_t> MeshletData::Pack(uint32_t vertexCount, VertexFormat vertexFormat, const AABB& aabb) const
+{
+    MeshletBufferHeader header = {};
+    header.meshletCount = static_cast<uint32_t>(meshlets.size());
+    header.vertexCount = vertexCount;
+    header.vertexFormat = vertexFormat;
+    memcpy(header.positionOffset, &aabb.min, sizeof(glm::vec3));
+    const glm::vec3 extent = aabb.max - aabb.min;
+    memcpy(header.positionScale, &extent, sizeof(glm::vec3));
+    header.meshletsOffset = sizeof(MeshletBufferHeader);
+    header.boundsOffset = header.meshletsOffset + static_cast<uint32_t>(meshlets.size() * sizeof(Meshlet));
+    header.vertexIndicesOffset = header.boundsOffset + static_cast<uint32_t>(bounds.size() * sizeof(MeshletBounds));
+    header.primitivesOffset = header.vertexIndicesOffset + static_cast<uint32_t>(vertexIndices.size() * sizeof(uint32_t));
+
+    std::vector<uint8_t> packed(header.primitivesOffset + primitives.size() * sizeof(uint32_t));
+    memcpy(packed.data(), &header, sizeof(header));
+    memcpy(packed.data() + header.meshletsOffset, meshlets.data(), meshlets.size() * sizeof(Meshlet));
+    memcpy(packed.data() + header.boundsOffset, bounds.data(), bounds.size() * sizeof(MeshletBounds));
+    memcpy(packed.data() + header.vertexIndicesOffset, vertexIndices.data(), vertexIndices.size() * sizeof(uint32_t));
+    memcpy(packed.data() + header.primitivesOffset, primitives.data(), primitives.size() * sizeof(uint32_t));
+    return packed;
 }
 
 static std::string GetTexture(aiMaterial* mat, aiTextureType type)
@@ -19,113 +194,227 @@ static std::string GetTexture(aiMaterial* mat, aiTextureType type)
     return "";
 }
 
-std::shared_ptr<Mesh> Mesh::From(Application& app, aiMesh* mesh, const aiScene* scene, const std::filesystem::path& modelPath)
+MeshImport Mesh::Import(const aiMesh* mesh, const aiScene* scene, bool buildMeshlets, VertexFormat vertexFormat)
 {
-    vg::Device device = app.GetDevice();
-    vg::BufferDesc bufferDesc = { mesh->mNumVertices * sizeof(Vertex) + mesh->mNumFaces * 3 * sizeof(uint32_t),
-        vg::BufferUsage::General, vg::HeapType::Upload};
-    vg::Buffer uploadBuffer;
-    if (device.CreateBuffer(&bufferDesc, &uploadBuffer) != vg::Result::Success)
+    MeshImport meshImport;
+    meshImport.mesh = mesh;
+    meshImport.vertexFormat = vertexFormat;
+    meshImport.aabb = {
+        { mesh->mAABB.mMin.x, mesh->mAABB.mMin.y, mesh->mAABB.mMin.z },
+        { mesh->mAABB.mMax.x, mesh->mAABB.mMax.y, mesh->mAABB.mMax.z }
+    };
+
+    meshImport.indices.resize(mesh->mNumFaces * 3);
+    for (uint32_t i = 0; i < mesh->mNumFaces; i++)
     {
-        std::cerr << "Unable to create upload buffer for mesh\n";
-        return nullptr;
+        meshImport.indices[i * 3 + 0] = mesh->mFaces[i].mIndices[0];
+        meshImport.indices[i * 3 + 1] = mesh->mFaces[i].mIndices[1];
+        meshImport.indices[i * 3 + 2] = mesh->mFaces[i].mIndices[2];
     }
 
-    bufferDesc.heapType = vg::HeapType::Gpu;
-    vg::Buffer vertexBuffer;
-    if (device.CreateBuffer(&bufferDesc, &vertexBuffer) != vg::Result::Success)
+    if (buildMeshlets)
     {
-        std::cerr << "Unable to create vertex buffer for mesh\n";
-        device.DestroyBuffer(uploadBuffer);
-        return nullptr;
+        auto meshlets = MeshletData::Build(mesh->mVertices, mesh->HasNormals() ? mesh->mNormals : nullptr, meshImport.indices, mesh->mNumVertices);
+        meshImport.meshletCount = static_cast<uint32_t>(meshlets.meshlets.size());
+        meshImport.meshletData = meshlets.Pack(mesh->mNumVertices, vertexFormat, meshImport.aabb);
     }
 
-    vertexBuffer.SetName((std::string(mesh->mName.C_Str()) + " | Vertex+Index").c_str());
+    if (mesh->mMaterialIndex >= 0)
+    {
+        auto aiMaterial = scene->mMaterials[mesh->mMaterialIndex];
 
-    std::vector<float> uvs(mesh->mNumVertices * 2);
-    if (mesh->HasTextureCoords(0))
+        int twoSided = 0;
+        if (aiMaterial->Get(AI_MATKEY_TWOSIDED, meshImport.material.twoSided) == aiReturn_SUCCESS && twoSided != 0)
+            meshImport.material.twoSided = true;
+
+        meshImport.material.baseColor = GetTexture(aiMaterial, aiTextureType_DIFFUSE);
+        if (meshImport.material.baseColor.empty())
+            meshImport.material.baseColor = GetTexture(aiMaterial, aiTextureType_BASE_COLOR);
+
+        meshImport.material.specular = GetTexture(aiMaterial, aiTextureType_SPECULAR);
+
+        meshImport.material.normal = GetTexture(aiMaterial, aiTextureType_NORMALS);
+    }
+
+    return meshImport;
+}
+
+static void OctahedralEncode(const aiVector3D& v, int8_t* out)
+{
+    const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (l1 == 0.0f)
     {
-        for (uint32_t i = 0; i < mesh->mNumVertices; i++)
-        {
-            uvs[i * 2 + 0] = mesh->mTextureCoords[0][i].x;
-            uvs[i * 2 + 1] = mesh->mTextureCoords[0][i].y;
-        }
+        out[0] = out[1] = 0;
+        return;
     }
-    else
+
+    float x = v.x / l1;
+    float y = v.y / l1;
+    if (v.z < 0.0f)
     {
-        memset(uvs.data(), 0, sizeof(float) * uvs.size());
+        const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
     }
+    out[0] = static_cast<int8_t>(std::round(std::clamp(x, -1.0f, 1.0f) * 127.0f));
+    out[1] = static_cast<int8_t>(std::round(std::clamp(y, -1.0f, 1.0f) * 127.0f));
+}
 
-    std::vector<uint32_t> indices(mesh->mNumFaces * 3);
-    for (uint32_t i = 0; i < mesh->mNumFaces; i++)
+static void WritePackedVertices(const aiMesh* mesh, const AABB& aabb, PackedVertex* vertices)
+{
+    const glm::vec3 extent = aabb.max - aabb.min;
+    const glm::vec3 invExtent = {
+        extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+        extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+        extent.z > 0.0f ? 1.0f / extent.z : 0.0f
+    };
+
+    for (uint32_t i = 0; i < mesh->mNumVertices; i++)
     {
-        indices[i * 3 + 0] = mesh->mFaces[i].mIndices[0];
-        indices[i * 3 + 1] = mesh->mFaces[i].mIndices[1];
-        indices[i * 3 + 2] = mesh->mFaces[i].mIndices[2];
+        PackedVertex& vertex = vertices[i];
+
+        const auto& p = mesh->mVertices[i];
+        const glm::vec3 unorm = glm::clamp((glm::vec3(p.x, p.y, p.z) - aabb.min) * invExtent, 0.0f, 1.0f);
+        vertex.position[0] = static_cast<uint16_t>(std::round(unorm.x * 65535.0f));
+        vertex.position[1] = static_cast<uint16_t>(std::round(unorm.y * 65535.0f));
+        vertex.position[2] = static_cast<uint16_t>(std::round(unorm.z * 65535.0f));
+        vertex.position[3] = 0;
+
+        OctahedralEncode(mesh->HasNormals() ? mesh->mNormals[i] : aiVector3D(0.0f), vertex.normalTangent);
+        OctahedralEncode(mesh->HasTangentsAndBitangents() ? mesh->mTangents[i] : aiVector3D(0.0f), vertex.normalTangent + 2);
+
+        const auto uv = mesh->HasTextureCoords(0) ? mesh->mTextureCoords[0][i] : aiVector3D(0.0f);
+        vertex.uv[0] = glm::packHalf1x16(uv.x);
+        vertex.uv[1] = glm::packHalf1x16(uv.y);
     }
-    void* mapped = nullptr;
-    if (uploadBuffer.Map(&mapped) != vg::Result::Success)
+}
+
+void MeshImport::WriteUploadData(void* dst) const
+{
+    auto mapped = static_cast<uint8_t*>(dst);
+    const uint32_t numVertices = mesh->mNumVertices;
+
+    if (vertexFormat == VertexFormat::Compressed)
     {
-        std::cerr << "Unable to upload data for mesh\n";
-        device.DestroyBuffer(uploadBuffer);
-        device.DestroyBuffer(vertexBuffer);
-        return nullptr;
+        WritePackedVertices(mesh, aabb, reinterpret_cast<PackedVertex*>(mapped));
+        memcpy(mapped + numVertices * sizeof(PackedVertex), indices.data(), indices.size() * sizeof(uint32_t));
+        if (!meshletData.empty())
+            memcpy(mapped + VertexDataSize(), meshletData.data(), meshletData.size());
+        return;
     }
-    memcpy(mapped, mesh->mVertices, mesh->mNumVertices * sizeof(float) * 3);
+
+    memcpy(mapped, mesh->mVertices, numVertices * sizeof(float) * 3);
     if (mesh->HasNormals())
-        memcpy(static_cast<uint8_t*>(mapped) + sizeof(float) * 3 * mesh->mNumVertices, mesh->mNormals, mesh->mNumVertices * sizeof(float) * 3);
+        memcpy(mapped + sizeof(float) * 3 * numVertices, mesh->mNormals, numVertices * sizeof(float) * 3);
+    else
+        memset(mapped + sizeof(float) * 3 * numVertices, 0, numVertices * sizeof(float) * 3);
     if (mesh->HasTangentsAndBitangents())
-        memcpy(static_cast<uint8_t*>(mapped) + sizeof(float) * 6 * mesh->mNumVertices, mesh->mTangents, mesh->mNumVertices * sizeof(float) * 3);
+        memcpy(mapped + sizeof(float) * 6 * numVertices, mesh->mTangents, numVertices * sizeof(float) * 3);
+    else
+        memset(mapped + sizeof(float) * 6 * numVertices, 0, numVertices * sizeof(float) * 3);
+
+    auto uvs = reinterpret_cast<float*>(mapped + sizeof(float) * 9 * numVertices);
     if (mesh->HasTextureCoords(0))
-        memcpy(static_cast<uint8_t*>(mapped) + sizeof(float) * 9 * mesh->mNumVertices, uvs.data(), mesh->mNumVertices * sizeof(float) * 2);
-    memcpy(static_cast<uint8_t*>(mapped) + mesh->mNumVertices * sizeof(Vertex), indices.data(), indices.size() * sizeof(uint32_t));
-    uploadBuffer.Unmap();
-    
-    app.SubmitImmediately([&](vg::CommandList cmd)
     {
-        cmd.CopyBufferToBuffer(vertexBuffer, 0, uploadBuffer, 0, VG_WHOLE_SIZE);
-    });
-
-    Material material;
-    if (mesh->mMaterialIndex >= 0)
+        for (uint32_t i = 0; i < numVertices; i++)
+        {
+            uvs[i * 2 + 0] = mesh->mTextureCoords[0][i].x;
+            uvs[i * 2 + 1] = mesh->mTextureCoords[0][i].y;
+        }
+    }
+    else
     {
-        auto aiMaterial = scene->mMaterials[mesh->mMaterialIndex];
+        memset(uvs, 0, numVertices * sizeof(float) * 2);
+    }
 
-        int twoSided = 0;
-        if (aiMaterial->Get(AI_MATKEY_TWOSIDED, material.twoSided) == aiReturn_SUCCESS && twoSided != 0)
-            material.twoSided = true;
+    memcpy(mapped + numVertices * sizeof(Vertex), indices.data(), indices.size() * sizeof(uint32_t));
+    if (!meshletData.empty())
+        memcpy(mapped + VertexDataSize(), meshletData.data(), meshletData.size());
+}
 
-        material.baseColor = GetTexture(aiMaterial, aiTextureType_DIFFUSE);
-        if (material.baseColor.empty())
-            material.baseColor = GetTexture(aiMaterial, aiTextureType_BASE_COLOR);
+std::shared_ptr<Mesh> Mesh::Create(Application& app, const MeshImport& meshImport, std::shared_ptr<Texture> baseColor)
+{
+    vg::Device device = app.GetDevice();
+    vg::BufferDesc bufferDesc = { meshImport.VertexDataSize(), vg::BufferUsage::General, vg::HeapType::Gpu };
+    vg::Buffer vertexBuffer;
+    if (device.CreateBuffer(&bufferDesc, &vertexBuffer) != vg::Result::Success)
+    {
+        std::cerr << "Unable to create vertex buffer for mesh\n";
+        return nullptr;
+    }
 
-        material.specular = GetTexture(aiMaterial, aiTextureType_SPECULAR);
+    vertexBuffer.SetName((std::string(meshImport.mesh->mName.C_Str()) + " | Vertex+Index").c_str());
 
-        material.normal = GetTexture(aiMaterial, aiTextureType_NORMALS);
+    vg::Buffer meshletBuffer = nullptr;
+    if (!meshImport.meshletData.empty())
+    {
+        bufferDesc.size = meshImport.meshletData.size();
+        if (device.CreateBuffer(&bufferDesc, &meshletBuffer) != vg::Result::Success)
+        {
+            std::cerr << "Unable to create meshlet buffer for mesh\n";
+            device.DestroyBuffer(vertexBuffer);
+            return nullptr;
+        }
+        meshletBuffer.SetName((std::string(meshImport.mesh->mName.C_Str()) + " | Meshlets").c_str());
     }
 
-    auto baseColor = Texture::From(app, modelPath.parent_path() / material.baseColor);
-    if (baseColor.has_value()) material.baseColorTexture = baseColor.value();
+    Material material = meshImport.material;
+    material.baseColorTexture = baseColor;
 
-    AABB aabb = {
-        { mesh->mAABB.mMin.x, mesh->mAABB.mMin.y, mesh->mAABB.mMin.z },
-        { mesh->mAABB.mMax.x, mesh->mAABB.mMax.y, mesh->mAABB.mMax.z }
-    };
+    return std::shared_ptr<Mesh>(new Mesh(meshImport.mesh->mName.C_Str(), vertexBuffer, static_cast<uint32_t>(meshImport.indices.size()),
+        meshImport.aabb, meshImport.vertexFormat, material, meshletBuffer, meshImport.meshletCount));
+}
 
-    device.DestroyBuffer(uploadBuffer);
-    return std::shared_ptr<Mesh>(new Mesh(mesh->mName.C_Str(), vertexBuffer, mesh->mNumFaces * 3, aabb, material));
+void Mesh::RecordUpload(vg::CommandList cmd, vg::Buffer uploadBuffer, uint64_t offset) const
+{
+    const uint64_t vertexDataSize = _indexOffset + sizeof(uint32_t) * _indexCount;
+    cmd.CopyBufferToBuffer(_vertexBuffer, 0, uploadBuffer, offset, vertexDataSize);
+    if (_meshletBuffer)
+    {
+        vg::BufferDesc desc;
+        _meshletBuffer.GetDesc(&desc);
+        cmd.CopyBufferToBuffer(_meshletBuffer, 0, uploadBuffer, offset + vertexDataSize, desc.size);
+    }
 }
 
-Mesh::Mesh(std::string_view name, vg::Buffer vertexBuffer, uint32_t indexCount, const AABB& aabb, const Material& material)
-    : _name(name), _vertexBuffer(vertexBuffer), _indexCount(indexCount), _material(material), _aabb(aabb)
+Mesh::Mesh(std::string_view name, vg::Buffer vertexBuffer, uint32_t indexCount, const AABB& aabb, VertexFormat vertexFormat,
+    const Material& material, vg::Buffer meshletBuffer, uint32_t meshletCount)
+    : _name(name), _vertexBuffer(vertexBuffer), _indexCount(indexCount), _material(material), _aabb(aabb), _vertexFormat(vertexFormat),
+    _meshletBuffer(meshletBuffer), _meshletCount(meshletCount), _meshletsView(VG_NO_VIEW), _verticesView(VG_NO_VIEW)
 {
     vg::BufferDesc desc;
     vertexBuffer.GetDesc(&desc);
     _indexOffset = desc.size - sizeof(uint32_t) * indexCount;
-    _vertexCount = _indexOffset / sizeof(Vertex);
+    _vertexCount = _indexOffset / GetVertexStride(vertexFormat);
+
+    if (vertexFormat == VertexFormat::Compressed)
+    {
+        _packedVB = vg::VertexBufferView { _vertexBuffer, 0, sizeof(PackedVertex) };
+    }
+    else
+    {
+        _positionsVB = vg::VertexBufferView { _vertexBuffer, 0, sizeof(float) * 3 };
+        _normalsVB = vg::VertexBufferView { _vertexBuffer, _vertexCount * sizeof(float) * 3, sizeof(float) * 3 };
+        _tangentsVB = vg::VertexBufferView { _vertexBuffer, _normalsVB.offset + _vertexCount * sizeof(float) * 3, sizeof(float) * 3 };
+        _uvsVB = vg::VertexBufferView { _vertexBuffer, _tangentsVB.offset + _vertexCount * sizeof(float) * 3, sizeof(float) * 2 };
+    }
 
-    _positionsVB = vg::VertexBufferView { _vertexBuffer, 0, sizeof(float) * 3 };
-    _normalsVB = vg::VertexBufferView { _vertexBuffer, _vertexCount * sizeof(float) * 3, sizeof(float) * 3 };
-    _tangentsVB = vg::VertexBufferView { _vertexBuffer, _normalsVB.offset + _vertexCount * sizeof(float) * 3, sizeof(float) * 3 };
-    _uvsVB = vg::VertexBufferView { _vertexBuffer, _tangentsVB.offset + _vertexCount * sizeof(float) * 3, sizeof(float) * 2 };
-}
\ No newline at end of file
+    if (_meshletBuffer)
+    {
+        vg::BufferViewDesc viewDesc = { vg::BufferDescriptorType::Srv, vg::BufferViewType::ByteAddressBuffer, vg::Format::Unknown,
+            0, _indexOffset, 0 };
+        vgCheck(_vertexBuffer.CreateView(&viewDesc, &_verticesView));
+
+        vg::BufferDesc meshletDesc;
+        _meshletBuffer.GetDesc(&meshletDesc);
+        viewDesc.size = meshletDesc.size;
+        vgCheck(_meshletBuffer.CreateView(&viewDesc, &_meshletsView));
+    }
+}
+
+glm::mat4 Mesh::GetDequantizationMatrix() const
+{
+    if (_vertexFormat != VertexFormat::Compressed) return glm::mat4(1.0f);
+    return glm::scale(glm::translate(glm::mat4(1.0f), _aabb.min), _aabb.max - _aabb.min);
+}
@@ -4,6 +4,64 @@
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <functional>
+#include <unordered_map>
+
+// Staging memory allocated at once while uploading a model
+static constexpr uint64_t UploadBatchSize = 256ull * 1024 * 1024;
+// Covers D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+static constexpr uint64_t UploadAlignment = 512;
+
+struct UploadItem
+{
+	uint64_t size;
+	std::function<void(void*)> write;
+	std::function<void(vg::CommandList, vg::Buffer, uint64_t)> record;
+};
+
+// Fills staging memory on the thread pool and records all copies of a batch into one submission
+static void UploadBatched(Application& app, const std::vector<UploadItem>& items)
+{
+	vg::Device device = app.GetDevice();
+
+	size_t first = 0;
+	while (first < items.size())
+	{
+		std::vector<uint64_t> offsets;
+		uint64_t batchSize = 0;
+		size_t last = first;
+		for (; last < items.size(); last++)
+		{
+			uint64_t offset = (batchSize + UploadAlignment - 1) & ~(UploadAlignment - 1);
+			// Single item bigger than the budget still gets its own batch
+			if (last != first && offset + items[last].size > UploadBatchSize) break;
+			offsets.push_back(offset);
+			batchSize = offset + items[last].size;
+		}
+
+		vg::BufferDesc bufferDesc = { batchSize, vg::BufferUsage::General, vg::HeapType::Upload };
+		vg::Buffer uploadBuffer;
+		vgCheck(device.CreateBuffer(&bufferDesc, &uploadBuffer));
+		uploadBuffer.SetName("Model upload");
+
+		void* mapped;
+		vgCheck(uploadBuffer.Map(&mapped));
+		app.GetThreadPool().ParallelFor(last - first, [&](size_t i)
+		{
+			items[first + i].write(static_cast<uint8_t*>(mapped) + offsets[i]);
+		});
+		uploadBuffer.Unmap();
+
+		app.SubmitImmediately([&](vg::CommandList cmd)
+		{
+			for (size_t i = first; i < last; i++)
+				items[i].record(cmd, uploadBuffer, offsets[i - first]);
+		});
+
+		device.DestroyBuffer(uploadBuffer);
+		first = last;
+	}
+}
 
 std::optional<std::shared_ptr<Model>> Model::From(Application& app, const std::filesystem::path& path)
 {
@@ -18,22 +76,80 @@ std::optional<std::shared_ptr<Model>> Model::From(Application& app, const std::f
 		std::cerr << "Assimp failed to load model: " << importer.GetErrorString() << std::endl;
 		return {};
 	}
+
+	// CPU work (index/meshlet building, DDS parsing) runs on the thread pool, device calls stay on this thread
+	auto& threadPool = app.GetThreadPool();
+	const bool buildMeshlets = app.MeshShadersSupported();
+	const VertexFormat vertexFormat = app.GetVertexFormat();
+
+	std::vector<MeshImport> meshImports(scene->mNumMeshes);
+	threadPool.ParallelFor(scene->mNumMeshes, [&](size_t i)
+	{
+		meshImports[i] = Mesh::Import(scene->mMeshes[i], scene, buildMeshlets, vertexFormat);
+	});
+
+	// Meshes sharing a texture now share one GPU texture
+	std::vector<std::string> texturePaths;
+	std::unordered_map<std::string, size_t> textureIndices;
+	for (const auto& meshImport : meshImports)
+	{
+		if (meshImport.material.baseColor.empty()) continue;
+		auto texturePath = (path.parent_path() / meshImport.material.baseColor).generic_string();
+		if (textureIndices.emplace(texturePath, texturePaths.size()).second)
+			texturePaths.push_back(texturePath);
+	}
+
+	std::vector<std::optional<TextureImport>> textureImports(texturePaths.size());
+	threadPool.ParallelFor(texturePaths.size(), [&](size_t i)
+	{
+		textureImports[i] = Texture::Import(texturePaths[i]);
+	});
+
+	std::vector<UploadItem> uploads;
+	std::vector<std::shared_ptr<Texture>> textures(texturePaths.size());
+	for (size_t i = 0; i < textureImports.size(); i++)
+	{
+		if (!textureImports[i]) continue;
+		textures[i] = Texture::Create(app, *textureImports[i]);
+		if (!textures[i]) continue;
+
+		const auto& textureImport = *textureImports[i];
+		auto texture = textures[i];
+		uploads.push_back({ textureImport.uploadSize,
+			[&textureImport](void* dst) { textureImport.WriteUploadData(dst); },
+			[&textureImport, texture](vg::CommandList cmd, vg::Buffer buffer, uint64_t offset)
+			{
+				texture->RecordUpload(cmd, textureImport, buffer, offset);
+			} });
+	}
+
 	uint32_t totalVertices = 0;
 	std::vector<std::shared_ptr<Mesh>> meshes;
-	for (uint32_t i = 0; i < scene->mNumMeshes; i++)
+	for (const auto& meshImport : meshImports)
 	{
-		std::cout << "Mesh " << i + 1 << "/" << scene->mNumMeshes << "\n";
-		auto mesh = Mesh::From(app, scene->mMeshes[i], scene, path);
+		std::shared_ptr<Texture> baseColor;
+		if (!meshImport.material.baseColor.empty())
+			baseColor = textures[textureIndices[(path.parent_path() / meshImport.material.baseColor).generic_string()]];
+
+		auto mesh = Mesh::Create(app, meshImport, baseColor);
+		if (!mesh) continue;
+
+		uploads.push_back({ meshImport.UploadSize(),
+			[&meshImport](void* dst) { meshImport.WriteUploadData(dst); },
+			[mesh](vg::CommandList cmd, vg::Buffer buffer, uint64_t offset) { mesh->RecordUpload(cmd, buffer, offset); } });
+
 		totalVertices += mesh->GetVertexCount();
 		meshes.push_back(mesh);
 	}
 
+	UploadBatched(app, uploads);
+
 	std::sort(meshes.begin(), meshes.end(), [](const auto& a, const auto& b)
 	{
 		return a->GetMaterial().twoSided > b->GetMaterial().twoSided;
 	});
 
-	std::cout << "Total: " << totalVertices << " vertices\n";
+	std::cout << "Total: " << meshes.size() << " meshes, " << textures.size() << " textures, " << totalVertices << " vertices\n";
 	return std::shared_ptr<Model>(new Model(meshes));
 }
 
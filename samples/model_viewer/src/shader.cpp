@@ -1,116 +1,51 @@
 #include "shader.h"
+#include "shader_bundle.h"
+#include "shader_permutations.h"
 #include "mesh.h"
 #include "application.h"
 
-#if _WIN32
-#  define WIN32_LEAN_AND_MEAN
-#  define NOMINMAX
-#  include <Windows.h>
-#  include <wrl.h>
-#  include <unknwn.h>
-template <class T>
-using ComPtr = Microsoft::WRL::ComPtr<T>;
-#else
-#include "WinAdapter.h"
-template <class T>
-using ComPtr = CComPtr<T>;
+#if !MV_SHADER_BUNDLE_ONLY
+#include "shader_compiler.h"
 #endif
 
-#include <dxcapi.h>
-
-#include <fstream>
-
-struct DxcInstance
+// Stage binaries of a pipeline in PipelinePermutation::stages order. Taken from shaders.bundle when it holds
+// the permutation, otherwise compiled with DXC through the shader cache.
+static std::vector<std::vector<uint8_t>> LoadPipelineStages(std::string_view name, bool spirv)
 {
-	ComPtr<IDxcLibrary> Library;
-	ComPtr<IDxcCompiler> Compiler;
-	ComPtr<IDxcIncludeHandler> IncludeHandler;
+	static const auto bundle = ShaderBundle::Open("shaders.bundle");
 
-	DxcInstance()
-	{
-		DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&Library));
-		DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&Compiler));
-		Library->CreateIncludeHandler(&IncludeHandler);
-	}
+	const auto* permutation = FindPipelinePermutation(name);
+	if (!permutation) throw std::runtime_error("Unknown pipeline permutation " + std::string(name));
 
-	~DxcInstance()
+	std::vector<std::vector<uint8_t>> stages;
+	const auto* pipeline = bundle ? bundle->FindPipeline(ShaderBundle::PipelineKey(name)) : nullptr;
+	if (pipeline && pipeline->numStages == permutation->numStages)
 	{
-	}
-};
-
-static std::vector<uint8_t> CompileShader(std::wstring_view path, std::wstring_view profile, std::wstring_view entryPoint, bool spirv = false)
-{
-	static DxcInstance dxc;
-
-	std::ifstream shaderFile(path.data(), std::ios::binary);
-	if (!shaderFile.is_open()) {
-		std::wcerr << L"Path: " << path << L"\n";
-		throw std::runtime_error("Cannot open shader on path");
-	}
-	std::string shaderSource((std::istreambuf_iterator<char>(shaderFile)), std::istreambuf_iterator<char>());
-	ComPtr<IDxcBlobEncoding> sourceBlob;
-	if (FAILED(dxc.Library->CreateBlobWithEncodingFromPinned((LPBYTE)shaderSource.data(),
-		(UINT32)shaderSource.size(), CP_UTF8, &sourceBlob))) {
-		std::wcerr << L"Path: " << path << "L\n";
-		throw std::runtime_error("Failed to create source blob");
-	}
-
-	std::filesystem::path shaderFilePath(path);
-	std::wstring includeDir = shaderFilePath.parent_path().wstring();
-
-	// Define compiler arguments
-	std::vector<LPCWSTR> arguments = {
-		path.data(),
-		L"-E", entryPoint.data(),
-		L"-T", profile.data(),
-		L"-I", includeDir.c_str(),
-		L"-Qstrip_reflect",      // Strip reflection data
-		L"-Qstrip_debug"         // Strip debug information
-	};
-	if (spirv)
-	{
-		arguments.push_back(L"-spirv");
-		// otherwise SV_InstanceID will become gl_InstanceIndex with different behavior
-		arguments.push_back(L"-fvk-support-nonzero-base-instance");
-		arguments.push_back(L"-fvk-bind-resource-heap");
-		arguments.push_back(L"0");
-		arguments.push_back(L"0");
-		arguments.push_back(L"-fvk-bind-counter-heap");
-		arguments.push_back(L"1");
-		arguments.push_back(L"0");
-		arguments.push_back(L"-fvk-bind-sampler-heap");
-		arguments.push_back(L"2");
-		arguments.push_back(L"0");
-	}
-
-	ComPtr<IDxcOperationResult> result;
-	if (FAILED(dxc.Compiler->Compile(sourceBlob.Get(), path.data(), entryPoint.data(), profile.data(),
-		arguments.data(), (UINT)arguments.size(), nullptr, 0, dxc.IncludeHandler.Get(), &result))) {
-		std::wcerr << L"Path: " << path << "\n";
-		throw std::runtime_error("Shader compilation failed");
-	}
-
-	HRESULT hrStatus;
-	if (FAILED(result->GetStatus(&hrStatus)) || FAILED(hrStatus)) {
-		ComPtr<IDxcBlobEncoding> errorBlob;
-		if (SUCCEEDED(result->GetErrorBuffer(&errorBlob))) {
-			std::wcerr << L"Shader compilation errors:\n"
-				<< (const char*)errorBlob->GetBufferPointer() << std::endl;
+		const auto target = static_cast<uint32_t>(spirv ? ShaderTarget::Spirv : ShaderTarget::Dxil);
+		for (uint32_t i = 0; i < pipeline->numStages; i++)
+		{
+			const auto binary = bundle->FindShader(pipeline->stages[target][i]);
+			if (binary.empty()) break;
+			stages.emplace_back(binary.begin(), binary.end());
 		}
-		throw std::runtime_error("<=================>");
+		if (stages.size() == pipeline->numStages) return stages;
+		stages.clear();
 	}
 
-	ComPtr<IDxcBlob> shaderBlob;
-	if (FAILED(result->GetResult(&shaderBlob))) {
-		throw std::runtime_error("Failed to retrieve compiled shader");
+#if MV_SHADER_BUNDLE_ONLY
+	throw std::runtime_error("Pipeline " + std::string(name) + " is missing from shaders.bundle");
+#else
+	static ShaderCache cache("shader_cache");
+	const std::wstring file(permutation->file.begin(), permutation->file.end());
+	for (uint32_t i = 0; i < permutation->numStages; i++)
+	{
+		const auto& stage = permutation->stages[i];
+		const std::wstring profile(stage.profile.begin(), stage.profile.end());
+		const std::wstring entryPoint(stage.entryPoint.begin(), stage.entryPoint.end());
+		stages.push_back(CompileShader(file, profile, entryPoint, spirv, &cache));
 	}
-
-	std::vector<uint8_t> shader;
-	shader.assign(
-		(uint8_t*)shaderBlob->GetBufferPointer(),
-		(uint8_t*)shaderBlob->GetBufferPointer() + shaderBlob->GetBufferSize()
-	);
-	return shader;
+	return stages;
+#endif
 }
 
 MeshShader::~MeshShader()
@@ -125,7 +60,7 @@ MeshShader::~MeshShader()
 	}
 }
 
-std::shared_ptr<MeshShader> MeshShader::From(Application& app, const std::filesystem::path& path)
+std::shared_ptr<MeshShader> MeshShader::From(Application& app, const std::filesystem::path& path, VertexFormat vertexFormat)
 {
 	vg::SwapChainDesc swapChainDesc;
 	if (app.GetSwapChain().GetDesc(&swapChainDesc) != vg::Result::Success) return nullptr;
@@ -135,32 +70,44 @@ std::shared_ptr<MeshShader> MeshShader::From(Application& app, const std::filesy
 	device.GetGraphicsApi(&api);
 	bool spirv = api == vg::GraphicsApi::Vulkan;
 
-	auto shaderModule = CompileShader(path.generic_wstring(), L"vs_6_6", L"Vertex", spirv);
+	const bool compressed = vertexFormat == VertexFormat::Compressed;
+	const auto stages = LoadPipelineStages(path.stem().generic_string() + (compressed ? "Packed" : ""), spirv);
 	vg::ShaderModule vertexShader;
-	if (device.CreateShaderModule(shaderModule.data(), shaderModule.size(), &vertexShader) != vg::Result::Success)
+	if (device.CreateShaderModule(stages[0].data(), stages[0].size(), &vertexShader) != vg::Result::Success)
 	{
 		std::cerr << "Unable to create vertex shader " << path.generic_string() << "\n";
 		return nullptr;
 	}
-	shaderModule = CompileShader(path.generic_wstring(), L"ps_6_6", L"Pixel", spirv);
 	vg::ShaderModule pixelShader;
-	if (device.CreateShaderModule(shaderModule.data(), shaderModule.size(), &pixelShader) != vg::Result::Success)
+	if (device.CreateShaderModule(stages[1].data(), stages[1].size(), &pixelShader) != vg::Result::Success)
 	{
 		std::cerr << "Unable to create pixel shader " << path.generic_string() << "\n";
 		device.DestroyShaderModule(vertexShader);
 		return nullptr;
 	}
 
-	std::array<vg::VertexAttribute, 4> attributes =
+	std::vector<vg::VertexAttribute> attributes;
+	if (compressed)
 	{
-		vg::VertexAttribute { vg::Format::R32g32b32Float, 0, 0, vg::AttributeInputRate::Vertex, 0 },
-		vg::VertexAttribute { vg::Format::R32g32b32Float, 0, 1, vg::AttributeInputRate::Vertex, 0 },
-		vg::VertexAttribute { vg::Format::R32g32b32Float, 0, 2, vg::AttributeInputRate::Vertex, 0 },
-		vg::VertexAttribute { vg::Format::R32g32Float, 0, 3, vg::AttributeInputRate::Vertex, 0 },
-	};
+		// Single PackedVertex stream
+		attributes = {
+			vg::VertexAttribute { vg::Format::R16g16b16a16Unorm, offsetof(PackedVertex, position), 0, vg::AttributeInputRate::Vertex, 0 },
+			vg::VertexAttribute { vg::Format::R8g8b8a8Snorm, offsetof(PackedVertex, normalTangent), 0, vg::AttributeInputRate::Vertex, 0 },
+			vg::VertexAttribute { vg::Format::R16g16Float, offsetof(PackedVertex, uv), 0, vg::AttributeInputRate::Vertex, 0 },
+		};
+	}
+	else
+	{
+		attributes = {
+			vg::VertexAttribute { vg::Format::R32g32b32Float, 0, 0, vg::AttributeInputRate::Vertex, 0 },
+			vg::VertexAttribute { vg::Format::R32g32b32Float, 0, 1, vg::AttributeInputRate::Vertex, 0 },
+			vg::VertexAttribute { vg::Format::R32g32b32Float, 0, 2, vg::AttributeInputRate::Vertex, 0 },
+			vg::VertexAttribute { vg::Format::R32g32Float, 0, 3, vg::AttributeInputRate::Vertex, 0 },
+		};
+	}
 	vg::GraphicsPipelineDesc pipelineDesc = {
 		vg::VertexPipeline::FixedFunction, vg::FixedFunctionState{
-			attributes.size(), attributes.data(), vertexShader, nullptr, nullptr, nullptr
+			static_cast<uint32_t>(attributes.size()), attributes.data(), vertexShader, nullptr, nullptr, nullptr
 		}, vg::MeshShaderState{}, pixelShader, vg::PrimitiveTopology::TriangleList, false, 0u,
 		vg::RasterizationState{vg::FillMode::Fill, vg::CullMode::Back, vg::FrontFace::Clockwise},
 		vg::MultisamplingState{vg::SampleCount::e1}, vg::DepthStencilState{true, true, vg::CompareOp::Less},
@@ -190,3 +137,73 @@ std::shared_ptr<MeshShader> MeshShader::From(Application& app, const std::filesy
 	device.DestroyShaderModule(pixelShader);
 	return std::shared_ptr<MeshShader>(new MeshShader(pipeline, pipelineTwoSided));
 }
+
+std::shared_ptr<MeshShader> MeshShader::FromMeshlets(Application& app, const std::filesystem::path& path)
+{
+	vg::SwapChainDesc swapChainDesc;
+	if (app.GetSwapChain().GetDesc(&swapChainDesc) != vg::Result::Success) return nullptr;
+	vg::GraphicsApi api;
+
+	auto device = app.GetDevice();
+	device.GetGraphicsApi(&api);
+	bool spirv = api == vg::GraphicsApi::Vulkan;
+
+	const auto stages = LoadPipelineStages(path.stem().generic_string(), spirv);
+	vg::ShaderModule amplificationShader;
+	if (device.CreateShaderModule(stages[0].data(), stages[0].size(), &amplificationShader) != vg::Result::Success)
+	{
+		std::cerr << "Unable to create amplification shader " << path.generic_string() << "\n";
+		return nullptr;
+	}
+	vg::ShaderModule meshShader;
+	if (device.CreateShaderModule(stages[1].data(), stages[1].size(), &meshShader) != vg::Result::Success)
+	{
+		std::cerr << "Unable to create mesh shader " << path.generic_string() << "\n";
+		device.DestroyShaderModule(amplificationShader);
+		return nullptr;
+	}
+	vg::ShaderModule pixelShader;
+	if (device.CreateShaderModule(stages[2].data(), stages[2].size(), &pixelShader) != vg::Result::Success)
+	{
+		std::cerr << "Unable to create pixel shader " << path.generic_string() << "\n";
+		device.DestroyShaderModule(amplificationShader);
+		device.DestroyShaderModule(meshShader);
+		return nullptr;
+	}
+
+	const auto destroyShaderModules = [&]()
+	{
+		device.DestroyShaderModule(amplificationShader);
+		device.DestroyShaderModule(meshShader);
+		device.DestroyShaderModule(pixelShader);
+	};
+
+	vg::GraphicsPipelineDesc pipelineDesc = {
+		vg::VertexPipeline::MeshShader, vg::FixedFunctionState{}, vg::MeshShaderState{ amplificationShader, meshShader },
+		pixelShader, vg::PrimitiveTopology::TriangleList, false, 0u,
+		vg::RasterizationState{vg::FillMode::Fill, vg::CullMode::Back, vg::FrontFace::Clockwise},
+		vg::MultisamplingState{vg::SampleCount::e1}, vg::DepthStencilState{true, true, vg::CompareOp::Less},
+		1u, {}, app.GetDepthBufferFormat(), vg::BlendState{false, vg::LogicOp::NoOp, {} }
+	};
+	pipelineDesc.colorAttachmentFormats[0] = swapChainDesc.format;
+	pipelineDesc.blendState.attachments[0] = { false, {}, {}, {}, {}, {}, {},
+		vg::ColorComponentFlags::R | vg::ColorComponentFlags::G | vg::ColorComponentFlags::B | vg::ColorComponentFlags::A };
+	float blendConstants[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	memcpy(pipelineDesc.blendState.blendConstants, blendConstants, sizeof(float) * 4);
+
+	vg::Pipeline pipeline;
+	if (device.CreateGraphicsPipeline(&pipelineDesc, &pipeline) != vg::Result::Success)
+	{
+		std::cerr << "Unable to create mesh shader pipeline\n";
+		destroyShaderModules();
+		return nullptr;
+	}
+
+	pipelineDesc.rasterizationState.cullMode = vg::CullMode::None;
+	vg::Pipeline pipelineTwoSided;
+	if (device.CreateGraphicsPipeline(&pipelineDesc, &pipelineTwoSided) != vg::Result::Success) pipelineTwoSided = pipeline;
+
+	pipeline.SetName(path.stem().generic_string().c_str());
+	destroyShaderModules();
+	return std::shared_ptr<MeshShader>(new MeshShader(pipeline, pipelineTwoSided));
+}
@@ -0,0 +1,100 @@
+#include "shader_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+std::shared_ptr<ShaderBundle> ShaderBundle::Open(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) return nullptr;
+
+	std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(data.data()), data.size()) || data.size() < sizeof(Header))
+	{
+		std::cerr << "Shader bundle " << path.generic_string() << " is truncated\n";
+		return nullptr;
+	}
+
+	Header header;
+	std::memcpy(&header, data.data(), sizeof(header));
+	const uint64_t tablesSize = sizeof(Header) + uint64_t(header.numShaders) * sizeof(ShaderEntry)
+		+ uint64_t(header.numPipelines) * sizeof(PipelineEntry);
+	if (header.magic != magic || header.version != version || tablesSize > data.size())
+	{
+		std::cerr << "Shader bundle " << path.generic_string() << " was written by another version, ignoring it\n";
+		return nullptr;
+	}
+
+	return std::shared_ptr<ShaderBundle>(new ShaderBundle(std::move(data)));
+}
+
+ShaderBundle::ShaderBundle(std::vector<uint8_t> data) : _data(std::move(data))
+{
+	Header header;
+	std::memcpy(&header, _data.data(), sizeof(header));
+	const auto* shaders = reinterpret_cast<const ShaderEntry*>(_data.data() + sizeof(Header));
+	_shaders = { shaders, header.numShaders };
+	_pipelines = { reinterpret_cast<const PipelineEntry*>(shaders + header.numShaders), header.numPipelines };
+}
+
+std::span<const uint8_t> ShaderBundle::FindShader(uint64_t key) const
+{
+	auto it = std::lower_bound(_shaders.begin(), _shaders.end(), key, [](const ShaderEntry& entry, uint64_t key) { return entry.key < key; });
+	if (it == _shaders.end() || it->key != key || it->offset + it->size > _data.size()) return {};
+	return { _data.data() + it->offset, it->size };
+}
+
+const ShaderBundle::PipelineEntry* ShaderBundle::FindPipeline(uint64_t key) const
+{
+	auto it = std::lower_bound(_pipelines.begin(), _pipelines.end(), key, [](const PipelineEntry& entry, uint64_t key) { return entry.key < key; });
+	return it != _pipelines.end() && it->key == key ? &*it : nullptr;
+}
+
+void ShaderBundle::Builder::AddShader(uint64_t key, std::vector<uint8_t> binary)
+{
+	// Stages shared between pipelines, such as a common pixel shader, are stored once
+	for (const auto& shader : _shaders)
+	{
+		if (shader.first == key) return;
+	}
+	_shaders.emplace_back(key, std::move(binary));
+}
+
+void ShaderBundle::Builder::AddPipeline(const PipelineEntry& pipeline)
+{
+	_pipelines.push_back(pipeline);
+}
+
+bool ShaderBundle::Builder::Write(const std::filesystem::path& path) const
+{
+	auto shaders = _shaders;
+	auto pipelines = _pipelines;
+	std::sort(shaders.begin(), shaders.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+	std::sort(pipelines.begin(), pipelines.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+
+	const Header header = { magic, version, static_cast<uint32_t>(shaders.size()), static_cast<uint32_t>(pipelines.size()) };
+	uint64_t offset = sizeof(Header) + shaders.size() * sizeof(ShaderEntry) + pipelines.size() * sizeof(PipelineEntry);
+	std::vector<ShaderEntry> entries;
+	for (const auto& [key, binary] : shaders)
+	{
+		entries.push_back({ key, offset, binary.size() });
+		// Keep binaries 8 byte aligned, SPIR-V is consumed as uint32_t words
+		offset += (binary.size() + 7) & ~uint64_t(7);
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) return false;
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ShaderEntry));
+	file.write(reinterpret_cast<const char*>(pipelines.data()), pipelines.size() * sizeof(PipelineEntry));
+	for (const auto& [key, binary] : shaders)
+	{
+		static constexpr char padding[8] = {};
+		file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+		file.write(padding, ((binary.size() + 7) & ~size_t(7)) - binary.size());
+	}
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,178 @@
+#include "shader_cache.h"
+
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace
+{
+	// Two independently seeded 64 bit lanes, wide enough that colliding keys are not a practical concern
+	class Hasher
+	{
+	public:
+		void Update(const void* data, size_t size)
+		{
+			const auto* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				_a = (_a ^ bytes[i]) * 0x100000001B3ull;
+				_b = (_b ^ bytes[i]) * 0x9E3779B97F4A7C15ull;
+			}
+		}
+
+		void Update(std::string_view str)
+		{
+			const uint64_t size = str.size();
+			Update(&size, sizeof(size));
+			Update(str.data(), str.size());
+		}
+
+		std::string Finish() const
+		{
+			static constexpr char digits[] = "0123456789abcdef";
+			std::string result;
+			for (uint64_t lane : { Mix(_a), Mix(_b ^ _a) })
+			{
+				for (int shift = 60; shift >= 0; shift -= 4) result.push_back(digits[(lane >> shift) & 0xF]);
+			}
+			return result;
+		}
+
+	private:
+		uint64_t _a{ 0xCBF29CE484222325ull };
+		uint64_t _b{ 0x84222325CBF29CE4ull };
+
+		static uint64_t Mix(uint64_t x)
+		{
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+			return x ^ (x >> 31);
+		}
+	};
+
+	std::optional<std::string> ReadFile(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open()) return std::nullopt;
+		return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	}
+
+	// Collects the targets of #include "..." lines. Includes inside inactive #if blocks are hashed as well,
+	// which only costs a spurious miss when such a file changes.
+	std::vector<std::string> FindIncludes(std::string_view source)
+	{
+		std::vector<std::string> includes;
+		size_t lineStart = 0;
+		while (lineStart < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string_view::npos) lineEnd = source.size();
+			auto line = source.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd + 1;
+
+			line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+			if (!line.starts_with('#')) continue;
+			line.remove_prefix(1);
+			line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+			if (!line.starts_with("include")) continue;
+
+			const auto open = line.find('"');
+			const auto close = open == std::string_view::npos ? open : line.find('"', open + 1);
+			if (close == std::string_view::npos) continue;
+			includes.emplace_back(line.substr(open + 1, close - open - 1));
+		}
+		return includes;
+	}
+
+	void HashIncludeClosure(Hasher& hasher, const std::filesystem::path& path, std::string_view source,
+		std::span<const std::filesystem::path> includeDirs, std::set<std::filesystem::path>& visited)
+	{
+		for (const auto& include : FindIncludes(source))
+		{
+			// Same lookup order as DXC: directory of the including file, then the -I directories
+			std::optional<std::string> content;
+			std::filesystem::path resolved = path.parent_path() / include;
+			content = ReadFile(resolved);
+			for (size_t i = 0; !content && i < includeDirs.size(); i++)
+			{
+				resolved = includeDirs[i] / include;
+				content = ReadFile(resolved);
+			}
+
+			hasher.Update(include);
+			if (!content)
+			{
+				// Let the compiler report the missing file, the key still changes once it appears
+				hasher.Update(std::string_view("<missing>"));
+				continue;
+			}
+			if (!visited.insert(std::filesystem::weakly_canonical(resolved)).second) continue;
+
+			hasher.Update(*content);
+			HashIncludeClosure(hasher, resolved, *content, includeDirs, visited);
+		}
+	}
+}
+
+ShaderCache::ShaderCache(std::filesystem::path directory) : _directory(std::move(directory))
+{
+	std::error_code error;
+	std::filesystem::create_directories(_directory, error);
+	if (error) std::cerr << "Shader cache: unable to create " << _directory.generic_string() << ", " << error.message() << "\n";
+}
+
+std::string ShaderCache::Key(const std::filesystem::path& path, std::span<const std::filesystem::path> includeDirs,
+	std::span<const std::wstring_view> arguments, std::string_view compilerVersion)
+{
+	Hasher hasher;
+	hasher.Update(compilerVersion);
+	for (auto argument : arguments)
+	{
+		const uint64_t size = argument.size();
+		hasher.Update(&size, sizeof(size));
+		hasher.Update(argument.data(), argument.size() * sizeof(wchar_t));
+	}
+
+	const auto source = ReadFile(path);
+	hasher.Update(source ? std::string_view(*source) : std::string_view("<missing>"));
+	if (source)
+	{
+		std::set<std::filesystem::path> visited = { std::filesystem::weakly_canonical(path) };
+		HashIncludeClosure(hasher, path, *source, includeDirs, visited);
+	}
+	return hasher.Finish();
+}
+
+std::optional<std::vector<uint8_t>> ShaderCache::Find(const std::string& key)
+{
+	std::scoped_lock lock(_mutex);
+	if (auto it = _memory.find(key); it != _memory.end()) return it->second;
+
+	std::ifstream file(_directory / (key + ".bin"), std::ios::binary);
+	if (!file.is_open()) return std::nullopt;
+	std::vector<uint8_t> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (binary.empty()) return std::nullopt;
+
+	_memory.emplace(key, binary);
+	return binary;
+}
+
+void ShaderCache::Store(const std::string& key, const std::vector<uint8_t>& binary)
+{
+	std::scoped_lock lock(_mutex);
+	_memory.insert_or_assign(key, binary);
+
+	// Written next to the final name and renamed, so an interrupted run never leaves a truncated entry
+	const auto path = _directory / (key + ".bin");
+	const auto tempPath = _directory / (key + ".tmp");
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) return;
+		file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+		if (!file) return;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, path, error);
+	if (error) std::filesystem::remove(tempPath, error);
+}
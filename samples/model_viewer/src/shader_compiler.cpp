@@ -0,0 +1,142 @@
+#include "shader_compiler.h"
+
+#if _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <Windows.h>
+#  include <wrl.h>
+#  include <unknwn.h>
+template <class T>
+using ComPtr = Microsoft::WRL::ComPtr<T>;
+#else
+#include "WinAdapter.h"
+template <class T>
+using ComPtr = CComPtr<T>;
+#endif
+
+#include <dxcapi.h>
+
+#include <fstream>
+#include <iostream>
+
+struct DxcInstance
+{
+	ComPtr<IDxcLibrary> Library;
+	ComPtr<IDxcCompiler> Compiler;
+	ComPtr<IDxcIncludeHandler> IncludeHandler;
+	// Part of every shader cache key, a different compiler build may produce different code
+	std::string Version;
+
+	DxcInstance()
+	{
+		DxcCreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&Library));
+		DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&Compiler));
+		Library->CreateIncludeHandler(&IncludeHandler);
+
+		ComPtr<IDxcVersionInfo> versionInfo;
+		UINT32 major = 0, minor = 0;
+		if (SUCCEEDED(Compiler->QueryInterface(IID_PPV_ARGS(&versionInfo))) && SUCCEEDED(versionInfo->GetVersion(&major, &minor)))
+		{
+			Version = std::to_string(major) + "." + std::to_string(minor);
+		}
+		ComPtr<IDxcVersionInfo2> versionInfo2;
+		UINT32 commitCount = 0;
+		char* commitHash = nullptr;
+		if (SUCCEEDED(Compiler->QueryInterface(IID_PPV_ARGS(&versionInfo2)))
+			&& SUCCEEDED(versionInfo2->GetCommitInfo(&commitCount, &commitHash)))
+		{
+			Version += "+" + std::to_string(commitCount) + "." + commitHash;
+			CoTaskMemFree(commitHash);
+		}
+	}
+
+	~DxcInstance()
+	{
+	}
+};
+
+std::vector<uint8_t> CompileShader(std::wstring_view path, std::wstring_view profile, std::wstring_view entryPoint, bool spirv,
+	ShaderCache* cache)
+{
+	static DxcInstance dxc;
+
+	std::filesystem::path shaderFilePath(path);
+	std::wstring includeDir = shaderFilePath.parent_path().wstring();
+
+	// Define compiler arguments
+	std::vector<LPCWSTR> arguments = {
+		path.data(),
+		L"-E", entryPoint.data(),
+		L"-T", profile.data(),
+		L"-I", includeDir.c_str(),
+		L"-Qstrip_reflect",      // Strip reflection data
+		L"-Qstrip_debug"         // Strip debug information
+	};
+	if (spirv)
+	{
+		arguments.push_back(L"-spirv");
+		// otherwise SV_InstanceID will become gl_InstanceIndex with different behavior
+		arguments.push_back(L"-fvk-support-nonzero-base-instance");
+		arguments.push_back(L"-fvk-bind-resource-heap");
+		arguments.push_back(L"0");
+		arguments.push_back(L"0");
+		arguments.push_back(L"-fvk-bind-counter-heap");
+		arguments.push_back(L"1");
+		arguments.push_back(L"0");
+		arguments.push_back(L"-fvk-bind-sampler-heap");
+		arguments.push_back(L"2");
+		arguments.push_back(L"0");
+		// VK_EXT_mesh_shader (SPV_EXT_mesh_shader) requires SPIR-V 1.4
+		if (profile.starts_with(L"as_") || profile.starts_with(L"ms_"))
+			arguments.push_back(L"-fspv-target-env=vulkan1.3");
+	}
+
+	// Identical permutations within a run and unchanged shaders between runs skip the compiler entirely
+	const std::vector<std::wstring_view> keyArguments(arguments.begin(), arguments.end());
+	const std::filesystem::path includeDirs[] = { includeDir };
+	const auto cacheKey = cache ? ShaderCache::Key(shaderFilePath, includeDirs, keyArguments, dxc.Version) : std::string();
+	if (auto cached = cache ? cache->Find(cacheKey) : std::nullopt) return std::move(*cached);
+
+	std::ifstream shaderFile(path.data(), std::ios::binary);
+	if (!shaderFile.is_open()) {
+		std::wcerr << L"Path: " << path << L"\n";
+		throw std::runtime_error("Cannot open shader on path");
+	}
+	std::string shaderSource((std::istreambuf_iterator<char>(shaderFile)), std::istreambuf_iterator<char>());
+	ComPtr<IDxcBlobEncoding> sourceBlob;
+	if (FAILED(dxc.Library->CreateBlobWithEncodingFromPinned((LPBYTE)shaderSource.data(),
+		(UINT32)shaderSource.size(), CP_UTF8, &sourceBlob))) {
+		std::wcerr << L"Path: " << path << "L\n";
+		throw std::runtime_error("Failed to create source blob");
+	}
+
+	ComPtr<IDxcOperationResult> result;
+	if (FAILED(dxc.Compiler->Compile(sourceBlob.Get(), path.data(), entryPoint.data(), profile.data(),
+		arguments.data(), (UINT)arguments.size(), nullptr, 0, dxc.IncludeHandler.Get(), &result))) {
+		std::wcerr << L"Path: " << path << "\n";
+		throw std::runtime_error("Shader compilation failed");
+	}
+
+	HRESULT hrStatus;
+	if (FAILED(result->GetStatus(&hrStatus)) || FAILED(hrStatus)) {
+		ComPtr<IDxcBlobEncoding> errorBlob;
+		if (SUCCEEDED(result->GetErrorBuffer(&errorBlob))) {
+			std::wcerr << L"Shader compilation errors:\n"
+				<< (const char*)errorBlob->GetBufferPointer() << std::endl;
+		}
+		throw std::runtime_error("<=================>");
+	}
+
+	ComPtr<IDxcBlob> shaderBlob;
+	if (FAILED(result->GetResult(&shaderBlob))) {
+		throw std::runtime_error("Failed to retrieve compiled shader");
+	}
+
+	std::vector<uint8_t> shader;
+	shader.assign(
+		(uint8_t*)shaderBlob->GetBufferPointer(),
+		(uint8_t*)shaderBlob->GetBufferPointer() + shaderBlob->GetBufferSize()
+	);
+	if (cache) cache->Store(cacheKey, shader);
+	return shader;
+}
@@ -2,7 +2,6 @@
 #include "application.h"
 #include "dds_loader.h"
 
-#include <fstream>
 #include <iostream>
 #include <FreeImage.h>
 
@@ -13,186 +12,127 @@ Texture::~Texture()
 		device.DestroyTexture(_texture);
 }
 
-std::optional<std::shared_ptr<Texture>> Texture::From(Application& app, const std::filesystem::path& path)
+std::optional<TextureImport> Texture::Import(const std::filesystem::path& path)
 {
 	if (!exists(path)) return {};
 
+    if (path.extension() != ".dds")
+    {
+        assert(false);
+        return {};
+    }
+
+    TextureImport textureImport;
+    textureImport.path = path;
+    DDSData& data = textureImport.data;
+    if (!DDSLoader::Load(path, data)) return {};
+
+    if (data.width < 64 || data.height < 64) return {};
+
+    textureImport.mipOffsets.resize(data.mips.size());
+    for (uint32_t i = 0; i < data.mips.size(); ++i)
+    {
+        textureImport.mipOffsets[i] = textureImport.uploadSize;
+        textureImport.uploadSize += data.mips[i].size();
+    }
+
+    textureImport.uploadSize = (textureImport.uploadSize + 255) & ~255;
+    return textureImport;
+}
+
+void TextureImport::WriteUploadData(void* dst) const
+{
+    // Single copy straight from the file mapping into the upload buffer
+    for (uint32_t i = 0; i < data.mips.size(); ++i)
+    {
+        memcpy(static_cast<uint8_t*>(dst) + mipOffsets[i], data.mips[i].data(), data.mips[i].size());
+    }
+}
+
+std::shared_ptr<Texture> Texture::Create(Application& app, const TextureImport& textureImport)
+{
     vg::Device device = app.GetDevice();
+    const DDSData& data = textureImport.data;
 
-    if (path.extension() == ".dds")
+    vg::TextureDesc textureDesc = { vg::TextureType::e2d, data.format, data.width, data.height,
+        1, static_cast<uint32_t>(data.mips.size()), vg::SampleCount::e1, vg::TextureUsageFlags::ShaderResource, vg::TextureTiling::Optimal,
+        vg::TextureLayout::TransferDest, vg::HeapType::Gpu };
+    vg::Texture texture;
+    if (device.CreateTexture(&textureDesc, &texture) != vg::Result::Success)
     {
-        /*DDSTexture ddsTexture;
-        if (!LoadDDSTexture(path, ddsTexture) || ddsTexture.width <= 32 || ddsTexture.height <= 32) return {};
-
-        size_t totalDataSize = 0;
-        for (uint32_t i = 0; i < ddsTexture.mips; ++i)
-        {
-            uint32_t mipWidth = std::max(1u, ddsTexture.width >> i);
-            uint32_t mipHeight = std::max(1u, ddsTexture.height >> i);
-            totalDataSize += std::max(ComputeMipSize(mipWidth, mipHeight, ddsTexture.format), 256ull);
-            totalDataSize = (totalDataSize + 255) & ~256;
-        }
-
-        vg::BufferDesc bufferDesc = { totalDataSize, vg::BufferUsage::General, vg::HeapType::Upload};
-        vg::Buffer buffer;
-        if (device.CreateBuffer(&bufferDesc, &buffer) != vg::Result::Success)
-        {
-            std::cerr << "Unable to create upload buffer for texture.\n";
-            return {};
-        }
-        void* data;
-        if (buffer.Map(&data) != vg::Result::Success)
-        {
-            std::cerr << "Unable to map upload buffer for texture.\n";
-            device.DestroyBuffer(buffer);
-            return {};
-        }
-
-        memcpy(data, ddsTexture.data.data(), ddsTexture.data.size());
-        buffer.Unmap();
-
-        vg::TextureDesc textureDesc = { vg::TextureType::e2d, GetVgFormat(ddsTexture.format), ddsTexture.width, ddsTexture.height,
-            1, ddsTexture.mips, vg::SampleCount::e1, vg::TextureUsageFlags::ShaderResource, vg::TextureTiling::Optimal,
-            vg::TextureLayout::TransferDest, vg::HeapType::Gpu };
-        vg::Texture texture;
-        if (device.CreateTexture(&textureDesc, &texture) != vg::Result::Success)
-        {
-            std::cerr << "Unable to create texture.\n";
-            device.DestroyBuffer(buffer);
-            return {};
-        }
-        texture.SetName(path.filename().generic_string().c_str());
-
-        app.SubmitImmediately([&](vg::CommandList cmd)
-        {
-            cmd.BeginMarker(std::format("Loading {}", path.filename().generic_string()).c_str(), { 1.0f, 1.0f, 1.0f });
-
-            uint32_t mipWidth = textureDesc.width;
-            uint32_t mipHeight = textureDesc.height;
-            uint64_t offset = 0;
-            for (uint32_t i = 0; i < ddsTexture.mips; i++)
-            {
-                vg::Region region = { i, 0, 1, { 0, 0, 0 }, mipWidth, mipHeight, 1 };
-                cmd.CopyBufferToTexture(texture, &region, buffer, offset);
-                offset += (ComputeMipSize(mipWidth, mipHeight, ddsTexture.format) + 3) & ~256;
-
-                mipWidth = std::max(1u, mipWidth / 2);
-                mipHeight = std::max(1u, mipHeight / 2);
-            }
-
-            vg::TextureBarrier textureBarrier = { vg::PipelineStageFlags::AllTransfer, vg::AccessFlags::TransferWrite,
-                vg::PipelineStageFlags::AllGraphics, vg::AccessFlags::ShaderSampledRead,
-                vg::TextureLayout::TransferDest, vg::TextureLayout::ShaderResource, texture,
-                { 0, textureDesc.mipLevels, 0, 1 } };
-            vg::DependencyInfo dependency = { 0, nullptr, 0, nullptr, 1, &textureBarrier };
-            cmd.Barrier(&dependency);
-
-            cmd.EndMarker();
-        });
+        std::cerr << "Unable to create texture.\n";
+        return nullptr;
+    }
+    texture.SetName(textureImport.path.filename().generic_string().c_str());
 
-        device.DestroyBuffer(buffer);
-        return std::shared_ptr<Texture>(new Texture(texture));*/
-
-        /*FIBITMAP* image = FreeImage_Load(FIF_DDS, path.generic_string().c_str(), DDS_DEFAULT);
-        if (!image)
-        {
-            std::cerr << "Failed to load texture: " << path << std::endl;
-            return {};
-        }
-
-        unsigned width = FreeImage_GetWidth(image);
-        unsigned height = FreeImage_GetHeight(image);
-        unsigned size = FreeImage_GetMemorySize(image);
-        return {};*/
-
-        DDSData data;
-        if (!DDSLoader::Load(path, data)) return {};
-
-        if (data.width < 64 || data.height < 64) return {};
-
-        UINT64 uploadBufferSize = 0;
-        std::vector<UINT64> mipOffsets(data.mips.size());
-
-        for (uint32_t i = 0; i < data.mips.size(); ++i)
-        {
-            uint32_t mipWidth = std::max(1u, data.width >> i);
-            uint32_t mipHeight = std::max(1u, data.height >> i);
-
-            UINT64 mipSize = ((mipWidth + 3) / 4) * ((mipHeight + 3) / 4) * (data.format == vg::Format::Bc1Unorm ? 8 : 16);
-            mipOffsets[i] = uploadBufferSize;
-            uploadBufferSize += mipSize;
-        }
-
-        uploadBufferSize = (uploadBufferSize + 255) & ~255;
-
-        vg::BufferDesc bufferDesc = { uploadBufferSize, vg::BufferUsage::General, vg::HeapType::Upload };
-        vg::Buffer buffer;
-        if (device.CreateBuffer(&bufferDesc, &buffer) != vg::Result::Success)
-        {
-            std::cerr << "Unable to create upload buffer for texture.\n";
-            return {};
-        }
-        void* mappedData;
-        if (buffer.Map(&mappedData) != vg::Result::Success)
-        {
-            std::cerr << "Unable to map upload buffer for texture.\n";
-            device.DestroyBuffer(buffer);
-            return {};
-        }
-        for (uint32_t i = 0; i < data.mips.size(); ++i)
-        {
-            memcpy(static_cast<uint8_t*>(mappedData) + mipOffsets[i], data.mips[i].data(), data.mips[i].size());
-        }
-        buffer.Unmap();
-
-        vg::TextureDesc textureDesc = { vg::TextureType::e2d, data.format, data.width, data.height,
-            1, static_cast<uint32_t>(data.mips.size()), vg::SampleCount::e1, vg::TextureUsageFlags::ShaderResource, vg::TextureTiling::Optimal,
-            vg::TextureLayout::TransferDest, vg::HeapType::Gpu };
-        vg::Texture texture;
-        if (device.CreateTexture(&textureDesc, &texture) != vg::Result::Success)
-        {
-            std::cerr << "Unable to create texture.\n";
-            device.DestroyBuffer(buffer);
-            return {};
-        }
-        texture.SetName(path.filename().generic_string().c_str());
-
-        app.SubmitImmediately([&](vg::CommandList cmd)
-        {
-            cmd.BeginMarker(std::format("Loading {}", path.filename().generic_string()).c_str(), { 1.0f, 1.0f, 1.0f });
-
-            uint32_t mipWidth = textureDesc.width;
-            uint32_t mipHeight = textureDesc.height;
-            uint64_t offset = 0;
-            for (uint32_t i = 0; i < data.mips.size(); i++)
-            {
-                if (mipWidth <= 64 || mipHeight <= 64) break;
-                vg::Region region = { i, 0, 1, { 0, 0, 0 }, mipWidth, mipHeight, 1 };
-                cmd.CopyBufferToTexture(texture, &region, buffer, mipOffsets[i]);
-
-                mipWidth = std::max(1u, mipWidth / 2);
-                mipHeight = std::max(1u, mipHeight / 2);
-            }
-
-            vg::TextureBarrier textureBarrier = { vg::PipelineStageFlags::AllTransfer, vg::AccessFlags::TransferWrite,
-                vg::PipelineStageFlags::AllGraphics, vg::AccessFlags::ShaderSampledRead,
-                vg::TextureLayout::TransferDest, vg::TextureLayout::ShaderResource, texture,
-                { 0, textureDesc.mipLevels, 0, 1 } };
-            vg::DependencyInfo dependency = { 0, nullptr, 0, nullptr, 1, &textureBarrier };
-            cmd.Barrier(&dependency);
-
-            cmd.EndMarker();
-        });
+    return std::shared_ptr<Texture>(new Texture(texture));
+}
 
-        device.DestroyBuffer(buffer);
-        return std::shared_ptr<Texture>(new Texture(texture));
+std::optional<std::shared_ptr<Texture>> Texture::From(Application& app, const std::filesystem::path& path)
+{
+    auto textureImport = Texture::Import(path);
+    if (!textureImport) return {};
+
+    auto texture = Texture::Create(app, *textureImport);
+    if (!texture) return {};
+
+    vg::Device device = app.GetDevice();
+    vg::BufferDesc bufferDesc = { textureImport->uploadSize, vg::BufferUsage::General, vg::HeapType::Upload };
+    vg::Buffer buffer;
+    if (device.CreateBuffer(&bufferDesc, &buffer) != vg::Result::Success)
+    {
+        std::cerr << "Unable to create upload buffer for texture.\n";
+        return {};
     }
-    else
+    void* mappedData;
+    if (buffer.Map(&mappedData) != vg::Result::Success)
     {
-        assert(false);
+        std::cerr << "Unable to map upload buffer for texture.\n";
+        device.DestroyBuffer(buffer);
         return {};
     }
-    return {};
+    textureImport->WriteUploadData(mappedData);
+    buffer.Unmap();
+
+    app.SubmitImmediately([&](vg::CommandList cmd)
+    {
+        texture->RecordUpload(cmd, *textureImport, buffer, 0);
+    });
+
+    device.DestroyBuffer(buffer);
+    return texture;
+}
+
+void Texture::RecordUpload(vg::CommandList cmd, const TextureImport& textureImport, vg::Buffer uploadBuffer, uint64_t offset) const
+{
+    const DDSData& data = textureImport.data;
+    cmd.BeginMarker(std::format("Loading {}", textureImport.path.filename().generic_string()).c_str(), { 1.0f, 1.0f, 1.0f });
+
+    // All mips are copied with a single command
+    std::vector<vg::BufferTextureCopyRegion> regions;
+    uint32_t mipWidth = data.width;
+    uint32_t mipHeight = data.height;
+    for (uint32_t i = 0; i < data.mips.size(); i++)
+    {
+        if (mipWidth <= 64 || mipHeight <= 64) break;
+        regions.push_back({ offset + textureImport.mipOffsets[i], { i, 0, 1, { 0, 0, 0 }, mipWidth, mipHeight, 1 } });
+
+        mipWidth = std::max(1u, mipWidth / 2);
+        mipHeight = std::max(1u, mipHeight / 2);
+    }
+    if (!regions.empty())
+    {
+        cmd.CopyBufferToTextureRegions(_texture, uploadBuffer, static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    vg::TextureBarrier textureBarrier = { vg::PipelineStageFlags::AllTransfer, vg::AccessFlags::TransferWrite,
+        vg::PipelineStageFlags::AllGraphics, vg::AccessFlags::ShaderSampledRead,
+        vg::TextureLayout::TransferDest, vg::TextureLayout::ShaderResource, _texture,
+        { 0, static_cast<uint32_t>(data.mips.size()), 0, 1 } };
+    vg::DependencyInfo dependency = { 0, nullptr, 0, nullptr, 1, &textureBarrier };
+    cmd.Barrier(&dependency);
+
+    cmd.EndMarker();
 }
 
 Texture::Texture(vg::Texture texture) : _texture(texture)
@@ -0,0 +1,91 @@
+#include "thread_pool.h"
+
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(uint32_t numThreads)
+{
+	_workers.reserve(numThreads);
+	for (uint32_t i = 0; i < numThreads; i++)
+	{
+		_workers.emplace_back([this]() { WorkerLoop(); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::scoped_lock lock(_mutex);
+		_stop = true;
+	}
+	_jobAvailable.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+	if (count == 0) return;
+
+	// Helpers may pick up their job after all indices are done and this call has returned,
+	// so everything they touch lives in a shared state instead of on this stack frame
+	struct State
+	{
+		std::atomic<size_t> nextIndex{ 0 };
+		std::atomic<size_t> numDone{ 0 };
+		size_t count;
+		const std::function<void(size_t)>* func;
+		std::mutex doneMutex;
+		std::condition_variable allDone;
+	};
+	auto state = std::make_shared<State>();
+	state->count = count;
+	state->func = &func;
+
+	const auto run = [state]()
+	{
+		for (size_t i = state->nextIndex++; i < state->count; i = state->nextIndex++)
+		{
+			(*state->func)(i);
+			if (++state->numDone == state->count)
+			{
+				std::scoped_lock lock(state->doneMutex);
+				state->allDone.notify_one();
+			}
+		}
+	};
+
+	const size_t numHelpers = std::min(count - 1, _workers.size());
+	{
+		std::scoped_lock lock(_mutex);
+		for (size_t i = 0; i < numHelpers; i++)
+		{
+			_jobs.emplace_back(run);
+		}
+	}
+	_jobAvailable.notify_all();
+
+	run();
+
+	std::unique_lock lock(state->doneMutex);
+	state->allDone.wait(lock, [&]() { return state->numDone == count; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock lock(_mutex);
+			_jobAvailable.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+			if (_stop && _jobs.empty()) return;
+
+			job = std::move(_jobs.front());
+			_jobs.pop_front();
+		}
+		job();
+	}
+}
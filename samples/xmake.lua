@@ -2,6 +2,18 @@ add_requires("glfw", "mimalloc", "glm", "assimp", "freeimage", "directxshadercom
 
 add_rules("mode.debug", "mode.release")
 
+-- Precompiles every permutation in shader_permutations.h to DXIL and SPIR-V, see shader_bundle.h
+target("model_viewer_bundler")
+    set_kind("binary")
+    set_languages("cxx20")
+
+    add_includedirs("model_viewer/include")
+    add_files("model_viewer/bundler/main.cpp")
+    add_files("model_viewer/src/shader_bundle.cpp", "model_viewer/src/shader_cache.cpp", "model_viewer/src/shader_compiler.cpp")
+
+    set_symbols("debug")
+    add_packages("directxshadercompiler")
+
 target("model_viewer")
     set_kind("binary")
     set_languages("cxx20")
@@ -9,7 +21,7 @@ target("model_viewer")
     add_includedirs("model_viewer/include")
     add_headerfiles("model_viewer/include/**.h")
     add_files("model_viewer/src/**.cpp")
-    add_deps("varyag")
+    add_deps("varyag", "model_viewer_bundler")
 
     set_rundir("$(projectdir)/samples/model_viewer/data")
     set_configdir("$(buildir)/$(plat)/$(arch)/$(mode)/shaders")
@@ -17,4 +29,17 @@ target("model_viewer")
     add_configfiles("model_viewer/data/shaders/*.hlsli", {onlycopy = true})
 
     set_symbols("debug")
-    add_packages("glfw", "mimalloc", "glm", "assimp", "freeimage", "directxshadercompiler", "volk")
\ No newline at end of file
+    add_packages("glfw", "mimalloc", "glm", "assimp", "freeimage", "volk")
+
+    if is_mode("release") then
+        -- Release builds load every shader from shaders.bundle and never start the compiler
+        add_defines("MV_SHADER_BUNDLE_ONLY=1")
+        remove_files("model_viewer/src/shader_compiler.cpp", "model_viewer/src/shader_cache.cpp")
+    else
+        add_packages("directxshadercompiler")
+    end
+
+    after_build(function (target)
+        local datadir = path.join(os.projectdir(), "samples/model_viewer/data")
+        os.execv(target:dep("model_viewer_bundler"):targetfile(), { datadir, path.join(datadir, "shaders.bundle") })
+    end)
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "capture.h"
+#include <bit>
+#include <algorithm>
+
+static uint64_t HashPage(const uint8_t* data, size_t size)
+{
+	uint64_t hash = 0x9E3779B97F4A7C15ull ^ size;
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(word));
+		hash = std::rotl(hash ^ word, 29) * 0xBF58476D1CE4E5B9ull;
+	}
+	for (; i < size; i++)
+	{
+		hash = std::rotl(hash ^ data[i], 29) * 0xBF58476D1CE4E5B9ull;
+	}
+	return hash ^ (hash >> 31);
+}
+
+CaptureWriter* CaptureWriter::Open(const char* path)
+{
+	if (!path)
+	{
+		LOG(ERROR, "Cannot start capture: capture_path = NULL");
+		return nullptr;
+	}
+
+	std::FILE* file = std::fopen(path, "wb");
+	if (!file)
+	{
+		LOG(ERROR, "Cannot start capture: unable to open {}", path);
+		return nullptr;
+	}
+	std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+	const VgCaptureFileHeader header = { VG_CAPTURE_MAGIC, VG_CAPTURE_VERSION, sizeof(void*), VG_CAPTURE_PAGE_SIZE };
+	std::fwrite(&header, sizeof(header), 1, file);
+
+	LOG(INFO, "Capturing API calls to {}", path);
+	return new(GetAllocator().Allocate<CaptureWriter>()) CaptureWriter(file);
+}
+
+CaptureWriter::CaptureWriter(std::FILE* file) : _file(file)
+{
+}
+
+CaptureWriter::~CaptureWriter()
+{
+	SnapshotMappedBuffers();
+	std::fclose(_file);
+}
+
+void CaptureWriter::Commit(VgCaptureOp op, const vg::Vector<uint8_t>& payload)
+{
+	const VgCaptureRecordHeader header = { op, static_cast<uint32_t>(payload.size()) };
+
+	std::scoped_lock lock(_fileMutex);
+	std::fwrite(&header, sizeof(header), 1, _file);
+	if (!payload.empty()) std::fwrite(payload.data(), 1, payload.size(), _file);
+}
+
+uint64_t CaptureWriter::Id(const void* handle, bool create)
+{
+	if (!handle) return 0;
+
+	std::scoped_lock lock(_idMutex);
+	auto it = _ids.find(handle);
+	if (it != _ids.end()) return it->second;
+
+	// Handles which were never returned by a recorded call can only be replayed as new objects
+	if (!create) LOG(WARN, "Capture: unknown object {} is used before it was created", handle);
+	return _ids[handle] = _nextId++;
+}
+
+void CaptureWriter::Forget(const void* handle)
+{
+	std::scoped_lock lock(_idMutex);
+	_ids.erase(handle);
+}
+
+void CaptureWriter::Forget(VgBuffer buffer)
+{
+	{
+		std::scoped_lock lock(_mappedMutex);
+		_mappedBuffers.erase(buffer);
+	}
+	Forget(static_cast<const void*>(buffer));
+}
+
+void CaptureWriter::OnMap(VgBuffer buffer, void* data)
+{
+	if (buffer->Desc().heap_type != VG_HEAP_TYPE_UPLOAD) return;
+
+	std::scoped_lock lock(_mappedMutex);
+	auto& mapped = _mappedBuffers[buffer];
+	mapped.data = static_cast<uint8_t*>(data);
+	mapped.size = buffer->Desc().size;
+}
+
+void CaptureWriter::OnUnmap(VgBuffer buffer)
+{
+	std::scoped_lock lock(_mappedMutex);
+	auto it = _mappedBuffers.find(buffer);
+	if (it == _mappedBuffers.end()) return;
+
+	Snapshot(buffer, it->second);
+	_mappedBuffers.erase(it);
+}
+
+void CaptureWriter::SnapshotMappedBuffers()
+{
+	std::scoped_lock lock(_mappedMutex);
+	for (auto& [buffer, mapped] : _mappedBuffers)
+	{
+		Snapshot(buffer, mapped);
+	}
+}
+
+void CaptureWriter::Snapshot(VgBuffer buffer, MappedBuffer& mapped)
+{
+	constexpr uint64_t maxRunPages = 256;
+
+	const uint64_t numPages = (mapped.size + VG_CAPTURE_PAGE_SIZE - 1) / VG_CAPTURE_PAGE_SIZE;
+	const bool firstSnapshot = mapped.pageHashes.empty();
+	if (firstSnapshot) mapped.pageHashes.resize(numPages);
+
+	// Consecutive dirty pages are coalesced into one record
+	uint64_t runStart = 0, runPages = 0;
+	const auto flush = [&]()
+	{
+		if (runPages == 0) return;
+		const uint64_t offset = runStart * VG_CAPTURE_PAGE_SIZE;
+		const uint64_t size = std::min(runPages * VG_CAPTURE_PAGE_SIZE, mapped.size - offset);
+		Write(VG_CAPTURE_OP_BUFFER_DATA, buffer, offset, Blob(mapped.data + offset, size));
+		runPages = 0;
+	};
+
+	for (uint64_t page = 0; page < numPages; page++)
+	{
+		const uint64_t offset = page * VG_CAPTURE_PAGE_SIZE;
+		const uint64_t hash = HashPage(mapped.data + offset, std::min<uint64_t>(VG_CAPTURE_PAGE_SIZE, mapped.size - offset));
+		if (!firstSnapshot && hash == mapped.pageHashes[page])
+		{
+			flush();
+			continue;
+		}
+		mapped.pageHashes[page] = hash;
+
+		if (runPages == maxRunPages) flush();
+		if (runPages == 0) runStart = page;
+		runPages++;
+	}
+	flush();
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgVertexBufferView& view)
+{
+	Put(out, view.buffer);
+	Put(out, view.offset);
+	Put(out, view.stride_in_bytes);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgFenceOperation& operation)
+{
+	Put(out, operation.fence);
+	Put(out, operation.value);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgSubmitInfo& submit)
+{
+	Put(out, std::span<const VgFenceOperation>(submit.wait_fences, submit.num_wait_fences));
+	Put(out, std::span<const VgFenceOperation>(submit.signal_fences, submit.num_signal_fences));
+	Put(out, std::span<const VgCommandList>(submit.command_lists, submit.num_command_lists));
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgBufferBarrier& barrier)
+{
+	Put(out, barrier.src_stage);
+	Put(out, barrier.src_access);
+	Put(out, barrier.dst_stage);
+	Put(out, barrier.dst_access);
+	Put(out, barrier.buffer);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgTextureBarrier& barrier)
+{
+	Put(out, barrier.src_stage);
+	Put(out, barrier.src_access);
+	Put(out, barrier.dst_stage);
+	Put(out, barrier.dst_access);
+	Put(out, barrier.old_layout);
+	Put(out, barrier.new_layout);
+	Put(out, barrier.texture);
+	Put(out, barrier.subresource_range);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgDependencyInfo& dependencyInfo)
+{
+	Put(out, std::span<const VgMemoryBarrier>(dependencyInfo.memory_barriers, dependencyInfo.num_memory_barriers));
+	Put(out, std::span<const VgBufferBarrier>(dependencyInfo.buffer_barriers, dependencyInfo.num_buffer_barriers));
+	Put(out, std::span<const VgTextureBarrier>(dependencyInfo.texture_barriers, dependencyInfo.num_texture_barriers));
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgBufferTransition& transition)
+{
+	Put(out, transition.stage);
+	Put(out, transition.access);
+	Put(out, transition.buffer);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgTextureTransition& transition)
+{
+	Put(out, transition.stage);
+	Put(out, transition.access);
+	Put(out, transition.layout);
+	Put(out, transition.texture);
+	Put(out, transition.subresource_range);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgTransitionInfo& transitionInfo)
+{
+	Put(out, std::span<const VgBufferTransition>(transitionInfo.buffer_transitions, transitionInfo.num_buffer_transitions));
+	Put(out, std::span<const VgTextureTransition>(transitionInfo.texture_transitions, transitionInfo.num_texture_transitions));
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgRenderingInfo& info)
+{
+	Put(out, std::span<const VgAttachmentInfo>(info.color_attachments, info.num_color_attachments));
+	Put(out, info.depth_stencil_attachment);
+	Put(out, info.flags);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgBundleInheritanceInfo& info)
+{
+	Put(out, std::span<const VgFormat>(info.color_attachment_formats, info.num_color_attachments));
+	Put(out, info.depth_stencil_format);
+	Put(out, info.sample_count);
+	Put(out, std::span<const VgViewport>(info.viewports, info.num_viewports));
+	Put(out, std::span<const VgScissor>(info.scissors, info.num_viewports));
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgGraphicsPipelineDesc& desc)
+{
+	Put(out, desc.vertex_pipeline_type);
+	if (desc.vertex_pipeline_type == VG_VERTEX_PIPELINE_FIXED_FUNCTION)
+	{
+		Put(out, std::span<const VgVertexAttribute>(desc.fixed_function.vertex_attributes, desc.fixed_function.num_vertex_attributes));
+		Put(out, desc.fixed_function.vertex_shader);
+		Put(out, desc.fixed_function.hull_shader);
+		Put(out, desc.fixed_function.domain_shader);
+		Put(out, desc.fixed_function.geometry_shader);
+	}
+	else
+	{
+		Put(out, desc.mesh.amplification_shader);
+		Put(out, desc.mesh.mesh_shader);
+	}
+	Put(out, desc.pixel_shader);
+	Put(out, desc.primitive_topology);
+	Put(out, desc.primitive_restart_enable);
+	Put(out, desc.tesselation_control_points);
+	Put(out, desc.rasterization_state);
+	Put(out, desc.multisampling_state);
+	Put(out, desc.depth_stencil_state);
+	Put(out, std::span<const VgFormat>(desc.color_attachment_formats, desc.num_color_attachments));
+	Put(out, desc.depth_stencil_format);
+	Put(out, desc.blend_state);
+}
+
+void CaptureWriter::Put(vg::Vector<uint8_t>& out, const VgReadbackRequest& request)
+{
+	// Callbacks only matter to the replay in that they release their tickets in vgDeviceProcessReadbacks()
+	Put(out, request.fence);
+	Put(out, request.fence_value);
+	Put(out, request.callback != nullptr);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "common.h"
+#include "interface.h"
+#include "varyag_capture.h"
+#include <span>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <concepts>
+#include <type_traits>
+
+template <class T>
+concept CaptureHandle = std::same_as<T, VgAdapter> || std::same_as<T, VgDevice> || std::same_as<T, VgCommandPool>
+	|| std::same_as<T, VgCommandList> || std::same_as<T, VgBuffer> || std::same_as<T, VgShaderModule>
+	|| std::same_as<T, VgPipeline> || std::same_as<T, VgTexture> || std::same_as<T, VgSwapChain>
+	|| std::same_as<T, VgFence>;
+
+// Structs without pointers or handles, written with their native layout
+template <class T>
+concept CaptureRawStruct = std::same_as<T, VgBufferDesc> || std::same_as<T, VgBufferViewDesc>
+	|| std::same_as<T, VgSamplerDesc> || std::same_as<T, VgTextureDesc> || std::same_as<T, VgAttachmentViewDesc>
+	|| std::same_as<T, VgTextureViewDesc> || std::same_as<T, VgTextureSubresourceRange> || std::same_as<T, VgRegion>
+	|| std::same_as<T, VgViewport> || std::same_as<T, VgScissor> || std::same_as<T, VgAttachmentInfo>
+	|| std::same_as<T, VgMemoryBarrier> || std::same_as<T, VgVertexAttribute> || std::same_as<T, VgRasterizationState>
+	|| std::same_as<T, VgMultisamplingState> || std::same_as<T, VgDepthStencilState> || std::same_as<T, VgBlendState>
+	|| std::same_as<T, VgMultiDrawInfo> || std::same_as<T, VgMultiDrawIndexedInfo> || std::same_as<T, VgBufferCopyRegion>
+	|| std::same_as<T, VgBufferTextureCopyRegion> || std::same_as<T, VgTextureCopyRegion> || std::same_as<T, std::array<float, 3>>;
+
+// Serializes API calls into the format described in varyag_capture.h. Write() is thread safe,
+// records of concurrent calls are ordered by the time they are committed.
+class CaptureWriter
+{
+public:
+	// Object returned by the recorded call, assigned a new id unless it is already known
+	struct NewHandle { const void* handle; };
+	using Blob = std::span<const uint8_t>;
+
+	static CaptureWriter* Open(const char* path);
+	~CaptureWriter();
+
+	template <class... Args>
+	void Write(VgCaptureOp op, const Args&... args)
+	{
+		vg::Vector<uint8_t> payload;
+		(Put(payload, args), ...);
+		Commit(op, payload);
+	}
+
+	// Drops the id of a destroyed object so that a new object at the same address gets a new one
+	void Forget(const void* handle);
+	void Forget(VgBuffer buffer);
+
+	void OnMap(VgBuffer buffer, void* data);
+	void OnUnmap(VgBuffer buffer);
+	// Writes the pages of mapped upload buffers which changed since the last snapshot
+	void SnapshotMappedBuffers();
+
+private:
+	struct MappedBuffer
+	{
+		uint8_t* data;
+		uint64_t size;
+		vg::Vector<uint64_t> pageHashes;
+	};
+
+	std::FILE* _file;
+	std::mutex _fileMutex;
+
+	std::mutex _idMutex;
+	vg::UnorderedMap<const void*, uint64_t> _ids;
+	uint64_t _nextId{ 1 };
+
+	std::mutex _mappedMutex;
+	vg::UnorderedMap<VgBuffer, MappedBuffer> _mappedBuffers;
+
+	explicit CaptureWriter(std::FILE* file);
+
+	void Commit(VgCaptureOp op, const vg::Vector<uint8_t>& payload);
+	void Snapshot(VgBuffer buffer, MappedBuffer& mapped);
+	uint64_t Id(const void* handle, bool create);
+
+	static void PutBytes(vg::Vector<uint8_t>& out, const void* data, size_t size)
+	{
+		const auto offset = out.size();
+		out.resize(offset + size);
+		if (size > 0) std::memcpy(out.data() + offset, data, size);
+	}
+
+	template <class T> requires std::is_arithmetic_v<T> || std::is_enum_v<T> || CaptureRawStruct<T>
+	void Put(vg::Vector<uint8_t>& out, const T& value) { PutBytes(out, &value, sizeof(T)); }
+
+	template <CaptureHandle T>
+	void Put(vg::Vector<uint8_t>& out, T handle) { Put(out, Id(handle, false)); }
+
+	void Put(vg::Vector<uint8_t>& out, NewHandle handle) { Put(out, Id(handle.handle, true)); }
+
+	void Put(vg::Vector<uint8_t>& out, const char* str)
+	{
+		const auto length = str ? static_cast<uint32_t>(std::strlen(str)) : 0u;
+		Put(out, length);
+		PutBytes(out, str, length);
+	}
+
+	void Put(vg::Vector<uint8_t>& out, Blob blob)
+	{
+		Put(out, static_cast<uint32_t>(blob.size()));
+		PutBytes(out, blob.data(), blob.size());
+	}
+
+	template <class T>
+	void Put(vg::Vector<uint8_t>& out, std::span<const T> array)
+	{
+		Put(out, static_cast<uint32_t>(array.size()));
+		for (const auto& element : array) Put(out, element);
+	}
+
+	void Put(vg::Vector<uint8_t>& out, const VgVertexBufferView& view);
+	void Put(vg::Vector<uint8_t>& out, const VgFenceOperation& operation);
+	void Put(vg::Vector<uint8_t>& out, const VgSubmitInfo& submit);
+	void Put(vg::Vector<uint8_t>& out, const VgBufferBarrier& barrier);
+	void Put(vg::Vector<uint8_t>& out, const VgTextureBarrier& barrier);
+	void Put(vg::Vector<uint8_t>& out, const VgDependencyInfo& dependencyInfo);
+	void Put(vg::Vector<uint8_t>& out, const VgBufferTransition& transition);
+	void Put(vg::Vector<uint8_t>& out, const VgTextureTransition& transition);
+	void Put(vg::Vector<uint8_t>& out, const VgTransitionInfo& transitionInfo);
+	void Put(vg::Vector<uint8_t>& out, const VgRenderingInfo& info);
+	void Put(vg::Vector<uint8_t>& out, const VgBundleInheritanceInfo& info);
+	void Put(vg::Vector<uint8_t>& out, const VgGraphicsPipelineDesc& desc);
+	void Put(vg::Vector<uint8_t>& out, const VgReadbackRequest& request);
+};
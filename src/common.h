@@ -9,6 +9,7 @@
 
 #include "varyag.h"
 #include <set>
+#include <deque>
 #include <array>
 #include <format>
 #include <string>
@@ -90,6 +91,9 @@ namespace vg
     template <class T>
     using Vector = std::vector<T, vg::Allocator<T>>;
 
+    template <class T>
+    using Deque = std::deque<T, vg::Allocator<T>>;
+
     template <class K, class V>
     using UnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, vg::Allocator<std::pair<const K, V>>>;
 
@@ -266,6 +270,16 @@ constexpr uint64_t GetBCFormatBlockSize(VgFormat format)
     }
 }
 
+// Rows of texture data in buffers read and written by texture copies start at multiples of this
+constexpr uint64_t texture_copy_row_pitch_alignment = 256;
+
+constexpr uint64_t TextureCopyRowPitch(uint64_t width, VgFormat format)
+{
+    const auto bcSize = GetBCFormatBlockSize(format);
+    const uint64_t rowSize = bcSize == 0 ? width * FormatSizeBytes(format) : ((width + 3) / 4) * bcSize;
+    return (rowSize + texture_copy_row_pitch_alignment - 1) & ~(texture_copy_row_pitch_alignment - 1);
+}
+
 constexpr uint32_t SampleCount(VgSampleCount count)
 {
     switch (count)
@@ -324,7 +338,7 @@ constexpr uint32_t FormatPlaneCount(VgFormat format)
 class VgError : public std::runtime_error {
 public:
     VgResult result;
-    VgError(VgResult result, const std::string& msg) : std::runtime_error(msg) {}
+    VgError(VgResult result, const std::string& msg) : std::runtime_error(msg), result(result) {}
 };
 
 class VgFailure : public VgError {
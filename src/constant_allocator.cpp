@@ -0,0 +1,89 @@
+#include "constant_allocator.h"
+#include <algorithm>
+
+static constexpr uint64_t constant_alignment = VG_CONSTANT_ALLOCATION_ALIGNMENT;
+
+ConstantAllocator::ConstantAllocator(VgDevice device, uint64_t size)
+	: _device(device), _size((size + constant_alignment - 1) & ~(constant_alignment - 1))
+{
+	_buffer = _device->CreateBuffer(VgBufferDesc{ _size, VG_BUFFER_USAGE_CONSTANT, VG_HEAP_TYPE_UPLOAD });
+	_buffer->SetName("Constant allocator");
+	try
+	{
+		_mapped = static_cast<uint8_t*>(_buffer->Map());
+		_gpuAddress = _buffer->GpuAddress();
+
+		// Each view covers the largest allocation which can start at its offset
+		_views.resize(_size / constant_alignment);
+		for (uint64_t i = 0; i < _views.size(); i++)
+		{
+			const uint64_t offset = i * constant_alignment;
+			const VgBufferViewDesc viewDesc = {
+				.descriptor_type = VG_BUFFER_DESCRIPTOR_TYPE_CBV,
+				.view_type = VG_BUFFER_VIEW_TYPE_BUFFER,
+				.format = VG_FORMAT_UNKNOWN,
+				.offset = offset,
+				.size = std::min<uint64_t>(VG_MAX_CONSTANT_ALLOCATION_SIZE, _size - offset),
+				.element_size = 0
+			};
+			_views[i] = _buffer->CreateView(viewDesc);
+		}
+	}
+	catch (...)
+	{
+		_device->DestroyBuffer(_buffer);
+		throw;
+	}
+}
+
+ConstantAllocator::~ConstantAllocator()
+{
+	_buffer->Unmap();
+	_device->DestroyBuffer(_buffer);
+}
+
+bool ConstantAllocator::Allocate(uint64_t size, VgConstantAllocation& allocation)
+{
+	std::scoped_lock lock(_mutex);
+
+	// Fences are only queried once the ring looks full
+	for (bool reclaimed = false;; reclaimed = true)
+	{
+		if (_used == 0) _head = 0;
+
+		// An allocation which does not fit before the end of the ring skips the rest of it
+		const uint64_t aligned = (_head + constant_alignment - 1) & ~(constant_alignment - 1);
+		const bool wrap = aligned + size > _size;
+		const uint64_t offset = wrap ? 0 : aligned;
+		const uint64_t consumed = (wrap ? _size - _head : aligned - _head) + size;
+		if (_used + consumed <= _size)
+		{
+			_head = offset + size;
+			_used += consumed;
+			_frameSize += consumed;
+			allocation = { _mapped + offset, _buffer, offset, _gpuAddress + offset, _views[offset / constant_alignment] };
+			return true;
+		}
+
+		if (reclaimed) return false;
+		Reclaim();
+	}
+}
+
+void ConstantAllocator::EndFrame(VgFence fence, uint64_t fenceValue)
+{
+	std::scoped_lock lock(_mutex);
+	if (_frameSize == 0) return;
+
+	_frames.push_back({ fence, fenceValue, _frameSize });
+	_frameSize = 0;
+}
+
+void ConstantAllocator::Reclaim()
+{
+	while (!_frames.empty() && _device->GetFenceValue(_frames.front().fence) >= _frames.front().fenceValue)
+	{
+		_used -= _frames.front().size;
+		_frames.pop_front();
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common.h"
+#include "interface.h"
+#include <mutex>
+
+// Ring of persistently mapped VG_HEAP_TYPE_UPLOAD memory for transient constant data, shared by all backends.
+// Allocations are bumped from the head of the ring and freed by frame: vgDeviceEndConstantFrame() closes the
+// current frame with a fence value, its memory is reused once the fence has reached it. Every aligned offset has
+// a constant buffer view created up front, so an allocation only moves the head.
+class ConstantAllocator
+{
+public:
+	ConstantAllocator(VgDevice device, uint64_t size);
+	~ConstantAllocator();
+
+	VgDevice Device() const { return _device; }
+	VgBuffer Buffer() const { return _buffer; }
+	uint8_t* Mapped() const { return _mapped; }
+
+	// false if the frames in flight leave no room for size bytes
+	bool Allocate(uint64_t size, VgConstantAllocation& allocation);
+	void EndFrame(VgFence fence, uint64_t fenceValue);
+
+private:
+	struct Frame
+	{
+		VgFence fence;
+		uint64_t fenceValue;
+		// Bytes of the ring the frame used, including the padding in front of its allocations
+		uint64_t size;
+	};
+
+	VgDevice _device;
+	VgBuffer _buffer;
+	uint8_t* _mapped;
+	uint64_t _size;
+	uint64_t _gpuAddress;
+	// View of the offset i * VG_CONSTANT_ALLOCATION_ALIGNMENT
+	vg::Vector<uint32_t> _views;
+
+	std::mutex _mutex;
+	// Frames which ended but may still be read by the GPU, oldest first
+	vg::Deque<Frame> _frames;
+	uint64_t _head{ 0 };
+	// Bytes between the start of the oldest frame and _head
+	uint64_t _used{ 0 };
+	uint64_t _frameSize{ 0 };
+
+	void Reclaim();
+};
@@ -21,6 +21,7 @@ public:
 
 	uint32_t CreateView(const VgBufferViewDesc& desc) override;
 	void DestroyViews() override;
+	uint64_t GpuAddress() const override { return _resource->GetGPUVirtualAddress(); }
 	void* Map() override;
 	void Unmap() override;
 
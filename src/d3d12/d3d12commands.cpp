@@ -36,13 +36,13 @@ D3D12CommandPool::D3D12CommandPool(D3D12Device& device, VgCommandPoolFlags flags
 	: _device(&device)
 {
 	// VG_COMMAND_POOL_FLAG_TRANSIENT is only usable as Vulkan driver hint
-	(void)flags;
+	_flags = flags;
 	_queue = queue;
-	_type = QueueToCommandListType(queue);
+	_type = flags & VG_COMMAND_POOL_FLAG_BUNDLE ? D3D12_COMMAND_LIST_TYPE_BUNDLE : QueueToCommandListType(queue);
 	Assert(_type != D3D12_COMMAND_LIST_TYPE_NONE);
 
 	ThrowOnError(_device->Device()->CreateCommandAllocator(_type, IID_PPV_ARGS(&_allocator)));
-	_allocator->SetName(SelectCommandPoolName(queue).data());
+	_allocator->SetName(_type == D3D12_COMMAND_LIST_TYPE_BUNDLE ? L"Bundle Command Pool" : SelectCommandPoolName(queue).data());
 }
 
 D3D12CommandPool::~D3D12CommandPool()
@@ -107,6 +107,8 @@ void D3D12CommandList::ResetRefValues()
 	_state = STATE_NONE;
 	_currentIndexType = static_cast<VgIndexType>(-1);
 	_boundPipeline = nullptr;
+	_numViewports = 0;
+	_numScissors = 0;
 	memset(_computeRootConstants.data(), 0, _computeRootConstants.size() * sizeof(_computeRootConstants[0]));
 }
 
@@ -115,7 +117,7 @@ D3D12CommandList::D3D12CommandList(D3D12CommandPool& pool)
 {
 	ThrowOnError(pool.Device()->Device()->CreateCommandList(0, pool.Type(), pool.Allocator(), nullptr, IID_PPV_ARGS(&_cmd)));
 	ThrowOnError(_cmd->Close());
-	_cmd->SetName(SelectCommandListName(pool.Queue()).data());
+	_cmd->SetName(pool.Type() == D3D12_COMMAND_LIST_TYPE_BUNDLE ? L"Bundle" : SelectCommandListName(pool.Queue()).data());
 
 	memset(_viewports.data(), 0, _viewports.size() * sizeof(_viewports[0]));
 	memset(_scissors.data(), 0, _scissors.size() * sizeof(_scissors[0]));
@@ -180,9 +182,18 @@ void D3D12CommandList::Begin()
 	RestoreDescriptorState();
 }
 
+// Render targets, viewports and scissors are inherited from the executing list, the inheritance info is only needed on Vulkan
+void D3D12CommandList::BeginBundle(const VgBundleInheritanceInfo&)
+{
+	Begin();
+	_state |= STATE_RENDERING;
+}
+
 void D3D12CommandList::End()
 {
 	_cmd->Close();
+	_finalPipeline = _boundPipeline;
+	_finalIndexType = _currentIndexType;
 	ResetRefValues();
 }
 
@@ -246,7 +257,6 @@ void D3D12CommandList::SetRootConstants(VgPipelineType pipelineType, uint32_t of
 
 void D3D12CommandList::SetPipeline(VgPipeline pipeline)
 {
-	if (pipeline == _boundPipeline) return;
 	_cmd->SetPipelineState(static_cast<D3D12Pipeline*>(pipeline)->GetPipelineState().Get());
 
 	auto d3d12Pipeline = static_cast<D3D12Pipeline*>(pipeline);
@@ -277,6 +287,13 @@ void D3D12CommandList::SetPipeline(VgPipeline pipeline)
 	_boundPipeline = static_cast<D3D12Pipeline*>(pipeline);
 }
 
+void D3D12CommandList::SetGraphicsState(const GraphicsPipelineParts& state)
+{
+	// D3D12 has no shader objects, every combination of the state is a pipeline state cached by the device
+	auto pipeline = Device()->GetGraphicsStatePipeline(state);
+	if (pipeline != _boundPipeline) SetPipeline(pipeline);
+}
+
 void D3D12CommandList::Dispatch(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
 {
 	_cmd->Dispatch(groups_x, groups_y, groups_z);
@@ -510,6 +527,11 @@ void D3D12CommandList::DispatchIndirect(VgBuffer buffer, uint64_t offset)
 	_cmd->ExecuteIndirect(commandSignature.Get(), 1, static_cast<D3D12Buffer*>(buffer)->Resource().Get(), offset, nullptr, 0);
 }
 
+void D3D12CommandList::DispatchMesh(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
+{
+	_cmd->DispatchMesh(groups_x, groups_y, groups_z);
+}
+
 /*static D3D12_BARRIER_LAYOUT MapLayoutToQueue(D3D12_BARRIER_LAYOUT layout, VgQueue queue)
 {
 	const vg::UnorderedMap<VgQueue, vg::UnorderedMap<D3D12_BARRIER_LAYOUT, D3D12_BARRIER_LAYOUT>> bigMap = {
@@ -689,7 +711,7 @@ void D3D12CommandList::BeginRendering(const VgRenderingInfo& info)
 	_renderingNumColorAttachments = info.num_color_attachments;
 	memcpy(_renderingColorAttachments.data(), info.color_attachments, info.num_color_attachments * sizeof(VgAttachmentInfo));
 	_renderingDepthStencilAttachment = info.depth_stencil_attachment;
-	_state |= STATE_RENDERING;
+	_state |= info.flags & VG_RENDERING_FLAG_BUNDLES ? STATE_RENDERING_BUNDLES : STATE_RENDERING;
 }
 
 void D3D12CommandList::EndRendering()
@@ -710,30 +732,40 @@ void D3D12CommandList::EndRendering()
 		}
 	}*/
 
-	_state &= ~STATE_RENDERING;
+	_state &= ~(STATE_RENDERING | STATE_RENDERING_BUNDLES);
 }
 
 void D3D12CommandList::SetViewport(uint32_t firstViewport, uint32_t numViewports, VgViewport* viewports)
 {
-	//thread_local std::array<D3D12_VIEWPORT, vg_num_max_viewports_and_scissors> d3d12Viewports;
+	// RSSetViewports() replaces the whole array, so every viewport up to the highest one set so far is sent
 	memcpy(_viewports.data() + firstViewport, viewports, numViewports * sizeof(viewports[0]));
-	_cmd->RSSetViewports(static_cast<UINT>(_viewports.size()), _viewports.data());
+	_numViewports = std::max(_numViewports, firstViewport + numViewports);
+	_cmd->RSSetViewports(_numViewports, _viewports.data());
 }
 
 void D3D12CommandList::SetScissor(uint32_t firstScissor, uint32_t numScissors, VgScissor* scissors)
 {
-	//thread_local std::array<D3D12_RECT, vg_num_max_viewports_and_scissors> d3d12Scissors;
-	//memcpy(_scissors.data() + first_scissor, scissors, num_scissors * sizeof(scissors[0]));
-	for (uint32_t i = firstScissor; i < firstScissor + numScissors; i++)
+	for (uint32_t i = 0; i < numScissors; i++)
 	{
-		_scissors[i] = {
+		_scissors[firstScissor + i] = {
 			.left = static_cast<LONG>(scissors[i].x),
 			.top = static_cast<LONG>(scissors[i].y),
 			.right = static_cast<LONG>(scissors[i].x + scissors[i].width),
 			.bottom = static_cast<LONG>(scissors[i].y + scissors[i].height)
 		};
 	}
-	_cmd->RSSetScissorRects(static_cast<UINT>(_scissors.size()), _scissors.data());
+	_numScissors = std::max(_numScissors, firstScissor + numScissors);
+	_cmd->RSSetScissorRects(_numScissors, _scissors.data());
+}
+
+void D3D12CommandList::ExecuteBundle(VgCommandList bundle)
+{
+	const auto d3d12Bundle = static_cast<D3D12CommandList*>(bundle);
+	_cmd->ExecuteBundle(d3d12Bundle->Cmd());
+
+	// The pipeline and index buffer set by the bundle stay bound, the ones it did not set are left untouched
+	if (d3d12Bundle->_finalPipeline) _boundPipeline = d3d12Bundle->_finalPipeline;
+	if (d3d12Bundle->_finalIndexType != static_cast<VgIndexType>(-1)) _currentIndexType = d3d12Bundle->_finalIndexType;
 }
 
 void D3D12CommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
@@ -746,19 +778,37 @@ void D3D12CommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount,
 	_cmd->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
-constexpr size_t AlignRowPitch(size_t width) {
-	const size_t alignment = D3D12_TEXTURE_DATA_PITCH_ALIGNMENT; // 256-byte alignment
-	return (width + alignment - 1) & ~(alignment - 1);
+// D3D12 has no multi draw command, the draws are recorded back to back with their root constants
+void D3D12CommandList::DrawMulti(uint32_t drawCount, const VgMultiDrawInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants)
+{
+	for (uint32_t i = 0; i < drawCount; i++)
+	{
+		if (rootConstants)
+		{
+			_cmd->SetGraphicsRoot32BitConstants(0, rootConstants->num_32bit_values,
+				static_cast<const uint8_t*>(rootConstants->data) + i * rootConstants->stride, rootConstants->offset_in_32bit_values);
+		}
+		_cmd->DrawInstanced(draws[i].vertex_count, instanceCount, draws[i].first_vertex, firstInstance);
+	}
 }
 
-constexpr uint32_t GetSubresourceIndex(const VgRegion& region) {
-	return region.mip + (region.base_array_layer * region.array_layers);
+void D3D12CommandList::DrawIndexedMulti(uint32_t drawCount, const VgMultiDrawIndexedInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants)
+{
+	for (uint32_t i = 0; i < drawCount; i++)
+	{
+		if (rootConstants)
+		{
+			_cmd->SetGraphicsRoot32BitConstants(0, rootConstants->num_32bit_values,
+				static_cast<const uint8_t*>(rootConstants->data) + i * rootConstants->stride, rootConstants->offset_in_32bit_values);
+		}
+		_cmd->DrawIndexedInstanced(draws[i].index_count, instanceCount, draws[i].first_index, draws[i].vertex_offset, firstInstance);
+	}
 }
 
-constexpr size_t AlignRowPitchWithFormat(size_t width, VgFormat format) {
-	const auto bcSize = GetBCFormatBlockSize(format);
-	if (bcSize == 0) return AlignRowPitch(width * FormatSizeBytes(format));
-	return AlignRowPitch(((width + 3) / 4) * bcSize);
+static_assert(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT == texture_copy_row_pitch_alignment);
+
+constexpr uint32_t GetSubresourceIndex(const VgRegion& region) {
+	return region.mip + (region.base_array_layer * region.array_layers);
 }
 
 void D3D12CommandList::CopyBufferToBuffer(VgBuffer dst, uint64_t dstOffset, VgBuffer src, uint64_t srcOffset, uint64_t size)
@@ -786,7 +836,7 @@ void D3D12CommandList::CopyBufferToTexture(VgTexture dst, const VgRegion& dstReg
 				.Width = dstRegion.width,
 				.Height = dstRegion.height,
 				.Depth = dstRegion.depth,
-				.RowPitch = static_cast<UINT>(AlignRowPitchWithFormat(dstRegion.width, dstTexture->Desc().format))
+				.RowPitch = static_cast<UINT>(TextureCopyRowPitch(dstRegion.width, dstTexture->Desc().format))
 			}
 		}
 	};
@@ -806,7 +856,7 @@ void D3D12CommandList::CopyTextureToBuffer(VgBuffer dst, uint64_t dstOffset, VgT
 				.Width = srcRegion.width,
 				.Height = srcRegion.height,
 				.Depth = srcRegion.depth,
-				.RowPitch = static_cast<UINT>(AlignRowPitchWithFormat(srcRegion.width, srcTexture->Desc().format))
+				.RowPitch = static_cast<UINT>(TextureCopyRowPitch(srcRegion.width, srcTexture->Desc().format))
 			}
 		}
 	};
@@ -834,6 +884,39 @@ void D3D12CommandList::CopyTextureToTexture(VgTexture dst, const VgRegion& dstRe
 	_cmd->CopyTextureRegion(&dstLocation, dstRegion.offset.x, dstRegion.offset.y, dstRegion.offset.z, &srcLocation, nullptr);
 }
 
+// D3D12 has no batched copies, the regions still share a single API call and validation pass
+void D3D12CommandList::CopyBufferToBufferRegions(VgBuffer dst, VgBuffer src, uint32_t numRegions, const VgBufferCopyRegion* regions)
+{
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		CopyBufferToBuffer(dst, regions[i].dst_offset, src, regions[i].src_offset, regions[i].size);
+	}
+}
+
+void D3D12CommandList::CopyBufferToTextureRegions(VgTexture dst, VgBuffer src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions)
+{
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		CopyBufferToTexture(dst, regions[i].texture_region, src, regions[i].buffer_offset);
+	}
+}
+
+void D3D12CommandList::CopyTextureToBufferRegions(VgBuffer dst, VgTexture src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions)
+{
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		CopyTextureToBuffer(dst, regions[i].buffer_offset, src, regions[i].texture_region);
+	}
+}
+
+void D3D12CommandList::CopyTextureToTextureRegions(VgTexture dst, VgTexture src, uint32_t numRegions, const VgTextureCopyRegion* regions)
+{
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		CopyTextureToTexture(dst, regions[i].dst_region, src, regions[i].src_region);
+	}
+}
+
 void D3D12CommandList::BeginMarker(const char* name, float color[3])
 {
 	auto& runtime = static_cast<D3D12Device*>(_pool->Device())->PixEventRuntime();
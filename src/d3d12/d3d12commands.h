@@ -50,6 +50,7 @@ public:
 	void RestoreDescriptorState() override;
 
 	void Begin() override;
+	void BeginBundle(const VgBundleInheritanceInfo&) override;
 	void End() override;
 
 	void SetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, const VgVertexBufferView* buffers) override;
@@ -57,6 +58,7 @@ public:
 
 	void SetRootConstants(VgPipelineType pipelineType, uint32_t offsetIn32bitValues, uint32_t num32bitValues, const void* data) override;
 	void SetPipeline(VgPipeline pipeline) override;
+	void SetGraphicsState(const GraphicsPipelineParts& state) override;
 
 	void Barrier(const VgDependencyInfo& dependencyInfo) override;
 
@@ -64,20 +66,28 @@ public:
 	void EndRendering() override;
 	void SetViewport(uint32_t firstViewport, uint32_t numViewports, VgViewport* viewports) override;
 	void SetScissor(uint32_t firstScissor, uint32_t numScissors, VgScissor* scissors) override;
+	void ExecuteBundle(VgCommandList bundle) override;
 
 	void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
 	void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, uint32_t vertexOffset, uint32_t firstInstance) override;
+	void DrawMulti(uint32_t drawCount, const VgMultiDrawInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants) override;
+	void DrawIndexedMulti(uint32_t drawCount, const VgMultiDrawIndexedInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants) override;
 	void Dispatch(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z) override;
 	void DrawIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) override;
 	void DrawIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride) override;
 	void DrawIndexedIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) override;
 	void DrawIndexedIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride) override;
 	void DispatchIndirect(VgBuffer buffer, uint64_t offset) override;
+	void DispatchMesh(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z) override;
 
 	void CopyBufferToBuffer(VgBuffer dst, uint64_t dstOffset, VgBuffer src, uint64_t srcOffset, uint64_t size) override;
 	void CopyBufferToTexture(VgTexture dst, const VgRegion& dstRegion, VgBuffer src, uint64_t srcOffset) override;
 	void CopyTextureToBuffer(VgBuffer dst, uint64_t dstOffset, VgTexture src, const VgRegion& srcRegion) override;
 	void CopyTextureToTexture(VgTexture dst, const VgRegion& dstRegion, VgTexture src, const VgRegion& srcRegion) override;
+	void CopyBufferToBufferRegions(VgBuffer dst, VgBuffer src, uint32_t numRegions, const VgBufferCopyRegion* regions) override;
+	void CopyBufferToTextureRegions(VgTexture dst, VgBuffer src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions) override;
+	void CopyTextureToBufferRegions(VgBuffer dst, VgTexture src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions) override;
+	void CopyTextureToTextureRegions(VgTexture dst, VgTexture src, uint32_t numRegions, const VgTextureCopyRegion* regions) override;
 
 	void BeginMarker(const char* name, float color[3]) override;
 	void EndMarker() override;
@@ -90,8 +100,13 @@ private:
 
 	D3D12Pipeline* _boundPipeline;
 	VgIndexType _currentIndexType;
+	// Bound when a bundle was closed, they stay bound in the lists executing it
+	D3D12Pipeline* _finalPipeline{ nullptr };
+	VgIndexType _finalIndexType{ static_cast<VgIndexType>(-1) };
 	std::array<D3D12_VIEWPORT, vg_num_max_viewports_and_scissors> _viewports;
 	std::array<D3D12_RECT, vg_num_max_viewports_and_scissors> _scissors;
+	uint32_t _numViewports;
+	uint32_t _numScissors;
 
 	std::array<uint32_t, vg_num_allowed_root_constants> _computeRootConstants;
 	vg::Vector<D3D12Buffer*> _oldIndirectCommandBuffers;
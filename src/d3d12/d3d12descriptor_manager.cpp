@@ -3,7 +3,7 @@
 #if VG_D3D12_SUPPORTED
 
 D3D12DescriptorHeap::D3D12DescriptorHeap(D3D12Device& device, D3D12_DESCRIPTOR_HEAP_TYPE type,
-	uint32_t descriptorCount, std::wstring_view name) : _device(&device), _descriptorCount(descriptorCount)
+	uint32_t descriptorCount, const char* name) : _device(&device), _descriptorCount(descriptorCount), _slots(descriptorCount, name)
 {
 	const D3D12_DESCRIPTOR_HEAP_FLAGS flags = (type == D3D12_DESCRIPTOR_HEAP_TYPE_DSV || type == D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
 		? D3D12_DESCRIPTOR_HEAP_FLAG_NONE : D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
@@ -14,7 +14,7 @@ D3D12DescriptorHeap::D3D12DescriptorHeap(D3D12Device& device, D3D12_DESCRIPTOR_H
 		.NodeMask = 0
 	};
 	ThrowOnError(_device->Device()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&_heap)));
-	_heap->SetName(name.data());
+	_heap->SetName(ConvertToWideString(name).data());
 	_descriptorSize = _device->Device()->GetDescriptorHandleIncrementSize(type);
 
 	_cpuStart = _heap->GetCPUDescriptorHandleForHeapStart();
@@ -23,12 +23,6 @@ D3D12DescriptorHeap::D3D12DescriptorHeap(D3D12Device& device, D3D12_DESCRIPTOR_H
 	else
 		_gpuStart = {0};
 
-	_freeSlots.resize(descriptorCount);
-	for (int32_t i = descriptorCount - 1; i >= 0; i--)
-	{
-		_freeSlots[i] = descriptorCount - i - 1;
-	}
-
 	if (flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE)
 	{
 		_device->GetMemoryStatistics().used_vram += _descriptorSize * descriptorCount;
@@ -45,26 +39,20 @@ D3D12DescriptorHeap::~D3D12DescriptorHeap()
 
 uint32_t D3D12DescriptorHeap::RequestDescriptor()
 {
-	std::scoped_lock lock(_access);
-	if (_freeSlots.empty())
-		throw std::runtime_error("No free descriptor slots");
-	const auto slot = _freeSlots.back();
-	_freeSlots.pop_back();
-	return slot;
+	return _slots.Allocate();
 }
 
 void D3D12DescriptorHeap::FreeDescriptor(uint32_t index)
 {
-	std::scoped_lock lock(_access);
-	_freeSlots.push_back(index);
+	_slots.Free(index);
 }
 
 D3D12DescriptorManager::D3D12DescriptorManager(D3D12Device& device)
 	: _device(&device),
-	_resourceHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, NumResourceDescriptors, L"Resource Heap"),
-	_samplerHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, NumSamplerDescriptors, L"Sampler Heap"),
-	_rtvHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, NumRTVDescriptors, L"Render Target View Heap"),
-	_dsvHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, NumDSVDescriptors, L"Depth Stencil View Heap")
+	_resourceHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, NumResourceDescriptors, "Resource Heap"),
+	_samplerHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, NumSamplerDescriptors, "Sampler Heap"),
+	_rtvHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, NumRTVDescriptors, "Render Target View Heap"),
+	_dsvHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, NumDSVDescriptors, "Depth Stencil View Heap")
 {
 }
 
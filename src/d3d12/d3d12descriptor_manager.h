@@ -3,6 +3,7 @@
 #include "d3d12device.h"
 #include "d3d12buffer.h"
 #include "d3d12texture.h"
+#include "../descriptor_allocator.h"
 #include <unordered_map>
 #include <string_view>
 #include <vector>
@@ -13,7 +14,7 @@
 class D3D12DescriptorHeap
 {
 public:
-	D3D12DescriptorHeap(D3D12Device& device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t descriptorCount, std::wstring_view name);
+	D3D12DescriptorHeap(D3D12Device& device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t descriptorCount, const char* name);
 	~D3D12DescriptorHeap();
 
 	uint32_t RequestDescriptor();
@@ -32,15 +33,15 @@ public:
 	}
 
 	ID3D12DescriptorHeap* Heap() const { return _heap.Get(); }
+	VgDescriptorHeapStatistics Statistics() { return _slots.Statistics(); }
 
 private:
 	D3D12Device* _device;
 	ComPtr<ID3D12DescriptorHeap> _heap;
 	uint32_t _descriptorSize;
 	uint32_t _descriptorCount;
-	std::mutex _access;
 
-	vg::Vector<uint32_t> _freeSlots;
+	DescriptorSlotAllocator _slots;
 	D3D12_CPU_DESCRIPTOR_HANDLE _cpuStart;
 	D3D12_GPU_DESCRIPTOR_HANDLE _gpuStart;
 };
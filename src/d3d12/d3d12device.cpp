@@ -1,6 +1,7 @@
 #include "d3d12device.h"
 #include "../common.h"
 #include <array>
+#include <algorithm>
 #include <string_view>
 
 #if VG_D3D12_SUPPORTED
@@ -291,6 +292,7 @@ D3D12Device::D3D12Device(D3D12Adapter& adapter, VgInitFlags initFlags)
 
 D3D12Device::~D3D12Device()
 {
+    for (auto& [hash, entry] : _graphicsStatePipelines) GetAllocator().Delete(entry.Pipeline);
     GetAllocator().Delete(_descriptorManager);
 }
 
@@ -326,6 +328,17 @@ VgShaderModule D3D12Device::CreateShaderModule(const void* data, uint64_t size)
 
 void D3D12Device::DestroyShaderModule(VgShaderModule module)
 {
+    {
+        // Another module at the same address must not hit pipelines compiled for this one
+        std::scoped_lock lock(_graphicsStatePipelineMutex);
+        std::erase_if(_graphicsStatePipelines, [&](auto& item)
+            {
+                const auto& modules = item.second.ShaderModules;
+                if (std::find(modules.begin(), modules.end(), module) == modules.end()) return false;
+                GetAllocator().Delete(item.second.Pipeline);
+                return true;
+            });
+    }
     GetAllocator().Delete(module);
 }
 
@@ -339,6 +352,35 @@ VgPipeline D3D12Device::CreateComputePipeline(VgShaderModule shaderModule)
     return new(GetAllocator().Allocate<D3D12ComputePipeline>()) D3D12ComputePipeline(*this, shaderModule);
 }
 
+VgPipeline D3D12Device::CreateGraphicsPipelineLibrary(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc)
+{
+    return new(GetAllocator().Allocate<D3D12GraphicsPipelineLibrary>()) D3D12GraphicsPipelineLibrary(*this, parts, desc);
+}
+
+VgPipeline D3D12Device::LinkGraphicsPipeline(uint32_t numLibraries, const VgPipeline* libraries, const VgGraphicsPipelineDesc& desc)
+{
+    return new(GetAllocator().Allocate<D3D12GraphicsPipeline>()) D3D12GraphicsPipeline(*this, desc);
+}
+
+D3D12GraphicsPipeline* D3D12Device::GetGraphicsStatePipeline(const GraphicsPipelineParts& state)
+{
+    vg::Vector<uint8_t> key;
+    state.BuildKey(key);
+    const uint64_t hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(key.data()), key.size()));
+
+    // Compiling under the lock keeps threads which need the same state from compiling it twice
+    std::scoped_lock lock(_graphicsStatePipelineMutex);
+    auto [begin, end] = _graphicsStatePipelines.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+    {
+        if (it->second.Key == key) return it->second.Pipeline;
+    }
+
+    auto pipeline = new(GetAllocator().Allocate<D3D12GraphicsPipeline>()) D3D12GraphicsPipeline(*this, state.Desc());
+    _graphicsStatePipelines.emplace(hash, GraphicsStatePipeline{ std::move(key), state.ShaderModules(), pipeline });
+    return pipeline;
+}
+
 void D3D12Device::DestroyPipeline(VgPipeline pipeline)
 {
     GetAllocator().Delete(pipeline);
@@ -511,7 +553,8 @@ void D3D12Device::WaitFence(VgFence fence, uint64_t value)
 
 uint64_t D3D12Device::GetFenceValue(VgFence fence)
 {
-    return reinterpret_cast<ID3D12Fence*>(fence)->GetCompletedValue();
+    std::unique_lock lock(_fenceMutex);
+    return _fences[fence].Fence->GetCompletedValue();
 }
 
 void D3D12Device::SubmitCommandLists(uint32_t numSubmits, const VgSubmitInfo* submits)
@@ -578,6 +621,30 @@ uint32_t D3D12Device::GetSamplerIndex(VgSampler sampler)
     return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(sampler)) - 1;
 }
 
+void D3D12Device::GetMemoryBudget(VgMemoryBudget& budget)
+{
+    D3D12MA::Budget local, nonLocal;
+    _allocator->GetBudget(&local, &nonLocal);
+
+    // On UMA adapters both segments describe the same physical memory and the non-local one is reported as empty
+    budget.num_heaps = 0;
+    budget.heaps[budget.num_heaps++] = { VG_MEMORY_HEAP_DEVICE_LOCAL, local.BudgetBytes, local.UsageBytes };
+    if (!_allocator->IsUMA())
+        budget.heaps[budget.num_heaps++] = { VG_MEMORY_HEAP_NONE, nonLocal.BudgetBytes, nonLocal.UsageBytes };
+}
+
+bool D3D12Device::GetDescriptorHeapStatistics(VgDescriptorHeapType type, VgDescriptorHeapStatistics& stats)
+{
+    switch (type)
+    {
+    case VG_DESCRIPTOR_HEAP_TYPE_RESOURCE: stats = _descriptorManager->ResourceHeap().Statistics(); return true;
+    case VG_DESCRIPTOR_HEAP_TYPE_SAMPLER: stats = _descriptorManager->SamplerHeap().Statistics(); return true;
+    case VG_DESCRIPTOR_HEAP_TYPE_RENDER_TARGET: stats = _descriptorManager->RTVHeap().Statistics(); return true;
+    case VG_DESCRIPTOR_HEAP_TYPE_DEPTH_STENCIL: stats = _descriptorManager->DSVHeap().Statistics(); return true;
+    default: return false;
+    }
+}
+
 void D3D12Device::InitDescriptorManagement()
 {
     _descriptorManager = new (GetAllocator().Allocate<D3D12DescriptorManager>()) D3D12DescriptorManager(*this);
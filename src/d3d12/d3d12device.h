@@ -273,6 +273,7 @@ struct D3D12UtilityPipelines
 
 class D3D12Adapter;
 class D3D12DescriptorManager;
+class D3D12GraphicsPipeline;
 class D3D12Device final : public VgDevice_t
 {
 public:
@@ -283,6 +284,8 @@ public:
 	VgGraphicsApi Api() const override { return VG_GRAPHICS_API_D3D12; }
 	const VgMemoryStatistics& GetMemoryStatistics() const override { return _memStats; }
 	VgMemoryStatistics& GetMemoryStatistics() { return _memStats; }
+	void GetMemoryBudget(VgMemoryBudget& budget) override;
+	bool GetDescriptorHeapStatistics(VgDescriptorHeapType type, VgDescriptorHeapStatistics& stats) override;
 
 	uint32_t NodeMask() const { return 0; }
 	VgAdapter Adapter() const override;
@@ -308,6 +311,8 @@ public:
 
 	D3D12IndirectCommandSignatureManager& GetCommandSignatureManager() { return _commandSignatureManager; }
 	D3D12_EXECUTE_INDIRECT_TIER GetExecuteIndirectTier() const { return _executeIndirectTier; }
+	// Pipeline for a complete state of vgCmdSetGraphicsState(), compiled on first use
+	D3D12GraphicsPipeline* GetGraphicsStatePipeline(const GraphicsPipelineParts& state);
 
 	VgCommandPool CreateCommandPool(VgCommandPoolFlags flags, VgQueue queue) override;
 	void DestroyCommandPool(VgCommandPool pool) override;
@@ -320,6 +325,8 @@ public:
 
 	VgPipeline CreateGraphicsPipeline(const VgGraphicsPipelineDesc& desc) override;
 	VgPipeline CreateComputePipeline(VgShaderModule shaderModule) override;
+	VgPipeline CreateGraphicsPipelineLibrary(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc) override;
+	VgPipeline LinkGraphicsPipeline(uint32_t numLibraries, const VgPipeline* libraries, const VgGraphicsPipelineDesc& desc) override;
 	void DestroyPipeline(VgPipeline pipeline) override;
 
 	VgFence CreateFence(uint64_t initialValue) override;
@@ -378,6 +385,16 @@ private:
 	uintptr_t _nextFenceIndex{ 1 };
 	vg::UnorderedMap<void*, FenceWithEvent> _fences;
 
+	std::mutex _graphicsStatePipelineMutex;
+	struct GraphicsStatePipeline
+	{
+		vg::Vector<uint8_t> Key;
+		std::array<VgShaderModule, 7> ShaderModules;
+		D3D12GraphicsPipeline* Pipeline;
+	};
+	// Keyed by the hash of GraphicsStatePipeline::Key
+	vg::UnorderedMultimap<uint64_t, GraphicsStatePipeline> _graphicsStatePipelines;
+
 	VgMemoryStatistics _memStats;
 
 	void InitDescriptorManagement();
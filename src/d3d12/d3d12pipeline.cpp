@@ -314,6 +314,7 @@ D3D12GraphicsPipeline::D3D12GraphicsPipeline(D3D12Device& device, const VgGraphi
 	ThrowOnError(device.Device()->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&_state)));
 
 	_primitiveTopology = PrimitiveTopologyToD3D12(desc);
+	_vertexPipeline = desc.vertex_pipeline_type;
 
 	_device->GetMemoryStatistics().num_pipelines++;
 }
@@ -323,4 +324,12 @@ D3D12GraphicsPipeline::~D3D12GraphicsPipeline()
 	_device->GetMemoryStatistics().num_pipelines--;
 }
 
+D3D12GraphicsPipelineLibrary::D3D12GraphicsPipelineLibrary(D3D12Device& device, VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc)
+{
+	_device = &device;
+	_type = VG_PIPELINE_TYPE_GRAPHICS;
+	_parts.Add(parts, desc);
+	_library = &_parts;
+}
+
 #endif
\ No newline at end of file
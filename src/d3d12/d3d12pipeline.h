@@ -45,4 +45,17 @@ private:
 	D3D12_PRIMITIVE_TOPOLOGY _primitiveTopology;
 };
 
+// D3D12 cannot link separately compiled parts of a graphics pipeline, a library only keeps its part of the description
+// and linking compiles the whole pipeline state
+class D3D12GraphicsPipelineLibrary : public D3D12Pipeline
+{
+public:
+	D3D12GraphicsPipelineLibrary(D3D12Device& device, VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc);
+
+	void SetName(const char* name) override {}
+
+private:
+	GraphicsPipelineParts _parts;
+};
+
 #endif
\ No newline at end of file
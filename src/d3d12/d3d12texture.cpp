@@ -301,8 +301,11 @@ D3D12Texture::D3D12Texture(D3D12Device& device, const VgTextureDesc& desc) : _de
 		}
 	};
 
+	// D3D12 has no lazily allocated memory, transient attachments are cleared or discarded before their first use
+	// so the closest thing is skipping the zero fill of their heaps
 	D3D12MA::ALLOCATION_DESC allocationDesc = {
-		.HeapType = HeapTypeToD3D12HeapType(desc.heap_type)
+		.HeapType = HeapTypeToD3D12HeapType(desc.heap_type),
+		.ExtraHeapFlags = (desc.usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT) ? D3D12_HEAP_FLAG_CREATE_NOT_ZEROED : D3D12_HEAP_FLAG_NONE
 	};
 
 	auto layout = VgTextureLayoutToBarrierLayout(desc.initial_layout);
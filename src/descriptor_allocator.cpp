@@ -0,0 +1,54 @@
+#include "descriptor_allocator.h"
+
+// Warn once per heap when occupancy first reaches this fraction, well before allocation starts failing
+static constexpr double nearly_full_fraction = 0.9;
+
+DescriptorSlotAllocator::DescriptorSlotAllocator(uint32_t capacity, const char* name)
+	: _name(name), _capacity(capacity)
+{
+}
+
+uint32_t DescriptorSlotAllocator::Allocate()
+{
+	std::scoped_lock lock(_access);
+	uint32_t slot;
+	if (!_freeSlots.empty())
+	{
+		slot = _freeSlots.back();
+		_freeSlots.pop_back();
+	}
+	else if (_highWaterMark < _capacity)
+	{
+		slot = _highWaterMark++;
+	}
+	else throw VgFailure(std::format("{}: all {} descriptor slots are in use", _name, _capacity));
+
+	_totalAllocations++;
+	const uint64_t live = _totalAllocations - _totalFrees;
+	if (!_warnedNearlyFull && live >= static_cast<uint64_t>(_capacity * nearly_full_fraction))
+	{
+		_warnedNearlyFull = true;
+		LOG(WARN, "{}: {} of {} descriptor slots are in use", _name, live, _capacity);
+	}
+	return slot;
+}
+
+void DescriptorSlotAllocator::Free(uint32_t slot)
+{
+	std::scoped_lock lock(_access);
+	_freeSlots.push_back(slot);
+	_totalFrees++;
+}
+
+VgDescriptorHeapStatistics DescriptorSlotAllocator::Statistics()
+{
+	std::scoped_lock lock(_access);
+	return {
+		.capacity = _capacity,
+		.live_descriptors = static_cast<uint32_t>(_totalAllocations - _totalFrees),
+		.high_water_mark = _highWaterMark,
+		.free_list_length = static_cast<uint32_t>(_freeSlots.size()),
+		.total_allocations = _totalAllocations,
+		.total_frees = _totalFrees
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common.h"
+#include <mutex>
+
+// Hands out bindless descriptor indices from a fixed-size heap. Freed indices are reused first, new ones are bumped
+// from the high-water mark, so the free list only holds the holes below it. Tracks the numbers reported by
+// vgDeviceGetDescriptorHeapStatistics().
+class DescriptorSlotAllocator
+{
+public:
+	DescriptorSlotAllocator(uint32_t capacity, const char* name);
+
+	// Throws VgFailure once every slot is in use
+	uint32_t Allocate();
+	void Free(uint32_t slot);
+
+	VgDescriptorHeapStatistics Statistics();
+
+private:
+	const char* _name;
+	uint32_t _capacity;
+	uint32_t _highWaterMark{ 0 };
+	uint64_t _totalAllocations{ 0 };
+	uint64_t _totalFrees{ 0 };
+	bool _warnedNearlyFull{ false };
+
+	std::mutex _access;
+	vg::Vector<uint32_t> _freeSlots;
+};
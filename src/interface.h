@@ -1,6 +1,11 @@
 #pragma once
 
 #include "varyag.h"
+#include "memory_budget.h"
+#include "resource_state_tracker.h"
+#include "transient_attachments.h"
+#include "shadow_state.h"
+#include "pipeline_library.h"
 #include <optional>
 
 struct VgAdapter_t
@@ -31,6 +36,12 @@ public:
 	virtual VgGraphicsApi Api() const = 0;
 	virtual VgAdapter Adapter() const = 0;
 	virtual const VgMemoryStatistics& GetMemoryStatistics() const = 0;
+	virtual void GetMemoryBudget(VgMemoryBudget& budget) = 0;
+	// False if the backend has no heap of this type
+	virtual bool GetDescriptorHeapStatistics(VgDescriptorHeapType type, VgDescriptorHeapStatistics& stats) = 0;
+	MemoryBudgetMonitor& BudgetMonitor() { return _budgetMonitor; }
+	ResourceStateTracker& StateTracker() { return _stateTracker; }
+	TransientAttachmentViews& TransientAttachments() { return _transientAttachments; }
 
 	virtual VgCommandPool CreateCommandPool(VgCommandPoolFlags flags, VgQueue queue) = 0;
 	virtual void DestroyCommandPool(VgCommandPool pool) = 0;
@@ -39,6 +50,9 @@ public:
 	virtual VgShaderModule CreateShaderModule(const void* data, uint64_t size) = 0;
 	virtual void DestroyShaderModule(VgShaderModule module) = 0;
 	virtual VgPipeline CreateGraphicsPipeline(const VgGraphicsPipelineDesc& desc) = 0;
+	virtual VgPipeline CreateGraphicsPipelineLibrary(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc) = 0;
+	// desc is the validated union of the parts of the libraries
+	virtual VgPipeline LinkGraphicsPipeline(uint32_t numLibraries, const VgPipeline* libraries, const VgGraphicsPipelineDesc& desc) = 0;
 	virtual VgPipeline CreateComputePipeline(VgShaderModule shaderModule) = 0;
 	virtual void DestroyPipeline(VgPipeline pipeline) = 0;
 	virtual VgFence CreateFence(uint64_t initialValue) = 0;
@@ -60,6 +74,11 @@ public:
 	virtual void SubmitCommandLists(uint32_t numSubmits, const VgSubmitInfo* submits) = 0;
 
 	virtual uint32_t GetSamplerIndex(VgSampler_t* sampler) = 0;
+
+protected:
+	MemoryBudgetMonitor _budgetMonitor;
+	ResourceStateTracker _stateTracker;
+	TransientAttachmentViews _transientAttachments;
 };
 
 struct VgCommandPool_t
@@ -71,6 +90,7 @@ public:
 	virtual void SetName(const char* name) = 0;
 	virtual VgDevice Device() const = 0;
 	VgQueue Queue() const { return _queue; }
+	VgCommandPoolFlags Flags() const { return _flags; }
 
 	virtual VgCommandList AllocateCommandList() = 0;
 	virtual void FreeCommandList(VgCommandList list) = 0;
@@ -78,6 +98,7 @@ public:
 
 protected:
 	VgQueue _queue;
+	VgCommandPoolFlags _flags;
 };
 
 struct VgCommandList_t
@@ -87,7 +108,9 @@ public:
 	{
 		STATE_NONE = 0,
 		STATE_OPEN = 1,
-		STATE_RENDERING = 2
+		STATE_RENDERING = 2,
+		// Rendering started with VG_RENDERING_FLAG_BUNDLES, only bundles can be executed
+		STATE_RENDERING_BUNDLES = 4
 	};
 
 	virtual ~VgCommandList_t() = default;
@@ -100,8 +123,18 @@ public:
 	StateFlags GetState() const { return _state; }
 
 	void SetState(StateFlags flags) { _state = flags; }
+	bool IsBundle() const { return CommandPool()->Flags() & VG_COMMAND_POOL_FLAG_BUNDLE; }
+
+	// Only set for lists of VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES pools
+	CommandListStateTracker* StateTracker() { return _stateTracker ? &*_stateTracker : nullptr; }
+	void EnableStateTracking() { _stateTracker.emplace(); }
+	// Filters redundant binds before they reach the backend
+	CommandListShadowState& ShadowState() { return _shadowState; }
+	CommandListGraphicsState& GraphicsState() { return _graphicsState; }
 
 	virtual void Begin() = 0;
+	// Opens a list of a VG_COMMAND_POOL_FLAG_BUNDLE pool, which starts in the rendering state
+	virtual void BeginBundle(const VgBundleInheritanceInfo& info) = 0;
 	virtual void End() = 0;
 
 	virtual void SetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, const VgVertexBufferView* buffers) = 0;
@@ -109,7 +142,8 @@ public:
 
 	virtual void SetRootConstants(VgPipelineType pipelineType, uint32_t offsetIn32bitValues, uint32_t num32bitValues, const void* data) = 0;
 	virtual void SetPipeline(VgPipeline pipeline) = 0;
-
+	// Binds a complete state set with vgCmdSetGraphicsState() in place of a pipeline
+	virtual void SetGraphicsState(const GraphicsPipelineParts& state) = 0;
 
 	virtual void Barrier(const VgDependencyInfo& dependencyInfo) = 0;
 
@@ -117,26 +151,37 @@ public:
 	virtual void EndRendering() = 0;
 	virtual void SetViewport(uint32_t firstViewport, uint32_t numViewports, VgViewport* viewports) = 0;
 	virtual void SetScissor(uint32_t firstScissor, uint32_t numScissors, VgScissor* scissors) = 0;
+	virtual void ExecuteBundle(VgCommandList bundle) = 0;
 
 	virtual void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) = 0;
 	virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, uint32_t vertexOffset, uint32_t firstInstance) = 0;
+	virtual void DrawMulti(uint32_t drawCount, const VgMultiDrawInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants) = 0;
+	virtual void DrawIndexedMulti(uint32_t drawCount, const VgMultiDrawIndexedInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants) = 0;
 	virtual void Dispatch(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z) = 0;
 	virtual void DrawIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) = 0;
 	virtual void DrawIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride) = 0;
 	virtual void DrawIndexedIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) = 0;
 	virtual void DrawIndexedIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride) = 0;
 	virtual void DispatchIndirect(VgBuffer buffer, uint64_t offset) = 0;
+	virtual void DispatchMesh(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z) = 0;
 
 	virtual void CopyBufferToBuffer(VgBuffer dst, uint64_t dstOffset, VgBuffer src, uint64_t srcOffset, uint64_t size) = 0;
 	virtual void CopyBufferToTexture(VgTexture dst, const VgRegion& dstRegion, VgBuffer src, uint64_t srcOffset) = 0;
 	virtual void CopyTextureToBuffer(VgBuffer dst, uint64_t dstOffset, VgTexture src, const VgRegion& srcRegion) = 0;
 	virtual void CopyTextureToTexture(VgTexture dst, const VgRegion& dstRegion, VgTexture src, const VgRegion& srcRegion) = 0;
+	virtual void CopyBufferToBufferRegions(VgBuffer dst, VgBuffer src, uint32_t numRegions, const VgBufferCopyRegion* regions) = 0;
+	virtual void CopyBufferToTextureRegions(VgTexture dst, VgBuffer src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions) = 0;
+	virtual void CopyTextureToBufferRegions(VgBuffer dst, VgTexture src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions) = 0;
+	virtual void CopyTextureToTextureRegions(VgTexture dst, VgTexture src, uint32_t numRegions, const VgTextureCopyRegion* regions) = 0;
 
 	virtual void BeginMarker(const char* name, float color[3]) = 0;
 	virtual void EndMarker() = 0;
 
 protected:
 	StateFlags _state;
+	std::optional<CommandListStateTracker> _stateTracker;
+	CommandListShadowState _shadowState;
+	CommandListGraphicsState _graphicsState;
 };
 
 struct VgBuffer_t
@@ -150,6 +195,8 @@ public:
 	virtual const VgBufferDesc& Desc() const = 0;
 	virtual uint32_t CreateView(const VgBufferViewDesc& desc) = 0;
 	virtual void DestroyViews() = 0;
+	// GPU virtual address on D3D12, buffer device address on Vulkan
+	virtual uint64_t GpuAddress() const = 0;
 
 	virtual void* Map() = 0;
 	virtual void Unmap() = 0;
@@ -188,9 +235,15 @@ public:
 	virtual void SetName(const char* name) = 0;
 	virtual VgDevice Device() const = 0;
 	VgPipelineType Type() const { return _type; }
+	// Non-null for graphics pipeline libraries, which cannot be bound
+	const GraphicsPipelineParts* Library() const { return _library; }
+	// Only set for graphics pipelines
+	VgVertexPipeline VertexPipeline() const { return _vertexPipeline; }
 
 protected:
 	VgPipelineType _type;
+	const GraphicsPipelineParts* _library{ nullptr };
+	VgVertexPipeline _vertexPipeline{ VG_VERTEX_PIPELINE_FIXED_FUNCTION };
 };
 
 struct VgSwapChain_t
@@ -0,0 +1,44 @@
+#include "memory_budget.h"
+#include "interface.h"
+
+static_assert(VG_NUM_MAX_MEMORY_HEAPS <= 32, "_heapsAboveThreshold holds one bit per heap");
+
+void MemoryBudgetMonitor::SetNotification(const VgMemoryBudgetNotification* notification)
+{
+	std::scoped_lock lock(_mutex);
+	_notification = notification ? *notification : VgMemoryBudgetNotification{};
+	_heapsAboveThreshold = 0;
+	_enabled = _notification.callback != nullptr;
+}
+
+void MemoryBudgetMonitor::Check(VgDevice device)
+{
+	if (!_enabled) return;
+
+	VgMemoryBudget budget{};
+	device->GetMemoryBudget(budget);
+
+	uint32_t crossed = 0;
+	VgMemoryBudgetNotification notification;
+	{
+		std::scoped_lock lock(_mutex);
+		if (!_notification.callback) return;
+		notification = _notification;
+
+		uint32_t above = 0;
+		for (uint32_t i = 0; i < budget.num_heaps; i++)
+		{
+			const auto& heap = budget.heaps[i];
+			if (heap.budget && heap.usage > static_cast<uint64_t>(heap.budget * static_cast<double>(_notification.threshold)))
+				above |= 1u << i;
+		}
+		crossed = above & ~_heapsAboveThreshold;
+		_heapsAboveThreshold = above;
+	}
+
+	// Called without holding the lock, so the callback may free resources or query the budget again
+	for (uint32_t i = 0; i < budget.num_heaps; i++)
+	{
+		if (crossed & (1u << i)) notification.callback(notification.user_data, i, &budget.heaps[i]);
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "varyag.h"
+#include <atomic>
+#include <mutex>
+
+// Edge triggered over-budget notifications. Checked after resource creation and once per submission, so budget
+// changes caused by other processes are noticed at frame granularity.
+class MemoryBudgetMonitor
+{
+public:
+	void SetNotification(const VgMemoryBudgetNotification* notification);
+	// Invokes the callback for every heap which crossed the threshold since the previous check
+	void Check(VgDevice device);
+
+private:
+	std::mutex _mutex;
+	VgMemoryBudgetNotification _notification{};
+	std::atomic<bool> _enabled{ false };
+	// Bit per heap index, set while the heap is above the threshold
+	uint32_t _heapsAboveThreshold{ 0 };
+};
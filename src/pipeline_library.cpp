@@ -0,0 +1,160 @@
+#include "pipeline_library.h"
+#include <algorithm>
+#include <cstring>
+
+template <class T>
+static void Append(vg::Vector<uint8_t>& key, const T& value)
+{
+	static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>, "structs may contain padding");
+	const auto offset = key.size();
+	key.resize(offset + sizeof(T));
+	memcpy(key.data() + offset, &value, sizeof(T));
+}
+
+static void Append(vg::Vector<uint8_t>& key, const VgStencilState& state)
+{
+	Append(key, state.fail_op);
+	Append(key, state.depth_fail_op);
+	Append(key, state.pass_op);
+	Append(key, state.compare_op);
+}
+
+void GraphicsPipelineParts::Clear()
+{
+	_parts = VG_GRAPHICS_PIPELINE_LIBRARY_NONE;
+	_desc = {};
+}
+
+void GraphicsPipelineParts::Add(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc)
+{
+	if (parts & VG_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT)
+	{
+		const uint32_t numAttributes = std::min(desc.fixed_function.num_vertex_attributes, vg_num_max_vertex_attributes);
+		if (numAttributes > 0) std::copy_n(desc.fixed_function.vertex_attributes, numAttributes, _vertexAttributes.begin());
+		_desc.fixed_function.num_vertex_attributes = numAttributes;
+		_desc.fixed_function.vertex_attributes = _vertexAttributes.data();
+		_desc.primitive_topology = desc.primitive_topology;
+		_desc.primitive_restart_enable = desc.primitive_restart_enable;
+	}
+	if (parts & VG_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION)
+	{
+		_desc.vertex_pipeline_type = desc.vertex_pipeline_type;
+		_desc.fixed_function.vertex_shader = desc.fixed_function.vertex_shader;
+		_desc.fixed_function.hull_shader = desc.fixed_function.hull_shader;
+		_desc.fixed_function.domain_shader = desc.fixed_function.domain_shader;
+		_desc.fixed_function.geometry_shader = desc.fixed_function.geometry_shader;
+		_desc.mesh = desc.mesh;
+		_desc.tesselation_control_points = desc.tesselation_control_points;
+		_desc.rasterization_state = desc.rasterization_state;
+	}
+	if (parts & VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER)
+	{
+		_desc.pixel_shader = desc.pixel_shader;
+		_desc.depth_stencil_state = desc.depth_stencil_state;
+	}
+	if (parts & VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT)
+	{
+		_desc.num_color_attachments = desc.num_color_attachments;
+		std::copy_n(desc.color_attachment_formats, vg_num_max_color_attachments, _desc.color_attachment_formats);
+		_desc.depth_stencil_format = desc.depth_stencil_format;
+		_desc.multisampling_state = desc.multisampling_state;
+		_desc.blend_state = desc.blend_state;
+	}
+	_parts |= parts;
+}
+
+void GraphicsPipelineParts::BuildKey(vg::Vector<uint8_t>& key) const
+{
+	key.clear();
+	Append(key, _parts);
+	if (_parts & VG_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT)
+	{
+		Append(key, _desc.fixed_function.num_vertex_attributes);
+		for (uint32_t i = 0; i < _desc.fixed_function.num_vertex_attributes; i++)
+		{
+			const auto& attribute = _vertexAttributes[i];
+			Append(key, attribute.format);
+			Append(key, attribute.offset);
+			Append(key, attribute.vertex_buffer_index);
+			Append(key, attribute.input_rate);
+			Append(key, attribute.instance_step_rate);
+		}
+		Append(key, _desc.primitive_topology);
+		Append(key, _desc.primitive_restart_enable);
+	}
+	if (_parts & VG_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION)
+	{
+		Append(key, _desc.vertex_pipeline_type);
+		Append(key, _desc.fixed_function.vertex_shader);
+		Append(key, _desc.fixed_function.hull_shader);
+		Append(key, _desc.fixed_function.domain_shader);
+		Append(key, _desc.fixed_function.geometry_shader);
+		Append(key, _desc.mesh.amplification_shader);
+		Append(key, _desc.mesh.mesh_shader);
+		Append(key, _desc.tesselation_control_points);
+		const auto& raster = _desc.rasterization_state;
+		Append(key, raster.fill_mode);
+		Append(key, raster.cull_mode);
+		Append(key, raster.front_face);
+		Append(key, raster.depth_clip_mode);
+		Append(key, raster.depth_bias);
+		Append(key, raster.depth_bias_clamp);
+		Append(key, raster.depth_bias_slope_factor);
+		Append(key, raster.conservative_rasterization_enable);
+		Append(key, raster.rasterization_discard_enable);
+	}
+	if (_parts & VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER)
+	{
+		Append(key, _desc.pixel_shader);
+		const auto& depthStencil = _desc.depth_stencil_state;
+		Append(key, depthStencil.depth_test_enable);
+		Append(key, depthStencil.depth_write_enable);
+		Append(key, depthStencil.depth_compare_op);
+		Append(key, depthStencil.stencil_test_enable);
+		Append(key, depthStencil.front);
+		Append(key, depthStencil.back);
+		Append(key, depthStencil.stencil_read_mask);
+		Append(key, depthStencil.stencil_write_mask);
+		Append(key, depthStencil.stencil_reference);
+		Append(key, depthStencil.depth_bounds_test_enable);
+		Append(key, depthStencil.min_depth_bounds);
+		Append(key, depthStencil.max_depth_bounds);
+	}
+	if (_parts & VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT)
+	{
+		Append(key, _desc.num_color_attachments);
+		for (uint32_t i = 0; i < _desc.num_color_attachments; i++) Append(key, _desc.color_attachment_formats[i]);
+		Append(key, _desc.depth_stencil_format);
+		Append(key, _desc.multisampling_state.sample_count);
+		Append(key, _desc.multisampling_state.alpha_to_coverage);
+		const auto& blend = _desc.blend_state;
+		Append(key, blend.logic_op_enable);
+		Append(key, blend.logic_op);
+		for (uint32_t i = 0; i < _desc.num_color_attachments; i++)
+		{
+			const auto& attachment = blend.attachments[i];
+			Append(key, attachment.blend_enable);
+			Append(key, attachment.src_color);
+			Append(key, attachment.dst_color);
+			Append(key, attachment.color_op);
+			Append(key, attachment.src_alpha);
+			Append(key, attachment.dst_alpha);
+			Append(key, attachment.alpha_op);
+			Append(key, attachment.color_write_mask);
+		}
+		for (float constant : blend.blend_constants) Append(key, constant);
+	}
+}
+
+std::array<VgShaderModule, 7> GraphicsPipelineParts::ShaderModules() const
+{
+	return {
+		_desc.fixed_function.vertex_shader,
+		_desc.fixed_function.hull_shader,
+		_desc.fixed_function.domain_shader,
+		_desc.fixed_function.geometry_shader,
+		_desc.mesh.amplification_shader,
+		_desc.mesh.mesh_shader,
+		_desc.pixel_shader
+	};
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "common.h"
+#include <optional>
+
+// The fields of a VgGraphicsPipelineDesc which belong to a set of graphics pipeline library parts, fields of other
+// parts stay zeroed. The vertex attributes are copied so the description outlives the call which provided it.
+class GraphicsPipelineParts
+{
+public:
+	static constexpr VgGraphicsPipelineLibraryFlags All = VG_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT
+		| VG_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION | VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER
+		| VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT;
+
+	GraphicsPipelineParts() = default;
+	GraphicsPipelineParts(const GraphicsPipelineParts&) = delete;
+	GraphicsPipelineParts& operator=(const GraphicsPipelineParts&) = delete;
+
+	void Clear();
+	// Copies the fields of parts from desc, overwriting the ones of parts which were added before
+	void Add(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc);
+	void Add(const GraphicsPipelineParts& other) { Add(other._parts, other._desc); }
+
+	VgGraphicsPipelineLibraryFlags Parts() const { return _parts; }
+	// Complete once Parts() == All
+	const VgGraphicsPipelineDesc& Desc() const { return _desc; }
+
+	// Replaces key with the parts and their fields written one by one, without the padding of the API structs.
+	// Equal keys describe the same pipeline.
+	void BuildKey(vg::Vector<uint8_t>& key) const;
+	// All shader modules of the description, unused stages are NULL
+	std::array<VgShaderModule, 7> ShaderModules() const;
+
+private:
+	VgGraphicsPipelineLibraryFlags _parts{ VG_GRAPHICS_PIPELINE_LIBRARY_NONE };
+	VgGraphicsPipelineDesc _desc{};
+	std::array<VgVertexAttribute, vg_num_max_vertex_attributes> _vertexAttributes{};
+};
+
+// Graphics state of a command list set with vgCmdSetGraphicsState(), which the next draw binds after it changed
+class CommandListGraphicsState
+{
+public:
+	// Called by vgCmdBegin() and vgCmdBeginBundle()
+	void Reset()
+	{
+		_state.Clear();
+		_dirty = false;
+		_bound = false;
+		_pipelineVertexPipeline.reset();
+	}
+	void Set(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc)
+	{
+		_state.Add(parts, desc);
+		_dirty = true;
+	}
+	// A pipeline replaces the bound state until the state is set again
+	void OnSetPipeline(VgPipelineType type, VgVertexPipeline vertexPipeline)
+	{
+		_dirty = false;
+		_bound = false;
+		if (type == VG_PIPELINE_TYPE_GRAPHICS) _pipelineVertexPipeline = vertexPipeline;
+	}
+	// Executing a bundle leaves the bound state undefined
+	void Invalidate()
+	{
+		_dirty |= _bound;
+		_pipelineVertexPipeline.reset();
+	}
+	void OnBind()
+	{
+		_dirty = false;
+		_bound = true;
+	}
+
+	bool NeedsBind() const { return _dirty; }
+	const GraphicsPipelineParts& State() const { return _state; }
+	// Of the state or graphics pipeline the next draw uses, unknown if none was set since vgCmdBegin() or the last
+	// executed bundle
+	std::optional<VgVertexPipeline> VertexPipeline() const
+	{
+		if (_dirty || _bound) return _state.Desc().vertex_pipeline_type;
+		return _pipelineVertexPipeline;
+	}
+
+private:
+	GraphicsPipelineParts _state;
+	bool _dirty{ false };
+	bool _bound{ false };
+	std::optional<VgVertexPipeline> _pipelineVertexPipeline;
+};
@@ -0,0 +1,64 @@
+#include "queue_scheduler.h"
+#include <algorithm>
+
+QueueScheduler::QueueScheduler(VgDevice device)
+	: _device(device)
+{
+	try
+	{
+		for (auto& timeline : _timelines)
+		{
+			timeline = { _device->CreateFence(0), 0 };
+		}
+	}
+	catch (...)
+	{
+		for (const auto& timeline : _timelines)
+		{
+			if (timeline.fence) _device->DestroyFence(timeline.fence);
+		}
+		throw;
+	}
+}
+
+QueueScheduler::~QueueScheduler()
+{
+	for (const auto& timeline : _timelines)
+	{
+		_device->WaitFence(timeline.fence, timeline.lastValue);
+		_device->DestroyFence(timeline.fence);
+	}
+}
+
+const VgSubmitInfo& QueueScheduler::PrepareSubmit(VgQueue queue, std::span<const VgCommandList> lists, std::span<const VgSyncPoint> dependencies)
+{
+	// Only the latest value per queue is waited for, value 0 is the initial fence value and always complete
+	std::array<uint64_t, 3> waitValues{};
+	for (const auto& dependency : dependencies)
+	{
+		if (dependency.queue >= _timelines.size())
+			throw VgFailure(std::format("Dependency on unknown queue {}", static_cast<uint64_t>(dependency.queue)));
+		if (dependency.value > _timelines[dependency.queue].lastValue)
+			throw VgFailure(std::format("Dependency on sync point {} of queue {} which has not been scheduled yet",
+				dependency.value, static_cast<uint64_t>(dependency.queue)));
+
+		waitValues[dependency.queue] = std::max(waitValues[dependency.queue], dependency.value);
+	}
+
+	_waits.clear();
+	for (size_t i = 0; i < _timelines.size(); i++)
+	{
+		if (waitValues[i] > 0) _waits.push_back({ _timelines[i].fence, waitValues[i] });
+	}
+	_signal = { _timelines[queue].fence, _timelines[queue].lastValue + 1 };
+
+	_submit = {
+		.num_wait_fences = static_cast<uint32_t>(_waits.size()),
+		.wait_fences = _waits.data(),
+		.num_signal_fences = 1,
+		.signal_fences = &_signal,
+		.num_command_lists = static_cast<uint32_t>(lists.size()),
+		.command_lists = const_cast<VgCommandList*>(lists.data())
+	};
+	return _submit;
+}
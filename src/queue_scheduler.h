@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common.h"
+#include "interface.h"
+#include <array>
+#include <mutex>
+#include <span>
+
+// Orders submits across the graphics, compute and transfer queues. Every queue owns a timeline fence which is
+// signaled once per scheduled submit, so a submit is identified by the VgSyncPoint it returns and later submits
+// on any queue can wait for it, e.g. the graphics queue for culling or post-processing running on async compute.
+class QueueScheduler
+{
+public:
+	explicit QueueScheduler(VgDevice device);
+	// Waits for everything scheduled so far before destroying the fences
+	~QueueScheduler();
+
+	VgDevice Device() const { return _device; }
+	VgFence Fence(VgQueue queue) const { return _timelines[queue].fence; }
+	uint64_t LastValue(VgQueue queue) const { return _timelines[queue].lastValue; }
+
+	// Builds the submit and hands it to submitFn, which performs it. Runs under the scheduler lock,
+	// so the values signaled on every fence increase in the order the submits reach the queue
+	template <class SubmitFn>
+	VgSyncPoint Schedule(VgQueue queue, std::span<const VgCommandList> lists, std::span<const VgSyncPoint> dependencies, SubmitFn&& submitFn)
+	{
+		std::scoped_lock lock(_mutex);
+
+		const VgSubmitInfo& submit = PrepareSubmit(queue, lists, dependencies);
+		submitFn(submit);
+		return { queue, ++_timelines[queue].lastValue };
+	}
+
+private:
+	struct Timeline
+	{
+		VgFence fence;
+		uint64_t lastValue;
+	};
+
+	VgDevice _device;
+	std::array<Timeline, 3> _timelines{};
+
+	std::mutex _mutex;
+	vg::Vector<VgFenceOperation> _waits;
+	VgFenceOperation _signal{};
+	VgSubmitInfo _submit{};
+
+	const VgSubmitInfo& PrepareSubmit(VgQueue queue, std::span<const VgCommandList> lists, std::span<const VgSyncPoint> dependencies);
+};
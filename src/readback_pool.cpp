@@ -0,0 +1,149 @@
+#include "readback_pool.h"
+
+// Buffer readbacks only need natural alignment for typed reads, placed texture footprints need 512
+static constexpr uint64_t buffer_readback_alignment = 16;
+static constexpr uint64_t texture_readback_alignment = 512;
+
+ReadbackPool::ReadbackPool(VgDevice device, uint64_t size) : _device(device), _size(size)
+{
+	_buffer = _device->CreateBuffer(VgBufferDesc{ size, VG_BUFFER_USAGE_GENERAL, VG_HEAP_TYPE_READBACK });
+	_buffer->SetName("Readback pool");
+	try
+	{
+		// Readback heaps may stay mapped while the GPU writes to them
+		_mapped = static_cast<uint8_t*>(_buffer->Map());
+	}
+	catch (...)
+	{
+		_device->DestroyBuffer(_buffer);
+		throw;
+	}
+}
+
+ReadbackPool::~ReadbackPool()
+{
+	_buffer->Unmap();
+	_device->DestroyBuffer(_buffer);
+}
+
+VgReadbackTicket ReadbackPool::ReadbackBuffer(VgCommandList cmd, VgBuffer src, uint64_t srcOffset, uint64_t size, const VgReadbackRequest& request)
+{
+	std::scoped_lock lock(_mutex);
+	auto offset = Allocate(size, buffer_readback_alignment);
+	if (!offset) return VG_INVALID_READBACK_TICKET;
+
+	cmd->CopyBufferToBuffer(_buffer, *offset, src, srcOffset, size);
+	return Push(*offset, size, 0, request);
+}
+
+VgReadbackTicket ReadbackPool::ReadbackTexture(VgCommandList cmd, VgTexture src, const VgRegion& srcRegion, const VgReadbackRequest& request)
+{
+	const auto format = src->Desc().format;
+	const uint64_t rowPitch = TextureCopyRowPitch(srcRegion.width, format);
+	const uint64_t numRows = GetBCFormatBlockSize(format) ? (srcRegion.height + 3) / 4 : srcRegion.height;
+	const uint64_t size = rowPitch * numRows * srcRegion.depth;
+
+	std::scoped_lock lock(_mutex);
+	auto offset = Allocate(size, texture_readback_alignment);
+	if (!offset) return VG_INVALID_READBACK_TICKET;
+
+	cmd->CopyTextureToBuffer(_buffer, *offset, src, srcRegion);
+	return Push(*offset, size, rowPitch, request);
+}
+
+VgResult ReadbackPool::GetResult(VgReadbackTicket ticket, VgReadbackResult& result)
+{
+	std::scoped_lock lock(_mutex);
+	auto entry = Find(ticket);
+	if (!entry) return VG_BAD_ARGUMENT;
+	if (!IsComplete(*entry)) return VG_NOT_READY;
+
+	result = { _mapped + entry->offset, entry->size, entry->rowPitch };
+	return VG_SUCCESS;
+}
+
+void ReadbackPool::Release(VgReadbackTicket ticket)
+{
+	std::scoped_lock lock(_mutex);
+	auto entry = Find(ticket);
+	if (!entry) return;
+	entry->released = true;
+	Reclaim();
+}
+
+void ReadbackPool::Process()
+{
+	struct Completed
+	{
+		VgReadbackTicket ticket;
+		VgReadbackResult result;
+		VgReadbackRequest request;
+	};
+	vg::Vector<Completed> completed;
+	{
+		std::scoped_lock lock(_mutex);
+		for (auto& entry : _entries)
+		{
+			if (entry.released || !entry.request.callback || !IsComplete(entry)) continue;
+			completed.push_back({ entry.ticket, { _mapped + entry.offset, entry.size, entry.rowPitch }, entry.request });
+		}
+	}
+
+	// Called without holding the lock, so callbacks may issue new readbacks or query other tickets.
+	// Data stays valid until the ticket is released below.
+	for (const auto& readback : completed)
+	{
+		readback.request.callback(readback.request.user_data, readback.ticket, &readback.result);
+		Release(readback.ticket);
+	}
+}
+
+std::optional<uint64_t> ReadbackPool::Allocate(uint64_t size, uint64_t alignment)
+{
+	if (size == 0 || size > _size) return std::nullopt;
+	if (_entries.empty()) _head = 0;
+
+	const uint64_t offset = (_head + alignment - 1) & ~(alignment - 1);
+	if (_entries.empty()) return offset + size <= _size ? std::optional(offset) : std::nullopt;
+
+	// Free space is [_head, _size) + [0, tail) before the ring wraps and [_head, tail) after it. Allocations never
+	// end exactly at tail, so _head == tail only ever means an empty ring.
+	const uint64_t tail = _entries.front().offset;
+	if (_head > tail)
+	{
+		if (offset + size <= _size) return offset;
+		if (size < tail) return 0;
+		return std::nullopt;
+	}
+	if (offset + size < tail) return offset;
+	return std::nullopt;
+}
+
+VgReadbackTicket ReadbackPool::Push(uint64_t offset, uint64_t size, uint64_t rowPitch, const VgReadbackRequest& request)
+{
+	_head = offset + size;
+	const auto ticket = _nextTicket++;
+	_entries.push_back({ ticket, offset, size, rowPitch, request, false });
+	return ticket;
+}
+
+ReadbackPool::Entry* ReadbackPool::Find(VgReadbackTicket ticket)
+{
+	if (_entries.empty() || ticket < _entries.front().ticket) return nullptr;
+	const auto index = ticket - _entries.front().ticket;
+	if (index >= _entries.size() || _entries[index].released) return nullptr;
+	return &_entries[index];
+}
+
+bool ReadbackPool::IsComplete(const Entry& entry) const
+{
+	return _device->GetFenceValue(entry.request.fence) >= entry.request.fence_value;
+}
+
+void ReadbackPool::Reclaim()
+{
+	while (!_entries.empty() && _entries.front().released)
+	{
+		_entries.pop_front();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common.h"
+#include "interface.h"
+#include <mutex>
+#include <optional>
+
+// Ring of persistently mapped VG_HEAP_TYPE_READBACK memory shared by all backends. Every readback records a copy
+// into the ring and returns a ticket, which completes once the fence value passed with the request is reached.
+// Memory is reclaimed in allocation order, a ticket which is never released eventually blocks new readbacks.
+class ReadbackPool
+{
+public:
+	ReadbackPool(VgDevice device, uint64_t size);
+	~ReadbackPool();
+
+	VgDevice Device() const { return _device; }
+
+	// VG_INVALID_READBACK_TICKET if the ring has no room left
+	VgReadbackTicket ReadbackBuffer(VgCommandList cmd, VgBuffer src, uint64_t srcOffset, uint64_t size, const VgReadbackRequest& request);
+	VgReadbackTicket ReadbackTexture(VgCommandList cmd, VgTexture src, const VgRegion& srcRegion, const VgReadbackRequest& request);
+
+	// VG_NOT_READY while the fence has not reached the requested value, VG_BAD_ARGUMENT for released tickets
+	VgResult GetResult(VgReadbackTicket ticket, VgReadbackResult& result);
+	void Release(VgReadbackTicket ticket);
+	// Invokes the callbacks of completed readbacks and releases their tickets
+	void Process();
+
+private:
+	struct Entry
+	{
+		VgReadbackTicket ticket;
+		uint64_t offset;
+		uint64_t size;
+		uint64_t rowPitch;
+		VgReadbackRequest request;
+		bool released;
+	};
+
+	VgDevice _device;
+	VgBuffer _buffer;
+	uint8_t* _mapped;
+	uint64_t _size;
+
+	std::mutex _mutex;
+	// Entries in ticket order, _head is where the next allocation starts
+	vg::Deque<Entry> _entries;
+	uint64_t _head{ 0 };
+	VgReadbackTicket _nextTicket{ 1 };
+
+	std::optional<uint64_t> Allocate(uint64_t size, uint64_t alignment);
+	VgReadbackTicket Push(uint64_t offset, uint64_t size, uint64_t rowPitch, const VgReadbackRequest& request);
+	Entry* Find(VgReadbackTicket ticket);
+	bool IsComplete(const Entry& entry) const;
+	void Reclaim();
+};
@@ -0,0 +1,252 @@
+#include "resource_state_tracker.h"
+#include "interface.h"
+#include <algorithm>
+
+static constexpr VgAccessFlags writeAccess = VG_ACCESS_SHADER_WRITE | VG_ACCESS_COLOR_ATTACHMENT_WRITE
+	| VG_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE | VG_ACCESS_TRANSFER_WRITE | VG_ACCESS_MEMORY_WRITE
+	| VG_ACCESS_SHADER_STORAGE_WRITE | VG_ACCESS_ACCELERATION_STRUCTURE_WRITE;
+
+// Reads in the same layout only need their stages and accesses merged, everything else needs a barrier
+static bool NeedsBarrier(const ResourceState& before, const ResourceState& after)
+{
+	if (before.layout != after.layout) return true;
+	if (before.stage == VG_PIPELINE_STAGE_NONE && before.access == VG_ACCESS_NONE) return false;
+	return (before.access & writeAccess) || (after.access & writeAccess);
+}
+
+static ResourceState Merge(const ResourceState& before, const ResourceState& after)
+{
+	return { before.stage | after.stage, before.access | after.access, before.layout };
+}
+
+static uint32_t MipLevels(VgTexture texture)
+{
+	return std::max(texture->Desc().mip_levels, 1u);
+}
+
+static uint32_t ArrayLayers(VgTexture texture)
+{
+	const auto& desc = texture->Desc();
+	return desc.type == VG_TEXTURE_TYPE_3D ? 1 : std::max(desc.depth_or_array_layers, 1u);
+}
+
+// Extends the previous barrier when it covers the mip level below in the same layer with the same states
+static void AppendTextureBarrier(vg::Vector<VgTextureBarrier>& barriers, VgTexture texture, uint32_t mip, uint32_t layer,
+	const ResourceState& before, const ResourceState& after)
+{
+	if (!barriers.empty())
+	{
+		auto& last = barriers.back();
+		if (last.texture == texture && last.subresource_range.base_array_layer == layer && last.subresource_range.array_layers == 1
+			&& last.subresource_range.base_mip_level + last.subresource_range.mip_levels == mip
+			&& last.src_stage == before.stage && last.src_access == before.access && last.old_layout == before.layout
+			&& last.dst_stage == after.stage && last.dst_access == after.access && last.new_layout == after.layout)
+		{
+			last.subresource_range.mip_levels++;
+			return;
+		}
+	}
+	barriers.push_back({
+		.src_stage = before.stage,
+		.src_access = before.access,
+		.dst_stage = after.stage,
+		.dst_access = after.access,
+		.old_layout = before.layout,
+		.new_layout = after.layout,
+		.texture = texture,
+		.subresource_range = { mip, 1, layer, 1 }
+	});
+}
+
+template <class RecordFn>
+static void Apply(CommandListStateTracker::Subresource& subresource, const ResourceState& next, RecordFn&& record)
+{
+	if (!subresource.used)
+	{
+		subresource = { true, false, next, next };
+		return;
+	}
+	if (NeedsBarrier(subresource.last, next))
+	{
+		record(subresource.last);
+		subresource.last = next;
+		subresource.barrierRecorded = true;
+		return;
+	}
+	subresource.last = Merge(subresource.last, next);
+	if (!subresource.barrierRecorded) subresource.first = subresource.last;
+}
+
+template <class RecordFn>
+static void Resolve(ResourceState& global, const CommandListStateTracker::Subresource& subresource, RecordFn&& record)
+{
+	const bool barrier = NeedsBarrier(global, subresource.first);
+	if (barrier) record(global);
+	// Without any barrier the accesses of the list overlap the ones before it, a later writer has to wait for both
+	global = barrier || subresource.barrierRecorded ? subresource.last : Merge(global, subresource.last);
+}
+
+void CommandListStateTracker::Reset()
+{
+	_buffers.clear();
+	_textures.clear();
+	_numUsedPatchLists = 0;
+}
+
+VgCommandList CommandListStateTracker::NextPatchList(VgCommandPool pool)
+{
+	if (_numUsedPatchLists == _patchLists.size())
+	{
+		_patchLists.push_back(pool->AllocateCommandList());
+	}
+	return _patchLists[_numUsedPatchLists++];
+}
+
+void CommandListStateTracker::Transition(VgCommandList cmd, const VgTransitionInfo& info)
+{
+	_bufferBarriers.clear();
+	_textureBarriers.clear();
+
+	for (uint32_t i = 0; i < info.num_buffer_transitions; i++)
+	{
+		const auto& transition = info.buffer_transitions[i];
+		const ResourceState next = { transition.stage, transition.access, VG_TEXTURE_LAYOUT_UNDEFINED };
+		Apply(_buffers[transition.buffer], next, [&](const ResourceState& before)
+			{
+				_bufferBarriers.push_back({ before.stage, before.access, next.stage, next.access, transition.buffer });
+			});
+	}
+
+	for (uint32_t i = 0; i < info.num_texture_transitions; i++)
+	{
+		const auto& transition = info.texture_transitions[i];
+		const ResourceState next = { transition.stage, transition.access, transition.layout };
+		const uint32_t mips = MipLevels(transition.texture);
+		const uint32_t layers = ArrayLayers(transition.texture);
+
+		auto& subresources = _textures[transition.texture];
+		if (subresources.empty()) subresources.resize(mips * layers);
+
+		const auto& range = transition.subresource_range;
+		const uint32_t endMip = range.mip_levels == VG_REMAINING_MIP_LAYERS ? mips : std::min(range.base_mip_level + range.mip_levels, mips);
+		const uint32_t endLayer = range.array_layers == VG_REMAINING_MIP_LAYERS ? layers : std::min(range.base_array_layer + range.array_layers, layers);
+		for (uint32_t layer = range.base_array_layer; layer < endLayer; layer++)
+		{
+			for (uint32_t mip = range.base_mip_level; mip < endMip; mip++)
+			{
+				Apply(subresources[layer * mips + mip], next, [&](const ResourceState& before)
+					{
+						AppendTextureBarrier(_textureBarriers, transition.texture, mip, layer, before, next);
+					});
+			}
+		}
+	}
+
+	if (_bufferBarriers.empty() && _textureBarriers.empty()) return;
+
+	const VgDependencyInfo dependencyInfo = {
+		.num_memory_barriers = 0,
+		.memory_barriers = nullptr,
+		.num_buffer_barriers = static_cast<uint32_t>(_bufferBarriers.size()),
+		.buffer_barriers = _bufferBarriers.data(),
+		.num_texture_barriers = static_cast<uint32_t>(_textureBarriers.size()),
+		.texture_barriers = _textureBarriers.data()
+	};
+	cmd->Barrier(dependencyInfo);
+}
+
+void ResourceStateTracker::Forget(VgBuffer buffer)
+{
+	std::scoped_lock lock(_mutex);
+	_buffers.erase(buffer);
+}
+
+void ResourceStateTracker::Forget(VgTexture texture)
+{
+	std::scoped_lock lock(_mutex);
+	_textures.erase(texture);
+}
+
+const VgSubmitInfo* ResourceStateTracker::PatchSubmits(uint32_t numSubmits, const VgSubmitInfo* submits)
+{
+	bool tracked = false;
+	for (uint32_t i = 0; i < numSubmits && !tracked; i++)
+	{
+		for (uint32_t j = 0; j < submits[i].num_command_lists && !tracked; j++)
+		{
+			tracked = submits[i].command_lists[j]->StateTracker() != nullptr;
+		}
+	}
+	if (!tracked) return submits;
+
+	_submits.assign(submits, submits + numSubmits);
+	if (_lists.size() < numSubmits) _lists.resize(numSubmits);
+	for (uint32_t i = 0; i < numSubmits; i++)
+	{
+		auto& lists = _lists[i];
+		lists.clear();
+		for (uint32_t j = 0; j < submits[i].num_command_lists; j++)
+		{
+			VgCommandList cmd = submits[i].command_lists[j];
+			if (cmd->StateTracker())
+			{
+				if (auto patch = Patch(cmd)) lists.push_back(patch);
+			}
+			lists.push_back(cmd);
+		}
+		_submits[i].num_command_lists = static_cast<uint32_t>(lists.size());
+		_submits[i].command_lists = lists.data();
+	}
+	return _submits.data();
+}
+
+VgCommandList ResourceStateTracker::Patch(VgCommandList cmd)
+{
+	auto tracker = cmd->StateTracker();
+
+	_bufferBarriers.clear();
+	_textureBarriers.clear();
+
+	for (const auto& [buffer, subresource] : tracker->Buffers())
+	{
+		auto& global = _buffers.try_emplace(buffer, ResourceState{ VG_PIPELINE_STAGE_NONE, VG_ACCESS_NONE, VG_TEXTURE_LAYOUT_UNDEFINED }).first->second;
+		Resolve(global, subresource, [&](const ResourceState& before)
+			{
+				_bufferBarriers.push_back({ before.stage, before.access, subresource.first.stage, subresource.first.access, buffer });
+			});
+	}
+
+	for (const auto& [texture, subresources] : tracker->Textures())
+	{
+		const uint32_t mips = MipLevels(texture);
+		const ResourceState initial = { VG_PIPELINE_STAGE_NONE, VG_ACCESS_NONE, texture->Desc().initial_layout };
+		auto& globals = _textures.try_emplace(texture, subresources.size(), initial).first->second;
+
+		for (uint32_t i = 0; i < subresources.size(); i++)
+		{
+			if (!subresources[i].used) continue;
+			Resolve(globals[i], subresources[i], [&](const ResourceState& before)
+				{
+					AppendTextureBarrier(_textureBarriers, texture, i % mips, i / mips, before, subresources[i].first);
+				});
+		}
+	}
+
+	if (_bufferBarriers.empty() && _textureBarriers.empty()) return nullptr;
+
+	// Recorded from the pool of cmd, which is therefore not allowed to record on another thread during the submit
+	VgCommandList patch = tracker->NextPatchList(cmd->CommandPool());
+
+	const VgDependencyInfo dependencyInfo = {
+		.num_memory_barriers = 0,
+		.memory_barriers = nullptr,
+		.num_buffer_barriers = static_cast<uint32_t>(_bufferBarriers.size()),
+		.buffer_barriers = _bufferBarriers.data(),
+		.num_texture_barriers = static_cast<uint32_t>(_textureBarriers.size()),
+		.texture_barriers = _textureBarriers.data()
+	};
+	patch->Begin();
+	patch->Barrier(dependencyInfo);
+	patch->End();
+	return patch;
+}
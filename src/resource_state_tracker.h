@@ -0,0 +1,86 @@
+#pragma once
+
+#include "common.h"
+#include <mutex>
+
+struct ResourceState
+{
+	VgPipelineStageFlags stage;
+	VgAccessFlags access;
+	// Always VG_TEXTURE_LAYOUT_UNDEFINED for buffers
+	VgTextureLayout layout;
+};
+
+// Local state of one command list from a VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES pool. Transitions inside the
+// list are recorded directly, the first use of every buffer and texture subresource is left to the device, which
+// patches it against the global state when the list is submitted.
+class CommandListStateTracker
+{
+public:
+	struct Subresource
+	{
+		bool used;
+		// No barrier has been recorded since the first use, so reads merged into last also belong to first
+		bool barrierRecorded;
+		ResourceState first;
+		ResourceState last;
+	};
+
+	// Called by vgCmdBegin(), the list starts without any known states
+	void Reset();
+	void Transition(VgCommandList cmd, const VgTransitionInfo& info);
+
+	const vg::UnorderedMap<VgBuffer, Subresource>& Buffers() const { return _buffers; }
+	// Indexed by array layer * mip levels + mip level
+	const vg::UnorderedMap<VgTexture, vg::Vector<Subresource>>& Textures() const { return _textures; }
+
+	// Returns a list for the barriers patched in front of this one at submission. Every submission since the last
+	// Reset() gets its own, because the earlier ones may still be pending. Allocated from pool on first use and
+	// reused once the list is recorded again, which requires its previous submissions to be complete
+	VgCommandList NextPatchList(VgCommandPool pool);
+	const vg::Vector<VgCommandList>& PatchLists() const { return _patchLists; }
+
+private:
+	vg::UnorderedMap<VgBuffer, Subresource> _buffers;
+	vg::UnorderedMap<VgTexture, vg::Vector<Subresource>> _textures;
+	vg::Vector<VgCommandList> _patchLists;
+	size_t _numUsedPatchLists{ 0 };
+
+	vg::Vector<VgBufferBarrier> _bufferBarriers;
+	vg::Vector<VgTextureBarrier> _textureBarriers;
+};
+
+// Global state of every buffer and texture subresource used by tracked command lists, in submission order.
+// Resources shared between queues have to be synchronized with fences by the application as usual, the table
+// only decides which layout transitions and barriers the next tracked list needs.
+class ResourceStateTracker
+{
+public:
+	void Forget(VgBuffer buffer);
+	void Forget(VgTexture texture);
+
+	// Inserts the patch list of every tracked list which needs barriers in front of it and performs the
+	// submits through submitFn. Runs under the tracker lock, so the global states follow submission order
+	template <class SubmitFn>
+	void Submit(uint32_t numSubmits, const VgSubmitInfo* submits, SubmitFn&& submitFn)
+	{
+		std::scoped_lock lock(_mutex);
+		submitFn(numSubmits, PatchSubmits(numSubmits, submits));
+	}
+
+private:
+	std::mutex _mutex;
+	vg::UnorderedMap<VgBuffer, ResourceState> _buffers;
+	vg::UnorderedMap<VgTexture, vg::Vector<ResourceState>> _textures;
+
+	vg::Vector<VgSubmitInfo> _submits;
+	vg::Vector<vg::Vector<VgCommandList>> _lists;
+	vg::Vector<VgBufferBarrier> _bufferBarriers;
+	vg::Vector<VgTextureBarrier> _textureBarriers;
+
+	// Returns submits unchanged if none of the lists are tracked
+	const VgSubmitInfo* PatchSubmits(uint32_t numSubmits, const VgSubmitInfo* submits);
+	// Records the barriers from the global states to the first uses of cmd and applies its last states.
+	// Returns the patch list, or nullptr if cmd needs no barriers
+	VgCommandList Patch(VgCommandList cmd);
+};
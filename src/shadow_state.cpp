@@ -0,0 +1,126 @@
+#include "shadow_state.h"
+#include <algorithm>
+#include <cstring>
+
+// Copies the entries [first, first + num) of values into shadow and narrows first and num to the entries which
+// were unknown or different. Values may be unaligned, like root constant data.
+template <class T, size_t N, class EqualFn>
+static bool Update(std::array<T, N>& shadow, uint32_t& known, uint32_t& first, uint32_t& num, const void* values, EqualFn&& equal)
+{
+	const auto* bytes = static_cast<const uint8_t*>(values);
+	uint32_t begin = first + num;
+	uint32_t end = first;
+	for (uint32_t i = first; i < first + num; i++)
+	{
+		T value;
+		memcpy(&value, bytes + (i - first) * sizeof(T), sizeof(T));
+		if ((known & (1u << i)) && equal(shadow[i], value)) continue;
+
+		shadow[i] = value;
+		known |= 1u << i;
+		begin = std::min(begin, i);
+		end = i + 1;
+	}
+	if (begin >= end) return false;
+
+	first = begin;
+	num = end - begin;
+	return true;
+}
+
+// Only for types without padding
+template <class T>
+static bool BitwiseEqual(const T& a, const T& b)
+{
+	return memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+static bool VertexBuffersEqual(const VgVertexBufferView& a, const VgVertexBufferView& b)
+{
+	return a.buffer == b.buffer && a.offset == b.offset && a.stride_in_bytes == b.stride_in_bytes;
+}
+
+static_assert(vg_num_max_vertex_buffers <= 32 && vg_num_allowed_root_constants <= 32 && vg_num_max_viewports_and_scissors <= 32,
+	"known entries are tracked in 32 bit masks");
+
+void CommandListShadowState::Reset()
+{
+	Invalidate();
+	_statistics = {};
+}
+
+void CommandListShadowState::Invalidate()
+{
+	_known = {};
+	_pipelineKnown = false;
+	_indexBufferKnown = false;
+}
+
+void CommandListShadowState::InvalidateRootConstants()
+{
+	_known.graphicsRootConstants = 0;
+	_known.computeRootConstants = 0;
+}
+
+bool CommandListShadowState::Record(bool redundant)
+{
+	_statistics.num_state_commands++;
+	if (redundant) _statistics.num_filtered_state_commands++;
+	return !redundant;
+}
+
+bool CommandListShadowState::SetPipeline(VgPipeline pipeline)
+{
+	const bool redundant = _pipelineKnown && _pipeline == pipeline;
+	_pipelineKnown = true;
+	_pipeline = pipeline;
+	return Record(redundant);
+}
+
+bool CommandListShadowState::SetVertexBuffers(uint32_t& startSlot, uint32_t& numBuffers, const VgVertexBufferView*& buffers)
+{
+	const bool changed = Update(_vertexBuffers, _known.vertexBuffers, startSlot, numBuffers, buffers, VertexBuffersEqual);
+	buffers = _vertexBuffers.data() + startSlot;
+	return Record(!changed);
+}
+
+bool CommandListShadowState::SetIndexBuffer(VgIndexType indexType, uint64_t offset, VgBuffer buffer)
+{
+	const bool redundant = _indexBufferKnown && _indexType == indexType && _indexBufferOffset == offset && _indexBuffer == buffer;
+	_indexBufferKnown = true;
+	_indexType = indexType;
+	_indexBufferOffset = offset;
+	_indexBuffer = buffer;
+	return Record(redundant);
+}
+
+bool CommandListShadowState::SetRootConstants(VgPipelineType pipelineType, uint32_t& offsetIn32bitValues, uint32_t& num32bitValues, const void*& data)
+{
+	const bool graphics = pipelineType == VG_PIPELINE_TYPE_GRAPHICS;
+	auto& values = graphics ? _graphicsRootConstants : _computeRootConstants;
+	const bool changed = Update(values, graphics ? _known.graphicsRootConstants : _known.computeRootConstants,
+		offsetIn32bitValues, num32bitValues, data, BitwiseEqual<uint32_t>);
+	data = values.data() + offsetIn32bitValues;
+	return Record(!changed);
+}
+
+bool CommandListShadowState::SetViewports(uint32_t& firstViewport, uint32_t& numViewports, VgViewport*& viewports)
+{
+	const bool changed = Update(_viewports, _known.viewports, firstViewport, numViewports, viewports, BitwiseEqual<VgViewport>);
+	viewports = _viewports.data() + firstViewport;
+	return Record(!changed);
+}
+
+bool CommandListShadowState::SetScissors(uint32_t& firstScissor, uint32_t& numScissors, VgScissor*& scissors)
+{
+	const bool changed = Update(_scissors, _known.scissors, firstScissor, numScissors, scissors, BitwiseEqual<VgScissor>);
+	scissors = _scissors.data() + firstScissor;
+	return Record(!changed);
+}
+
+void CommandListShadowState::OverwriteRootConstants(VgPipelineType pipelineType, uint32_t offsetIn32bitValues, uint32_t num32bitValues, const void* data)
+{
+	const bool graphics = pipelineType == VG_PIPELINE_TYPE_GRAPHICS;
+	Update(graphics ? _graphicsRootConstants : _computeRootConstants, graphics ? _known.graphicsRootConstants : _known.computeRootConstants,
+		offsetIn32bitValues, num32bitValues, data, BitwiseEqual<uint32_t>);
+}
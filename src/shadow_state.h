@@ -0,0 +1,62 @@
+#pragma once
+
+#include "common.h"
+
+// Last state set on a command list through the API, used to drop binds which would not change anything before they
+// reach the backend. Partially redundant array binds are narrowed to the range of entries which changed.
+// Everything starts unknown on vgCmdBegin(), executing a bundle leaves the state of the executing list undefined.
+class CommandListShadowState
+{
+public:
+	// Called by vgCmdBegin() and vgCmdBeginBundle(), forgets all state and clears the statistics
+	void Reset();
+	// Called by vgCmdExecuteBundle(), forgets all state
+	void Invalidate();
+	// Root signatures and pipeline layouts set by the backend may reset the root constants
+	void InvalidateRootConstants();
+	// Called when the graphics state of vgCmdSetGraphicsState() was bound in place of a pipeline
+	void InvalidatePipeline() { _pipelineKnown = false; }
+
+	// Return false if the command is redundant, otherwise the arguments are narrowed to the changed range
+	// and the array pointers point into the shadow state, which holds the same values
+	bool SetPipeline(VgPipeline pipeline);
+	bool SetVertexBuffers(uint32_t& startSlot, uint32_t& numBuffers, const VgVertexBufferView*& buffers);
+	bool SetIndexBuffer(VgIndexType indexType, uint64_t offset, VgBuffer buffer);
+	bool SetRootConstants(VgPipelineType pipelineType, uint32_t& offsetIn32bitValues, uint32_t& num32bitValues, const void*& data);
+	bool SetViewports(uint32_t& firstViewport, uint32_t& numViewports, VgViewport*& viewports);
+	bool SetScissors(uint32_t& firstScissor, uint32_t& numScissors, VgScissor*& scissors);
+
+	// Root constants left behind by a multi draw, which sets them per draw without going through SetRootConstants()
+	void OverwriteRootConstants(VgPipelineType pipelineType, uint32_t offsetIn32bitValues, uint32_t num32bitValues, const void* data);
+
+	const VgCommandListStatistics& Statistics() const { return _statistics; }
+
+private:
+	// Bit i is set if entry i of the matching array holds the value the backend has bound
+	struct KnownMasks
+	{
+		uint32_t vertexBuffers;
+		uint32_t graphicsRootConstants;
+		uint32_t computeRootConstants;
+		uint32_t viewports;
+		uint32_t scissors;
+	};
+
+	KnownMasks _known{};
+	bool _pipelineKnown{ false };
+	bool _indexBufferKnown{ false };
+
+	VgPipeline _pipeline{ nullptr };
+	VgIndexType _indexType{};
+	uint64_t _indexBufferOffset{ 0 };
+	VgBuffer _indexBuffer{ nullptr };
+	std::array<VgVertexBufferView, vg_num_max_vertex_buffers> _vertexBuffers{};
+	std::array<uint32_t, vg_num_allowed_root_constants> _graphicsRootConstants{};
+	std::array<uint32_t, vg_num_allowed_root_constants> _computeRootConstants{};
+	std::array<VgViewport, vg_num_max_viewports_and_scissors> _viewports{};
+	std::array<VgScissor, vg_num_max_viewports_and_scissors> _scissors{};
+
+	VgCommandListStatistics _statistics{};
+
+	bool Record(bool redundant);
+};
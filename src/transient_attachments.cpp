@@ -0,0 +1,24 @@
+#include "transient_attachments.h"
+
+void TransientAttachmentViews::Add(VgTexture texture, bool depthStencil, uint32_t view)
+{
+	std::scoped_lock lock(_mutex);
+	_textureViews[texture].push_back(Key(depthStencil, view));
+	_views.insert(Key(depthStencil, view));
+}
+
+void TransientAttachmentViews::Forget(VgTexture texture)
+{
+	std::scoped_lock lock(_mutex);
+	auto it = _textureViews.find(texture);
+	if (it == _textureViews.end()) return;
+
+	for (auto key : it->second) _views.erase(key);
+	_textureViews.erase(it);
+}
+
+bool TransientAttachmentViews::Contains(bool depthStencil, uint32_t view)
+{
+	std::scoped_lock lock(_mutex);
+	return _views.contains(Key(depthStencil, view));
+}
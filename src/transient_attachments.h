@@ -0,0 +1,22 @@
+#pragma once
+
+#include "common.h"
+#include <mutex>
+
+// Attachment views of VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT textures, so vgCmdBeginRendering() can reject loading or
+// storing their contents. Attachment views are plain indices, color and depth stencil views are numbered separately.
+class TransientAttachmentViews
+{
+public:
+	void Add(VgTexture texture, bool depthStencil, uint32_t view);
+	// Called when the views of texture are destroyed, their indices may be reused by other textures
+	void Forget(VgTexture texture);
+	bool Contains(bool depthStencil, uint32_t view);
+
+private:
+	std::mutex _mutex;
+	vg::UnorderedMap<VgTexture, vg::Vector<uint64_t>> _textureViews;
+	vg::UnorderedSet<uint64_t> _views;
+
+	static uint64_t Key(bool depthStencil, uint32_t view) { return (uint64_t(depthStencil) << 32) | view; }
+};
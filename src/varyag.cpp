@@ -1,5 +1,9 @@
 #include "common.h"
 #include "interface.h"
+#include "capture.h"
+#include "readback_pool.h"
+#include "constant_allocator.h"
+#include "queue_scheduler.h"
 #if VG_D3D12_SUPPORTED
 #include "d3d12/d3d12adapter.h"
 #include "d3d12/d3d12device.h"
@@ -32,6 +36,10 @@ if (!(variable)) { \
 	return VG_BAD_ARGUMENT; \
 }}while (false)
 
+#define CAPTURE(op, ...) do { \
+if (capture) capture->Write(CONCAT(VG_CAPTURE_OP_, op), ##__VA_ARGS__); \
+} while (false)
+
 #include <magic_enum.hpp>
 #if VG_VALIDATION
 #include <ranges>
@@ -134,6 +142,24 @@ if (((variable) & (flags_a)) && ((variable) & (flags_b))) {\
 	return VG_BAD_ARGUMENT; \
 }} while (false)
 
+#define VALIDATE_NOT_TRANSIENT(texture, var_name) do { \
+if ((texture)->Desc().usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT) { \
+	LOG(ERROR, "{}(): {} has VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT usage and cannot be copied", _func_name_, var_name); \
+	return; \
+}} while (false)
+
+#define VALIDATE_NOT_BUNDLE(cmd) do { \
+if ((cmd)->IsBundle()) { \
+	LOG(ERROR, "{}(): not allowed in bundles", _func_name_); \
+	return; \
+}} while (false)
+
+#define VALIDATE_NOT_BUNDLE_RETURN(cmd) do { \
+if ((cmd)->IsBundle()) { \
+	LOG(ERROR, "{}(): not allowed in bundles", _func_name_); \
+	return VG_ILLEGAL_OPERATION; \
+}} while (false)
+
 template <> struct magic_enum::customize::enum_range<VgInitFlags> {
 	static constexpr bool is_flags = true;
 };
@@ -146,6 +172,9 @@ template <> struct magic_enum::customize::enum_range<VgPipelineStageFlags> {
 template <> struct magic_enum::customize::enum_range<VgAccessFlags> {
 	static constexpr bool is_flags = true;
 };
+template <> struct magic_enum::customize::enum_range<VgRenderingFlags> {
+	static constexpr bool is_flags = true;
+};
 
 template <class TIter> requires requires (TIter t) { std::is_enum_v<std::remove_all_extents_t<decltype(*t)>>; }
 static vg::String join(TIter begin, TIter end)
@@ -197,6 +226,7 @@ bool debug = false;
 VgMessageCallbackPFN messageCallback;
 static VgAllocator allocator;
 static bool wasInitialized = false;
+static CaptureWriter* capture = nullptr;
 
 struct Global
 {
@@ -279,6 +309,11 @@ VG_API VgResult vgInit(const VgConfig* cfg)
 
 	s_global = new (GetAllocator().Allocate<Global>()) Global();
 
+	if (cfg->flags & VG_INIT_ENABLE_CAPTURE)
+	{
+		capture = CaptureWriter::Open(cfg->capture_path);
+	}
+
 #if VG_VULKAN_SUPPORTED
 	s_global->vulkanCore = VulkanCore::LoadVulkan(*cfg);
 #endif
@@ -308,6 +343,11 @@ VG_API void vgShutdown()
 #if VG_VULKAN_SUPPORTED
 	GetAllocator().Delete(s_global->vulkanCore);
 #endif
+	if (capture)
+	{
+		GetAllocator().Delete(capture);
+		capture = nullptr;
+	}
 	GetAllocator().Delete(s_global);
 	s_global = nullptr;
 	messageCallback = nullptr;
@@ -351,7 +391,6 @@ VG_API VgResult vgEnumerateApis(uint32_t* out_num_apis, VgGraphicsApi* out_apis)
 VG_API VgResult vgEnumerateAdapters(VgGraphicsApi api, VgSurface surface, uint32_t* out_num_adapters, VgAdapter* out_adapters)
 {
 	FUNC_DATA(vgEnumerateAdapters);
-	CHECK_NOT_NULL_RETURN(surface);
 	CHECK_NOT_NULL_RETURN(out_num_adapters);
 #if VG_VALIDATION
 	VALIDATE_ENUM_RETURN(api, "api");
@@ -431,6 +470,7 @@ VG_API VgResult vgAdapterCreateDevice(VgAdapter adapter, VgDevice* out_device)
 	try
 	{
 		*out_device = adapter->CreateDevice(init_flags);
+		CAPTURE(ADAPTER_CREATE_DEVICE, adapter->Api(), adapter->GetProperties().name, CaptureWriter::NewHandle{ *out_device });
 	}
 	catch (VgError& ex)
 	{
@@ -446,6 +486,8 @@ VG_API void vgAdapterDestroyDevice(VgAdapter adapter, VgDevice device)
 	FUNC_DATA(vgAdapterDestroyDevice);
 	CHECK_NOT_NULL(device);
 
+	CAPTURE(ADAPTER_DESTROY_DEVICE, device);
+	if (capture) capture->Forget(device);
 	GetAllocator().Delete(device);
 }
 
@@ -489,6 +531,52 @@ VgResult vgDeviceGetMemoryStatistics(VgDevice device, VgMemoryStatistics* out_me
 	return VG_SUCCESS;
 }
 
+VgResult vgDeviceGetMemoryBudget(VgDevice device, VgMemoryBudget* out_budget)
+{
+	FUNC_DATA(vgDeviceGetMemoryBudget);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(out_budget);
+
+	*out_budget = {};
+	device->GetMemoryBudget(*out_budget);
+	return VG_SUCCESS;
+}
+
+VgResult vgDeviceSetMemoryBudgetNotification(VgDevice device, const VgMemoryBudgetNotification* notification)
+{
+	FUNC_DATA(vgDeviceSetMemoryBudgetNotification);
+	CHECK_NOT_NULL_RETURN(device);
+
+#if VG_VALIDATION
+	if (notification && !(notification->threshold > 0.0f))
+	{
+		LOG(ERROR, "{}(): threshold = {}, but should be > 0", _func_name_, notification->threshold);
+		return VG_BAD_ARGUMENT;
+	}
+#endif
+
+	device->BudgetMonitor().SetNotification(notification);
+	return VG_SUCCESS;
+}
+
+VgResult vgDeviceGetDescriptorHeapStatistics(VgDevice device, VgDescriptorHeapType type, VgDescriptorHeapStatistics* out_stats)
+{
+	FUNC_DATA(vgDeviceGetDescriptorHeapStatistics);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(out_stats);
+
+#if VG_VALIDATION
+	VALIDATE_ENUM_RETURN(type, "type");
+#endif
+
+	if (!device->GetDescriptorHeapStatistics(type, *out_stats))
+	{
+		LOG(DEBUG, "{}(): backend has no descriptor heap of type {}", _func_name_, static_cast<uint64_t>(type));
+		return VG_API_UNSUPPORTED;
+	}
+	return VG_SUCCESS;
+}
+
 void vgDeviceWaitQueueIdle(VgDevice device, VgQueue queue)
 {
 	FUNC_DATA(vgDeviceWaitQueueIdle);
@@ -497,6 +585,7 @@ void vgDeviceWaitQueueIdle(VgDevice device, VgQueue queue)
 #if VG_VALIDATION
 	VALIDATE_ENUM(queue, "queue");
 #endif
+	CAPTURE(DEVICE_WAIT_QUEUE_IDLE, device, queue);
 	device->WaitQueueIdle(queue);
 }
 
@@ -505,6 +594,7 @@ void vgDeviceWaitIdle(VgDevice device)
 	FUNC_DATA(vgDeviceWaitIdle);
 	CHECK_NOT_NULL(device);
 
+	CAPTURE(DEVICE_WAIT_IDLE, device);
 	device->WaitIdle();
 }
 
@@ -529,6 +619,8 @@ VgResult vgDeviceCreateBuffer(VgDevice device, const VgBufferDesc* desc, VgBuffe
 	try
 	{
 		*out_buffer = device->CreateBuffer(newDesc);
+		CAPTURE(DEVICE_CREATE_BUFFER, device, newDesc, CaptureWriter::NewHandle{ *out_buffer });
+		device->BudgetMonitor().Check(device);
 		return VG_SUCCESS;
 	}
 	catch (VgError& ex)
@@ -544,6 +636,9 @@ void vgDeviceDestroyBuffer(VgDevice device, VgBuffer buffer)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(buffer);
 	
+	CAPTURE(DEVICE_DESTROY_BUFFER, device, buffer);
+	if (capture) capture->Forget(buffer);
+	device->StateTracker().Forget(buffer);
 	device->DestroyBuffer(buffer);
 }
 
@@ -561,6 +656,8 @@ VgResult vgDeviceCreateShaderModule(VgDevice device, const void* data, uint64_t
 	try
 	{
 		*out_module = device->CreateShaderModule(data, size);
+		CAPTURE(DEVICE_CREATE_SHADER_MODULE, device, CaptureWriter::Blob(static_cast<const uint8_t*>(data), size),
+			CaptureWriter::NewHandle{ *out_module });
 	}
 	catch (VgError& ex)
 	{
@@ -576,21 +673,26 @@ void vgDeviceDestroyShaderModule(VgDevice device, VgShaderModule shader_module)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(shader_module);
 	
+	CAPTURE(DEVICE_DESTROY_SHADER_MODULE, device, shader_module);
+	if (capture) capture->Forget(shader_module);
 	device->DestroyShaderModule(shader_module);
 }
 
-VgResult vgDeviceCreateGraphicsPipeline(VgDevice device, const VgGraphicsPipelineDesc* desc, VgPipeline* out_pipeline)
+// Only checks the fields which belong to parts, complete pipelines and linked libraries are checked with all parts
+static VgResult ValidateGraphicsPipelineDesc(std::string_view _func_name_, VgDevice device, const VgGraphicsPipelineDesc* desc,
+	VgGraphicsPipelineLibraryFlags parts)
 {
-	FUNC_DATA(vgDeviceCreateGraphicsPipeline);
-	CHECK_NOT_NULL_RETURN(device);
-	CHECK_NOT_NULL_RETURN(desc);
-	CHECK_NOT_NULL_RETURN(out_pipeline);
+	const bool vertexInput = parts & VG_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT;
+	const bool preRasterization = parts & VG_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION;
+	const bool fragmentShader = parts & VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER;
+	// A vertex input library does not know the vertex pipeline, mesh shader pipelines ignore its attributes
+	const bool fixedFunction = !preRasterization || desc->vertex_pipeline_type == VG_VERTEX_PIPELINE_FIXED_FUNCTION;
 
 #if VG_VALIDATION
-	VALIDATE_ENUM_RETURN(desc->vertex_pipeline_type, "vertex_pipeline_type");
+	if (preRasterization) VALIDATE_ENUM_RETURN(desc->vertex_pipeline_type, "vertex_pipeline_type");
 #endif
 
-	if (desc->vertex_pipeline_type == VG_VERTEX_PIPELINE_FIXED_FUNCTION)
+	if (vertexInput && fixedFunction)
 	{
 		if (desc->fixed_function.num_vertex_attributes > 0 && !desc->fixed_function.vertex_attributes)
 		{
@@ -617,34 +719,49 @@ VgResult vgDeviceCreateGraphicsPipeline(VgDevice device, const VgGraphicsPipelin
 			}
 		}
 #endif
-
-		CHECK_NOT_NULL_RETURN(desc->fixed_function.vertex_shader);
-		if (desc->fixed_function.hull_shader) CHECK_NOT_NULL_RETURN(desc->fixed_function.domain_shader);
-		else if (desc->fixed_function.domain_shader) CHECK_NOT_NULL_RETURN(desc->fixed_function.hull_shader);
-	}
-	else if (desc->vertex_pipeline_type == VG_VERTEX_PIPELINE_MESH_SHADER)
-	{
-		CHECK_NOT_NULL_RETURN(desc->mesh.mesh_shader);
 	}
 
-	if (!desc->rasterization_state.rasterization_discard_enable) CHECK_NOT_NULL_RETURN(desc->pixel_shader);
-	if (desc->fixed_function.domain_shader && (desc->tesselation_control_points < 1 || desc->tesselation_control_points > 32))
+	if (preRasterization)
 	{
-		LOG(ERROR, "{}(): tesselation_control_points({}) should be in range 1..32 when domain_shader and hull_shader are set",
-			_func_name_, desc->tesselation_control_points);
-		return VG_FAILURE;
+		if (desc->vertex_pipeline_type == VG_VERTEX_PIPELINE_FIXED_FUNCTION)
+		{
+			CHECK_NOT_NULL_RETURN(desc->fixed_function.vertex_shader);
+			if (desc->fixed_function.hull_shader) CHECK_NOT_NULL_RETURN(desc->fixed_function.domain_shader);
+			else if (desc->fixed_function.domain_shader) CHECK_NOT_NULL_RETURN(desc->fixed_function.hull_shader);
+		}
+		else if (desc->vertex_pipeline_type == VG_VERTEX_PIPELINE_MESH_SHADER)
+		{
+			CHECK_NOT_NULL_RETURN(desc->mesh.mesh_shader);
+			if (!device->Adapter()->GetProperties().mesh_shaders)
+			{
+				LOG(ERROR, "{}(): vertex_pipeline_type is {} but mesh shaders are not supported by the adapter",
+					_func_name_, magic_enum::enum_name(desc->vertex_pipeline_type));
+				return VG_API_UNSUPPORTED;
+			}
+		}
+
+		if (desc->fixed_function.domain_shader && (desc->tesselation_control_points < 1 || desc->tesselation_control_points > 32))
+		{
+			LOG(ERROR, "{}(): tesselation_control_points({}) should be in range 1..32 when domain_shader and hull_shader are set",
+				_func_name_, desc->tesselation_control_points);
+			return VG_FAILURE;
+		}
 	}
+	if (preRasterization && fragmentShader && !desc->rasterization_state.rasterization_discard_enable) CHECK_NOT_NULL_RETURN(desc->pixel_shader);
 
 #if VG_VALIDATION
-	VALIDATE_ENUM_RETURN(desc->primitive_topology, "primitive_topology");
-
-	if (desc->primitive_restart_enable)
+	const bool fragmentOutput = parts & VG_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT;
+	if (vertexInput)
 	{
-		VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{VG_PRIMITIVE_TOPOLOGY_LINE_STRIP, VG_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY,
-			VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP, VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY}), desc->primitive_topology,
-			"primitive_topology [with primitive_restart = true]");
+		VALIDATE_ENUM_RETURN(desc->primitive_topology, "primitive_topology");
+		if (desc->primitive_restart_enable)
+		{
+			VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{VG_PRIMITIVE_TOPOLOGY_LINE_STRIP, VG_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY,
+				VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP, VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY}), desc->primitive_topology,
+				"primitive_topology [with primitive_restart = true]");
+		}
 	}
-	if (!desc->rasterization_state.rasterization_discard_enable)
+	if (preRasterization && !desc->rasterization_state.rasterization_discard_enable)
 	{
 		VALIDATE_ENUM_RETURN(desc->rasterization_state.fill_mode, "rasterization_state.fill_mode");
 		VALIDATE_ENUM_RETURN(desc->rasterization_state.cull_mode, "rasterization_state.cull_mode");
@@ -652,106 +769,217 @@ VgResult vgDeviceCreateGraphicsPipeline(VgDevice device, const VgGraphicsPipelin
 		VALIDATE_ENUM_RETURN(desc->rasterization_state.depth_clip_mode, "rasterization_state.depth_clip_mode");
 		if (desc->rasterization_state.conservative_rasterization_enable)
 		{
-			VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{ VG_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
-				VG_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY, VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY }),
-				desc->primitive_topology, "primitive_topology [with rasterization_state.conservative_rasterization_enable = true]");
+			if (vertexInput)
+			{
+				VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{ VG_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+					VG_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY, VG_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY }),
+					desc->primitive_topology, "primitive_topology [with rasterization_state.conservative_rasterization_enable = true]");
+			}
 			VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{ VG_FILL_MODE_FILL }), desc->rasterization_state.fill_mode,
 				"rasterization_state.fill_mode [with rasterization_state.conservative_rasterization_enable = true]");
 		}
 	}
-	VALIDATE_ENUM_RETURN(desc->multisampling_state.sample_count, "multisampling_state.sample_count");
-	if (desc->multisampling_state.alpha_to_coverage)
-	{
-		VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{ VG_SAMPLE_COUNT_2, VG_SAMPLE_COUNT_4, VG_SAMPLE_COUNT_8 }),
-			desc->multisampling_state.sample_count, "multisampling_state.sample_count [with multisampling_state.alpha_to_coverage = true]");
-	}
-	if (desc->depth_stencil_state.depth_test_enable)
-	{
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.depth_compare_op, "depth_stencil_state.depth_compare_op");
-	}
-	if (desc->depth_stencil_state.stencil_test_enable)
+	if (fragmentOutput)
 	{
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.fail_op, "depth_stencil_state.front.fail_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.depth_fail_op, "depth_stencil_state.front.depth_fail_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.pass_op, "depth_stencil_state.front.pass_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.compare_op, "depth_stencil_state.front.compare_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.fail_op, "depth_stencil_state.back.fail_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.depth_fail_op, "depth_stencil_state.back.depth_fail_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.pass_op, "depth_stencil_state.back.pass_op");
-		VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.compare_op, "depth_stencil_state.back.compare_op");
+		VALIDATE_ENUM_RETURN(desc->multisampling_state.sample_count, "multisampling_state.sample_count");
+		if (desc->multisampling_state.alpha_to_coverage)
+		{
+			VALIDATE_ENUM_ALLOWED_RETURN((vg::UnorderedSet{ VG_SAMPLE_COUNT_2, VG_SAMPLE_COUNT_4, VG_SAMPLE_COUNT_8 }),
+				desc->multisampling_state.sample_count, "multisampling_state.sample_count [with multisampling_state.alpha_to_coverage = true]");
+		}
 	}
-	if (desc->depth_stencil_state.depth_bounds_test_enable)
+	if (fragmentShader)
 	{
-		if (!desc->depth_stencil_state.depth_bounds_test_enable)
+		if (desc->depth_stencil_state.depth_test_enable)
 		{
-			LOG(WARN, "{}(): depth_stencil_state.depth_bounds_test_enable is true but depth_stencil_state.depth_test_enable is false",
-				_func_name_);
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.depth_compare_op, "depth_stencil_state.depth_compare_op");
 		}
-		else
+		if (desc->depth_stencil_state.stencil_test_enable)
 		{
-			if (desc->depth_stencil_state.min_depth_bounds < 0.0f || desc->depth_stencil_state.min_depth_bounds > 1.0f)
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.fail_op, "depth_stencil_state.front.fail_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.depth_fail_op, "depth_stencil_state.front.depth_fail_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.pass_op, "depth_stencil_state.front.pass_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.front.compare_op, "depth_stencil_state.front.compare_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.fail_op, "depth_stencil_state.back.fail_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.depth_fail_op, "depth_stencil_state.back.depth_fail_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.pass_op, "depth_stencil_state.back.pass_op");
+			VALIDATE_ENUM_RETURN(desc->depth_stencil_state.back.compare_op, "depth_stencil_state.back.compare_op");
+		}
+		if (desc->depth_stencil_state.depth_bounds_test_enable)
+		{
+			if (!desc->depth_stencil_state.depth_bounds_test_enable)
 			{
-				LOG(ERROR, "{}(): depth_stencil_state.min_depth_bounds({}) should be in range 0..1",
-					_func_name_, desc->depth_stencil_state.min_depth_bounds);
-				return VG_BAD_ARGUMENT;
+				LOG(WARN, "{}(): depth_stencil_state.depth_bounds_test_enable is true but depth_stencil_state.depth_test_enable is false",
+					_func_name_);
 			}
-			if (desc->depth_stencil_state.max_depth_bounds < 0.0f || desc->depth_stencil_state.max_depth_bounds > 1.0f)
+			else
 			{
-				LOG(ERROR, "{}(): depth_stencil_state.max_depth_bounds({}) should be in range 0..1",
-					_func_name_, desc->depth_stencil_state.max_depth_bounds);
-				return VG_BAD_ARGUMENT;
+				if (desc->depth_stencil_state.min_depth_bounds < 0.0f || desc->depth_stencil_state.min_depth_bounds > 1.0f)
+				{
+					LOG(ERROR, "{}(): depth_stencil_state.min_depth_bounds({}) should be in range 0..1",
+						_func_name_, desc->depth_stencil_state.min_depth_bounds);
+					return VG_BAD_ARGUMENT;
+				}
+				if (desc->depth_stencil_state.max_depth_bounds < 0.0f || desc->depth_stencil_state.max_depth_bounds > 1.0f)
+				{
+					LOG(ERROR, "{}(): depth_stencil_state.max_depth_bounds({}) should be in range 0..1",
+						_func_name_, desc->depth_stencil_state.max_depth_bounds);
+					return VG_BAD_ARGUMENT;
+				}
+				if (desc->depth_stencil_state.min_depth_bounds > desc->depth_stencil_state.max_depth_bounds)
+				{
+					LOG(ERROR, "{}(): depth_stencil_state.min_depth_bounds({}) should be <= depth_stencil_state.max_depth_bounds({})",
+						_func_name_, desc->depth_stencil_state.min_depth_bounds, desc->depth_stencil_state.max_depth_bounds);
+					return VG_BAD_ARGUMENT;
+				}
 			}
-			if (desc->depth_stencil_state.min_depth_bounds > desc->depth_stencil_state.max_depth_bounds)
+		}
+	}
+	if (fragmentOutput)
+	{
+		for (uint32_t i = 0; i < desc->num_color_attachments; i++)
+		{
+			VALIDATE_ENUM_RETURN(desc->color_attachment_formats[i], "color_attachment_formats[{}]", i);
+		}
+		VALIDATE_ENUM_RETURN(desc->depth_stencil_format, "depth_stencil_format");
+		if (desc->num_color_attachments == 0 && desc->depth_stencil_format == VG_FORMAT_UNKNOWN)
+		{
+			LOG(ERROR, "{}(): num_color_attachments = 0 and depth_stencil_format = {}", _func_name_, magic_enum::enum_name(VG_FORMAT_UNKNOWN));
+			return VG_BAD_ARGUMENT;
+		}
+		if (desc->blend_state.logic_op_enable)
+		{
+			VALIDATE_ENUM_RETURN(desc->blend_state.logic_op, "blend_state.logic_op");
+		}
+		for (uint32_t i = 0; i < desc->num_color_attachments; i++)
+		{
+			const auto& attachment = desc->blend_state.attachments[i];
+			if (desc->blend_state.logic_op_enable && attachment.blend_enable)
 			{
-				LOG(ERROR, "{}(): depth_stencil_state.min_depth_bounds({}) should be <= depth_stencil_state.max_depth_bounds({})",
-					_func_name_, desc->depth_stencil_state.min_depth_bounds, desc->depth_stencil_state.max_depth_bounds);
+				LOG(ERROR, "{}(): blend_state.attachments[{}].blend_enable should be false when blend_state.logic_op_enable = true",
+					_func_name_, i);
 				return VG_BAD_ARGUMENT;
 			}
+			if (attachment.blend_enable)
+			{
+				VALIDATE_ENUM_RETURN(attachment.src_color, "blend_state.attachments[{}].src_color", i);
+				VALIDATE_ENUM_RETURN(attachment.dst_color, "blend_state.attachments[{}].dst_color", i);
+				VALIDATE_ENUM_RETURN(attachment.color_op, "blend_state.attachments[{}].color_op", i);
+				VALIDATE_ENUM_RETURN(attachment.src_alpha, "blend_state.attachments[{}].src_alpha", i);
+				VALIDATE_ENUM_RETURN(attachment.dst_alpha, "blend_state.attachments[{}].dst_alpha", i);
+				VALIDATE_ENUM_RETURN(attachment.alpha_op, "blend_state.attachments[{}].alpha_op", i);
+			}
+			VALIDATE_FLAGS_RETURN(attachment.color_write_mask, "blend_state.attachments[{}].color_write_mask", i);
 		}
 	}
-	for (uint32_t i = 0; i < desc->num_color_attachments; i++)
+#endif
+	return VG_SUCCESS;
+}
+
+VgResult vgDeviceCreateGraphicsPipeline(VgDevice device, const VgGraphicsPipelineDesc* desc, VgPipeline* out_pipeline)
+{
+	FUNC_DATA(vgDeviceCreateGraphicsPipeline);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(desc);
+	CHECK_NOT_NULL_RETURN(out_pipeline);
+
+	VgResult result = ValidateGraphicsPipelineDesc(_func_name_, device, desc, GraphicsPipelineParts::All);
+	if (result != VG_SUCCESS) return result;
+
+	try
+	{
+		*out_pipeline = device->CreateGraphicsPipeline(*desc);
+		CAPTURE(DEVICE_CREATE_GRAPHICS_PIPELINE, device, *desc, CaptureWriter::NewHandle{ *out_pipeline });
+	}
+	catch (VgError& ex)
 	{
-		VALIDATE_ENUM_RETURN(desc->color_attachment_formats[i], "color_attachment_formats[{}]", i);
+		LOG(ERROR, "Cannot create graphics pipeline: {}", ex.what());
+		return ex.result;
 	}
-	VALIDATE_ENUM_RETURN(desc->depth_stencil_format, "depth_stencil_format");
-	if (desc->num_color_attachments == 0 && desc->depth_stencil_format == VG_FORMAT_UNKNOWN)
+	return VG_SUCCESS;
+}
+
+VgResult vgDeviceCreateGraphicsPipelineLibrary(VgDevice device, VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc* desc,
+	VgPipeline* out_library)
+{
+	FUNC_DATA(vgDeviceCreateGraphicsPipelineLibrary);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(desc);
+	CHECK_NOT_NULL_RETURN(out_library);
+
+#if VG_VALIDATION
+	VALIDATE_FLAGS_RETURN(parts, "parts");
+#endif
+	if (parts == VG_GRAPHICS_PIPELINE_LIBRARY_NONE)
 	{
-		LOG(ERROR, "{}(): num_color_attachments = 0 and depth_stencil_format = {}", _func_name_, magic_enum::enum_name(VG_FORMAT_UNKNOWN));
+		LOG(ERROR, "{}(): parts = {}", _func_name_, magic_enum::enum_name(VG_GRAPHICS_PIPELINE_LIBRARY_NONE));
 		return VG_BAD_ARGUMENT;
 	}
-	if (desc->blend_state.logic_op_enable)
+	VgResult result = ValidateGraphicsPipelineDesc(_func_name_, device, desc, parts);
+	if (result != VG_SUCCESS) return result;
+
+	try
+	{
+		*out_library = device->CreateGraphicsPipelineLibrary(parts, *desc);
+		if (capture)
+		{
+			// Only the fields of parts, so that a replay does not depend on the ones the library ignored
+			GraphicsPipelineParts captured;
+			captured.Add(parts, *desc);
+			CAPTURE(DEVICE_CREATE_GRAPHICS_PIPELINE_LIBRARY, device, parts, captured.Desc(), CaptureWriter::NewHandle{ *out_library });
+		}
+	}
+	catch (VgError& ex)
 	{
-		VALIDATE_ENUM_RETURN(desc->blend_state.logic_op, "blend_state.logic_op");
+		LOG(ERROR, "Cannot create graphics pipeline library: {}", ex.what());
+		return ex.result;
 	}
-	for (uint32_t i = 0; i < desc->num_color_attachments; i++)
+	return VG_SUCCESS;
+}
+
+VgResult vgDeviceLinkGraphicsPipeline(VgDevice device, uint32_t num_libraries, const VgPipeline* libraries, VgPipeline* out_pipeline)
+{
+	FUNC_DATA(vgDeviceLinkGraphicsPipeline);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(libraries);
+	CHECK_NOT_NULL_RETURN(out_pipeline);
+
+	GraphicsPipelineParts linked;
+	for (uint32_t i = 0; i < num_libraries; i++)
 	{
-		const auto& attachment = desc->blend_state.attachments[i];
-		if (desc->blend_state.logic_op_enable && attachment.blend_enable)
+		CHECK_NOT_NULL_RETURN(libraries[i]);
+		const GraphicsPipelineParts* library = libraries[i]->Library();
+		if (!library)
 		{
-			LOG(ERROR, "{}(): blend_state.attachments[{}].blend_enable should be false when blend_state.logic_op_enable = true",
-				_func_name_, i);
+			LOG(ERROR, "{}(): libraries[{}] is not a graphics pipeline library", _func_name_, i);
 			return VG_BAD_ARGUMENT;
 		}
-		if (attachment.blend_enable)
+		if (linked.Parts() & library->Parts())
 		{
-			VALIDATE_ENUM_RETURN(attachment.src_color, "blend_state.attachments[{}].src_color", i);
-			VALIDATE_ENUM_RETURN(attachment.dst_color, "blend_state.attachments[{}].dst_color", i);
-			VALIDATE_ENUM_RETURN(attachment.color_op, "blend_state.attachments[{}].color_op", i);
-			VALIDATE_ENUM_RETURN(attachment.src_alpha, "blend_state.attachments[{}].src_alpha", i);
-			VALIDATE_ENUM_RETURN(attachment.dst_alpha, "blend_state.attachments[{}].dst_alpha", i);
-			VALIDATE_ENUM_RETURN(attachment.alpha_op, "blend_state.attachments[{}].alpha_op", i);
+			LOG(ERROR, "{}(): libraries[{}] provides parts({}) which were already provided by another library",
+				_func_name_, i, static_cast<uint64_t>(linked.Parts() & library->Parts()));
+			return VG_BAD_ARGUMENT;
 		}
-		VALIDATE_FLAGS_RETURN(attachment.color_write_mask, "blend_state.attachments[{}].color_write_mask", i);
+		linked.Add(*library);
 	}
-#endif
+	if (linked.Parts() != GraphicsPipelineParts::All)
+	{
+		LOG(ERROR, "{}(): libraries do not provide parts({})", _func_name_, static_cast<uint64_t>(GraphicsPipelineParts::All & ~linked.Parts()));
+		return VG_BAD_ARGUMENT;
+	}
+	// Checks the combinations of fields from different libraries
+	VgResult result = ValidateGraphicsPipelineDesc(_func_name_, device, &linked.Desc(), GraphicsPipelineParts::All);
+	if (result != VG_SUCCESS) return result;
 
 	try
 	{
-		*out_pipeline = device->CreateGraphicsPipeline(*desc);
+		*out_pipeline = device->LinkGraphicsPipeline(num_libraries, libraries, linked.Desc());
+		CAPTURE(DEVICE_LINK_GRAPHICS_PIPELINE, device, std::span<const VgPipeline>(libraries, num_libraries),
+			CaptureWriter::NewHandle{ *out_pipeline });
 	}
 	catch (VgError& ex)
 	{
-		LOG(ERROR, "Cannot create graphics pipeline: {}", ex.what());
+		LOG(ERROR, "Cannot link graphics pipeline: {}", ex.what());
 		return ex.result;
 	}
 	return VG_SUCCESS;
@@ -766,6 +994,7 @@ VgResult vgDeviceCreateComputePipeline(VgDevice device, VgShaderModule shader_mo
 	try
 	{
 		*out_pipeline = device->CreateComputePipeline(shader_module);
+		CAPTURE(DEVICE_CREATE_COMPUTE_PIPELINE, device, shader_module, CaptureWriter::NewHandle{ *out_pipeline });
 	}
 	catch (VgError& ex)
 	{
@@ -781,6 +1010,8 @@ void vgDeviceDestroyPipeline(VgDevice device, VgPipeline pipeline)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(pipeline);
 
+	CAPTURE(DEVICE_DESTROY_PIPELINE, device, pipeline);
+	if (capture) capture->Forget(pipeline);
 	device->DestroyPipeline(pipeline);
 }
 
@@ -792,6 +1023,7 @@ VgResult vgDeviceCreateFence(VgDevice device, uint64_t initial_value, VgFence* o
 	try
 	{
 		*out_fence = device->CreateFence(initial_value);
+		CAPTURE(DEVICE_CREATE_FENCE, device, initial_value, CaptureWriter::NewHandle{ *out_fence });
 	}
 	catch (VgError& ex)
 	{
@@ -807,6 +1039,8 @@ void vgDeviceDestroyFence(VgDevice device, VgFence fence)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(fence);
 	
+	CAPTURE(DEVICE_DESTROY_FENCE, device, fence);
+	if (capture) capture->Forget(fence);
 	device->DestroyFence(fence);
 }
 
@@ -819,10 +1053,18 @@ VgResult vgDeviceCreateCommandPool(VgDevice device, VgCommandPoolFlags flags, Vg
 #if VG_VALIDATION
 	VALIDATE_FLAGS_RETURN(flags, "flags");
 	VALIDATE_ENUM_RETURN(queue, "queue");
+	VALIDATE_DISALLOWED_FLAGS_RETURN(flags, VG_COMMAND_POOL_FLAG_BUNDLE, VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES, "flags");
 #endif
+	if ((flags & VG_COMMAND_POOL_FLAG_BUNDLE) && queue != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "{}(): VG_COMMAND_POOL_FLAG_BUNDLE is only allowed on {} but queue is {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(queue));
+		return VG_ILLEGAL_OPERATION;
+	}
 	try
 	{
 		*out_pool = device->CreateCommandPool(flags, queue);
+		CAPTURE(DEVICE_CREATE_COMMAND_POOL, device, flags, queue, CaptureWriter::NewHandle{ *out_pool });
 	}
 	catch (VgError& ex)
 	{
@@ -838,6 +1080,8 @@ void vgDeviceDestroyCommandPool(VgDevice device, VgCommandPool pool)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(pool);
 
+	CAPTURE(DEVICE_DESTROY_COMMAND_POOL, device, pool);
+	if (capture) capture->Forget(pool);
 	device->DestroyCommandPool(pool);
 }
 
@@ -892,6 +1136,7 @@ VgResult vgDeviceCreateSampler(VgDevice device, const VgSamplerDesc* desc, VgSam
 	try
 	{
 		*out_sampler = device->CreateSampler(*desc);
+		CAPTURE(DEVICE_CREATE_SAMPLER, device, *desc, CaptureWriter::NewHandle{ *out_sampler });
 	}
 	catch (VgError& ex)
 	{
@@ -907,6 +1152,8 @@ void vgDeviceDestroySampler(VgDevice device, VgSampler sampler)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(sampler);
 
+	CAPTURE(DEVICE_DESTROY_SAMPLER, device, sampler);
+	if (capture) capture->Forget(sampler);
 	device->DestroySampler(sampler);
 }
 
@@ -958,10 +1205,30 @@ VgResult vgDeviceCreateTexture(VgDevice device, const VgTextureDesc* desc, VgTex
 			_func_name_, static_cast<uint64_t>(desc->sample_count));
 		return VG_BAD_ARGUMENT;
 	}
+	if (desc->usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT)
+	{
+		VALIDATE_DISALLOWED_FLAGS_RETURN(desc->usage, VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT,
+			VG_TEXTURE_USAGE_SHADER_RESOURCE | VG_TEXTURE_USAGE_UNORDERED_ACCESS | VG_TEXTURE_USAGE_ALLOW_SIMULTANEOUS_ACCESS,
+			"usage");
+		if (!(desc->usage & (VG_TEXTURE_USAGE_COLOR_ATTACHMENT | VG_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT)))
+		{
+			LOG(ERROR, "{}(): VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT requires VG_TEXTURE_USAGE_COLOR_ATTACHMENT or VG_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT usage",
+				_func_name_);
+			return VG_BAD_ARGUMENT;
+		}
+		if (desc->heap_type != VG_HEAP_TYPE_GPU || desc->tiling != VG_TEXTURE_TILING_OPTIMAL)
+		{
+			LOG(ERROR, "{}(): VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT requires heap_type {} and tiling {}", _func_name_,
+				magic_enum::enum_name(VG_HEAP_TYPE_GPU), magic_enum::enum_name(VG_TEXTURE_TILING_OPTIMAL));
+			return VG_BAD_ARGUMENT;
+		}
+	}
 #endif
 	try
 	{
 		*out_texture = device->CreateTexture(*desc);
+		CAPTURE(DEVICE_CREATE_TEXTURE, device, *desc, CaptureWriter::NewHandle{ *out_texture });
+		device->BudgetMonitor().Check(device);
 	}
 	catch (VgError& ex)
 	{
@@ -982,6 +1249,10 @@ void vgDeviceDestroyTexture(VgDevice device, VgTexture texture)
 		return;
 	}
 
+	CAPTURE(DEVICE_DESTROY_TEXTURE, device, texture);
+	if (capture) capture->Forget(texture);
+	device->StateTracker().Forget(texture);
+	device->TransientAttachments().Forget(texture);
 	device->DestroyTexture(texture);
 }
 
@@ -1024,6 +1295,11 @@ void vgDeviceSubmitCommandLists(VgDevice device, uint32_t num_submits, VgSubmitI
 				LOG(ERROR, "{}(): submit {} command list {} = NULL", _func_name_, i, j);
 				return;
 			}
+			if (submits[i].command_lists[j]->IsBundle())
+			{
+				LOG(ERROR, "{}(): submit {} command list {} is a bundle, bundles are executed with vgCmdExecuteBundle()", _func_name_, i, j);
+				return;
+			}
 		}
 		for (uint32_t j = 0; j < submits[i].num_signal_fences; j++)
 		{
@@ -1035,7 +1311,17 @@ void vgDeviceSubmitCommandLists(VgDevice device, uint32_t num_submits, VgSubmitI
 		}
 	}
 #endif
-	device->SubmitCommandLists(num_submits, submits);
+	if (capture)
+	{
+		// Uploads written through persistently mapped buffers have to land in the capture before the GPU reads them
+		capture->SnapshotMappedBuffers();
+		CAPTURE(DEVICE_SUBMIT_COMMAND_LISTS, device, std::span<const VgSubmitInfo>(submits, num_submits));
+	}
+	device->StateTracker().Submit(num_submits, submits, [&](uint32_t numSubmits, const VgSubmitInfo* patchedSubmits)
+		{
+			device->SubmitCommandLists(numSubmits, patchedSubmits);
+		});
+	device->BudgetMonitor().Check(device);
 }
 
 VgResult vgDeviceSignalFence(VgDevice device, VgFence fence, uint64_t value)
@@ -1047,6 +1333,7 @@ VgResult vgDeviceSignalFence(VgDevice device, VgFence fence, uint64_t value)
 	try
 	{
 		device->SignalFence(fence, value);
+		CAPTURE(DEVICE_SIGNAL_FENCE, device, fence, value);
 	}
 	catch (VgError& ex)
 	{
@@ -1062,6 +1349,7 @@ void vgDeviceWaitFence(VgDevice device, VgFence fence, uint64_t value)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(fence);
 
+	CAPTURE(DEVICE_WAIT_FENCE, device, fence, value);
 	device->WaitFence(fence, value);
 }
 
@@ -1098,6 +1386,8 @@ VgResult vgDeviceCreateSwapChain(VgDevice device, const VgSwapChainDesc* desc, V
 	try
 	{
 		*out_swap_chain = device->CreateSwapChain(*desc);
+		CAPTURE(DEVICE_CREATE_SWAP_CHAIN, device, desc->width, desc->height, desc->format, desc->buffer_count,
+			CaptureWriter::NewHandle{ *out_swap_chain });
 	}
 	catch (VgError& ex)
 	{
@@ -1113,92 +1403,427 @@ void vgDeviceDestroySwapChain(VgDevice device, VgSwapChain swap_chain)
 	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(swap_chain);
 
+	if (capture)
+	{
+		CAPTURE(DEVICE_DESTROY_SWAP_CHAIN, device, swap_chain);
+		for (uint32_t i = 0; i < swap_chain->Desc().buffer_count; i++)
+		{
+			capture->Forget(swap_chain->GetBackBuffer(i));
+		}
+		capture->Forget(swap_chain);
+	}
+	for (uint32_t i = 0; i < swap_chain->Desc().buffer_count; i++)
+	{
+		device->StateTracker().Forget(swap_chain->GetBackBuffer(i));
+	}
 	device->DestroySwapChain(swap_chain);
 }
 
-VgResult vgCommandPoolGetApiObject(VgCommandPool pool, void** out_obj)
+VgResult vgDeviceCreateReadbackPool(VgDevice device, uint64_t size, VgReadbackPool* out_pool)
 {
-	FUNC_DATA(vgCommandPoolGetApiObject);
-	CHECK_NOT_NULL_RETURN(pool);
-	CHECK_NOT_NULL_RETURN(out_obj);
+	FUNC_DATA(vgDeviceCreateReadbackPool);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(out_pool);
+#if VG_VALIDATION
+	if (size == 0)
+	{
+		LOG(ERROR, "{}(): size must be greater than 0", _func_name_);
+		return VG_BAD_ARGUMENT;
+	}
+#endif
 
-	*out_obj = pool->GetApiObject();
+	try
+	{
+		*out_pool = new(GetAllocator().Allocate<ReadbackPool>()) ReadbackPool(device, size);
+		CAPTURE(DEVICE_CREATE_READBACK_POOL, device, size, CaptureWriter::NewHandle{ *out_pool });
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "Unable to create readback pool: {}", ex.what());
+		return ex.result;
+	}
 	return VG_SUCCESS;
 }
 
-void vgCommandPoolSetName(VgCommandPool pool, const char* name)
+void vgDeviceDestroyReadbackPool(VgDevice device, VgReadbackPool pool)
 {
-	FUNC_DATA(vgCommandPoolSetName);
+	FUNC_DATA(vgDeviceDestroyReadbackPool);
+	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(pool);
-	CHECK_NOT_NULL(name);
-
-	pool->SetName(name);
-}
-
-VgResult vgCommandPoolGetDevice(VgCommandPool pool, VgDevice* out_device)
-{
-	FUNC_DATA(vgCommandPoolGetDevice);
-	CHECK_NOT_NULL_RETURN(pool);
-	CHECK_NOT_NULL_RETURN(out_device);
-	
-	*out_device = pool->Device();
-	return VG_SUCCESS;
-}
-
-VgResult vgCommandPoolGetQueue(VgCommandPool pool, VgQueue* out_queue)
-{
-	FUNC_DATA(vgCommandPoolGetQueue);
-	CHECK_NOT_NULL_RETURN(pool);
-	CHECK_NOT_NULL_RETURN(out_queue);
 
-	*out_queue = pool->Queue();
-	return VG_SUCCESS;
+	CAPTURE(DEVICE_DESTROY_READBACK_POOL, device, pool);
+	if (capture) capture->Forget(pool);
+	GetAllocator().Delete(static_cast<ReadbackPool*>(pool));
 }
 
-VgResult vgCommandPoolAllocateCommandList(VgCommandPool pool, VgCommandList* out_cmd)
+VgResult vgDeviceGetReadbackResult(VgDevice device, VgReadbackPool pool, VgReadbackTicket ticket, VgReadbackResult* out_result)
 {
-	FUNC_DATA(vgCommandPoolAllocateCommandList);
+	FUNC_DATA(vgDeviceGetReadbackResult);
+	CHECK_NOT_NULL_RETURN(device);
 	CHECK_NOT_NULL_RETURN(pool);
-	CHECK_NOT_NULL_RETURN(out_cmd);
+	CHECK_NOT_NULL_RETURN(out_result);
 
 	try
 	{
-		*out_cmd = pool->AllocateCommandList();
+		return static_cast<ReadbackPool*>(pool)->GetResult(ticket, *out_result);
 	}
 	catch (VgError& ex)
 	{
 		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
 		return ex.result;
 	}
-	return VG_SUCCESS;
 }
 
-void vgCommandPoolFreeCommandList(VgCommandPool pool, VgCommandList cmd)
+void vgDeviceReleaseReadback(VgDevice device, VgReadbackPool pool, VgReadbackTicket ticket)
 {
-	FUNC_DATA(vgCommandPoolFreeCommandList);
+	FUNC_DATA(vgDeviceReleaseReadback);
+	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(pool);
-	CHECK_NOT_NULL(cmd);
 
-	pool->FreeCommandList(cmd);
+	CAPTURE(DEVICE_RELEASE_READBACK, device, pool, ticket);
+	static_cast<ReadbackPool*>(pool)->Release(ticket);
 }
 
-void vgCommandPoolReset(VgCommandPool pool)
+void vgDeviceProcessReadbacks(VgDevice device, VgReadbackPool pool)
 {
-	FUNC_DATA(vgCommandPoolReset);
+	FUNC_DATA(vgDeviceProcessReadbacks);
+	CHECK_NOT_NULL(device);
 	CHECK_NOT_NULL(pool);
 
-	pool->Reset();
+	CAPTURE(DEVICE_PROCESS_READBACKS, device, pool);
+	try
+	{
+		static_cast<ReadbackPool*>(pool)->Process();
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+	}
 }
 
-VgResult vgCommandListGetApiObject(VgCommandList list, void** out_obj)
+VgResult vgDeviceCreateConstantAllocator(VgDevice device, uint64_t size, VgConstantAllocator* out_allocator)
 {
-	FUNC_DATA(vgCommandListGetApiObject);
-	CHECK_NOT_NULL_RETURN(list);
-	CHECK_NOT_NULL_RETURN(out_obj);
-
-	*out_obj = list->GetApiObject();
-	return VG_SUCCESS;
-}
+	FUNC_DATA(vgDeviceCreateConstantAllocator);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(out_allocator);
+#if VG_VALIDATION
+	if (size == 0)
+	{
+		LOG(ERROR, "{}(): size must be greater than 0", _func_name_);
+		return VG_BAD_ARGUMENT;
+	}
+#endif
+
+	try
+	{
+		auto allocator = new(GetAllocator().Allocate<ConstantAllocator>()) ConstantAllocator(device, size);
+		*out_allocator = allocator;
+		if (capture)
+		{
+			// The ring is snapshotted like a mapped upload buffer, so the replay sees the constants written into it
+			CAPTURE(DEVICE_CREATE_CONSTANT_ALLOCATOR, device, size, CaptureWriter::NewHandle{ allocator },
+				CaptureWriter::NewHandle{ allocator->Buffer() });
+			capture->OnMap(allocator->Buffer(), allocator->Mapped());
+		}
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "Unable to create constant allocator: {}", ex.what());
+		return ex.result;
+	}
+	return VG_SUCCESS;
+}
+
+void vgDeviceDestroyConstantAllocator(VgDevice device, VgConstantAllocator allocator)
+{
+	FUNC_DATA(vgDeviceDestroyConstantAllocator);
+	CHECK_NOT_NULL(device);
+	CHECK_NOT_NULL(allocator);
+
+	CAPTURE(DEVICE_DESTROY_CONSTANT_ALLOCATOR, device, allocator);
+	if (capture)
+	{
+		capture->Forget(static_cast<ConstantAllocator*>(allocator)->Buffer());
+		capture->Forget(allocator);
+	}
+	GetAllocator().Delete(static_cast<ConstantAllocator*>(allocator));
+}
+
+VgResult vgDeviceAllocateConstants(VgDevice device, VgConstantAllocator allocator, uint64_t size, VgConstantAllocation* out_allocation)
+{
+	FUNC_DATA(vgDeviceAllocateConstants);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(allocator);
+	CHECK_NOT_NULL_RETURN(out_allocation);
+#if VG_VALIDATION
+	if (size == 0 || size > VG_MAX_CONSTANT_ALLOCATION_SIZE)
+	{
+		LOG(ERROR, "{}(): size must be between 1 and {} but is {}", _func_name_, VG_MAX_CONSTANT_ALLOCATION_SIZE, size);
+		return VG_BAD_ARGUMENT;
+	}
+	if (static_cast<ConstantAllocator*>(allocator)->Device() != device)
+	{
+		LOG(ERROR, "{}(): allocator was created on another device", _func_name_);
+		return VG_BAD_ARGUMENT;
+	}
+#endif
+
+	try
+	{
+		if (!static_cast<ConstantAllocator*>(allocator)->Allocate(size, *out_allocation))
+		{
+			LOG(WARN, "{}(): constant allocator is full, end frames or use a larger allocator", _func_name_);
+			return VG_OUT_OF_MEMORY;
+		}
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+		return ex.result;
+	}
+	CAPTURE(DEVICE_ALLOCATE_CONSTANTS, device, allocator, size, out_allocation->offset, out_allocation->view);
+	return VG_SUCCESS;
+}
+
+void vgDeviceEndConstantFrame(VgDevice device, VgConstantAllocator allocator, VgFence fence, uint64_t fence_value)
+{
+	FUNC_DATA(vgDeviceEndConstantFrame);
+	CHECK_NOT_NULL(device);
+	CHECK_NOT_NULL(allocator);
+	CHECK_NOT_NULL(fence);
+
+	CAPTURE(DEVICE_END_CONSTANT_FRAME, device, allocator, fence, fence_value);
+	static_cast<ConstantAllocator*>(allocator)->EndFrame(fence, fence_value);
+}
+
+VgResult vgDeviceCreateQueueScheduler(VgDevice device, VgQueueScheduler* out_scheduler)
+{
+	FUNC_DATA(vgDeviceCreateQueueScheduler);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(out_scheduler);
+
+	try
+	{
+		auto scheduler = new(GetAllocator().Allocate<QueueScheduler>()) QueueScheduler(device);
+		*out_scheduler = scheduler;
+
+		// The scheduler is recorded as its fences, so replays do not need to know about it
+		for (auto queue : { VG_QUEUE_GRAPHICS, VG_QUEUE_COMPUTE, VG_QUEUE_TRANSFER })
+		{
+			CAPTURE(DEVICE_CREATE_FENCE, device, uint64_t{ 0 }, CaptureWriter::NewHandle{ scheduler->Fence(queue) });
+		}
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "Unable to create queue scheduler: {}", ex.what());
+		return ex.result;
+	}
+	return VG_SUCCESS;
+}
+
+void vgDeviceDestroyQueueScheduler(VgDevice device, VgQueueScheduler scheduler)
+{
+	FUNC_DATA(vgDeviceDestroyQueueScheduler);
+	CHECK_NOT_NULL(device);
+	CHECK_NOT_NULL(scheduler);
+
+	auto queueScheduler = static_cast<QueueScheduler*>(scheduler);
+	for (auto queue : { VG_QUEUE_GRAPHICS, VG_QUEUE_COMPUTE, VG_QUEUE_TRANSFER })
+	{
+		const VgFence fence = queueScheduler->Fence(queue);
+		CAPTURE(DEVICE_WAIT_FENCE, device, fence, queueScheduler->LastValue(queue));
+		CAPTURE(DEVICE_DESTROY_FENCE, device, fence);
+		if (capture) capture->Forget(fence);
+	}
+	try
+	{
+		GetAllocator().Delete(queueScheduler);
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+	}
+}
+
+VgResult vgDeviceScheduleCommandLists(VgDevice device, VgQueueScheduler scheduler, uint32_t num_command_lists, VgCommandList* command_lists, uint32_t num_dependencies, const VgSyncPoint* dependencies, VgSyncPoint* out_sync_point)
+{
+	FUNC_DATA(vgDeviceScheduleCommandLists);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(scheduler);
+	CHECK_NOT_NULL_RETURN(command_lists);
+	CHECK_NOT_NULL_RETURN(out_sync_point);
+	if (num_dependencies > 0) CHECK_NOT_NULL_RETURN(dependencies);
+
+	if (num_command_lists == 0)
+	{
+		LOG(ERROR, "{}(): num_command_lists must be greater than 0", _func_name_);
+		return VG_BAD_ARGUMENT;
+	}
+	for (uint32_t i = 0; i < num_command_lists; i++)
+	{
+		if (command_lists[i] == nullptr)
+		{
+			LOG(ERROR, "{}(): command list {} = NULL", _func_name_, i);
+			return VG_BAD_ARGUMENT;
+		}
+		if (command_lists[i]->IsBundle())
+		{
+			LOG(ERROR, "{}(): command list {} is a bundle, bundles are executed with vgCmdExecuteBundle()", _func_name_, i);
+			return VG_ILLEGAL_OPERATION;
+		}
+	}
+
+	// Every submit signals the fence of a single queue, so the lists cannot be split across queues
+	const VgQueue queue = command_lists[0]->CommandPool()->Queue();
+	for (uint32_t i = 1; i < num_command_lists; i++)
+	{
+		if (command_lists[i]->CommandPool()->Queue() != queue)
+		{
+			LOG(ERROR, "{}(): command list {} belongs to queue {} but command list 0 to queue {}", _func_name_, i,
+				magic_enum::enum_name(command_lists[i]->CommandPool()->Queue()), magic_enum::enum_name(queue));
+			return VG_BAD_ARGUMENT;
+		}
+	}
+
+	try
+	{
+		*out_sync_point = static_cast<QueueScheduler*>(scheduler)->Schedule(queue,
+			{ command_lists, num_command_lists }, { dependencies, num_dependencies },
+			[&](const VgSubmitInfo& submit)
+			{
+				if (capture)
+				{
+					capture->SnapshotMappedBuffers();
+					CAPTURE(DEVICE_SUBMIT_COMMAND_LISTS, device, std::span<const VgSubmitInfo>(&submit, 1));
+				}
+				device->StateTracker().Submit(1, &submit, [&](uint32_t numSubmits, const VgSubmitInfo* patchedSubmits)
+					{
+						device->SubmitCommandLists(numSubmits, patchedSubmits);
+					});
+			});
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+		return ex.result;
+	}
+	device->BudgetMonitor().Check(device);
+	return VG_SUCCESS;
+}
+
+VgResult vgDeviceGetSyncPointFence(VgDevice device, VgQueueScheduler scheduler, const VgSyncPoint* sync_point, VgFenceOperation* out_fence)
+{
+	FUNC_DATA(vgDeviceGetSyncPointFence);
+	CHECK_NOT_NULL_RETURN(device);
+	CHECK_NOT_NULL_RETURN(scheduler);
+	CHECK_NOT_NULL_RETURN(sync_point);
+	CHECK_NOT_NULL_RETURN(out_fence);
+	if (sync_point->queue > VG_QUEUE_TRANSFER)
+	{
+		LOG(ERROR, "{}(): sync_point->queue({}) is not a valid queue", _func_name_, static_cast<uint64_t>(sync_point->queue));
+		return VG_BAD_ARGUMENT;
+	}
+
+	*out_fence = { static_cast<QueueScheduler*>(scheduler)->Fence(sync_point->queue), sync_point->value };
+	return VG_SUCCESS;
+}
+
+VgResult vgCommandPoolGetApiObject(VgCommandPool pool, void** out_obj)
+{
+	FUNC_DATA(vgCommandPoolGetApiObject);
+	CHECK_NOT_NULL_RETURN(pool);
+	CHECK_NOT_NULL_RETURN(out_obj);
+
+	*out_obj = pool->GetApiObject();
+	return VG_SUCCESS;
+}
+
+void vgCommandPoolSetName(VgCommandPool pool, const char* name)
+{
+	FUNC_DATA(vgCommandPoolSetName);
+	CHECK_NOT_NULL(pool);
+	CHECK_NOT_NULL(name);
+
+	CAPTURE(COMMAND_POOL_SET_NAME, pool, name);
+	pool->SetName(name);
+}
+
+VgResult vgCommandPoolGetDevice(VgCommandPool pool, VgDevice* out_device)
+{
+	FUNC_DATA(vgCommandPoolGetDevice);
+	CHECK_NOT_NULL_RETURN(pool);
+	CHECK_NOT_NULL_RETURN(out_device);
+	
+	*out_device = pool->Device();
+	return VG_SUCCESS;
+}
+
+VgResult vgCommandPoolGetQueue(VgCommandPool pool, VgQueue* out_queue)
+{
+	FUNC_DATA(vgCommandPoolGetQueue);
+	CHECK_NOT_NULL_RETURN(pool);
+	CHECK_NOT_NULL_RETURN(out_queue);
+
+	*out_queue = pool->Queue();
+	return VG_SUCCESS;
+}
+
+VgResult vgCommandPoolAllocateCommandList(VgCommandPool pool, VgCommandList* out_cmd)
+{
+	FUNC_DATA(vgCommandPoolAllocateCommandList);
+	CHECK_NOT_NULL_RETURN(pool);
+	CHECK_NOT_NULL_RETURN(out_cmd);
+
+	try
+	{
+		*out_cmd = pool->AllocateCommandList();
+		if (pool->Flags() & VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES) (*out_cmd)->EnableStateTracking();
+		CAPTURE(COMMAND_POOL_ALLOCATE_COMMAND_LIST, pool, CaptureWriter::NewHandle{ *out_cmd });
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+		return ex.result;
+	}
+	return VG_SUCCESS;
+}
+
+void vgCommandPoolFreeCommandList(VgCommandPool pool, VgCommandList cmd)
+{
+	FUNC_DATA(vgCommandPoolFreeCommandList);
+	CHECK_NOT_NULL(pool);
+	CHECK_NOT_NULL(cmd);
+
+	CAPTURE(COMMAND_POOL_FREE_COMMAND_LIST, pool, cmd);
+	if (capture) capture->Forget(cmd);
+	if (auto tracker = cmd->StateTracker())
+	{
+		for (auto patch : tracker->PatchLists())
+		{
+			pool->FreeCommandList(patch);
+		}
+	}
+	pool->FreeCommandList(cmd);
+}
+
+void vgCommandPoolReset(VgCommandPool pool)
+{
+	FUNC_DATA(vgCommandPoolReset);
+	CHECK_NOT_NULL(pool);
+
+	CAPTURE(COMMAND_POOL_RESET, pool);
+	pool->Reset();
+}
+
+VgResult vgCommandListGetApiObject(VgCommandList list, void** out_obj)
+{
+	FUNC_DATA(vgCommandListGetApiObject);
+	CHECK_NOT_NULL_RETURN(list);
+	CHECK_NOT_NULL_RETURN(out_obj);
+
+	*out_obj = list->GetApiObject();
+	return VG_SUCCESS;
+}
 
 void vgCommandListSetName(VgCommandList list, const char* name)
 {
@@ -1206,6 +1831,7 @@ void vgCommandListSetName(VgCommandList list, const char* name)
 	CHECK_NOT_NULL(list);
 	CHECK_NOT_NULL(name);
 
+	CAPTURE(COMMAND_LIST_SET_NAME, list, name);
 	list->SetName(name);
 }
 
@@ -1239,12 +1865,24 @@ VgResult vgCommandListGetQueue(VgCommandList cmd, VgQueue* out_queue)
 	return VG_SUCCESS;
 }
 
+VgResult vgCommandListGetStatistics(VgCommandList cmd, VgCommandListStatistics* out_statistics)
+{
+	FUNC_DATA(vgCommandListGetStatistics);
+	CHECK_NOT_NULL_RETURN(cmd);
+	CHECK_NOT_NULL_RETURN(out_statistics);
+
+	*out_statistics = cmd->ShadowState().Statistics();
+	return VG_SUCCESS;
+}
+
 void vgCommandListRestoreDescriptorState(VgCommandList cmd)
 {
 	FUNC_DATA(vgCommandListRestoreDescriptorState);
 	CHECK_NOT_NULL(cmd);
 
+	CAPTURE(COMMAND_LIST_RESTORE_DESCRIPTOR_STATE, cmd);
 	cmd->RestoreDescriptorState();
+	cmd->ShadowState().InvalidateRootConstants();
 }
 
 void vgCmdBegin(VgCommandList cmd)
@@ -1252,14 +1890,84 @@ void vgCmdBegin(VgCommandList cmd)
 	FUNC_DATA(vgCmdBegin);
 	CHECK_NOT_NULL(cmd);
 
+#if VG_VALIDATION
+	if (cmd->IsBundle())
+	{
+		LOG(ERROR, "{}(): cmd is a bundle, use vgCmdBeginBundle() instead", _func_name_);
+		return;
+	}
+#endif
+	CAPTURE(CMD_BEGIN, cmd);
+	if (auto tracker = cmd->StateTracker()) tracker->Reset();
+	cmd->ShadowState().Reset();
+	cmd->GraphicsState().Reset();
 	cmd->Begin();
 }
 
+VgResult vgCmdBeginBundle(VgCommandList cmd, const VgBundleInheritanceInfo* inheritance_info)
+{
+	FUNC_DATA(vgCmdBeginBundle);
+	CHECK_NOT_NULL_RETURN(cmd);
+	CHECK_NOT_NULL_RETURN(inheritance_info);
+	if (!cmd->IsBundle())
+	{
+		LOG(ERROR, "{}(): cmd was not allocated from a VG_COMMAND_POOL_FLAG_BUNDLE pool", _func_name_);
+		return VG_ILLEGAL_OPERATION;
+	}
+	if (inheritance_info->num_color_attachments > vg_num_max_color_attachments)
+	{
+		LOG(ERROR, "{}(): num_color_attachments({}) should not exceed vg_num_max_color_attachments({})", _func_name_,
+			inheritance_info->num_color_attachments, vg_num_max_color_attachments);
+		return VG_BAD_ARGUMENT;
+	}
+	if (inheritance_info->num_viewports > vg_num_max_viewports_and_scissors)
+	{
+		LOG(ERROR, "{}(): num_viewports({}) should not exceed vg_num_max_viewports_and_scissors({})", _func_name_,
+			inheritance_info->num_viewports, vg_num_max_viewports_and_scissors);
+		return VG_BAD_ARGUMENT;
+	}
+	if (inheritance_info->num_viewports > 0 && (!inheritance_info->viewports || !inheritance_info->scissors))
+	{
+		LOG(ERROR, "{}(): num_viewports({}) > 0, but viewports or scissors is NULL", _func_name_, inheritance_info->num_viewports);
+		return VG_BAD_ARGUMENT;
+	}
+
+#if VG_VALIDATION
+	for (uint32_t i = 0; i < inheritance_info->num_color_attachments; i++)
+	{
+		VALIDATE_ENUM_RETURN(inheritance_info->color_attachment_formats[i], "color_attachment_formats[{}]", i);
+	}
+	VALIDATE_ENUM_RETURN(inheritance_info->depth_stencil_format, "depth_stencil_format");
+	VALIDATE_ENUM_RETURN(inheritance_info->sample_count, "sample_count");
+	if (inheritance_info->depth_stencil_format != VG_FORMAT_UNKNOWN && !FormatIsDepthStencil(inheritance_info->depth_stencil_format))
+	{
+		LOG(ERROR, "{}(): depth_stencil_format({}) is not a depth stencil format", _func_name_,
+			magic_enum::enum_name(inheritance_info->depth_stencil_format));
+		return VG_BAD_ARGUMENT;
+	}
+#endif
+
+	CAPTURE(CMD_BEGIN_BUNDLE, cmd, *inheritance_info);
+	cmd->ShadowState().Reset();
+	cmd->GraphicsState().Reset();
+	try
+	{
+		cmd->BeginBundle(*inheritance_info);
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+		return ex.result;
+	}
+	return VG_SUCCESS;
+}
+
 void vgCmdEnd(VgCommandList cmd)
 {
 	FUNC_DATA(vgCmdEnd);
 	CHECK_NOT_NULL(cmd);
 
+	CAPTURE(CMD_END, cmd);
 	cmd->End();
 }
 
@@ -1272,11 +1980,17 @@ void vgCmdSetVertexBuffers(VgCommandList cmd, uint32_t start_slot, uint32_t num_
 		LOG(WARN, "{}(): buffers = NULL", _func_name_);
 		return;
 	}
-	if (num_buffers > vg_num_max_vertex_buffers)
+	if (start_slot >= vg_num_max_vertex_buffers)
+	{
+		LOG(ERROR, "{}(): start_slot({}) should be < vg_num_max_vertex_buffers({})", _func_name_,
+			start_slot, vg_num_max_vertex_buffers);
+		return;
+	}
+	if (start_slot + num_buffers > vg_num_max_vertex_buffers)
 	{
-		LOG(WARN, "{}(): num_buffers({}) should not exceed vg_num_max_vertex_buffers({}) -> clamped", _func_name_,
-			num_buffers, vg_num_max_vertex_buffers);
-		num_buffers = vg_num_max_vertex_buffers;
+		LOG(WARN, "{}(): start_slot({}) + num_buffers({}) should not exceed vg_num_max_vertex_buffers({}) -> clamped", _func_name_,
+			start_slot, num_buffers, vg_num_max_vertex_buffers);
+		num_buffers = vg_num_max_vertex_buffers - start_slot;
 	}
 #if VG_VALIDATION
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
@@ -1298,6 +2012,8 @@ void vgCmdSetVertexBuffers(VgCommandList cmd, uint32_t start_slot, uint32_t num_
 		}
 	}
 #endif
+	CAPTURE(CMD_SET_VERTEX_BUFFERS, cmd, start_slot, std::span<const VgVertexBufferView>(buffers, num_buffers));
+	if (!cmd->ShadowState().SetVertexBuffers(start_slot, num_buffers, buffers)) return;
 	cmd->SetVertexBuffers(start_slot, num_buffers, buffers);
 }
 
@@ -1315,6 +2031,8 @@ void vgCmdSetIndexBuffer(VgCommandList cmd, VgIndexType index_type, uint64_t off
 	}
 	VALIDATE_ENUM(index_type, "index_type");
 #endif
+	CAPTURE(CMD_SET_INDEX_BUFFER, cmd, index_type, offset, index_buffer);
+	if (!cmd->ShadowState().SetIndexBuffer(index_type, offset, index_buffer)) return;
 	cmd->SetIndexBuffer(index_type, offset, index_buffer);
 }
 
@@ -1343,6 +2061,9 @@ void vgCmdSetRootConstants(VgCommandList cmd, VgPipelineType pipeline_type,
 	}
 	VALIDATE_ENUM(pipeline_type, "pipeline_type");
 #endif
+	CAPTURE(CMD_SET_ROOT_CONSTANTS, cmd, pipeline_type, offset_in_32bit_values,
+		CaptureWriter::Blob(static_cast<const uint8_t*>(data), num_32bit_values * sizeof(uint32_t)));
+	if (!cmd->ShadowState().SetRootConstants(pipeline_type, offset_in_32bit_values, num_32bit_values, data)) return;
 	cmd->SetRootConstants(pipeline_type, offset_in_32bit_values, num_32bit_values, data);
 }
 
@@ -1363,15 +2084,51 @@ void vgCmdSetPipeline(VgCommandList cmd, VgPipeline pipeline)
 		LOG(ERROR, "{}(): command list queue is VG_QUEUE_COMPUTE but pipeline type is VG_PIPELINE_TYPE_GRAPHICS", _func_name_);
 		return;
 	}
+	if (pipeline->Library())
+	{
+		LOG(ERROR, "{}(): pipeline is a graphics pipeline library, link it with vgDeviceLinkGraphicsPipeline()", _func_name_);
+		return;
+	}
 #endif
 
+	CAPTURE(CMD_SET_PIPELINE, cmd, pipeline);
+	cmd->GraphicsState().OnSetPipeline(pipeline->Type(), pipeline->VertexPipeline());
+	if (!cmd->ShadowState().SetPipeline(pipeline)) return;
 	cmd->SetPipeline(pipeline);
 }
 
+void vgCmdSetGraphicsState(VgCommandList cmd, VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc* desc)
+{
+	FUNC_DATA(vgCmdSetGraphicsState);
+	CHECK_NOT_NULL(cmd);
+	CHECK_NOT_NULL(desc);
+	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		return;
+	}
+#if VG_VALIDATION
+	VALIDATE_FLAGS(parts, "parts");
+#endif
+	if (ValidateGraphicsPipelineDesc(_func_name_, cmd->Device(), desc, parts) != VG_SUCCESS) return;
+
+	if (capture)
+	{
+		GraphicsPipelineParts captured;
+		captured.Add(parts, *desc);
+		CAPTURE(CMD_SET_GRAPHICS_STATE, cmd, parts, captured.Desc());
+	}
+	cmd->GraphicsState().Set(parts, *desc);
+}
+
 void vgCmdBarrier(VgCommandList cmd, const VgDependencyInfo* dependency_info)
 {
 	FUNC_DATA(vgCmdBarrier);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(dependency_info);
 
 #if VG_VALIDATION
@@ -1495,9 +2252,68 @@ void vgCmdBarrier(VgCommandList cmd, const VgDependencyInfo* dependency_info)
 	}
 #endif
 
+	CAPTURE(CMD_BARRIER, cmd, *dependency_info);
 	cmd->Barrier(*dependency_info);
 }
 
+void vgCmdTransition(VgCommandList cmd, const VgTransitionInfo* transition_info)
+{
+	FUNC_DATA(vgCmdTransition);
+	CHECK_NOT_NULL(cmd);
+	CHECK_NOT_NULL(transition_info);
+
+	auto tracker = cmd->StateTracker();
+	if (!tracker)
+	{
+		LOG(ERROR, "{}(): cmd is not allocated from a pool with {}", _func_name_,
+			magic_enum::enum_name(VG_COMMAND_POOL_FLAG_TRACK_RESOURCE_STATES));
+		return;
+	}
+	if (transition_info->num_buffer_transitions > 0 && !transition_info->buffer_transitions)
+	{
+		LOG(ERROR, "{}(): num_buffer_transitions({}) > 0, but buffer_transitions is NULL", _func_name_, transition_info->num_buffer_transitions);
+		return;
+	}
+	if (transition_info->num_texture_transitions > 0 && !transition_info->texture_transitions)
+	{
+		LOG(ERROR, "{}(): num_texture_transitions({}) > 0, but texture_transitions is NULL", _func_name_, transition_info->num_texture_transitions);
+		return;
+	}
+	for (uint32_t i = 0; i < transition_info->num_buffer_transitions; i++)
+	{
+		if (transition_info->buffer_transitions[i].buffer == nullptr)
+		{
+			LOG(ERROR, "{}(): buffer transition {}: buffer = NULL", _func_name_, i);
+			return;
+		}
+	}
+	for (uint32_t i = 0; i < transition_info->num_texture_transitions; i++)
+	{
+		if (transition_info->texture_transitions[i].texture == nullptr)
+		{
+			LOG(ERROR, "{}(): texture transition {}: texture = NULL", _func_name_, i);
+			return;
+		}
+	}
+
+#if VG_VALIDATION
+	for (uint32_t i = 0; i < transition_info->num_buffer_transitions; i++)
+	{
+		VALIDATE_FLAGS(transition_info->buffer_transitions[i].stage, "buffer transition {} stage", i);
+		VALIDATE_FLAGS(transition_info->buffer_transitions[i].access, "buffer transition {} access", i);
+	}
+	for (uint32_t i = 0; i < transition_info->num_texture_transitions; i++)
+	{
+		VALIDATE_FLAGS(transition_info->texture_transitions[i].stage, "texture transition {} stage", i);
+		VALIDATE_FLAGS(transition_info->texture_transitions[i].access, "texture transition {} access", i);
+		VALIDATE_ENUM(transition_info->texture_transitions[i].layout, "texture transition {} layout", i);
+	}
+#endif
+
+	CAPTURE(CMD_TRANSITION, cmd, *transition_info);
+	tracker->Transition(cmd, *transition_info);
+}
+
 VgResult vgBufferGetApiObject(VgBuffer buffer, void** out_obj)
 {
 	FUNC_DATA(vgBufferGetApiObject);
@@ -1514,6 +2330,7 @@ void vgBufferSetName(VgBuffer buffer, const char* name)
 	CHECK_NOT_NULL(buffer);
 	CHECK_NOT_NULL(name);
 
+	CAPTURE(BUFFER_SET_NAME, buffer, name);
 	buffer->SetName(name);
 }
 
@@ -1565,7 +2382,16 @@ VgResult vgBufferCreateView(VgBuffer buffer, const VgBufferViewDesc* desc, VgVie
 	{
 		descCopy.size = buffer->Desc().size - desc->offset;
 	}
-	*out_descriptor = buffer->CreateView(descCopy);
+	try
+	{
+		*out_descriptor = buffer->CreateView(descCopy);
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "{}() failed: {}", _func_name_, ex.what());
+		return ex.result;
+	}
+	CAPTURE(BUFFER_CREATE_VIEW, buffer, descCopy, *out_descriptor);
 	return VG_SUCCESS;
 }
 
@@ -1574,6 +2400,7 @@ void vgBufferDestroyViews(VgBuffer buffer)
 	FUNC_DATA(vgBufferDestroyViews);
 	CHECK_NOT_NULL(buffer);
 
+	CAPTURE(BUFFER_DESTROY_VIEWS, buffer);
 	buffer->DestroyViews();
 }
 
@@ -1586,6 +2413,11 @@ VgResult vgBufferMap(VgBuffer buffer, void** out_data)
 	try
 	{
 		*out_data = buffer->Map();
+		if (capture)
+		{
+			CAPTURE(BUFFER_MAP, buffer);
+			capture->OnMap(buffer, *out_data);
+		}
 	}
 	catch (VgError& ex)
 	{
@@ -1600,6 +2432,11 @@ void vgBufferUnmap(VgBuffer buffer)
 	FUNC_DATA(vgBufferUnmap);
 	CHECK_NOT_NULL(buffer);
 
+	if (capture)
+	{
+		capture->OnUnmap(buffer);
+		CAPTURE(BUFFER_UNMAP, buffer);
+	}
 	buffer->Unmap();
 }
 
@@ -1619,6 +2456,7 @@ void vgPipelineSetName(VgPipeline pipeline, const char* name)
 	CHECK_NOT_NULL(pipeline);
 	CHECK_NOT_NULL(name);
 
+	CAPTURE(PIPELINE_SET_NAME, pipeline, name);
 	pipeline->SetName(name);
 }
 
@@ -1642,10 +2480,37 @@ VgResult vgPipelineGetType(VgPipeline pipeline, VgPipelineType* out_type)
 	return VG_SUCCESS;
 }
 
+#if VG_VALIDATION
+// The contents of transient attachments only live in tile memory during the rendering
+// index is the index of a color attachment, ignored for the depth stencil attachment
+static bool ValidateTransientAttachment(std::string_view _func_name_, VgDevice device, bool depthStencil,
+	const VgAttachmentInfo& attachment, uint32_t index)
+{
+	if (!device->TransientAttachments().Contains(depthStencil, attachment.view)) return true;
+	const auto name = depthStencil ? std::string("depth_stencil_attachment") : std::format("color_attachments[{}]", index);
+	if (attachment.load_op == VG_ATTACHMENT_OP_DEFAULT)
+	{
+		LOG(ERROR, "{}(): {} has VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT usage and cannot be loaded, use {} or {}", _func_name_, name,
+			magic_enum::enum_name(VG_ATTACHMENT_OP_CLEAR), magic_enum::enum_name(VG_ATTACHMENT_OP_DONT_CARE));
+		return false;
+	}
+	if (attachment.store_op != VG_ATTACHMENT_OP_DONT_CARE)
+	{
+		LOG(ERROR, "{}(): {} has VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT usage and cannot be stored, use {}", _func_name_, name,
+			magic_enum::enum_name(VG_ATTACHMENT_OP_DONT_CARE));
+		return false;
+	}
+	return true;
+}
+#endif
+
 VgResult vgCmdBeginRendering(VgCommandList cmd, const VgRenderingInfo* info)
 {
 	FUNC_DATA(vgCmdBeginRendering);
 	CHECK_NOT_NULL_RETURN(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE_RETURN(cmd);
+#endif
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
 		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
@@ -1665,6 +2530,12 @@ VgResult vgCmdBeginRendering(VgCommandList cmd, const VgRenderingInfo* info)
 	}
 
 #if VG_VALIDATION
+	if (cmd->GetState() & (VgCommandList_t::STATE_RENDERING | VgCommandList_t::STATE_RENDERING_BUNDLES))
+	{
+		LOG(ERROR, "{}(): rendering was already started, call vgCmdEndRendering() first", _func_name_);
+		return VG_ILLEGAL_OPERATION;
+	}
+	VALIDATE_FLAGS_RETURN(info->flags, "flags");
 	for (uint32_t i = 0; i < info->num_color_attachments; i++)
 	{
 		if (info->color_attachments[i].view == VG_NO_VIEW)
@@ -1680,6 +2551,10 @@ VgResult vgCmdBeginRendering(VgCommandList cmd, const VgRenderingInfo* info)
 		}
 		VALIDATE_ENUM_RETURN(info->color_attachments[i].load_op, "color_attachments[{}].load_op", i);
 		VALIDATE_ENUM_RETURN(info->color_attachments[i].store_op, "color_attachments[{}].store_op", i);
+		if (!ValidateTransientAttachment(_func_name_, cmd->Device(), false, info->color_attachments[i], i))
+		{
+			return VG_ILLEGAL_OPERATION;
+		}
 	}
 	if (info->depth_stencil_attachment.view != VG_NO_VIEW)
 	{
@@ -1691,9 +2566,14 @@ VgResult vgCmdBeginRendering(VgCommandList cmd, const VgRenderingInfo* info)
 		}
 		VALIDATE_ENUM_RETURN(info->depth_stencil_attachment.load_op, "depth_stencil_attachment.load_op");
 		VALIDATE_ENUM_RETURN(info->depth_stencil_attachment.store_op, "depth_stencil_attachment.store_op");
+		if (!ValidateTransientAttachment(_func_name_, cmd->Device(), true, info->depth_stencil_attachment, 0))
+		{
+			return VG_ILLEGAL_OPERATION;
+		}
 	}
 #endif
 
+	CAPTURE(CMD_BEGIN_RENDERING, cmd, *info);
 	cmd->BeginRendering(*info);
 	return VG_SUCCESS;
 }
@@ -1702,18 +2582,196 @@ void vgCmdEndRendering(VgCommandList cmd)
 {
 	FUNC_DATA(vgCmdEndRendering);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
 		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
 			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
 		return;
 	}
+	CAPTURE(CMD_END_RENDERING, cmd);
 	cmd->EndRendering();
 }
 
-void vgCmdSetViewport(VgCommandList cmd, uint32_t first_viewport, uint32_t num_viewports, VgViewport* viewports)
+void vgCmdSetViewport(VgCommandList cmd, uint32_t first_viewport, uint32_t num_viewports, VgViewport* viewports)
+{
+	FUNC_DATA(vgCmdSetViewport);
+	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
+	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		return;
+	}
+	if (num_viewports == 0) return;
+	CHECK_NOT_NULL(viewports);
+
+	if (first_viewport >= vg_num_max_viewports_and_scissors)
+	{
+		LOG(ERROR, "{}(): first_viewport({}) should be < vg_num_max_viewports_and_scissors({})",
+			_func_name_, first_viewport, vg_num_max_viewports_and_scissors);
+		return;
+	}
+	if (first_viewport + num_viewports > vg_num_max_viewports_and_scissors)
+	{
+		LOG(WARN, "{}(): first_viewport({}) + num_viewports({}) should be <= vg_num_max_viewports_and_scissors({})",
+			_func_name_, first_viewport, num_viewports, vg_num_max_viewports_and_scissors);
+		num_viewports = vg_num_max_viewports_and_scissors - first_viewport;
+	}
+
+	CAPTURE(CMD_SET_VIEWPORT, cmd, first_viewport, std::span<const VgViewport>(viewports, num_viewports));
+	if (!cmd->ShadowState().SetViewports(first_viewport, num_viewports, viewports)) return;
+	cmd->SetViewport(first_viewport, num_viewports, viewports);
+}
+
+void vgCmdSetScissor(VgCommandList cmd, uint32_t first_scissor, uint32_t num_scissors, VgScissor* scissors)
+{
+	FUNC_DATA(vgCmdSetScissor);
+	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
+	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		return;
+	}
+	if (num_scissors == 0) return;
+	CHECK_NOT_NULL(scissors);
+
+	if (first_scissor >= vg_num_max_viewports_and_scissors)
+	{
+		LOG(ERROR, "{}(): first_scissor({}) should be < vg_num_max_viewports_and_scissors({})",
+			_func_name_, first_scissor, vg_num_max_viewports_and_scissors);
+		return;
+	}
+	if (first_scissor + num_scissors > vg_num_max_viewports_and_scissors)
+	{
+		LOG(WARN, "{}(): first_scissor({}) + num_viewports({}) should be <= vg_num_max_viewports_and_scissors({})",
+			_func_name_, first_scissor, num_scissors, vg_num_max_viewports_and_scissors);
+		num_scissors = vg_num_max_viewports_and_scissors - first_scissor;
+	}
+
+	CAPTURE(CMD_SET_SCISSOR, cmd, first_scissor, std::span<const VgScissor>(scissors, num_scissors));
+	if (!cmd->ShadowState().SetScissors(first_scissor, num_scissors, scissors)) return;
+	cmd->SetScissor(first_scissor, num_scissors, scissors);
+}
+
+void vgCmdExecuteBundle(VgCommandList cmd, VgCommandList bundle)
+{
+	FUNC_DATA(vgCmdExecuteBundle);
+	CHECK_NOT_NULL(cmd);
+	CHECK_NOT_NULL(bundle);
+	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		return;
+	}
+
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+	if (!bundle->IsBundle())
+	{
+		LOG(ERROR, "{}(): bundle was not allocated from a VG_COMMAND_POOL_FLAG_BUNDLE pool", _func_name_);
+		return;
+	}
+	if (bundle->Device() != cmd->Device())
+	{
+		LOG(ERROR, "{}(): bundle was created by another device than cmd", _func_name_);
+		return;
+	}
+	if (bundle->GetState() & VgCommandList_t::STATE_OPEN)
+	{
+		LOG(ERROR, "{}(): bundle is still being recorded, call vgCmdEnd() first", _func_name_);
+		return;
+	}
+	if (!(cmd->GetState() & VgCommandList_t::STATE_RENDERING_BUNDLES))
+	{
+		LOG(ERROR, "{}(): command list should be in state of rendering started with VG_RENDERING_FLAG_BUNDLES", _func_name_);
+		return;
+	}
+#endif
+
+	CAPTURE(CMD_EXECUTE_BUNDLE, cmd, bundle);
+	cmd->ExecuteBundle(bundle);
+	cmd->ShadowState().Invalidate();
+	cmd->GraphicsState().Invalidate();
+}
+
+// Binds the state of vgCmdSetGraphicsState() before a draw if it changed, false if the draw has to be dropped
+static bool BindGraphicsState(std::string_view _func_name_, VgCommandList cmd)
+{
+	auto& graphicsState = cmd->GraphicsState();
+	if (!graphicsState.NeedsBind()) return true;
+
+	const auto& state = graphicsState.State();
+	if (state.Parts() != GraphicsPipelineParts::All)
+	{
+		LOG(ERROR, "{}(): parts({}) of the graphics state were not set with vgCmdSetGraphicsState()", _func_name_,
+			static_cast<uint64_t>(GraphicsPipelineParts::All & ~state.Parts()));
+		return false;
+	}
+	// Checks the combinations of fields set by different calls
+	if (ValidateGraphicsPipelineDesc(_func_name_, cmd->Device(), &state.Desc(), GraphicsPipelineParts::All) != VG_SUCCESS) return false;
+
+	try
+	{
+		cmd->SetGraphicsState(state);
+	}
+	catch (VgError& ex)
+	{
+		LOG(ERROR, "Cannot bind graphics state: {}", ex.what());
+		return false;
+	}
+	graphicsState.OnBind();
+	cmd->ShadowState().InvalidatePipeline();
+	return true;
+}
+
+void vgCmdDraw(VgCommandList cmd, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+{
+	FUNC_DATA(vgCmdDraw);
+	CHECK_NOT_NULL(cmd);
+	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		return;
+	}
+
+#if VG_VALIDATION
+	if (!(cmd->GetState() & VgCommandList_t::STATE_RENDERING))
+	{
+		LOG(ERROR, "{}(): command list should be in state of rendering", _func_name_);
+		return;
+	}
+	if (vertex_count == 0)
+	{
+		LOG(WARN, "{}(): called with vertex_count = 0", _func_name_);
+		return;
+	}
+	if (instance_count == 0)
+	{
+		LOG(WARN, "{}(): called with instance_count = 0", _func_name_);
+		return;
+	}
+#endif
+
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	CAPTURE(CMD_DRAW, cmd, vertex_count, instance_count, first_vertex, first_instance);
+	cmd->Draw(vertex_count, instance_count, first_vertex, first_instance);
+}
+
+void vgCmdDrawIndexed(VgCommandList cmd, uint32_t index_count, uint32_t instance_count, uint32_t first_index, uint32_t vertex_offset, uint32_t first_instance)
 {
-	FUNC_DATA(vgCmdSetViewport);
+	FUNC_DATA(vgCmdDraw);
 	CHECK_NOT_NULL(cmd);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
@@ -1721,28 +2779,34 @@ void vgCmdSetViewport(VgCommandList cmd, uint32_t first_viewport, uint32_t num_v
 			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
 		return;
 	}
-	if (num_viewports == 0) return;
-	CHECK_NOT_NULL(viewports);
 
-	if (first_viewport >= vg_num_max_viewports_and_scissors)
+#if VG_VALIDATION
+	if (!(cmd->GetState() & VgCommandList_t::STATE_RENDERING))
 	{
-		LOG(ERROR, "{}(): first_viewport({}) should be < vg_num_max_viewports_and_scissors({})",
-			_func_name_, first_viewport, vg_num_max_viewports_and_scissors);
+		LOG(ERROR, "{}(): command list should be in state of rendering", _func_name_);
 		return;
 	}
-	if (first_viewport + num_viewports > vg_num_max_viewports_and_scissors)
+	if (index_count == 0)
 	{
-		LOG(WARN, "{}(): first_viewport({}) + num_viewports({}) should be <= vg_num_max_viewports_and_scissors({})",
-			_func_name_, first_viewport, num_viewports, vg_num_max_viewports_and_scissors);
-		num_viewports = vg_num_max_viewports_and_scissors - first_viewport;
+		LOG(WARN, "{}(): called with index_count = 0", _func_name_);
+		return;
+	}
+	if (instance_count == 0)
+	{
+		LOG(WARN, "{}(): called with instance_count = 0", _func_name_);
+		return;
 	}
+#endif
 
-	cmd->SetViewport(first_viewport, num_viewports, viewports);
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	CAPTURE(CMD_DRAW_INDEXED, cmd, index_count, instance_count, first_index, vertex_offset, first_instance);
+	cmd->DrawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
 }
 
-void vgCmdSetScissor(VgCommandList cmd, uint32_t first_scissor, uint32_t num_scissors, VgScissor* scissors)
+void vgCmdDrawMulti(VgCommandList cmd, uint32_t draw_count, const VgMultiDrawInfo* draws, uint32_t instance_count, uint32_t first_instance,
+	const VgMultiDrawRootConstants* root_constants)
 {
-	FUNC_DATA(vgCmdSetScissor);
+	FUNC_DATA(vgCmdDrawMulti);
 	CHECK_NOT_NULL(cmd);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
@@ -1750,33 +2814,22 @@ void vgCmdSetScissor(VgCommandList cmd, uint32_t first_scissor, uint32_t num_sci
 			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
 		return;
 	}
-	if (num_scissors == 0) return;
-	CHECK_NOT_NULL(scissors);
-
-	if (first_scissor >= vg_num_max_viewports_and_scissors)
+	if (draw_count == 0)
 	{
-		LOG(ERROR, "{}(): first_scissor({}) should be < vg_num_max_viewports_and_scissors({})",
-			_func_name_, first_scissor, vg_num_max_viewports_and_scissors);
+		LOG(WARN, "{}(): called with draw_count = 0", _func_name_);
 		return;
 	}
-	if (first_scissor + num_scissors > vg_num_max_viewports_and_scissors)
+	CHECK_NOT_NULL(draws);
+	if (root_constants && root_constants->num_32bit_values == 0) root_constants = nullptr;
+	if (root_constants && !root_constants->data)
 	{
-		LOG(WARN, "{}(): first_scissor({}) + num_viewports({}) should be <= vg_num_max_viewports_and_scissors({})",
-			_func_name_, first_scissor, num_scissors, vg_num_max_viewports_and_scissors);
-		num_scissors = vg_num_max_viewports_and_scissors - first_scissor;
+		LOG(WARN, "{}(): root_constants->data = NULL but root_constants->num_32bit_values > 0", _func_name_);
+		return;
 	}
-
-	cmd->SetScissor(first_scissor, num_scissors, scissors);
-}
-
-void vgCmdDraw(VgCommandList cmd, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
-{
-	FUNC_DATA(vgCmdDraw);
-	CHECK_NOT_NULL(cmd);
-	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	if (root_constants && root_constants->offset_in_32bit_values + root_constants->num_32bit_values > vg_num_allowed_root_constants)
 	{
-		LOG(ERROR, "(){}: only allowed on {} but cmd is on queue {}", _func_name_,
-			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		LOG(ERROR, "{}(): root constant offset {} + count {} > allowed {}", _func_name_,
+			root_constants->offset_in_32bit_values, root_constants->num_32bit_values, vg_num_allowed_root_constants);
 		return;
 	}
 
@@ -1786,24 +2839,40 @@ void vgCmdDraw(VgCommandList cmd, uint32_t vertex_count, uint32_t instance_count
 		LOG(ERROR, "{}(): command list should be in state of rendering", _func_name_);
 		return;
 	}
-	if (vertex_count == 0)
-	{
-		LOG(WARN, "{}(): called with vertex_count = 0", _func_name_);
-		return;
-	}
 	if (instance_count == 0)
 	{
 		LOG(WARN, "{}(): called with instance_count = 0", _func_name_);
 		return;
 	}
+	for (uint32_t i = 0; i < draw_count; i++)
+	{
+		if (draws[i].vertex_count == 0) LOG(WARN, "{}(): draws[{}].vertex_count = 0", _func_name_, i);
+	}
 #endif
 
-	cmd->Draw(vertex_count, instance_count, first_vertex, first_instance);
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	if (capture)
+	{
+		// Written with the stride of the application, so the replay reads the values of every draw from the same offsets
+		const VgMultiDrawRootConstants rootConstants = root_constants ? *root_constants : VgMultiDrawRootConstants{};
+		const size_t rootConstantsSize = root_constants
+			? (draw_count - 1) * static_cast<size_t>(rootConstants.stride) + rootConstants.num_32bit_values * sizeof(uint32_t) : 0;
+		CAPTURE(CMD_DRAW_MULTI, cmd, std::span<const VgMultiDrawInfo>(draws, draw_count), instance_count, first_instance,
+			rootConstants.offset_in_32bit_values, rootConstants.num_32bit_values, rootConstants.stride,
+			CaptureWriter::Blob(static_cast<const uint8_t*>(rootConstants.data), rootConstantsSize));
+	}
+	cmd->DrawMulti(draw_count, draws, instance_count, first_instance, root_constants);
+	if (root_constants)
+	{
+		cmd->ShadowState().OverwriteRootConstants(VG_PIPELINE_TYPE_GRAPHICS, root_constants->offset_in_32bit_values, root_constants->num_32bit_values,
+			static_cast<const uint8_t*>(root_constants->data) + (draw_count - 1) * static_cast<size_t>(root_constants->stride));
+	}
 }
 
-void vgCmdDrawIndexed(VgCommandList cmd, uint32_t index_count, uint32_t instance_count, uint32_t first_index, uint32_t vertex_offset, uint32_t first_instance)
+void vgCmdDrawIndexedMulti(VgCommandList cmd, uint32_t draw_count, const VgMultiDrawIndexedInfo* draws, uint32_t instance_count, uint32_t first_instance,
+	const VgMultiDrawRootConstants* root_constants)
 {
-	FUNC_DATA(vgCmdDraw);
+	FUNC_DATA(vgCmdDrawIndexedMulti);
 	CHECK_NOT_NULL(cmd);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
@@ -1811,6 +2880,24 @@ void vgCmdDrawIndexed(VgCommandList cmd, uint32_t index_count, uint32_t instance
 			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
 		return;
 	}
+	if (draw_count == 0)
+	{
+		LOG(WARN, "{}(): called with draw_count = 0", _func_name_);
+		return;
+	}
+	CHECK_NOT_NULL(draws);
+	if (root_constants && root_constants->num_32bit_values == 0) root_constants = nullptr;
+	if (root_constants && !root_constants->data)
+	{
+		LOG(WARN, "{}(): root_constants->data = NULL but root_constants->num_32bit_values > 0", _func_name_);
+		return;
+	}
+	if (root_constants && root_constants->offset_in_32bit_values + root_constants->num_32bit_values > vg_num_allowed_root_constants)
+	{
+		LOG(ERROR, "{}(): root constant offset {} + count {} > allowed {}", _func_name_,
+			root_constants->offset_in_32bit_values, root_constants->num_32bit_values, vg_num_allowed_root_constants);
+		return;
+	}
 
 #if VG_VALIDATION
 	if (!(cmd->GetState() & VgCommandList_t::STATE_RENDERING))
@@ -1818,19 +2905,34 @@ void vgCmdDrawIndexed(VgCommandList cmd, uint32_t index_count, uint32_t instance
 		LOG(ERROR, "{}(): command list should be in state of rendering", _func_name_);
 		return;
 	}
-	if (index_count == 0)
-	{
-		LOG(WARN, "{}(): called with index_count = 0", _func_name_);
-		return;
-	}
 	if (instance_count == 0)
 	{
 		LOG(WARN, "{}(): called with instance_count = 0", _func_name_);
 		return;
 	}
+	for (uint32_t i = 0; i < draw_count; i++)
+	{
+		if (draws[i].index_count == 0) LOG(WARN, "{}(): draws[{}].index_count = 0", _func_name_, i);
+	}
 #endif
 
-	cmd->DrawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	if (capture)
+	{
+		// Written with the stride of the application, so the replay reads the values of every draw from the same offsets
+		const VgMultiDrawRootConstants rootConstants = root_constants ? *root_constants : VgMultiDrawRootConstants{};
+		const size_t rootConstantsSize = root_constants
+			? (draw_count - 1) * static_cast<size_t>(rootConstants.stride) + rootConstants.num_32bit_values * sizeof(uint32_t) : 0;
+		CAPTURE(CMD_DRAW_INDEXED_MULTI, cmd, std::span<const VgMultiDrawIndexedInfo>(draws, draw_count), instance_count, first_instance,
+			rootConstants.offset_in_32bit_values, rootConstants.num_32bit_values, rootConstants.stride,
+			CaptureWriter::Blob(static_cast<const uint8_t*>(rootConstants.data), rootConstantsSize));
+	}
+	cmd->DrawIndexedMulti(draw_count, draws, instance_count, first_instance, root_constants);
+	if (root_constants)
+	{
+		cmd->ShadowState().OverwriteRootConstants(VG_PIPELINE_TYPE_GRAPHICS, root_constants->offset_in_32bit_values, root_constants->num_32bit_values,
+			static_cast<const uint8_t*>(root_constants->data) + (draw_count - 1) * static_cast<size_t>(root_constants->stride));
+	}
 }
 
 void vgCmdDispatch(VgCommandList cmd, uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
@@ -1858,6 +2960,7 @@ void vgCmdDispatch(VgCommandList cmd, uint32_t groups_x, uint32_t groups_y, uint
 		LOG(WARN, "{}(): groups_z = 0", _func_name_);
 		return;
 	}
+	CAPTURE(CMD_DISPATCH, cmd, groups_x, groups_y, groups_z);
 	cmd->Dispatch(groups_x, groups_y, groups_z);
 }
 
@@ -1865,6 +2968,9 @@ void vgCmdDrawIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offset, uint
 {
 	FUNC_DATA(vgCmdDrawIndirect);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(buffer);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
@@ -1891,6 +2997,8 @@ void vgCmdDrawIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offset, uint
 		return;
 	}
 #endif
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	CAPTURE(CMD_DRAW_INDIRECT, cmd, buffer, offset, draw_count, stride);
 	cmd->DrawIndirect(buffer, offset, draw_count, stride);
 }
 
@@ -1898,6 +3006,9 @@ void vgCmdDrawIndirectCount(VgCommandList cmd, VgBuffer buffer, uint64_t offset,
 {
 	FUNC_DATA(vgCmdDrawIndirectCount);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(buffer);
 	CHECK_NOT_NULL(count_buffer);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
@@ -1926,6 +3037,8 @@ void vgCmdDrawIndirectCount(VgCommandList cmd, VgBuffer buffer, uint64_t offset,
 		return;
 	}
 #endif
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	CAPTURE(CMD_DRAW_INDIRECT_COUNT, cmd, buffer, offset, count_buffer, count_buffer_offset, max_draw_count, stride);
 	cmd->DrawIndirectCount(buffer, offset, count_buffer, count_buffer_offset, max_draw_count, stride);
 }
 
@@ -1933,6 +3046,9 @@ void vgCmdDrawIndexedIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offse
 {
 	FUNC_DATA(vgCmdDrawIndexedIndirect);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(buffer);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
 	{
@@ -1959,6 +3075,8 @@ void vgCmdDrawIndexedIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offse
 		return;
 	}
 #endif
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	CAPTURE(CMD_DRAW_INDEXED_INDIRECT, cmd, buffer, offset, draw_count, stride);
 	cmd->DrawIndexedIndirect(buffer, offset, draw_count, stride);
 }
 
@@ -1966,6 +3084,9 @@ void vgCmdDrawIndexedIndirectCount(VgCommandList cmd, VgBuffer buffer, uint64_t
 {
 	FUNC_DATA(vgCmdDrawIndexedIndirectCount);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(buffer);
 	CHECK_NOT_NULL(count_buffer);
 	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
@@ -1994,6 +3115,8 @@ void vgCmdDrawIndexedIndirectCount(VgCommandList cmd, VgBuffer buffer, uint64_t
 		return;
 	}
 #endif
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+	CAPTURE(CMD_DRAW_INDEXED_INDIRECT_COUNT, cmd, buffer, offset, count_buffer, count_buffer_offset, max_draw_count, stride);
 	cmd->DrawIndexedIndirectCount(buffer, offset, count_buffer, count_buffer_offset, max_draw_count, stride);
 }
 
@@ -2017,14 +3140,59 @@ void vgCmdDispatchIndirect(VgCommandList cmd, VgBuffer buffer, uint64_t offset)
 		return;
 	}
 #endif
+	CAPTURE(CMD_DISPATCH_INDIRECT, cmd, buffer, offset);
 	cmd->DispatchIndirect(buffer, offset);
 }
 
+void vgCmdDispatchMesh(VgCommandList cmd, uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
+{
+	FUNC_DATA(vgCmdDispatchMesh);
+	CHECK_NOT_NULL(cmd);
+	if (cmd->CommandPool()->Queue() != VG_QUEUE_GRAPHICS)
+	{
+		LOG(ERROR, "{}(): only allowed on {} but cmd is on queue {}", _func_name_,
+			magic_enum::enum_name(VG_QUEUE_GRAPHICS), magic_enum::enum_name(cmd->CommandPool()->Queue()));
+		return;
+	}
+
+#if VG_VALIDATION
+	if (!cmd->Device()->Adapter()->GetProperties().mesh_shaders)
+	{
+		LOG(ERROR, "{}(): mesh shaders are not supported by the adapter", _func_name_);
+		return;
+	}
+	if (!(cmd->GetState() & VgCommandList_t::STATE_RENDERING))
+	{
+		LOG(ERROR, "{}(): command list should be in state of rendering", _func_name_);
+		return;
+	}
+#endif
+	if (groups_x == 0 || groups_y == 0 || groups_z == 0)
+	{
+		LOG(WARN, "{}(): called with zero groups ({}, {}, {})", _func_name_, groups_x, groups_y, groups_z);
+		return;
+	}
+	if (!BindGraphicsState(_func_name_, cmd)) return;
+#if VG_VALIDATION
+	if (auto vertexPipeline = cmd->GraphicsState().VertexPipeline(); vertexPipeline && *vertexPipeline != VG_VERTEX_PIPELINE_MESH_SHADER)
+	{
+		LOG(ERROR, "{}(): bound graphics pipeline has vertex_pipeline_type {}, expected {}", _func_name_,
+			magic_enum::enum_name(*vertexPipeline), magic_enum::enum_name(VG_VERTEX_PIPELINE_MESH_SHADER));
+		return;
+	}
+#endif
+	CAPTURE(CMD_DISPATCH_MESH, cmd, groups_x, groups_y, groups_z);
+	cmd->DispatchMesh(groups_x, groups_y, groups_z);
+}
+
 // Do not allow src to be on READBACK heap
 void vgCmdCopyBufferToBuffer(VgCommandList cmd, VgBuffer dst, uint64_t dst_offset, VgBuffer src, uint64_t src_offset, uint64_t size)
 {
 	FUNC_DATA(vgCmdCopyBufferToBuffer);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(dst);
 	CHECK_NOT_NULL(src);
 #if VG_VALIDATION
@@ -2034,6 +3202,7 @@ void vgCmdCopyBufferToBuffer(VgCommandList cmd, VgBuffer dst, uint64_t dst_offse
 	{
 		size = src->Desc().size;
 	}
+	CAPTURE(CMD_COPY_BUFFER_TO_BUFFER, cmd, dst, dst_offset, src, src_offset, size);
 	cmd->CopyBufferToBuffer(dst, dst_offset, src, src_offset, size);
 
 }
@@ -2042,12 +3211,16 @@ void vgCmdCopyBufferToTexture(VgCommandList cmd, VgTexture dst, const VgRegion*
 {
 	FUNC_DATA(vgCmdCopyBufferToTexture);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(dst);
 	CHECK_NOT_NULL(dst_region);
 	CHECK_NOT_NULL(src);
 #if VG_VALIDATION
-	// ...
+	VALIDATE_NOT_TRANSIENT(dst, "dst");
 #endif
+	CAPTURE(CMD_COPY_BUFFER_TO_TEXTURE, cmd, dst, *dst_region, src, src_offset);
 	cmd->CopyBufferToTexture(dst, *dst_region, src, src_offset);
 }
 
@@ -2055,12 +3228,16 @@ void vgCmdCopyTextureToBuffer(VgCommandList cmd, VgBuffer dst, uint64_t dst_offs
 {
 	FUNC_DATA(vgCmdCopyTextureToBuffer);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(dst);
 	CHECK_NOT_NULL(src);
 	CHECK_NOT_NULL(src_region);
 #if VG_VALIDATION
-	// ...
+	VALIDATE_NOT_TRANSIENT(src, "src");
 #endif
+	CAPTURE(CMD_COPY_TEXTURE_TO_BUFFER, cmd, dst, dst_offset, src, *src_region);
 	cmd->CopyTextureToBuffer(dst, dst_offset, src, *src_region);
 }
 
@@ -2068,16 +3245,223 @@ void vgCmdCopyTextureToTexture(VgCommandList cmd, VgTexture dst, const VgRegion*
 {
 	FUNC_DATA(vgCmdCopyTextureToBuffer);
 	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
 	CHECK_NOT_NULL(dst);
 	CHECK_NOT_NULL(dst_region);
 	CHECK_NOT_NULL(src);
 	CHECK_NOT_NULL(src_region);
 #if VG_VALIDATION
-	// ...
+	VALIDATE_NOT_TRANSIENT(dst, "dst");
+	VALIDATE_NOT_TRANSIENT(src, "src");
 #endif
+	CAPTURE(CMD_COPY_TEXTURE_TO_TEXTURE, cmd, dst, *dst_region, src, *src_region);
 	cmd->CopyTextureToTexture(dst, *dst_region, src, *src_region);
 }
 
+#if VG_VALIDATION
+static bool ValidateCopyRegion(std::string_view _func_name_, VgTexture texture, const char* varName, uint32_t index, const VgRegion& region)
+{
+	if (region.mip >= texture->Desc().mip_levels)
+	{
+		LOG(ERROR, "{}(): regions[{}] copies mip {} of {} which has {} mips", _func_name_, index, region.mip, varName, texture->Desc().mip_levels);
+		return false;
+	}
+	return true;
+}
+#endif
+
+void vgCmdCopyBufferToBufferRegions(VgCommandList cmd, VgBuffer dst, VgBuffer src, uint32_t num_regions, const VgBufferCopyRegion* regions)
+{
+	FUNC_DATA(vgCmdCopyBufferToBufferRegions);
+	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
+	CHECK_NOT_NULL(dst);
+	CHECK_NOT_NULL(src);
+	if (num_regions == 0)
+	{
+		LOG(WARN, "{}(): called with num_regions = 0", _func_name_);
+		return;
+	}
+	CHECK_NOT_NULL(regions);
+#if VG_VALIDATION
+	for (uint32_t i = 0; i < num_regions; i++)
+	{
+		const auto& region = regions[i];
+		if (region.size == VG_WHOLE_SIZE || region.src_offset + region.size > src->Desc().size || region.dst_offset + region.size > dst->Desc().size)
+		{
+			LOG(ERROR, "{}(): regions[{}] is out of the bounds of src or dst", _func_name_, i);
+			return;
+		}
+	}
+#endif
+	CAPTURE(CMD_COPY_BUFFER_TO_BUFFER_REGIONS, cmd, dst, src, std::span<const VgBufferCopyRegion>(regions, num_regions));
+	cmd->CopyBufferToBufferRegions(dst, src, num_regions, regions);
+}
+
+void vgCmdCopyBufferToTextureRegions(VgCommandList cmd, VgTexture dst, VgBuffer src, uint32_t num_regions, const VgBufferTextureCopyRegion* regions)
+{
+	FUNC_DATA(vgCmdCopyBufferToTextureRegions);
+	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
+	CHECK_NOT_NULL(dst);
+	CHECK_NOT_NULL(src);
+	if (num_regions == 0)
+	{
+		LOG(WARN, "{}(): called with num_regions = 0", _func_name_);
+		return;
+	}
+	CHECK_NOT_NULL(regions);
+#if VG_VALIDATION
+	VALIDATE_NOT_TRANSIENT(dst, "dst");
+	for (uint32_t i = 0; i < num_regions; i++)
+	{
+		if (!ValidateCopyRegion(_func_name_, dst, "dst", i, regions[i].texture_region)) return;
+	}
+#endif
+	CAPTURE(CMD_COPY_BUFFER_TO_TEXTURE_REGIONS, cmd, dst, src, std::span<const VgBufferTextureCopyRegion>(regions, num_regions));
+	cmd->CopyBufferToTextureRegions(dst, src, num_regions, regions);
+}
+
+void vgCmdCopyTextureToBufferRegions(VgCommandList cmd, VgBuffer dst, VgTexture src, uint32_t num_regions, const VgBufferTextureCopyRegion* regions)
+{
+	FUNC_DATA(vgCmdCopyTextureToBufferRegions);
+	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
+	CHECK_NOT_NULL(dst);
+	CHECK_NOT_NULL(src);
+	if (num_regions == 0)
+	{
+		LOG(WARN, "{}(): called with num_regions = 0", _func_name_);
+		return;
+	}
+	CHECK_NOT_NULL(regions);
+#if VG_VALIDATION
+	VALIDATE_NOT_TRANSIENT(src, "src");
+	for (uint32_t i = 0; i < num_regions; i++)
+	{
+		if (!ValidateCopyRegion(_func_name_, src, "src", i, regions[i].texture_region)) return;
+	}
+#endif
+	CAPTURE(CMD_COPY_TEXTURE_TO_BUFFER_REGIONS, cmd, dst, src, std::span<const VgBufferTextureCopyRegion>(regions, num_regions));
+	cmd->CopyTextureToBufferRegions(dst, src, num_regions, regions);
+}
+
+void vgCmdCopyTextureToTextureRegions(VgCommandList cmd, VgTexture dst, VgTexture src, uint32_t num_regions, const VgTextureCopyRegion* regions)
+{
+	FUNC_DATA(vgCmdCopyTextureToTextureRegions);
+	CHECK_NOT_NULL(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE(cmd);
+#endif
+	CHECK_NOT_NULL(dst);
+	CHECK_NOT_NULL(src);
+	if (num_regions == 0)
+	{
+		LOG(WARN, "{}(): called with num_regions = 0", _func_name_);
+		return;
+	}
+	CHECK_NOT_NULL(regions);
+#if VG_VALIDATION
+	VALIDATE_NOT_TRANSIENT(dst, "dst");
+	VALIDATE_NOT_TRANSIENT(src, "src");
+	for (uint32_t i = 0; i < num_regions; i++)
+	{
+		if (!ValidateCopyRegion(_func_name_, dst, "dst", i, regions[i].dst_region)) return;
+		if (!ValidateCopyRegion(_func_name_, src, "src", i, regions[i].src_region)) return;
+	}
+#endif
+	CAPTURE(CMD_COPY_TEXTURE_TO_TEXTURE_REGIONS, cmd, dst, src, std::span<const VgTextureCopyRegion>(regions, num_regions));
+	cmd->CopyTextureToTextureRegions(dst, src, num_regions, regions);
+}
+
+VgResult vgCmdReadbackBuffer(VgCommandList cmd, VgReadbackPool pool, VgBuffer src, uint64_t src_offset, uint64_t size, const VgReadbackRequest* request, VgReadbackTicket* out_ticket)
+{
+	FUNC_DATA(vgCmdReadbackBuffer);
+	CHECK_NOT_NULL_RETURN(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE_RETURN(cmd);
+#endif
+	CHECK_NOT_NULL_RETURN(pool);
+	CHECK_NOT_NULL_RETURN(src);
+	CHECK_NOT_NULL_RETURN(request);
+	CHECK_NOT_NULL_RETURN(request->fence);
+	CHECK_NOT_NULL_RETURN(out_ticket);
+#if VG_VALIDATION
+	if (static_cast<ReadbackPool*>(pool)->Device() != cmd->Device())
+	{
+		LOG(ERROR, "{}(): pool was created by another device than cmd", _func_name_);
+		return VG_BAD_ARGUMENT;
+	}
+	if (src_offset > src->Desc().size)
+	{
+		LOG(ERROR, "{}(): src_offset {} is past the end of src of size {}", _func_name_, src_offset, src->Desc().size);
+		return VG_BAD_ARGUMENT;
+	}
+	if (size != VG_WHOLE_SIZE && size > src->Desc().size - src_offset)
+	{
+		LOG(ERROR, "{}(): src_offset {} + size {} exceeds src of size {}", _func_name_, src_offset, size, src->Desc().size);
+		return VG_BAD_ARGUMENT;
+	}
+#endif
+	if (size == VG_WHOLE_SIZE)
+	{
+		size = src->Desc().size - src_offset;
+	}
+
+	CAPTURE(CMD_READBACK_BUFFER, cmd, pool, src, src_offset, size, *request);
+	*out_ticket = static_cast<ReadbackPool*>(pool)->ReadbackBuffer(cmd, src, src_offset, size, *request);
+	if (*out_ticket == VG_INVALID_READBACK_TICKET)
+	{
+		LOG(WARN, "{}(): readback pool is full, release completed readbacks", _func_name_);
+		return VG_OUT_OF_MEMORY;
+	}
+	return VG_SUCCESS;
+}
+
+VgResult vgCmdReadbackTexture(VgCommandList cmd, VgReadbackPool pool, VgTexture src, const VgRegion* src_region, const VgReadbackRequest* request, VgReadbackTicket* out_ticket)
+{
+	FUNC_DATA(vgCmdReadbackTexture);
+	CHECK_NOT_NULL_RETURN(cmd);
+#if VG_VALIDATION
+	VALIDATE_NOT_BUNDLE_RETURN(cmd);
+#endif
+	CHECK_NOT_NULL_RETURN(pool);
+	CHECK_NOT_NULL_RETURN(src);
+	CHECK_NOT_NULL_RETURN(src_region);
+	CHECK_NOT_NULL_RETURN(request);
+	CHECK_NOT_NULL_RETURN(request->fence);
+	CHECK_NOT_NULL_RETURN(out_ticket);
+#if VG_VALIDATION
+	if (static_cast<ReadbackPool*>(pool)->Device() != cmd->Device())
+	{
+		LOG(ERROR, "{}(): pool was created by another device than cmd", _func_name_);
+		return VG_BAD_ARGUMENT;
+	}
+	if (src->Desc().usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT)
+	{
+		LOG(ERROR, "{}(): src has VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT usage and cannot be read back", _func_name_);
+		return VG_ILLEGAL_OPERATION;
+	}
+#endif
+
+	CAPTURE(CMD_READBACK_TEXTURE, cmd, pool, src, *src_region, *request);
+	*out_ticket = static_cast<ReadbackPool*>(pool)->ReadbackTexture(cmd, src, *src_region, *request);
+	if (*out_ticket == VG_INVALID_READBACK_TICKET)
+	{
+		LOG(WARN, "{}(): readback pool is full, release completed readbacks", _func_name_);
+		return VG_OUT_OF_MEMORY;
+	}
+	return VG_SUCCESS;
+}
+
 void vgCmdBeginMarker(VgCommandList cmd, const char* name, float color[3])
 {
 	FUNC_DATA(vgCmdBeginMarker);
@@ -2085,13 +3469,16 @@ void vgCmdBeginMarker(VgCommandList cmd, const char* name, float color[3])
 	CHECK_NOT_NULL(name);
 	
 	static float defaultColor[] = { 1.0f, 1.0f, 1.0f };
-	cmd->BeginMarker(name, color ? color : defaultColor);
+	if (!color) color = defaultColor;
+	CAPTURE(CMD_BEGIN_MARKER, cmd, name, std::array{ color[0], color[1], color[2] });
+	cmd->BeginMarker(name, color);
 }
 
 void vgCmdEndMarker(VgCommandList cmd)
 {
 	FUNC_DATA(vgCmdEndMarker);
 	CHECK_NOT_NULL(cmd);
+	CAPTURE(CMD_END_MARKER, cmd);
 	cmd->EndMarker();
 }
 
@@ -2122,6 +3509,7 @@ void vgTextureSetName(VgTexture texture, const char* name)
 	CHECK_NOT_NULL(texture);
 	CHECK_NOT_NULL(name);
 
+	CAPTURE(TEXTURE_SET_NAME, texture, name);
 	texture->SetName(name);
 }
 
@@ -2249,6 +3637,13 @@ VgResult vgTextureCreateAttachmentView(VgTexture texture, const VgAttachmentView
 #endif
 
 	*out_descriptor = texture->CreateAttachmentView(*desc);
+#if VG_VALIDATION
+	if (texture->Desc().usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT)
+	{
+		texture->Device()->TransientAttachments().Add(texture, FormatIsDepthStencil(desc->format), *out_descriptor);
+	}
+#endif
+	CAPTURE(TEXTURE_CREATE_ATTACHMENT_VIEW, texture, *desc, *out_descriptor);
 	return VG_SUCCESS;
 }
 
@@ -2260,6 +3655,11 @@ VgResult vgTextureCreateView(VgTexture texture, const VgTextureViewDesc* desc, V
 	CHECK_NOT_NULL_RETURN(out_descriptor);
 
 #if VG_VALIDATION
+	if (texture->Desc().usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT)
+	{
+		LOG(ERROR, "{}(): texture has VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT usage and cannot be viewed by shaders", _func_name_);
+		return VG_ILLEGAL_OPERATION;
+	}
 	VALIDATE_ENUM_RETURN(desc->format, "format");
 	VALIDATE_ENUM_RETURN(desc->type, "type");
 	VALIDATE_ENUM_RETURN(desc->descriptor_type, "descriptor_type");
@@ -2385,6 +3785,7 @@ VgResult vgTextureCreateView(VgTexture texture, const VgTextureViewDesc* desc, V
 #endif
 
 	*out_descriptor = texture->CreateView(*desc);
+	CAPTURE(TEXTURE_CREATE_VIEW, texture, *desc, *out_descriptor);
 	return VG_SUCCESS;
 }
 
@@ -2393,6 +3794,8 @@ void vgTextureDestroyViews(VgTexture texture)
 	FUNC_DATA(vgTextureDestroyViews);
 	CHECK_NOT_NULL(texture);
 
+	CAPTURE(TEXTURE_DESTROY_VIEWS, texture);
+	texture->Device()->TransientAttachments().Forget(texture);
 	texture->DestroyViews();
 }
 
@@ -2489,6 +3892,7 @@ VgResult vgSwapChainAcquireNextImage(VgSwapChain swap_chain, uint32_t* out_image
 	try
 	{
 		*out_image_index = swap_chain->AcquireNextImage();
+		CAPTURE(SWAP_CHAIN_ACQUIRE_NEXT_IMAGE, swap_chain, *out_image_index);
 	}
 	catch (VgError& ex)
 	{
@@ -2506,6 +3910,7 @@ VgResult vgSwapChainGetBackBuffer(VgSwapChain swap_chain, uint32_t index, VgText
 	try
 	{
 		*out_back_buffer = swap_chain->GetBackBuffer(index);
+		CAPTURE(SWAP_CHAIN_GET_BACK_BUFFER, swap_chain, index, CaptureWriter::NewHandle{ *out_back_buffer });
 	}
 	catch (VgError& ex)
 	{
@@ -2526,6 +3931,7 @@ VgResult vgSwapChainPresent(VgSwapChain swap_chain, uint32_t num_wait_fences, Vg
 	try
 	{
 		swap_chain->Present(num_wait_fences, wait_fences);
+		CAPTURE(SWAP_CHAIN_PRESENT, swap_chain, std::span<const VgFenceOperation>(wait_fences, num_wait_fences));
 	}
 	catch (VgError& ex)
 	{
@@ -1,5 +1,6 @@
 #include "vkadapter.h"
 #include "vkdevice.h"
+#include "vkdescriptor_manager.h"
 
 #if VG_VULKAN_SUPPORTED
 
@@ -61,8 +62,52 @@ VulkanAdapter::VulkanAdapter(VulkanCore& core, vkb::PhysicalDevice physicalDevic
 
 	_extensions = {
 		.MutableDescriptors = (physicalDevice.enable_extension_if_present(VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME)
-			&& physicalDevice.enable_extension_features_if_present(VulkanCore::mutableDescriptorTypeFeatures)) && false
+			&& physicalDevice.enable_extension_features_if_present(VulkanCore::mutableDescriptorTypeFeatures)) && false,
+		.MemoryBudget = physicalDevice.enable_extension_if_present(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME),
+		.InheritedViewportScissor = physicalDevice.enable_extension_if_present(VK_NV_INHERITED_VIEWPORT_SCISSOR_EXTENSION_NAME)
+			&& physicalDevice.enable_extension_features_if_present(VulkanCore::inheritedViewportScissorFeatures),
+		.MultiDraw = physicalDevice.enable_extension_if_present(VK_EXT_MULTI_DRAW_EXTENSION_NAME)
+			&& physicalDevice.enable_extension_features_if_present(VulkanCore::multiDrawFeatures),
+		.DescriptorBuffer = physicalDevice.enable_extension_if_present(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)
+			&& physicalDevice.enable_extension_features_if_present(VulkanCore::descriptorBufferFeatures)
 	};
+
+	if (_extensions.MultiDraw)
+	{
+		VkPhysicalDeviceMultiDrawPropertiesEXT multiDrawProperties = {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_PROPERTIES_EXT,
+			.pNext = nullptr
+		};
+
+		VkPhysicalDeviceProperties2 properties2 = {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+			.pNext = &multiDrawProperties
+		};
+		vkGetPhysicalDeviceProperties2(physicalDevice.physical_device, &properties2);
+		_maxMultiDrawCount = multiDrawProperties.maxMultiDrawCount;
+	}
+
+	if (_extensions.DescriptorBuffer)
+	{
+		_descriptorBufferProperties = {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT,
+			.pNext = nullptr
+		};
+
+		VkPhysicalDeviceProperties2 properties2 = {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+			.pNext = &_descriptorBufferProperties
+		};
+		vkGetPhysicalDeviceProperties2(physicalDevice.physical_device, &properties2);
+
+		// The resource set is one buffer holding resources and samplers, adapters with small sampler
+		// address spaces keep using descriptor sets
+		const VkDeviceSize size = VulkanDescriptorBufferManager::EstimateBufferSize(_descriptorBufferProperties);
+		_extensions.DescriptorBuffer = size <= _descriptorBufferProperties.maxResourceDescriptorBufferRange
+			&& size <= _descriptorBufferProperties.maxSamplerDescriptorBufferRange
+			&& size <= _descriptorBufferProperties.resourceDescriptorBufferAddressSpaceSize
+			&& size <= _descriptorBufferProperties.samplerDescriptorBufferAddressSpaceSize;
+	}
 }
 
 VulkanAdapter::~VulkanAdapter()
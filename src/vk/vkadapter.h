@@ -9,6 +9,10 @@
 struct VulkanExtensions
 {
 	uint8_t MutableDescriptors : 1;
+	uint8_t MemoryBudget : 1;
+	uint8_t InheritedViewportScissor : 1;
+	uint8_t MultiDraw : 1;
+	uint8_t DescriptorBuffer : 1;
 };
 
 class VulkanAdapter final : public VgAdapter_t
@@ -23,6 +27,10 @@ public:
 	vkb::PhysicalDevice PhysicalDevice() const { return _adapter; }
 	VulkanCore* Core() const { return _core; }
 	const VulkanExtensions& Extensions() const { return _extensions; }
+	// 0 without VK_EXT_multi_draw
+	uint32_t MaxMultiDrawCount() const { return _maxMultiDrawCount; }
+	// Only filled in with DescriptorBuffer
+	const VkPhysicalDeviceDescriptorBufferPropertiesEXT& DescriptorBufferProperties() const { return _descriptorBufferProperties; }
 
 	VgDevice_t* CreateDevice(VgInitFlags initFlags) override;
 
@@ -32,6 +40,8 @@ private:
 	VgAdapterProperties _properties;
 
 	VulkanExtensions _extensions;
+	uint32_t _maxMultiDrawCount{ 0 };
+	VkPhysicalDeviceDescriptorBufferPropertiesEXT _descriptorBufferProperties{};
 };
 
 #endif
\ No newline at end of file
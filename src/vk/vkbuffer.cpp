@@ -0,0 +1,122 @@
+#include "vkbuffer.h"
+#include "vkdescriptor_manager.h"
+
+#if VG_VULKAN_SUPPORTED
+
+VulkanBuffer::~VulkanBuffer()
+{
+	DestroyViews();
+	Unmap();
+
+	VmaAllocationInfo allocationInfo;
+	vmaGetAllocationInfo(_device->Allocator(), _allocation, &allocationInfo);
+	_device->GetMemoryStatistics().used_vram -= allocationInfo.size;
+	_device->GetMemoryStatistics().num_buffers--;
+
+	vmaDestroyBuffer(_device->Allocator(), _buffer, _allocation);
+}
+
+uint32_t VulkanBuffer::CreateView(const VgBufferViewDesc& desc)
+{
+	// Typed views need a VkBufferView per descriptor, which the descriptor managers can't write yet
+	if (desc.descriptor_type != VG_BUFFER_DESCRIPTOR_TYPE_CBV && desc.view_type == VG_BUFFER_VIEW_TYPE_BUFFER)
+	{
+		throw VgError(VG_NOT_SUPPORTED, "typed buffer views are not supported on Vulkan");
+	}
+
+	auto& descriptorManager = _device->DescriptorManager();
+	const uint32_t index = descriptorManager.ResourceSlots().Allocate();
+	// Structured and byte address buffers are storage buffers for SRVs and UAVs alike, like DXC compiles them to SPIR-V
+	const VkDescriptorType type = desc.descriptor_type == VG_BUFFER_DESCRIPTOR_TYPE_CBV ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+		: VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	descriptorManager.WriteBuffer(VulkanDescriptorManager::ResourceBinding, index, type, _buffer, desc.offset, desc.size);
+	_views.push_back(index);
+	return index;
+}
+
+void VulkanBuffer::DestroyViews()
+{
+	for (auto index : _views)
+	{
+		_device->DescriptorManager().ResourceSlots().Free(index);
+	}
+	_views.clear();
+}
+
+void* VulkanBuffer::Map()
+{
+	if (_mapped) return _mapped;
+
+	VkThrowOnError(vmaMapMemory(_device->Allocator(), _allocation, &_mapped));
+	return _mapped;
+}
+
+void VulkanBuffer::Unmap()
+{
+	if (_mapped)
+	{
+		vmaUnmapMemory(_device->Allocator(), _allocation);
+		_mapped = nullptr;
+	}
+}
+
+// General buffers may be used for anything a D3D12 buffer can, constant buffers only as uniform buffers
+constexpr VkBufferUsageFlags BufferUsageToVk(VgBufferUsage usage)
+{
+	VkBufferUsageFlags flags = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+		| VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+	if (usage == VG_BUFFER_USAGE_GENERAL)
+	{
+		flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+			| VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+	}
+	return flags;
+}
+
+constexpr VmaAllocationCreateInfo BufferAllocationToVk(const VgBufferDesc& desc)
+{
+	VmaAllocationCreateFlags flags = 0;
+	if (desc.heap_type == VG_HEAP_TYPE_UPLOAD) flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+	else if (desc.heap_type == VG_HEAP_TYPE_READBACK) flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+	return {
+		.flags = flags,
+		.usage = VMA_MEMORY_USAGE_AUTO,
+		.requiredFlags = 0,
+		.preferredFlags = 0,
+		.memoryTypeBits = 0,
+		.pool = VK_NULL_HANDLE,
+		.pUserData = nullptr,
+		.priority = 0.0f
+	};
+}
+
+VulkanBuffer::VulkanBuffer(VulkanDevice& device, const VgBufferDesc& desc) : _device(&device), _desc(desc)
+{
+	const auto& queueFamilies = device.QueueFamilies();
+	const VkBufferCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.size = desc.size,
+		.usage = BufferUsageToVk(desc.usage),
+		.sharingMode = queueFamilies.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+		.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size()),
+		.pQueueFamilyIndices = queueFamilies.data()
+	};
+	const VmaAllocationCreateInfo allocationCreateInfo = BufferAllocationToVk(desc);
+
+	VmaAllocationInfo allocationInfo;
+	VkThrowOnError(vmaCreateBuffer(device.Allocator(), &createInfo, &allocationCreateInfo, &_buffer, &_allocation, &allocationInfo));
+
+	const VkBufferDeviceAddressInfo addressInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+		.pNext = nullptr,
+		.buffer = _buffer
+	};
+	_address = device.Functions().vkGetBufferDeviceAddress(device.Device(), &addressInfo);
+
+	_device->GetMemoryStatistics().used_vram += allocationInfo.size;
+	_device->GetMemoryStatistics().num_buffers++;
+}
+
+#endif
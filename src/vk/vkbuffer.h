@@ -0,0 +1,39 @@
+#pragma once
+
+#include "vkdevice.h"
+
+#if VG_VULKAN_SUPPORTED
+
+class VulkanBuffer final : public VgBuffer_t
+{
+public:
+	~VulkanBuffer();
+
+	void* GetApiObject() const override { return _buffer; }
+	void SetName(const char* name) override { _device->SetObjectName(VK_OBJECT_TYPE_BUFFER, _buffer, name); }
+	VulkanDevice* Device() const override { return _device; }
+	const VgBufferDesc& Desc() const override { return _desc; }
+	VkBuffer Buffer() const { return _buffer; }
+
+	uint32_t CreateView(const VgBufferViewDesc& desc) override;
+	void DestroyViews() override;
+	uint64_t GpuAddress() const override { return _address; }
+	void* Map() override;
+	void Unmap() override;
+
+private:
+	VulkanDevice* _device;
+	VgBufferDesc _desc;
+
+	VkBuffer _buffer;
+	VmaAllocation _allocation;
+	VkDeviceAddress _address;
+	void* _mapped{ nullptr };
+
+	vg::Vector<uint32_t> _views;
+
+	friend VulkanDevice;
+	VulkanBuffer(VulkanDevice& device, const VgBufferDesc& desc);
+};
+
+#endif
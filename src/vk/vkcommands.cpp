@@ -0,0 +1,648 @@
+#include "vkcommands.h"
+#include "vkdescriptor_manager.h"
+#include "vktexture.h"
+
+#if VG_VULKAN_SUPPORTED
+
+static VkBuffer ToVkBuffer(VgBuffer buffer)
+{
+	return static_cast<VkBuffer>(buffer->GetApiObject());
+}
+
+VulkanCommandPool::VulkanCommandPool(VulkanDevice& device, VgCommandPoolFlags flags, VgQueue queue)
+	: _device(&device)
+{
+	_flags = flags;
+	_queue = queue;
+
+	// Command buffers are reset together with the pool, like D3D12 command allocators
+	const VkCommandPoolCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = flags & VG_COMMAND_POOL_FLAG_TRANSIENT ? VK_COMMAND_POOL_CREATE_TRANSIENT_BIT : 0u,
+		.queueFamilyIndex = _device->QueueFamily(queue)
+	};
+	VkThrowOnError(_device->Functions().vkCreateCommandPool(_device->Device(), &createInfo, _device->AllocationCallbacks(), &_pool));
+}
+
+VulkanCommandPool::~VulkanCommandPool()
+{
+	std::scoped_lock lock(_cmdMutex);
+
+	for (auto list : _lists)
+	{
+		GetAllocator().Delete(list);
+	}
+	_device->Functions().vkDestroyCommandPool(_device->Device(), _pool, _device->AllocationCallbacks());
+}
+
+VgCommandList VulkanCommandPool::AllocateCommandList()
+{
+	std::scoped_lock lock(_cmdMutex);
+
+	auto list = new(GetAllocator().Allocate<VulkanCommandList>()) VulkanCommandList(*this);
+	_lists.insert(list);
+	return list;
+}
+
+void VulkanCommandPool::FreeCommandList(VgCommandList list)
+{
+	std::scoped_lock lock(_cmdMutex);
+
+	_lists.erase(static_cast<VulkanCommandList*>(list));
+	GetAllocator().Delete(list);
+}
+
+void VulkanCommandPool::Reset()
+{
+	std::scoped_lock lock(_cmdMutex);
+
+	VkThrowOnError(_device->Functions().vkResetCommandPool(_device->Device(), _pool, 0));
+	for (auto list : _lists)
+	{
+		list->SetState(VgCommandList_t::STATE_NONE);
+	}
+}
+
+VulkanCommandList::VulkanCommandList(VulkanCommandPool& pool)
+	: _pool(&pool)
+{
+	const VkCommandBufferAllocateInfo allocateInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+		.pNext = nullptr,
+		.commandPool = pool.Pool(),
+		.level = pool.Flags() & VG_COMMAND_POOL_FLAG_BUNDLE ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+		.commandBufferCount = 1
+	};
+	VkThrowOnError(pool.Device()->Functions().vkAllocateCommandBuffers(pool.Device()->Device(), &allocateInfo, &_cmd));
+	_state = STATE_NONE;
+}
+
+VulkanCommandList::~VulkanCommandList()
+{
+	auto device = _pool->Device();
+	device->Functions().vkFreeCommandBuffers(device->Device(), _pool->Pool(), 1, &_cmd);
+}
+
+void VulkanCommandList::RestoreDescriptorState()
+{
+	_pool->Device()->DescriptorManager().BindHeaps(_cmd);
+}
+
+void VulkanCommandList::Begin()
+{
+	const VkCommandBufferBeginInfo beginInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.pNext = nullptr,
+		.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+		.pInheritanceInfo = nullptr
+	};
+	VkThrowOnError(_pool->Device()->Functions().vkBeginCommandBuffer(_cmd, &beginInfo));
+	_state = STATE_OPEN;
+
+	if (_pool->Queue() == VG_QUEUE_TRANSFER) return;
+	RestoreDescriptorState();
+}
+
+void VulkanCommandList::BeginBundle(const VgBundleInheritanceInfo& info)
+{
+	auto device = _pool->Device();
+
+	std::array<VkFormat, vg_num_max_color_attachments> colorFormats;
+	for (uint32_t i = 0; i < info.num_color_attachments; i++)
+	{
+		colorFormats[i] = FormatToVk(info.color_attachment_formats[i]);
+	}
+	const VkFormat depthStencilFormat = FormatToVk(info.depth_stencil_format);
+
+	// Only the depth range of the inherited viewports is taken from here
+	const VkViewport viewportDepth = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+	const VkCommandBufferInheritanceViewportScissorInfoNV viewportScissorInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_VIEWPORT_SCISSOR_INFO_NV,
+		.pNext = nullptr,
+		.viewportScissor2D = VK_TRUE,
+		.viewportDepthCount = 1,
+		.pViewportDepths = &viewportDepth
+	};
+	const bool inheritViewports = device->Adapter()->Extensions().InheritedViewportScissor;
+
+	const VkCommandBufferInheritanceRenderingInfo renderingInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+		.pNext = inheritViewports ? &viewportScissorInfo : nullptr,
+		.flags = 0,
+		.viewMask = 0,
+		.colorAttachmentCount = info.num_color_attachments,
+		.pColorAttachmentFormats = colorFormats.data(),
+		.depthAttachmentFormat = depthStencilFormat,
+		.stencilAttachmentFormat = FormatPlaneCount(info.depth_stencil_format) > 1 ? depthStencilFormat : VK_FORMAT_UNDEFINED,
+		.rasterizationSamples = static_cast<VkSampleCountFlagBits>(SampleCount(info.sample_count))
+	};
+	const VkCommandBufferInheritanceInfo inheritanceInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+		.pNext = &renderingInfo,
+		.renderPass = VK_NULL_HANDLE,
+		.subpass = 0,
+		.framebuffer = VK_NULL_HANDLE,
+		.occlusionQueryEnable = VK_FALSE,
+		.queryFlags = 0,
+		.pipelineStatistics = 0
+	};
+	// Bundles are executed many times and may be pending in several lists at once
+	const VkCommandBufferBeginInfo beginInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.pNext = nullptr,
+		.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT,
+		.pInheritanceInfo = &inheritanceInfo
+	};
+	VkThrowOnError(device->Functions().vkBeginCommandBuffer(_cmd, &beginInfo));
+	_state = STATE_OPEN | STATE_RENDERING;
+
+	RestoreDescriptorState();
+	if (!inheritViewports && info.num_viewports > 0)
+	{
+		SetViewport(0, info.num_viewports, const_cast<VgViewport*>(info.viewports));
+		SetScissor(0, info.num_viewports, const_cast<VgScissor*>(info.scissors));
+	}
+}
+
+void VulkanCommandList::End()
+{
+	VkThrowOnError(_pool->Device()->Functions().vkEndCommandBuffer(_cmd));
+	_state = STATE_NONE;
+}
+
+void VulkanCommandList::SetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, const VgVertexBufferView* buffers)
+{
+	std::array<VkBuffer, vg_num_max_vertex_buffers> vkBuffers;
+	std::array<VkDeviceSize, vg_num_max_vertex_buffers> offsets;
+	std::array<VkDeviceSize, vg_num_max_vertex_buffers> strides;
+	for (uint32_t i = 0; i < numBuffers; i++)
+	{
+		vkBuffers[i] = ToVkBuffer(buffers[i].buffer);
+		offsets[i] = buffers[i].offset;
+		strides[i] = buffers[i].stride_in_bytes;
+	}
+	// Strides are passed here like on D3D12, so graphics pipelines will need VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE
+	_pool->Device()->Functions().vkCmdBindVertexBuffers2(_cmd, startSlot, numBuffers, vkBuffers.data(), offsets.data(), nullptr, strides.data());
+}
+
+void VulkanCommandList::SetIndexBuffer(VgIndexType indexType, uint64_t offset, VgBuffer buffer)
+{
+	_pool->Device()->Functions().vkCmdBindIndexBuffer(_cmd, ToVkBuffer(buffer), offset,
+		indexType == VG_INDEX_TYPE_UINT16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+}
+
+void VulkanCommandList::SetRootConstants(VgPipelineType pipelineType, uint32_t offsetIn32bitValues, uint32_t num32bitValues, const void* data)
+{
+	// Every pipeline uses the layout of the descriptor manager, so pipelineType doesn't pick a separate set of constants
+	auto device = _pool->Device();
+	device->Functions().vkCmdPushConstants(_cmd, device->DescriptorManager().PipelineLayout(), VK_SHADER_STAGE_ALL,
+		offsetIn32bitValues * sizeof(uint32_t), num32bitValues * sizeof(uint32_t), data);
+}
+
+void VulkanCommandList::SetPipeline(VgPipeline pipeline)
+{
+}
+
+void VulkanCommandList::SetGraphicsState(const GraphicsPipelineParts& state)
+{
+	throw VgError(VG_NOT_SUPPORTED, "graphics state is not supported on Vulkan");
+}
+
+void VulkanCommandList::Barrier(const VgDependencyInfo& dependencyInfo)
+{
+}
+
+constexpr VkAttachmentLoadOp AttachmentLoadOpToVk(VgAttachmentOp op)
+{
+	switch (op)
+	{
+	case VG_ATTACHMENT_OP_CLEAR: return VK_ATTACHMENT_LOAD_OP_CLEAR;
+	case VG_ATTACHMENT_OP_DONT_CARE: return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	default: return VK_ATTACHMENT_LOAD_OP_LOAD;
+	}
+}
+
+constexpr VkAttachmentStoreOp AttachmentStoreOpToVk(VgAttachmentOp op)
+{
+	return op == VG_ATTACHMENT_OP_DONT_CARE ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+}
+
+constexpr VkResolveModeFlagBits ResolveModeToVk(VgResolveMode mode, bool depthStencil)
+{
+	switch (mode)
+	{
+	case VG_RESOLVE_MODE_MIN: return VK_RESOLVE_MODE_MIN_BIT;
+	case VG_RESOLVE_MODE_MAX: return VK_RESOLVE_MODE_MAX_BIT;
+	// Depth and stencil can't be averaged, every implementation supports taking the first sample instead
+	default: return depthStencil ? VK_RESOLVE_MODE_SAMPLE_ZERO_BIT : VK_RESOLVE_MODE_AVERAGE_BIT;
+	}
+}
+
+static VkRenderingAttachmentInfo AttachmentInfoToVk(const VgAttachmentInfo& attachment, const VulkanAttachmentViewTable& views, bool depthStencil)
+{
+	VkClearValue clear;
+	if (depthStencil)
+	{
+		clear.depthStencil = { attachment.clear.depth, attachment.clear.stencil };
+	}
+	else
+	{
+		memcpy(clear.color.float32, attachment.clear.color, sizeof(clear.color.float32));
+	}
+
+	// Resolves happen at the end of the render pass as attachment writes, not as transfers like on D3D12
+	const bool resolve = attachment.resolve_view != VG_NO_VIEW;
+	VkImageLayout resolveLayout = TextureLayoutToVk(attachment.resolve_view_layout);
+	if (attachment.resolve_view_layout == VG_TEXTURE_LAYOUT_RESOLVE_DEST)
+	{
+		resolveLayout = depthStencil ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	}
+
+	return {
+		.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+		.pNext = nullptr,
+		.imageView = views[attachment.view].view,
+		.imageLayout = TextureLayoutToVk(attachment.view_layout),
+		.resolveMode = resolve ? ResolveModeToVk(attachment.resolve_mode, depthStencil) : VK_RESOLVE_MODE_NONE,
+		.resolveImageView = resolve ? views[attachment.resolve_view].view : VK_NULL_HANDLE,
+		.resolveImageLayout = resolve ? resolveLayout : VK_IMAGE_LAYOUT_UNDEFINED,
+		.loadOp = AttachmentLoadOpToVk(attachment.load_op),
+		.storeOp = AttachmentStoreOpToVk(attachment.store_op),
+		.clearValue = clear
+	};
+}
+
+void VulkanCommandList::BeginRendering(const VgRenderingInfo& info)
+{
+	auto device = _pool->Device();
+	const auto& colorViews = device->ColorAttachmentViews();
+	const auto& depthStencilViews = device->DepthStencilAttachmentViews();
+
+	// The render area covers what all attachments have in common
+	VkExtent2D extent = { UINT32_MAX, UINT32_MAX };
+	uint32_t layers = UINT32_MAX;
+	const auto fitRenderArea = [&](const VulkanAttachmentViewTable::Entry& entry)
+	{
+		extent.width = std::min(extent.width, entry.extent.width);
+		extent.height = std::min(extent.height, entry.extent.height);
+		layers = std::min(layers, entry.layers);
+	};
+
+	std::array<VkRenderingAttachmentInfo, vg_num_max_color_attachments> colorAttachments;
+	for (uint32_t i = 0; i < info.num_color_attachments; i++)
+	{
+		colorAttachments[i] = AttachmentInfoToVk(info.color_attachments[i], colorViews, false);
+		fitRenderArea(colorViews[info.color_attachments[i].view]);
+	}
+
+	VkRenderingAttachmentInfo depthStencilAttachment;
+	VkImageAspectFlags depthStencilAspects = 0;
+	if (info.depth_stencil_attachment.view != VG_NO_VIEW)
+	{
+		const auto& entry = depthStencilViews[info.depth_stencil_attachment.view];
+		depthStencilAttachment = AttachmentInfoToVk(info.depth_stencil_attachment, depthStencilViews, true);
+		depthStencilAspects = FormatAspectsToVk(entry.format);
+		fitRenderArea(entry);
+	}
+
+	// Bundles are secondary command buffers, which can't be mixed with draws recorded directly in the render pass
+	const VkRenderingInfo renderingInfo = {
+		.sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+		.pNext = nullptr,
+		.flags = info.flags & VG_RENDERING_FLAG_BUNDLES ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0u,
+		.renderArea = { { 0, 0 }, extent },
+		.layerCount = layers,
+		.viewMask = 0,
+		.colorAttachmentCount = info.num_color_attachments,
+		.pColorAttachments = colorAttachments.data(),
+		.pDepthAttachment = depthStencilAspects & VK_IMAGE_ASPECT_DEPTH_BIT ? &depthStencilAttachment : nullptr,
+		.pStencilAttachment = depthStencilAspects & VK_IMAGE_ASPECT_STENCIL_BIT ? &depthStencilAttachment : nullptr
+	};
+	device->Functions().vkCmdBeginRendering(_cmd, &renderingInfo);
+	_state |= info.flags & VG_RENDERING_FLAG_BUNDLES ? STATE_RENDERING_BUNDLES : STATE_RENDERING;
+}
+
+void VulkanCommandList::EndRendering()
+{
+	_pool->Device()->Functions().vkCmdEndRendering(_cmd);
+	_state &= ~(STATE_RENDERING | STATE_RENDERING_BUNDLES);
+}
+
+void VulkanCommandList::SetViewport(uint32_t firstViewport, uint32_t numViewports, VgViewport* viewports)
+{
+	std::array<VkViewport, vg_num_max_viewports_and_scissors> vkViewports;
+	for (uint32_t i = 0; i < numViewports; i++)
+	{
+		// Flipped so clip space matches D3D12, requires VK_KHR_maintenance1 which is core since 1.1
+		vkViewports[i] = {
+			.x = viewports[i].x,
+			.y = viewports[i].y + viewports[i].height,
+			.width = viewports[i].width,
+			.height = -viewports[i].height,
+			.minDepth = viewports[i].min_depth,
+			.maxDepth = viewports[i].max_depth
+		};
+	}
+	_pool->Device()->Functions().vkCmdSetViewport(_cmd, firstViewport, numViewports, vkViewports.data());
+}
+
+void VulkanCommandList::SetScissor(uint32_t firstScissor, uint32_t numScissors, VgScissor* scissors)
+{
+	std::array<VkRect2D, vg_num_max_viewports_and_scissors> rects;
+	for (uint32_t i = 0; i < numScissors; i++)
+	{
+		rects[i] = {
+			.offset = { static_cast<int32_t>(scissors[i].x), static_cast<int32_t>(scissors[i].y) },
+			.extent = { scissors[i].width, scissors[i].height }
+		};
+	}
+	_pool->Device()->Functions().vkCmdSetScissor(_cmd, firstScissor, numScissors, rects.data());
+}
+
+void VulkanCommandList::ExecuteBundle(VgCommandList bundle)
+{
+	const VkCommandBuffer cmd = static_cast<VulkanCommandList*>(bundle)->Cmd();
+	_pool->Device()->Functions().vkCmdExecuteCommands(_cmd, 1, &cmd);
+}
+
+void VulkanCommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+	_pool->Device()->Functions().vkCmdDraw(_cmd, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void VulkanCommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, uint32_t vertexOffset, uint32_t firstInstance)
+{
+	_pool->Device()->Functions().vkCmdDrawIndexed(_cmd, indexCount, instanceCount, firstIndex, static_cast<int32_t>(vertexOffset), firstInstance);
+}
+
+static_assert(sizeof(VgMultiDrawInfo) == sizeof(VkMultiDrawInfoEXT));
+static_assert(sizeof(VgMultiDrawIndexedInfo) == sizeof(VkMultiDrawIndexedInfoEXT));
+
+// VK_EXT_multi_draw cannot change push constants between draws, so draws with per-draw root constants
+// and devices without the extension fall back to one draw call per draw
+void VulkanCommandList::DrawMulti(uint32_t drawCount, const VgMultiDrawInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants)
+{
+	const auto& functions = _pool->Device()->Functions();
+	const uint32_t maxDrawCount = _pool->Device()->Adapter()->MaxMultiDrawCount();
+	if (!rootConstants && maxDrawCount > 0)
+	{
+		for (uint32_t first = 0; first < drawCount; first += maxDrawCount)
+		{
+			functions.vkCmdDrawMultiEXT(_cmd, std::min(drawCount - first, maxDrawCount), reinterpret_cast<const VkMultiDrawInfoEXT*>(draws + first),
+				instanceCount, firstInstance, sizeof(VgMultiDrawInfo));
+		}
+		return;
+	}
+
+	for (uint32_t i = 0; i < drawCount; i++)
+	{
+		if (rootConstants)
+		{
+			SetRootConstants(VG_PIPELINE_TYPE_GRAPHICS, rootConstants->offset_in_32bit_values, rootConstants->num_32bit_values,
+				static_cast<const uint8_t*>(rootConstants->data) + i * rootConstants->stride);
+		}
+		functions.vkCmdDraw(_cmd, draws[i].vertex_count, instanceCount, draws[i].first_vertex, firstInstance);
+	}
+}
+
+void VulkanCommandList::DrawIndexedMulti(uint32_t drawCount, const VgMultiDrawIndexedInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants)
+{
+	const auto& functions = _pool->Device()->Functions();
+	const uint32_t maxDrawCount = _pool->Device()->Adapter()->MaxMultiDrawCount();
+	if (!rootConstants && maxDrawCount > 0)
+	{
+		for (uint32_t first = 0; first < drawCount; first += maxDrawCount)
+		{
+			functions.vkCmdDrawMultiIndexedEXT(_cmd, std::min(drawCount - first, maxDrawCount), reinterpret_cast<const VkMultiDrawIndexedInfoEXT*>(draws + first),
+				instanceCount, firstInstance, sizeof(VgMultiDrawIndexedInfo), nullptr);
+		}
+		return;
+	}
+
+	for (uint32_t i = 0; i < drawCount; i++)
+	{
+		if (rootConstants)
+		{
+			SetRootConstants(VG_PIPELINE_TYPE_GRAPHICS, rootConstants->offset_in_32bit_values, rootConstants->num_32bit_values,
+				static_cast<const uint8_t*>(rootConstants->data) + i * rootConstants->stride);
+		}
+		functions.vkCmdDrawIndexed(_cmd, draws[i].index_count, instanceCount, draws[i].first_index, static_cast<int32_t>(draws[i].vertex_offset), firstInstance);
+	}
+}
+
+void VulkanCommandList::Dispatch(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
+{
+	_pool->Device()->Functions().vkCmdDispatch(_cmd, groups_x, groups_y, groups_z);
+}
+
+// VgDraw(Indexed)IndirectCommand match VkDraw(Indexed)IndirectCommand, and shaders read the draw index from
+// the DrawIndex built-in (gl_DrawID), so unlike D3D12 no argument rewriting pass is needed
+static_assert(sizeof(VgDrawIndirectCommand) == sizeof(VkDrawIndirectCommand));
+static_assert(sizeof(VgDrawIndexedIndirectCommand) == sizeof(VkDrawIndexedIndirectCommand));
+static_assert(sizeof(VgDispatchIndirectCommand) == sizeof(VkDispatchIndirectCommand));
+
+void VulkanCommandList::DrawIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+	_pool->Device()->Functions().vkCmdDrawIndirect(_cmd, ToVkBuffer(buffer), offset, drawCount, stride);
+}
+
+void VulkanCommandList::DrawIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+	_pool->Device()->Functions().vkCmdDrawIndirectCount(_cmd, ToVkBuffer(buffer), offset, ToVkBuffer(countBuffer), countBufferOffset,
+		maxDrawCount, stride);
+}
+
+void VulkanCommandList::DrawIndexedIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+	_pool->Device()->Functions().vkCmdDrawIndexedIndirect(_cmd, ToVkBuffer(buffer), offset, drawCount, stride);
+}
+
+void VulkanCommandList::DrawIndexedIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+	_pool->Device()->Functions().vkCmdDrawIndexedIndirectCount(_cmd, ToVkBuffer(buffer), offset, ToVkBuffer(countBuffer), countBufferOffset,
+		maxDrawCount, stride);
+}
+
+void VulkanCommandList::DispatchIndirect(VgBuffer buffer, uint64_t offset)
+{
+	_pool->Device()->Functions().vkCmdDispatchIndirect(_cmd, ToVkBuffer(buffer), offset);
+}
+
+void VulkanCommandList::DispatchMesh(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
+{
+	_pool->Device()->Functions().vkCmdDrawMeshTasksEXT(_cmd, groups_x, groups_y, groups_z);
+}
+
+void VulkanCommandList::CopyBufferToBuffer(VgBuffer dst, uint64_t dstOffset, VgBuffer src, uint64_t srcOffset, uint64_t size)
+{
+	const VkBufferCopy region = {
+		.srcOffset = srcOffset,
+		.dstOffset = dstOffset,
+		.size = size
+	};
+	_pool->Device()->Functions().vkCmdCopyBuffer(_cmd, ToVkBuffer(src), ToVkBuffer(dst), 1, &region);
+}
+
+void VulkanCommandList::CopyBufferToTexture(VgTexture dst, const VgRegion& dstRegion, VgBuffer src, uint64_t srcOffset)
+{
+	const VgBufferTextureCopyRegion region = { srcOffset, dstRegion };
+	CopyBufferToTextureRegions(dst, src, 1, &region);
+}
+
+void VulkanCommandList::CopyTextureToBuffer(VgBuffer dst, uint64_t dstOffset, VgTexture src, const VgRegion& srcRegion)
+{
+	const VgBufferTextureCopyRegion region = { dstOffset, srcRegion };
+	CopyTextureToBufferRegions(dst, src, 1, &region);
+}
+
+void VulkanCommandList::CopyTextureToTexture(VgTexture dst, const VgRegion& dstRegion, VgTexture src, const VgRegion& srcRegion)
+{
+	const VgTextureCopyRegion region = { dstRegion, srcRegion };
+	CopyTextureToTextureRegions(dst, src, 1, &region);
+}
+
+void VulkanCommandList::CopyBufferToBufferRegions(VgBuffer dst, VgBuffer src, uint32_t numRegions, const VgBufferCopyRegion* regions)
+{
+	vg::Vector<VkBufferCopy2> vkRegions(numRegions);
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		vkRegions[i] = {
+			.sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2,
+			.pNext = nullptr,
+			.srcOffset = regions[i].src_offset,
+			.dstOffset = regions[i].dst_offset,
+			.size = regions[i].size
+		};
+	}
+	const VkCopyBufferInfo2 copyInfo = {
+		.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2,
+		.pNext = nullptr,
+		.srcBuffer = ToVkBuffer(src),
+		.dstBuffer = ToVkBuffer(dst),
+		.regionCount = numRegions,
+		.pRegions = vkRegions.data()
+	};
+	_pool->Device()->Functions().vkCmdCopyBuffer2(_cmd, &copyInfo);
+}
+
+// Like on D3D12 a region covers a single subresource, depth-stencil textures are copied through their depth aspect
+static VkImageSubresourceLayers RegionSubresourceToVk(const VgRegion& region, VgFormat format)
+{
+	return {
+		.aspectMask = FormatIsDepthStencil(format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT,
+		.mipLevel = region.mip,
+		.baseArrayLayer = region.base_array_layer,
+		.layerCount = 1
+	};
+}
+
+// Rows in the buffer are TextureCopyRowPitch() apart like in D3D12 placed footprints, Vulkan takes that pitch in texels
+static VkBufferImageCopy2 BufferTextureCopyRegionToVk(const VgBufferTextureCopyRegion& region, VgFormat format)
+{
+	const VgRegion& textureRegion = region.texture_region;
+	const uint64_t rowPitch = TextureCopyRowPitch(textureRegion.width, format);
+	const uint64_t bcSize = GetBCFormatBlockSize(format);
+	return {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2,
+		.pNext = nullptr,
+		.bufferOffset = region.buffer_offset,
+		.bufferRowLength = static_cast<uint32_t>(bcSize == 0 ? rowPitch / FormatSizeBytes(format) : rowPitch / bcSize * 4),
+		.bufferImageHeight = 0,
+		.imageSubresource = RegionSubresourceToVk(textureRegion, format),
+		.imageOffset = { static_cast<int32_t>(textureRegion.offset.x), static_cast<int32_t>(textureRegion.offset.y), static_cast<int32_t>(textureRegion.offset.z) },
+		.imageExtent = { textureRegion.width, textureRegion.height, textureRegion.depth }
+	};
+}
+
+// Textures are expected in VG_TEXTURE_LAYOUT_TRANSFER_DEST when copied to and VG_TEXTURE_LAYOUT_TRANSFER_SOURCE when copied from
+void VulkanCommandList::CopyBufferToTextureRegions(VgTexture dst, VgBuffer src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions)
+{
+	const VgFormat format = dst->Desc().format;
+	vg::Vector<VkBufferImageCopy2> vkRegions(numRegions);
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		vkRegions[i] = BufferTextureCopyRegionToVk(regions[i], format);
+	}
+	const VkCopyBufferToImageInfo2 copyInfo = {
+		.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_TO_IMAGE_INFO_2,
+		.pNext = nullptr,
+		.srcBuffer = ToVkBuffer(src),
+		.dstImage = static_cast<VulkanTexture*>(dst)->Image(),
+		.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.regionCount = numRegions,
+		.pRegions = vkRegions.data()
+	};
+	_pool->Device()->Functions().vkCmdCopyBufferToImage2(_cmd, &copyInfo);
+}
+
+void VulkanCommandList::CopyTextureToBufferRegions(VgBuffer dst, VgTexture src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions)
+{
+	const VgFormat format = src->Desc().format;
+	vg::Vector<VkBufferImageCopy2> vkRegions(numRegions);
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		vkRegions[i] = BufferTextureCopyRegionToVk(regions[i], format);
+	}
+	const VkCopyImageToBufferInfo2 copyInfo = {
+		.sType = VK_STRUCTURE_TYPE_COPY_IMAGE_TO_BUFFER_INFO_2,
+		.pNext = nullptr,
+		.srcImage = static_cast<VulkanTexture*>(src)->Image(),
+		.srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		.dstBuffer = ToVkBuffer(dst),
+		.regionCount = numRegions,
+		.pRegions = vkRegions.data()
+	};
+	_pool->Device()->Functions().vkCmdCopyImageToBuffer2(_cmd, &copyInfo);
+}
+
+void VulkanCommandList::CopyTextureToTextureRegions(VgTexture dst, VgTexture src, uint32_t numRegions, const VgTextureCopyRegion* regions)
+{
+	const VgFormat dstFormat = dst->Desc().format;
+	const VgFormat srcFormat = src->Desc().format;
+	vg::Vector<VkImageCopy2> vkRegions(numRegions);
+	for (uint32_t i = 0; i < numRegions; i++)
+	{
+		const VgRegion& dstRegion = regions[i].dst_region;
+		const VgRegion& srcRegion = regions[i].src_region;
+		vkRegions[i] = {
+			.sType = VK_STRUCTURE_TYPE_IMAGE_COPY_2,
+			.pNext = nullptr,
+			.srcSubresource = RegionSubresourceToVk(srcRegion, srcFormat),
+			.srcOffset = { static_cast<int32_t>(srcRegion.offset.x), static_cast<int32_t>(srcRegion.offset.y), static_cast<int32_t>(srcRegion.offset.z) },
+			.dstSubresource = RegionSubresourceToVk(dstRegion, dstFormat),
+			.dstOffset = { static_cast<int32_t>(dstRegion.offset.x), static_cast<int32_t>(dstRegion.offset.y), static_cast<int32_t>(dstRegion.offset.z) },
+			.extent = { srcRegion.width, srcRegion.height, srcRegion.depth }
+		};
+	}
+	const VkCopyImageInfo2 copyInfo = {
+		.sType = VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2,
+		.pNext = nullptr,
+		.srcImage = static_cast<VulkanTexture*>(src)->Image(),
+		.srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		.dstImage = static_cast<VulkanTexture*>(dst)->Image(),
+		.dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.regionCount = numRegions,
+		.pRegions = vkRegions.data()
+	};
+	_pool->Device()->Functions().vkCmdCopyImage2(_cmd, &copyInfo);
+}
+
+void VulkanCommandList::BeginMarker(const char* name, float color[3])
+{
+	if (!vkCmdBeginDebugUtilsLabelEXT) return;
+	const VkDebugUtilsLabelEXT label = {
+		.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
+		.pNext = nullptr,
+		.pLabelName = name,
+		.color = { color[0], color[1], color[2], 1.0f }
+	};
+	vkCmdBeginDebugUtilsLabelEXT(_cmd, &label);
+}
+
+void VulkanCommandList::EndMarker()
+{
+	if (vkCmdEndDebugUtilsLabelEXT) vkCmdEndDebugUtilsLabelEXT(_cmd);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "vkdevice.h"
+#include <mutex>
+
+#if VG_VULKAN_SUPPORTED
+
+class VulkanCommandList;
+class VulkanCommandPool final : public VgCommandPool_t
+{
+public:
+	VulkanCommandPool(VulkanDevice& device, VgCommandPoolFlags flags, VgQueue queue);
+	~VulkanCommandPool();
+
+	void* GetApiObject() const override { return _pool; }
+	void SetName(const char* name) override { _device->SetObjectName(VK_OBJECT_TYPE_COMMAND_POOL, _pool, name); }
+	VulkanDevice* Device() const override { return _device; }
+	VkCommandPool Pool() const { return _pool; }
+
+	VgCommandList AllocateCommandList() override;
+	void FreeCommandList(VgCommandList list) override;
+	void Reset() override;
+
+private:
+	VulkanDevice* _device;
+	VkCommandPool _pool;
+	vg::UnorderedSet<VulkanCommandList*> _lists;
+	std::mutex _cmdMutex;
+};
+
+class VulkanCommandList final : public VgCommandList_t
+{
+public:
+	~VulkanCommandList();
+
+	void* GetApiObject() const override { return _cmd; }
+	void SetName(const char* name) override { _pool->Device()->SetObjectName(VK_OBJECT_TYPE_COMMAND_BUFFER, _cmd, name); }
+	VulkanDevice* Device() const override { return _pool->Device(); }
+	VulkanCommandPool* CommandPool() const override { return _pool; }
+	VkCommandBuffer Cmd() const { return _cmd; }
+	void RestoreDescriptorState() override;
+
+	void Begin() override;
+	void BeginBundle(const VgBundleInheritanceInfo& info) override;
+	void End() override;
+
+	void SetVertexBuffers(uint32_t startSlot, uint32_t numBuffers, const VgVertexBufferView* buffers) override;
+	void SetIndexBuffer(VgIndexType indexType, uint64_t offset, VgBuffer buffer) override;
+
+	void SetRootConstants(VgPipelineType pipelineType, uint32_t offsetIn32bitValues, uint32_t num32bitValues, const void* data) override;
+	void SetPipeline(VgPipeline pipeline) override;
+	void SetGraphicsState(const GraphicsPipelineParts& state) override;
+
+	void Barrier(const VgDependencyInfo& dependencyInfo) override;
+
+	void BeginRendering(const VgRenderingInfo& info) override;
+	void EndRendering() override;
+	void SetViewport(uint32_t firstViewport, uint32_t numViewports, VgViewport* viewports) override;
+	void SetScissor(uint32_t firstScissor, uint32_t numScissors, VgScissor* scissors) override;
+	void ExecuteBundle(VgCommandList bundle) override;
+
+	void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+	void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, uint32_t vertexOffset, uint32_t firstInstance) override;
+	void DrawMulti(uint32_t drawCount, const VgMultiDrawInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants) override;
+	void DrawIndexedMulti(uint32_t drawCount, const VgMultiDrawIndexedInfo* draws, uint32_t instanceCount, uint32_t firstInstance, const VgMultiDrawRootConstants* rootConstants) override;
+	void Dispatch(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z) override;
+	void DrawIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) override;
+	void DrawIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride) override;
+	void DrawIndexedIndirect(VgBuffer buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) override;
+	void DrawIndexedIndirectCount(VgBuffer buffer, uint64_t offset, VgBuffer countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride) override;
+	void DispatchIndirect(VgBuffer buffer, uint64_t offset) override;
+	void DispatchMesh(uint32_t groups_x, uint32_t groups_y, uint32_t groups_z) override;
+
+	void CopyBufferToBuffer(VgBuffer dst, uint64_t dstOffset, VgBuffer src, uint64_t srcOffset, uint64_t size) override;
+	void CopyBufferToTexture(VgTexture dst, const VgRegion& dstRegion, VgBuffer src, uint64_t srcOffset) override;
+	void CopyTextureToBuffer(VgBuffer dst, uint64_t dstOffset, VgTexture src, const VgRegion& srcRegion) override;
+	void CopyTextureToTexture(VgTexture dst, const VgRegion& dstRegion, VgTexture src, const VgRegion& srcRegion) override;
+	void CopyBufferToBufferRegions(VgBuffer dst, VgBuffer src, uint32_t numRegions, const VgBufferCopyRegion* regions) override;
+	void CopyBufferToTextureRegions(VgTexture dst, VgBuffer src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions) override;
+	void CopyTextureToBufferRegions(VgBuffer dst, VgTexture src, uint32_t numRegions, const VgBufferTextureCopyRegion* regions) override;
+	void CopyTextureToTextureRegions(VgTexture dst, VgTexture src, uint32_t numRegions, const VgTextureCopyRegion* regions) override;
+
+	void BeginMarker(const char* name, float color[3]) override;
+	void EndMarker() override;
+
+private:
+	VulkanCommandPool* _pool;
+	VkCommandBuffer _cmd;
+
+	friend VulkanCommandPool;
+	VulkanCommandList(VulkanCommandPool& pool);
+};
+
+#endif
@@ -105,6 +105,8 @@ vg::Vector<VgAdapter_t*> VulkanCore::CollectAdapters(VgSurface surface)
 		.tessellationShader = true,
 		.sampleRateShading = true,
 		.dualSrcBlend = true,
+		.multiDrawIndirect = true,
+		.drawIndirectFirstInstance = true,
 		.samplerAnisotropy = true,
 		.textureCompressionBC = true,
 		.fragmentStoresAndAtomics = true,
@@ -135,6 +137,8 @@ vg::Vector<VgAdapter_t*> VulkanCore::CollectAdapters(VgSurface surface)
 			.customBorderColors = true,
 			.customBorderColorWithoutFormat = true
 		})
+		// Without a surface (headless use) presentation support is not required
+		.require_present(surface != nullptr)
 		.set_surface(static_cast<VkSurfaceKHR>(surface)).select_devices();
 	if (!devices.has_value() || devices.value().empty()) return {};
 	for (auto& device : devices.value())
@@ -84,6 +84,146 @@ constexpr const char* VulkanResultToString(VkResult result)
     }
 }
 
+// Typeless formats map to one of their typed variants, X channels to their A variant.
+// VG_FORMAT_R1_UNORM and VG_FORMAT_R10G10B10_XR_BIAS_A2_UNORM have no Vulkan equivalent
+constexpr VkFormat FormatToVk(VgFormat format)
+{
+	switch (format)
+	{
+	case VG_FORMAT_R32G32B32A32_TYPELESS: return VK_FORMAT_R32G32B32A32_UINT;
+	case VG_FORMAT_R32G32B32A32_FLOAT: return VK_FORMAT_R32G32B32A32_SFLOAT;
+	case VG_FORMAT_R32G32B32A32_UINT: return VK_FORMAT_R32G32B32A32_UINT;
+	case VG_FORMAT_R32G32B32A32_SINT: return VK_FORMAT_R32G32B32A32_SINT;
+	case VG_FORMAT_R32G32B32_TYPELESS: return VK_FORMAT_R32G32B32_UINT;
+	case VG_FORMAT_R32G32B32_FLOAT: return VK_FORMAT_R32G32B32_SFLOAT;
+	case VG_FORMAT_R32G32B32_UINT: return VK_FORMAT_R32G32B32_UINT;
+	case VG_FORMAT_R32G32B32_SINT: return VK_FORMAT_R32G32B32_SINT;
+	case VG_FORMAT_R16G16B16A16_TYPELESS: return VK_FORMAT_R16G16B16A16_UINT;
+	case VG_FORMAT_R16G16B16A16_FLOAT: return VK_FORMAT_R16G16B16A16_SFLOAT;
+	case VG_FORMAT_R16G16B16A16_UNORM: return VK_FORMAT_R16G16B16A16_UNORM;
+	case VG_FORMAT_R16G16B16A16_UINT: return VK_FORMAT_R16G16B16A16_UINT;
+	case VG_FORMAT_R16G16B16A16_SNORM: return VK_FORMAT_R16G16B16A16_SNORM;
+	case VG_FORMAT_R16G16B16A16_SINT: return VK_FORMAT_R16G16B16A16_SINT;
+	case VG_FORMAT_R32G32_TYPELESS: return VK_FORMAT_R32G32_UINT;
+	case VG_FORMAT_R32G32_FLOAT: return VK_FORMAT_R32G32_SFLOAT;
+	case VG_FORMAT_R32G32_UINT: return VK_FORMAT_R32G32_UINT;
+	case VG_FORMAT_R32G32_SINT: return VK_FORMAT_R32G32_SINT;
+	case VG_FORMAT_R32G8X24_TYPELESS: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+	case VG_FORMAT_D32_FLOAT_S8X24_UINT: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+	case VG_FORMAT_R32_FLOAT_X8X24_TYPELESS: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+	case VG_FORMAT_X32_TYPELESS_G8X24_UINT: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+	case VG_FORMAT_R10G10B10A2_TYPELESS: return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+	case VG_FORMAT_R10G10B10A2_UNORM: return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+	case VG_FORMAT_R10G10B10A2_UINT: return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+	case VG_FORMAT_R11G11B10_FLOAT: return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+	case VG_FORMAT_R8G8B8A8_TYPELESS: return VK_FORMAT_R8G8B8A8_UNORM;
+	case VG_FORMAT_R8G8B8A8_UNORM: return VK_FORMAT_R8G8B8A8_UNORM;
+	case VG_FORMAT_R8G8B8A8_SRGB: return VK_FORMAT_R8G8B8A8_SRGB;
+	case VG_FORMAT_R8G8B8A8_UINT: return VK_FORMAT_R8G8B8A8_UINT;
+	case VG_FORMAT_R8G8B8A8_SNORM: return VK_FORMAT_R8G8B8A8_SNORM;
+	case VG_FORMAT_R8G8B8A8_SINT: return VK_FORMAT_R8G8B8A8_SINT;
+	case VG_FORMAT_R16G16_TYPELESS: return VK_FORMAT_R16G16_UINT;
+	case VG_FORMAT_R16G16_FLOAT: return VK_FORMAT_R16G16_SFLOAT;
+	case VG_FORMAT_R16G16_UNORM: return VK_FORMAT_R16G16_UNORM;
+	case VG_FORMAT_R16G16_UINT: return VK_FORMAT_R16G16_UINT;
+	case VG_FORMAT_R16G16_SNORM: return VK_FORMAT_R16G16_SNORM;
+	case VG_FORMAT_R16G16_SINT: return VK_FORMAT_R16G16_SINT;
+	case VG_FORMAT_R32_TYPELESS: return VK_FORMAT_R32_UINT;
+	case VG_FORMAT_D32_FLOAT: return VK_FORMAT_D32_SFLOAT;
+	case VG_FORMAT_R32_FLOAT: return VK_FORMAT_R32_SFLOAT;
+	case VG_FORMAT_R32_UINT: return VK_FORMAT_R32_UINT;
+	case VG_FORMAT_R32_SINT: return VK_FORMAT_R32_SINT;
+	case VG_FORMAT_R24G8_TYPELESS: return VK_FORMAT_D24_UNORM_S8_UINT;
+	case VG_FORMAT_D24_UNORM_S8_UINT: return VK_FORMAT_D24_UNORM_S8_UINT;
+	case VG_FORMAT_R24_UNORM_X8_TYPELESS: return VK_FORMAT_D24_UNORM_S8_UINT;
+	case VG_FORMAT_X24_TYPELESS_G8_UINT: return VK_FORMAT_D24_UNORM_S8_UINT;
+	case VG_FORMAT_R8G8_TYPELESS: return VK_FORMAT_R8G8_UNORM;
+	case VG_FORMAT_R8G8_UNORM: return VK_FORMAT_R8G8_UNORM;
+	case VG_FORMAT_R8G8_UINT: return VK_FORMAT_R8G8_UINT;
+	case VG_FORMAT_R8G8_SNORM: return VK_FORMAT_R8G8_SNORM;
+	case VG_FORMAT_R8G8_SINT: return VK_FORMAT_R8G8_SINT;
+	case VG_FORMAT_R16_TYPELESS: return VK_FORMAT_R16_UINT;
+	case VG_FORMAT_R16_FLOAT: return VK_FORMAT_R16_SFLOAT;
+	case VG_FORMAT_D16_UNORM: return VK_FORMAT_D16_UNORM;
+	case VG_FORMAT_R16_UNORM: return VK_FORMAT_R16_UNORM;
+	case VG_FORMAT_R16_UINT: return VK_FORMAT_R16_UINT;
+	case VG_FORMAT_R16_SNORM: return VK_FORMAT_R16_SNORM;
+	case VG_FORMAT_R16_SINT: return VK_FORMAT_R16_SINT;
+	case VG_FORMAT_R8_TYPELESS: return VK_FORMAT_R8_UNORM;
+	case VG_FORMAT_R8_UNORM: return VK_FORMAT_R8_UNORM;
+	case VG_FORMAT_R8_UINT: return VK_FORMAT_R8_UINT;
+	case VG_FORMAT_R8_SNORM: return VK_FORMAT_R8_SNORM;
+	case VG_FORMAT_R8_SINT: return VK_FORMAT_R8_SINT;
+	case VG_FORMAT_A8_UNORM: return VK_FORMAT_A8_UNORM_KHR;
+	case VG_FORMAT_R9G9B9E5_SHAREDEXP: return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+	case VG_FORMAT_R8G8_B8G8_UNORM: return VK_FORMAT_G8B8G8R8_422_UNORM;
+	case VG_FORMAT_G8R8_G8B8_UNORM: return VK_FORMAT_B8G8R8G8_422_UNORM;
+	case VG_FORMAT_BC1_TYPELESS: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+	case VG_FORMAT_BC1_UNORM: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+	case VG_FORMAT_BC1_SRGB: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+	case VG_FORMAT_BC2_TYPELESS: return VK_FORMAT_BC2_UNORM_BLOCK;
+	case VG_FORMAT_BC2_UNORM: return VK_FORMAT_BC2_UNORM_BLOCK;
+	case VG_FORMAT_BC2_SRGB: return VK_FORMAT_BC2_SRGB_BLOCK;
+	case VG_FORMAT_BC3_TYPELESS: return VK_FORMAT_BC3_UNORM_BLOCK;
+	case VG_FORMAT_BC3_UNORM: return VK_FORMAT_BC3_UNORM_BLOCK;
+	case VG_FORMAT_BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+	case VG_FORMAT_BC4_TYPELESS: return VK_FORMAT_BC4_UNORM_BLOCK;
+	case VG_FORMAT_BC4_UNORM: return VK_FORMAT_BC4_UNORM_BLOCK;
+	case VG_FORMAT_BC4_SNORM: return VK_FORMAT_BC4_SNORM_BLOCK;
+	case VG_FORMAT_BC5_TYPELESS: return VK_FORMAT_BC5_UNORM_BLOCK;
+	case VG_FORMAT_BC5_UNORM: return VK_FORMAT_BC5_UNORM_BLOCK;
+	case VG_FORMAT_BC5_SNORM: return VK_FORMAT_BC5_SNORM_BLOCK;
+	case VG_FORMAT_B5G6R5_UNORM: return VK_FORMAT_R5G6B5_UNORM_PACK16;
+	case VG_FORMAT_B5G5R5A1_UNORM: return VK_FORMAT_A1R5G5B5_UNORM_PACK16;
+	case VG_FORMAT_B8G8R8A8_UNORM: return VK_FORMAT_B8G8R8A8_UNORM;
+	case VG_FORMAT_B8G8R8X8_UNORM: return VK_FORMAT_B8G8R8A8_UNORM;
+	case VG_FORMAT_B8G8R8A8_TYPELESS: return VK_FORMAT_B8G8R8A8_UNORM;
+	case VG_FORMAT_B8G8R8A8_SRGB: return VK_FORMAT_B8G8R8A8_SRGB;
+	case VG_FORMAT_B8G8R8X8_TYPELESS: return VK_FORMAT_B8G8R8A8_UNORM;
+	case VG_FORMAT_B8G8R8X8_SRGB: return VK_FORMAT_B8G8R8A8_SRGB;
+	case VG_FORMAT_BC6H_TYPELESS: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+	case VG_FORMAT_BC6H_UF16: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+	case VG_FORMAT_BC6H_SF16: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+	case VG_FORMAT_BC7_TYPELESS: return VK_FORMAT_BC7_UNORM_BLOCK;
+	case VG_FORMAT_BC7_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
+	case VG_FORMAT_BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
+	default: return VK_FORMAT_UNDEFINED;
+	}
+}
+
+// Every aspect of the format, copies and shader views have to pick a single one
+constexpr VkImageAspectFlags FormatAspectsToVk(VkFormat format)
+{
+	switch (format)
+	{
+	case VK_FORMAT_D16_UNORM:
+	case VK_FORMAT_D32_SFLOAT: return VK_IMAGE_ASPECT_DEPTH_BIT;
+	case VK_FORMAT_D24_UNORM_S8_UINT:
+	case VK_FORMAT_D32_SFLOAT_S8_UINT: return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+	default: return VK_IMAGE_ASPECT_COLOR_BIT;
+	}
+}
+
+constexpr VkImageLayout TextureLayoutToVk(VgTextureLayout layout)
+{
+	switch (layout)
+	{
+	case VG_TEXTURE_LAYOUT_GENERAL:
+	case VG_TEXTURE_LAYOUT_UNORDERED_ACCESS: return VK_IMAGE_LAYOUT_GENERAL;
+	case VG_TEXTURE_LAYOUT_COLOR_ATTACHMENT: return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	case VG_TEXTURE_LAYOUT_DEPTH_STENCIL: return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	case VG_TEXTURE_LAYOUT_DEPTH_STENCIL_READ_ONLY: return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+	case VG_TEXTURE_LAYOUT_SHADER_RESOURCE: return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	case VG_TEXTURE_LAYOUT_TRANSFER_SOURCE:
+	case VG_TEXTURE_LAYOUT_RESOLVE_SOURCE: return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	case VG_TEXTURE_LAYOUT_TRANSFER_DEST:
+	case VG_TEXTURE_LAYOUT_RESOLVE_DEST: return VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	case VG_TEXTURE_LAYOUT_PRESENT: return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	case VG_TEXTURE_LAYOUT_READ_ONLY: return VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL;
+	default: return VK_IMAGE_LAYOUT_UNDEFINED;
+	}
+}
+
 class VulkanCore
 {
 public:
@@ -117,6 +257,21 @@ public:
 		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_EXT, nullptr, true
 	};
 
+	// ========== BUNDLES ==========
+	inline static constexpr VkPhysicalDeviceInheritedViewportScissorFeaturesNV inheritedViewportScissorFeatures = {
+		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INHERITED_VIEWPORT_SCISSOR_FEATURES_NV, nullptr, true
+	};
+
+	// ========== MULTI DRAW ==========
+	inline static constexpr VkPhysicalDeviceMultiDrawFeaturesEXT multiDrawFeatures = {
+		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT, nullptr, true
+	};
+
+	// ========== DESCRIPTOR BUFFER ==========
+	inline static constexpr VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures = {
+		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT, nullptr, true
+	};
+
 	~VulkanCore();
 
 	static VulkanCore* LoadVulkan(const VgConfig& config);
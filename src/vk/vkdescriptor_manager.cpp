@@ -1,22 +1,27 @@
 #include "vkdescriptor_manager.h"
+#include <algorithm>
 
 #if VG_VULKAN_SUPPORTED
 
+static constexpr std::array resourceDescriptorTypes = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE };
 
-VulkanDescriptorManager::VulkanDescriptorManager(VulkanDevice& device)
-	: _device(&device)
+VulkanDescriptorManager::VulkanDescriptorManager(VulkanDevice& device, VkDescriptorSetLayoutCreateFlags layoutFlags,
+	VkDescriptorSetLayoutCreateFlags immutableSamplersLayoutFlags, VkDescriptorBindingFlags bindingFlags)
+	: _device(&device),
+	_resourceSlots(NumResourceDescriptors, "Resource descriptor set"),
+	_samplerSlots(NumSamplerDescriptors, "Sampler descriptor set")
 {
-	CreateResourceDescriptorSet();
-	CreateImmutableSamplersSet();
+	CreateResourcesLayout(layoutFlags, bindingFlags);
+	CreateImmutableSamplersLayout(immutableSamplersLayoutFlags);
+	CreatePipelineLayout();
 }
 
 VulkanDescriptorManager::~VulkanDescriptorManager()
 {
 	auto& fn = _device->Functions();
 
-	fn.vkDestroyDescriptorPool(_device->Device(), _resourcesPool, _device->AllocationCallbacks());
-	fn.vkDestroyDescriptorPool(_device->Device(), _immutableSamplersPool, _device->AllocationCallbacks());
-
+	fn.vkDestroyPipelineLayout(_device->Device(), _pipelineLayout, _device->AllocationCallbacks());
 	fn.vkDestroyDescriptorSetLayout(_device->Device(), _resourcesLayout, _device->AllocationCallbacks());
 	fn.vkDestroyDescriptorSetLayout(_device->Device(), _immutableSamplersLayout, _device->AllocationCallbacks());
 
@@ -26,27 +31,27 @@ VulkanDescriptorManager::~VulkanDescriptorManager()
 	}
 }
 
-void VulkanDescriptorManager::CreateResourceDescriptorSet()
+void VulkanDescriptorManager::CreateResourcesLayout(VkDescriptorSetLayoutCreateFlags layoutFlags, VkDescriptorBindingFlags bindingFlags)
 {
 	auto& fn = _device->Functions();
 
 	std::array<VkDescriptorSetLayoutBinding, 3> bindings = {
 		VkDescriptorSetLayoutBinding {
-			.binding = 0,
+			.binding = ResourceBinding,
 			.descriptorType = VK_DESCRIPTOR_TYPE_MUTABLE_EXT,
 			.descriptorCount = NumResourceDescriptors,
 			.stageFlags = VK_SHADER_STAGE_ALL,
 			.pImmutableSamplers = nullptr
 		},
 		VkDescriptorSetLayoutBinding {
-			.binding = 1,
+			.binding = StorageBufferBinding,
 			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
 			.descriptorCount = NumResourceDescriptors,
 			.stageFlags = VK_SHADER_STAGE_ALL,
 			.pImmutableSamplers = nullptr
 		},
 		VkDescriptorSetLayoutBinding {
-			.binding = 2,
+			.binding = SamplerBinding,
 			.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
 			.descriptorCount = NumSamplerDescriptors,
 			.stageFlags = VK_SHADER_STAGE_ALL,
@@ -54,16 +59,15 @@ void VulkanDescriptorManager::CreateResourceDescriptorSet()
 		}
 	};
 
-	vg::Vector<VkDescriptorType> resourceDescriptorTypes = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-		  VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE };
+	vg::Vector<VkDescriptorType> mutableTypes(resourceDescriptorTypes.begin(), resourceDescriptorTypes.end());
 	if (_device->Adapter()->GetProperties().hardware_ray_tracing)
 	{
-		//resourceDescriptorTypes.push_back(VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR);
+		//mutableTypes.push_back(VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR);
 	}
 
 	VkMutableDescriptorTypeListEXT typeList{
-		.descriptorTypeCount = static_cast<uint32_t>(resourceDescriptorTypes.size()),
-		.pDescriptorTypes = resourceDescriptorTypes.data()
+		.descriptorTypeCount = static_cast<uint32_t>(mutableTypes.size()),
+		.pDescriptorTypes = mutableTypes.data()
 	};
 	VkMutableDescriptorTypeCreateInfoEXT mutableInfo{
 		.sType = VK_STRUCTURE_TYPE_MUTABLE_DESCRIPTOR_TYPE_CREATE_INFO_EXT,
@@ -75,58 +79,25 @@ void VulkanDescriptorManager::CreateResourceDescriptorSet()
 	std::array<VkDescriptorBindingFlags, bindings.size()> flags;
 	for (uint64_t i = 0; i < flags.size(); i++)
 	{
-		flags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+		flags[i] = bindingFlags;
 	}
 
-	VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlags = {
+	VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
 		VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO, &mutableInfo,
 		static_cast<uint32_t>(flags.size()), flags.data()
 	};
 	VkDescriptorSetLayoutCreateInfo createInfo = {
 		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-		.pNext = &bindingFlags,
-		.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+		.pNext = &bindingFlagsInfo,
+		.flags = layoutFlags,
 		.bindingCount = static_cast<uint32_t>(bindings.size()),
 		.pBindings = bindings.data()
 	};
 
 	VkThrowOnError(fn.vkCreateDescriptorSetLayout(_device->Device(), &createInfo, _device->AllocationCallbacks(), &_resourcesLayout));
-
-	constexpr std::array poolSizes = {
-		VkDescriptorPoolSize{
-			.type = VK_DESCRIPTOR_TYPE_MUTABLE_EXT,
-			.descriptorCount = NumResourceDescriptors
-		},
-		VkDescriptorPoolSize{
-			.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-			.descriptorCount = NumResourceDescriptors
-		},
-		VkDescriptorPoolSize{
-			.type = VK_DESCRIPTOR_TYPE_SAMPLER,
-			.descriptorCount = NumSamplerDescriptors
-		}
-	};
-	VkDescriptorPoolCreateInfo poolCreateInfo = {
-		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-		.pNext = nullptr,
-		.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-		.maxSets = 1,
-		.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
-		.pPoolSizes = poolSizes.data()
-	};
-	VkThrowOnError(fn.vkCreateDescriptorPool(_device->Device(), &poolCreateInfo, _device->AllocationCallbacks(), &_resourcesPool));
-
-	VkDescriptorSetAllocateInfo allocateInfo = {
-		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-		.pNext = nullptr,
-		.descriptorPool = _resourcesPool,
-		.descriptorSetCount = 1,
-		.pSetLayouts = &_resourcesLayout
-	};
-	VkThrowOnError(fn.vkAllocateDescriptorSets(_device->Device(), &allocateInfo, &_resourcesSet));
 }
 
-void VulkanDescriptorManager::CreateImmutableSamplersSet()
+void VulkanDescriptorManager::CreateImmutableSamplersLayout(VkDescriptorSetLayoutCreateFlags layoutFlags)
 {
 	auto& fn = _device->Functions();
 
@@ -170,34 +141,330 @@ void VulkanDescriptorManager::CreateImmutableSamplersSet()
 	VkDescriptorSetLayoutCreateInfo layoutCreateInfo = {
 		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
 		.pNext = nullptr,
-		.flags = 0,
+		.flags = layoutFlags,
 		.bindingCount = static_cast<uint32_t>(bindings.size()),
 		.pBindings = bindings.data()
 	};
 	VkThrowOnError(fn.vkCreateDescriptorSetLayout(_device->Device(), &layoutCreateInfo, _device->AllocationCallbacks(), &_immutableSamplersLayout));
-	
-	const VkDescriptorPoolSize poolSize = {
+}
+
+void VulkanDescriptorManager::CreatePipelineLayout()
+{
+	auto& fn = _device->Functions();
+
+	// Root constants are push constants, vg_num_allowed_root_constants fits into the 128 bytes every implementation supports
+	const std::array setLayouts = { _resourcesLayout, _immutableSamplersLayout };
+	const VkPushConstantRange pushConstantRange = {
+		.stageFlags = VK_SHADER_STAGE_ALL,
+		.offset = 0,
+		.size = vg_num_allowed_root_constants * sizeof(uint32_t)
+	};
+	const VkPipelineLayoutCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
+		.pSetLayouts = setLayouts.data(),
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges = &pushConstantRange
+	};
+	VkThrowOnError(fn.vkCreatePipelineLayout(_device->Device(), &createInfo, _device->AllocationCallbacks(), &_pipelineLayout));
+}
+
+// ========== DESCRIPTOR SETS ==========
+
+VulkanDescriptorSetManager::VulkanDescriptorSetManager(VulkanDevice& device)
+	: VulkanDescriptorManager(device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT, 0,
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT)
+{
+	auto& fn = _device->Functions();
+
+	constexpr std::array poolSizes = {
+		VkDescriptorPoolSize{
+			.type = VK_DESCRIPTOR_TYPE_MUTABLE_EXT,
+			.descriptorCount = NumResourceDescriptors
+		},
+		VkDescriptorPoolSize{
+			.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.descriptorCount = NumResourceDescriptors
+		},
+		VkDescriptorPoolSize{
+			.type = VK_DESCRIPTOR_TYPE_SAMPLER,
+			.descriptorCount = NumSamplerDescriptors
+		}
+	};
+	VkDescriptorPoolCreateInfo poolCreateInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+		.maxSets = 1,
+		.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+		.pPoolSizes = poolSizes.data()
+	};
+	VkThrowOnError(fn.vkCreateDescriptorPool(_device->Device(), &poolCreateInfo, _device->AllocationCallbacks(), &_resourcesPool));
+
+	VkDescriptorSetAllocateInfo allocateInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.pNext = nullptr,
+		.descriptorPool = _resourcesPool,
+		.descriptorSetCount = 1,
+		.pSetLayouts = &_resourcesLayout
+	};
+	VkThrowOnError(fn.vkAllocateDescriptorSets(_device->Device(), &allocateInfo, &_resourcesSet));
+
+	const VkDescriptorPoolSize samplerPoolSize = {
 		.type = VK_DESCRIPTOR_TYPE_SAMPLER,
 		.descriptorCount = static_cast<uint32_t>(_immutableSamplers.size())
 	};
-	VkDescriptorPoolCreateInfo poolCreateInfo = {
+	VkDescriptorPoolCreateInfo samplerPoolCreateInfo = {
 		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
 		.pNext = nullptr,
 		.flags = 0,
 		.maxSets = 1,
 		.poolSizeCount = 1,
-		.pPoolSizes = &poolSize
+		.pPoolSizes = &samplerPoolSize
 	};
-	VkThrowOnError(fn.vkCreateDescriptorPool(_device->Device(), &poolCreateInfo, _device->AllocationCallbacks(), &_immutableSamplersPool));
+	VkThrowOnError(fn.vkCreateDescriptorPool(_device->Device(), &samplerPoolCreateInfo, _device->AllocationCallbacks(), &_immutableSamplersPool));
 
-	VkDescriptorSetAllocateInfo allocateInfo = {
+	VkDescriptorSetAllocateInfo samplerAllocateInfo = {
 		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
 		.pNext = nullptr,
 		.descriptorPool = _immutableSamplersPool,
 		.descriptorSetCount = 1,
 		.pSetLayouts = &_immutableSamplersLayout
 	};
-	VkThrowOnError(fn.vkAllocateDescriptorSets(_device->Device(), &allocateInfo, &_immutableSamplersSet));
+	VkThrowOnError(fn.vkAllocateDescriptorSets(_device->Device(), &samplerAllocateInfo, &_immutableSamplersSet));
+}
+
+VulkanDescriptorSetManager::~VulkanDescriptorSetManager()
+{
+	auto& fn = _device->Functions();
+
+	fn.vkDestroyDescriptorPool(_device->Device(), _resourcesPool, _device->AllocationCallbacks());
+	fn.vkDestroyDescriptorPool(_device->Device(), _immutableSamplersPool, _device->AllocationCallbacks());
+}
+
+void VulkanDescriptorSetManager::Write(const VkWriteDescriptorSet& write)
+{
+	std::scoped_lock lock(_writeMutex);
+	_device->Functions().vkUpdateDescriptorSets(_device->Device(), 1, &write, 0, nullptr);
+}
+
+void VulkanDescriptorSetManager::WriteImage(uint32_t index, VkDescriptorType type, VkImageView view, VkImageLayout layout)
+{
+	const VkDescriptorImageInfo imageInfo = { VK_NULL_HANDLE, view, layout };
+	Write({
+		.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext = nullptr,
+		.dstSet = _resourcesSet,
+		.dstBinding = ResourceBinding,
+		.dstArrayElement = index,
+		.descriptorCount = 1,
+		.descriptorType = type,
+		.pImageInfo = &imageInfo,
+		.pBufferInfo = nullptr,
+		.pTexelBufferView = nullptr
+	});
+}
+
+void VulkanDescriptorSetManager::WriteBuffer(uint32_t binding, uint32_t index, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+{
+	const VkDescriptorBufferInfo bufferInfo = { buffer, offset, range };
+	Write({
+		.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext = nullptr,
+		.dstSet = _resourcesSet,
+		.dstBinding = binding,
+		.dstArrayElement = index,
+		.descriptorCount = 1,
+		.descriptorType = type,
+		.pImageInfo = nullptr,
+		.pBufferInfo = &bufferInfo,
+		.pTexelBufferView = nullptr
+	});
+}
+
+void VulkanDescriptorSetManager::WriteSampler(uint32_t index, VkSampler sampler)
+{
+	const VkDescriptorImageInfo imageInfo = { sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+	Write({
+		.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.pNext = nullptr,
+		.dstSet = _resourcesSet,
+		.dstBinding = SamplerBinding,
+		.dstArrayElement = index,
+		.descriptorCount = 1,
+		.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+		.pImageInfo = &imageInfo,
+		.pBufferInfo = nullptr,
+		.pTexelBufferView = nullptr
+	});
+}
+
+void VulkanDescriptorSetManager::BindSets(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout)
+{
+	const std::array sets = { _resourcesSet, _immutableSamplersSet };
+	_device->Functions().vkCmdBindDescriptorSets(cmd, bindPoint, layout, 0, static_cast<uint32_t>(sets.size()), sets.data(), 0, nullptr);
+}
+
+// ========== DESCRIPTOR BUFFER ==========
+
+static size_t MutableDescriptorSize(const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties)
+{
+	return std::max({ properties.uniformBufferDescriptorSize, properties.storageBufferDescriptorSize,
+		properties.storageTexelBufferDescriptorSize, properties.sampledImageDescriptorSize, properties.storageImageDescriptorSize });
+}
+
+VkDeviceSize VulkanDescriptorBufferManager::EstimateBufferSize(const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties)
+{
+	// Bindings are laid out back to back, give each some room for its alignment
+	return NumResourceDescriptors * (MutableDescriptorSize(properties) + properties.storageBufferDescriptorSize)
+		+ NumSamplerDescriptors * properties.samplerDescriptorSize + 3 * properties.descriptorBufferOffsetAlignment;
+}
+
+VulkanDescriptorBufferManager::VulkanDescriptorBufferManager(VulkanDevice& device)
+	: VulkanDescriptorManager(device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT,
+		VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT | VK_DESCRIPTOR_SET_LAYOUT_CREATE_EMBEDDED_IMMUTABLE_SAMPLERS_BIT_EXT,
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT)
+{
+	auto& fn = _device->Functions();
+	const auto& properties = _device->Adapter()->DescriptorBufferProperties();
+
+	VkDeviceSize size;
+	fn.vkGetDescriptorSetLayoutSizeEXT(_device->Device(), _resourcesLayout, &size);
+	for (uint32_t binding = 0; binding < _bindingOffsets.size(); binding++)
+	{
+		fn.vkGetDescriptorSetLayoutBindingOffsetEXT(_device->Device(), _resourcesLayout, binding, &_bindingOffsets[binding]);
+	}
+	_bindingStrides = { MutableDescriptorSize(properties), properties.storageBufferDescriptorSize, properties.samplerDescriptorSize };
+
+	const VkBufferCreateInfo bufferCreateInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.size = size,
+		.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT
+			| VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+		.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+		.queueFamilyIndexCount = 0,
+		.pQueueFamilyIndices = nullptr
+	};
+	// Coherent so that a written descriptor only needs the memcpy of vkGetDescriptorEXT(), device local when the
+	// adapter has host visible VRAM
+	const VmaAllocationCreateInfo allocationCreateInfo = {
+		.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+		.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+		.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		.preferredFlags = 0,
+		.memoryTypeBits = 0,
+		.pool = VK_NULL_HANDLE,
+		.pUserData = nullptr,
+		.priority = 1.0f
+	};
+	VmaAllocationInfo allocationInfo;
+	VkThrowOnError(vmaCreateBuffer(_device->Allocator(), &bufferCreateInfo, &allocationCreateInfo, &_buffer, &_allocation, &allocationInfo));
+	_mapped = static_cast<uint8_t*>(allocationInfo.pMappedData);
+	_device->SetObjectName(VK_OBJECT_TYPE_BUFFER, _buffer, "Resource descriptor buffer");
+
+	const VkBufferDeviceAddressInfo addressInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+		.pNext = nullptr,
+		.buffer = _buffer
+	};
+	_address = fn.vkGetBufferDeviceAddress(_device->Device(), &addressInfo);
+}
+
+VulkanDescriptorBufferManager::~VulkanDescriptorBufferManager()
+{
+	vmaDestroyBuffer(_device->Allocator(), _buffer, _allocation);
+}
+
+size_t VulkanDescriptorBufferManager::DescriptorSize(VkDescriptorType type) const
+{
+	const auto& properties = _device->Adapter()->DescriptorBufferProperties();
+	switch (type)
+	{
+	case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER: return properties.uniformBufferDescriptorSize;
+	case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: return properties.storageBufferDescriptorSize;
+	case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: return properties.storageTexelBufferDescriptorSize;
+	case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE: return properties.sampledImageDescriptorSize;
+	case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: return properties.storageImageDescriptorSize;
+	case VK_DESCRIPTOR_TYPE_SAMPLER: return properties.samplerDescriptorSize;
+	default: return 0;
+	}
+}
+
+void VulkanDescriptorBufferManager::Write(uint32_t binding, uint32_t index, const VkDescriptorGetInfoEXT& info, size_t size)
+{
+	uint8_t* descriptor = _mapped + _bindingOffsets[binding] + index * _bindingStrides[binding];
+	_device->Functions().vkGetDescriptorEXT(_device->Device(), &info, size, descriptor);
+}
+
+void VulkanDescriptorBufferManager::WriteImage(uint32_t index, VkDescriptorType type, VkImageView view, VkImageLayout layout)
+{
+	const VkDescriptorImageInfo imageInfo = { VK_NULL_HANDLE, view, layout };
+	VkDescriptorGetInfoEXT info = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+		.pNext = nullptr,
+		.type = type
+	};
+	if (type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE) info.data.pStorageImage = &imageInfo;
+	else info.data.pSampledImage = &imageInfo;
+	Write(ResourceBinding, index, info, DescriptorSize(type));
+}
+
+void VulkanDescriptorBufferManager::WriteBuffer(uint32_t binding, uint32_t index, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+{
+	const VkBufferDeviceAddressInfo addressInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+		.pNext = nullptr,
+		.buffer = buffer
+	};
+	const VkDescriptorAddressInfoEXT bufferInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+		.pNext = nullptr,
+		.address = _device->Functions().vkGetBufferDeviceAddress(_device->Device(), &addressInfo) + offset,
+		.range = range,
+		.format = VK_FORMAT_UNDEFINED
+	};
+	VkDescriptorGetInfoEXT info = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+		.pNext = nullptr,
+		.type = type
+	};
+	if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) info.data.pUniformBuffer = &bufferInfo;
+	else info.data.pStorageBuffer = &bufferInfo;
+	Write(binding, index, info, DescriptorSize(type));
+}
+
+void VulkanDescriptorBufferManager::WriteSampler(uint32_t index, VkSampler sampler)
+{
+	VkDescriptorGetInfoEXT info = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+		.pNext = nullptr,
+		.type = VK_DESCRIPTOR_TYPE_SAMPLER
+	};
+	info.data.pSampler = &sampler;
+	Write(SamplerBinding, index, info, DescriptorSize(VK_DESCRIPTOR_TYPE_SAMPLER));
+}
+
+void VulkanDescriptorBufferManager::BindHeaps(VkCommandBuffer cmd)
+{
+	const VkDescriptorBufferBindingInfoEXT bindingInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+		.pNext = nullptr,
+		.address = _address,
+		.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT
+	};
+	_device->Functions().vkCmdBindDescriptorBuffersEXT(cmd, 1, &bindingInfo);
+}
+
+void VulkanDescriptorBufferManager::BindSets(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout)
+{
+	const uint32_t bufferIndex = 0;
+	const VkDeviceSize offset = 0;
+	_device->Functions().vkCmdSetDescriptorBufferOffsetsEXT(cmd, bindPoint, layout, 0, 1, &bufferIndex, &offset);
+	_device->Functions().vkCmdBindDescriptorBufferEmbeddedSamplersEXT(cmd, bindPoint, layout, 1);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,33 +1,124 @@
 #pragma once
 
 #include "vkdevice.h"
+#include "../descriptor_allocator.h"
 
 #if VG_VULKAN_SUPPORTED
 
+// Bindless descriptors of a device: set 0 holds the resources and samplers, set 1 the static samplers as immutable samplers.
+// The device picks VulkanDescriptorBufferManager when the adapter has DescriptorBuffer, otherwise VulkanDescriptorSetManager.
 class VulkanDescriptorManager
 {
 public:
 	inline static constexpr uint32_t NumResourceDescriptors = 250'000;
 	inline static constexpr uint32_t NumSamplerDescriptors = 2'048;
 
-	VulkanDescriptorManager(VulkanDevice& device);
-	~VulkanDescriptorManager();
+	// Bindings of the resource set
+	inline static constexpr uint32_t ResourceBinding = 0;
+	inline static constexpr uint32_t StorageBufferBinding = 1;
+	inline static constexpr uint32_t SamplerBinding = 2;
 
-private:
+	virtual ~VulkanDescriptorManager();
+
+	DescriptorSlotAllocator& ResourceSlots() { return _resourceSlots; }
+	DescriptorSlotAllocator& SamplerSlots() { return _samplerSlots; }
+
+	VkDescriptorSetLayout ResourcesLayout() const { return _resourcesLayout; }
+	VkDescriptorSetLayout ImmutableSamplersLayout() const { return _immutableSamplersLayout; }
+	// Layout shared by every pipeline: both sets and vg_num_allowed_root_constants push constants visible to all stages
+	VkPipelineLayout PipelineLayout() const { return _pipelineLayout; }
+	// Added to the flags of pipelines whose layout uses the sets
+	virtual VkPipelineCreateFlags PipelineCreateFlags() const { return 0; }
+
+	// Images go to ResourceBinding, buffers to ResourceBinding or StorageBufferBinding. Writes to different indices may
+	// happen on several threads at once.
+	virtual void WriteImage(uint32_t index, VkDescriptorType type, VkImageView view, VkImageLayout layout) = 0;
+	virtual void WriteBuffer(uint32_t binding, uint32_t index, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) = 0;
+	virtual void WriteSampler(uint32_t index, VkSampler sampler) = 0;
+
+	// Called when a graphics or compute command list begins
+	virtual void BindHeaps(VkCommandBuffer cmd) {}
+	// Called after binding a pipeline whose layout uses the sets
+	virtual void BindSets(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout) = 0;
+
+protected:
 	VulkanDevice* _device;
+	DescriptorSlotAllocator _resourceSlots;
+	DescriptorSlotAllocator _samplerSlots;
 
 	VkDescriptorSetLayout _resourcesLayout;
 	VkDescriptorSetLayout _immutableSamplersLayout;
 	std::array<VkSampler, static_samplers.size()> _immutableSamplers;
+	VkPipelineLayout _pipelineLayout;
+
+	// layoutFlags and immutableSamplersLayoutFlags are added to the flags of the set layouts
+	VulkanDescriptorManager(VulkanDevice& device, VkDescriptorSetLayoutCreateFlags layoutFlags,
+		VkDescriptorSetLayoutCreateFlags immutableSamplersLayoutFlags, VkDescriptorBindingFlags bindingFlags);
+
+private:
+	void CreateResourcesLayout(VkDescriptorSetLayoutCreateFlags layoutFlags, VkDescriptorBindingFlags bindingFlags);
+	void CreateImmutableSamplersLayout(VkDescriptorSetLayoutCreateFlags layoutFlags);
+	void CreatePipelineLayout();
+};
+
+// One update-after-bind descriptor set per layout, written with vkUpdateDescriptorSets()
+class VulkanDescriptorSetManager final : public VulkanDescriptorManager
+{
+public:
+	VulkanDescriptorSetManager(VulkanDevice& device);
+	~VulkanDescriptorSetManager();
+
+	void WriteImage(uint32_t index, VkDescriptorType type, VkImageView view, VkImageLayout layout) override;
+	void WriteBuffer(uint32_t binding, uint32_t index, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) override;
+	void WriteSampler(uint32_t index, VkSampler sampler) override;
+
+	void BindSets(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout) override;
 
+private:
 	VkDescriptorPool _resourcesPool;
 	VkDescriptorPool _immutableSamplersPool;
 
 	VkDescriptorSet _resourcesSet;
 	VkDescriptorSet _immutableSamplersSet;
 
-	void CreateResourceDescriptorSet();
-	void CreateImmutableSamplersSet();
+	// Host access to a descriptor set has to be externally synchronized
+	std::mutex _writeMutex;
+
+	void Write(const VkWriteDescriptorSet& write);
+};
+
+// VK_EXT_descriptor_buffer: the resource set lives in a persistently mapped buffer which descriptors are written into
+// with vkGetDescriptorEXT(), without any locking. The static samplers are embedded in the layout of set 1.
+class VulkanDescriptorBufferManager final : public VulkanDescriptorManager
+{
+public:
+	VulkanDescriptorBufferManager(VulkanDevice& device);
+	~VulkanDescriptorBufferManager();
+
+	// Size of the descriptor buffer for the adapter, to check it against the limits before creating the manager
+	static VkDeviceSize EstimateBufferSize(const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties);
+
+	VkPipelineCreateFlags PipelineCreateFlags() const override { return VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT; }
+
+	void WriteImage(uint32_t index, VkDescriptorType type, VkImageView view, VkImageLayout layout) override;
+	void WriteBuffer(uint32_t binding, uint32_t index, VkDescriptorType type, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) override;
+	void WriteSampler(uint32_t index, VkSampler sampler) override;
+
+	void BindHeaps(VkCommandBuffer cmd) override;
+	void BindSets(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout) override;
+
+private:
+	VkBuffer _buffer;
+	VmaAllocation _allocation;
+	uint8_t* _mapped;
+	VkDeviceAddress _address;
+
+	// Offset and stride of each binding of the resource set in the buffer
+	std::array<VkDeviceSize, 3> _bindingOffsets;
+	std::array<VkDeviceSize, 3> _bindingStrides;
+
+	void Write(uint32_t binding, uint32_t index, const VkDescriptorGetInfoEXT& info, size_t size);
+	size_t DescriptorSize(VkDescriptorType type) const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,10 +1,16 @@
 #include "vkdevice.h"
 #include "vkdescriptor_manager.h"
+#include "vkcommands.h"
+#include "vkbuffer.h"
+#include "vktexture.h"
+#include <algorithm>
 
 #if VG_VULKAN_SUPPORTED
 
 VulkanDevice::VulkanDevice(VulkanAdapter& adapter, VgInitFlags initFlags)
-	: _adapter(&adapter)
+	: _adapter(&adapter),
+	_colorAttachmentViews(NumColorAttachmentViews, "Color attachment views"),
+	_depthStencilAttachmentViews(NumDepthStencilAttachmentViews, "Depth stencil attachment views")
 {
 	vkb::DeviceBuilder deviceBuilder(adapter.PhysicalDevice());
 
@@ -48,7 +54,8 @@ VulkanDevice::VulkanDevice(VulkanAdapter& adapter, VgInitFlags initFlags)
 	};
 
 	VmaAllocatorCreateInfo allocatorCreateInfo = {
-		.flags = 0,
+		.flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT
+			| (adapter.Extensions().MemoryBudget ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT : 0u),
 		.physicalDevice = adapter.PhysicalDevice(),
 		.device = _device,
 		.preferredLargeHeapBlockSize = 0,
@@ -61,8 +68,7 @@ VulkanDevice::VulkanDevice(VulkanAdapter& adapter, VgInitFlags initFlags)
 		.pTypeExternalMemoryHandleTypes = nullptr
 	};
 
-	VmaAllocator allocator;
-	VkThrowOnError(vmaCreateAllocator(&allocatorCreateInfo, &allocator));
+	VkThrowOnError(vmaCreateAllocator(&allocatorCreateInfo, &_allocator));
 
 	if (auto queue = _device.get_queue(vkb::QueueType::graphics); queue.has_value())
 	{
@@ -76,16 +82,37 @@ VulkanDevice::VulkanDevice(VulkanAdapter& adapter, VgInitFlags initFlags)
 		_computeQueue = queue.value();
 		_computeQueueFamily = _device.get_queue_index(vkb::QueueType::compute).value();
 	}
-	else throw VgFailure(std::format("Unable to get compute queue"));
+	else
+	{
+		_computeQueue = _graphicsQueue;
+		_computeQueueFamily = _graphicsQueueFamily;
+	}
 
 	if (auto queue = _device.get_queue(vkb::QueueType::transfer); queue.has_value())
 	{
 		_transferQueue = queue.value();
 		_transferQueueFamily = _device.get_queue_index(vkb::QueueType::transfer).value();
 	}
-	else throw VgFailure(std::format("Unable to get transfer queue"));
+	else
+	{
+		_transferQueue = _graphicsQueue;
+		_transferQueueFamily = _graphicsQueueFamily;
+	}
+
+	for (const uint32_t family : { _graphicsQueueFamily, _computeQueueFamily, _transferQueueFamily })
+	{
+		if (std::find(_queueFamilies.begin(), _queueFamilies.end(), family) == _queueFamilies.end()) _queueFamilies.push_back(family);
+	}
+
+	for (auto& semaphore : _joinSemaphores)
+	{
+		semaphore = reinterpret_cast<VkSemaphore>(CreateFence(0));
+	}
 
-	_descriptorManager = new (GetAllocator().Allocate<VulkanDescriptorManager>()) VulkanDescriptorManager(*this);
+	if (adapter.Extensions().DescriptorBuffer)
+		_descriptorManager = new (GetAllocator().Allocate<VulkanDescriptorBufferManager>()) VulkanDescriptorBufferManager(*this);
+	else
+		_descriptorManager = new (GetAllocator().Allocate<VulkanDescriptorSetManager>()) VulkanDescriptorSetManager(*this);
 }
 
 VulkanDevice::~VulkanDevice()
@@ -93,26 +120,32 @@ VulkanDevice::~VulkanDevice()
 	auto& fn = _functions;
 
 	GetAllocator().Delete(_descriptorManager);
+	for (auto semaphore : _joinSemaphores)
+	{
+		fn.vkDestroySemaphore(_device, semaphore, AllocationCallbacks());
+	}
 	vmaDestroyAllocator(_allocator);
 	vkb::destroy_device(_device);
 }
 
 VgCommandPool VulkanDevice::CreateCommandPool(VgCommandPoolFlags flags, VgQueue queue)
 {
-	return VgCommandPool();
+	return new(GetAllocator().Allocate<VulkanCommandPool>()) VulkanCommandPool(*this, flags, queue);
 }
 
 void VulkanDevice::DestroyCommandPool(VgCommandPool pool)
 {
+	GetAllocator().Delete(pool);
 }
 
 VgBuffer VulkanDevice::CreateBuffer(const VgBufferDesc& desc)
 {
-	return VgBuffer();
+	return new(GetAllocator().Allocate<VulkanBuffer>()) VulkanBuffer(*this, desc);
 }
 
 void VulkanDevice::DestroyBuffer(VgBuffer buffer)
 {
+	GetAllocator().Delete(buffer);
 }
 
 VgShaderModule VulkanDevice::CreateShaderModule(const void* data, uint64_t size)
@@ -134,17 +167,43 @@ VgPipeline VulkanDevice::CreateComputePipeline(VgShaderModule shaderModule)
 	return VgPipeline();
 }
 
+VgPipeline VulkanDevice::CreateGraphicsPipelineLibrary(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc)
+{
+	throw VgError(VG_NOT_SUPPORTED, "graphics pipeline libraries are not supported on Vulkan");
+}
+
+VgPipeline VulkanDevice::LinkGraphicsPipeline(uint32_t numLibraries, const VgPipeline* libraries, const VgGraphicsPipelineDesc& desc)
+{
+	throw VgError(VG_NOT_SUPPORTED, "graphics pipeline libraries are not supported on Vulkan");
+}
+
 void VulkanDevice::DestroyPipeline(VgPipeline pipeline)
 {
 }
 
 VgFence VulkanDevice::CreateFence(uint64_t initialValue)
 {
-	return VgFence();
+	// Fences are timeline semaphores, their values behave like ID3D12Fence values
+	const VkSemaphoreTypeCreateInfo typeInfo = {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+		.pNext = nullptr,
+		.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+		.initialValue = initialValue
+	};
+	const VkSemaphoreCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+		.pNext = &typeInfo,
+		.flags = 0
+	};
+
+	VkSemaphore semaphore;
+	VkThrowOnError(_functions.vkCreateSemaphore(_device, &createInfo, AllocationCallbacks(), &semaphore));
+	return reinterpret_cast<VgFence>(semaphore);
 }
 
 void VulkanDevice::DestroyFence(VgFence fence)
 {
+	_functions.vkDestroySemaphore(_device, reinterpret_cast<VkSemaphore>(fence), AllocationCallbacks());
 }
 
 VgSampler VulkanDevice::CreateSampler(const VgSamplerDesc& desc)
@@ -158,11 +217,12 @@ void VulkanDevice::DestroySampler(VgSampler sampler)
 
 VgTexture VulkanDevice::CreateTexture(const VgTextureDesc& desc)
 {
-	return VgTexture();
+	return new(GetAllocator().Allocate<VulkanTexture>()) VulkanTexture(*this, desc);
 }
 
 void VulkanDevice::DestroyTexture(VgTexture texture)
 {
+	GetAllocator().Delete(texture);
 }
 
 VgSwapChain VulkanDevice::CreateSwapChain(const VgSwapChainDesc& desc)
@@ -176,27 +236,145 @@ void VulkanDevice::DestroySwapChain(VgSwapChain swapChain)
 
 void VulkanDevice::WaitQueueIdle(VgQueue queue)
 {
+	std::scoped_lock lock(_queueMutex);
+	VkThrowOnError(_functions.vkQueueWaitIdle(Queue(queue)));
 }
 
 void VulkanDevice::WaitIdle()
 {
+	std::scoped_lock lock(_queueMutex);
+	VkThrowOnError(_functions.vkDeviceWaitIdle(_device));
 }
 
 void VulkanDevice::SignalFence(VgFence_t* fence, uint64_t value)
 {
+	const VkSemaphoreSignalInfo signalInfo = {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO,
+		.pNext = nullptr,
+		.semaphore = reinterpret_cast<VkSemaphore>(fence),
+		.value = value
+	};
+	VkThrowOnError(_functions.vkSignalSemaphore(_device, &signalInfo));
 }
 
 void VulkanDevice::WaitFence(VgFence_t* fence, uint64_t value)
 {
+	const auto semaphore = reinterpret_cast<VkSemaphore>(fence);
+	const VkSemaphoreWaitInfo waitInfo = {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.semaphoreCount = 1,
+		.pSemaphores = &semaphore,
+		.pValues = &value
+	};
+	VkThrowOnError(_functions.vkWaitSemaphores(_device, &waitInfo, UINT64_MAX));
 }
 
 uint64_t VulkanDevice::GetFenceValue(VgFence_t* fence)
 {
-	return 0;
+	uint64_t value;
+	VkThrowOnError(_functions.vkGetSemaphoreCounterValue(_device, reinterpret_cast<VkSemaphore>(fence), &value));
+	return value;
 }
 
 void VulkanDevice::SubmitCommandLists(uint32_t numSubmits, const VgSubmitInfo* submits)
 {
+	const auto semaphoreInfo = [](VkSemaphore semaphore, uint64_t value)
+		{
+			return VkSemaphoreSubmitInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+				.pNext = nullptr,
+				.semaphore = semaphore,
+				.value = value,
+				.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+				.deviceIndex = 0
+			};
+		};
+
+	// Command lists of one submit grouped by the queue they execute on. Queues without
+	// a separate family share the graphics VkQueue and therefore a single batch
+	struct Batch
+	{
+		VgQueue queue;
+		VkQueue vkQueue;
+		vg::Vector<VkCommandBufferSubmitInfo> commandBuffers;
+	};
+
+	vg::Vector<Batch> batches;
+	vg::Vector<VkSemaphoreSubmitInfo> waits;
+	vg::Vector<VkSemaphoreSubmitInfo> signals;
+
+	std::scoped_lock lock(_queueMutex);
+	for (uint32_t i = 0; i < numSubmits; i++)
+	{
+		const VgSubmitInfo& info = submits[i];
+
+		batches.clear();
+		for (uint32_t j = 0; j < info.num_command_lists; j++)
+		{
+			auto cmd = static_cast<VulkanCommandList*>(info.command_lists[j]);
+			const VgQueue queue = cmd->CommandPool()->Queue();
+			const VkQueue vkQueue = Queue(queue);
+
+			auto batch = std::find_if(batches.begin(), batches.end(), [&](const Batch& b) { return b.vkQueue == vkQueue; });
+			if (batch == batches.end())
+			{
+				batch = batches.insert(batches.end(), Batch{ .queue = queue, .vkQueue = vkQueue });
+			}
+			batch->commandBuffers.push_back({
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+				.pNext = nullptr,
+				.commandBuffer = cmd->Cmd(),
+				.deviceMask = 0
+			});
+		}
+
+		// A fence value must only be signaled once, so when the lists span several queues only the
+		// last batch signals the fences of the submit, after waiting for the other batches to finish
+		for (size_t b = 0; b < batches.size(); b++)
+		{
+			const bool last = b + 1 == batches.size();
+
+			waits.clear();
+			for (uint32_t j = 0; j < info.num_wait_fences; j++)
+			{
+				waits.push_back(semaphoreInfo(reinterpret_cast<VkSemaphore>(info.wait_fences[j].fence), info.wait_fences[j].value));
+			}
+
+			signals.clear();
+			if (last)
+			{
+				for (size_t other = 0; other < b; other++)
+				{
+					const auto queue = batches[other].queue;
+					waits.push_back(semaphoreInfo(_joinSemaphores[queue], _joinValues[queue]));
+				}
+				for (uint32_t j = 0; j < info.num_signal_fences; j++)
+				{
+					signals.push_back(semaphoreInfo(reinterpret_cast<VkSemaphore>(info.signal_fences[j].fence), info.signal_fences[j].value));
+				}
+			}
+			else
+			{
+				const auto queue = batches[b].queue;
+				signals.push_back(semaphoreInfo(_joinSemaphores[queue], ++_joinValues[queue]));
+			}
+
+			const VkSubmitInfo2 submitInfo = {
+				.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+				.pNext = nullptr,
+				.flags = 0,
+				.waitSemaphoreInfoCount = static_cast<uint32_t>(waits.size()),
+				.pWaitSemaphoreInfos = waits.data(),
+				.commandBufferInfoCount = static_cast<uint32_t>(batches[b].commandBuffers.size()),
+				.pCommandBufferInfos = batches[b].commandBuffers.data(),
+				.signalSemaphoreInfoCount = static_cast<uint32_t>(signals.size()),
+				.pSignalSemaphoreInfos = signals.data()
+			};
+			VkThrowOnError(_functions.vkQueueSubmit2(batches[b].vkQueue, 1, &submitInfo, VK_NULL_HANDLE));
+		}
+	}
 }
 
 uint32_t VulkanDevice::GetSamplerIndex(VgSampler_t* sampler)
@@ -204,4 +382,34 @@ uint32_t VulkanDevice::GetSamplerIndex(VgSampler_t* sampler)
 	return 0;
 }
 
+void VulkanDevice::GetMemoryBudget(VgMemoryBudget& budget)
+{
+	// Without VK_EXT_memory_budget VMA estimates the budget as 80% of the heap size and usage from its own blocks
+	VmaBudget heapBudgets[VK_MAX_MEMORY_HEAPS];
+	vmaGetHeapBudgets(_allocator, heapBudgets);
+
+	const VkPhysicalDeviceMemoryProperties* memoryProperties;
+	vmaGetMemoryProperties(_allocator, &memoryProperties);
+
+	budget.num_heaps = std::min(memoryProperties->memoryHeapCount, vg_num_max_memory_heaps);
+	for (uint32_t i = 0; i < budget.num_heaps; i++)
+	{
+		budget.heaps[i] = {
+			.flags = memoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT ? VG_MEMORY_HEAP_DEVICE_LOCAL : VG_MEMORY_HEAP_NONE,
+			.budget = heapBudgets[i].budget,
+			.usage = heapBudgets[i].usage
+		};
+	}
+}
+
+bool VulkanDevice::GetDescriptorHeapStatistics(VgDescriptorHeapType type, VgDescriptorHeapStatistics& stats)
+{
+	switch (type)
+	{
+	case VG_DESCRIPTOR_HEAP_TYPE_RESOURCE: stats = _descriptorManager->ResourceSlots().Statistics(); return true;
+	case VG_DESCRIPTOR_HEAP_TYPE_SAMPLER: stats = _descriptorManager->SamplerSlots().Statistics(); return true;
+	default: return false;
+	}
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "vkcore.h"
 #include "vkadapter.h"
+#include "../descriptor_allocator.h"
+#include <array>
+#include <mutex>
 
 #if VG_VULKAN_SUPPORTED
 
@@ -57,10 +60,75 @@ constexpr void SamplerDescToVk(const VgSamplerDesc& desc, VkSamplerCreateInfo& i
 	};
 }
 
+constexpr VkImageUsageFlags TextureUsageToVk(VgTextureUsageFlags usage)
+{
+	VkImageUsageFlags flags = 0;
+	if (usage & VG_TEXTURE_USAGE_SHADER_RESOURCE) flags |= VK_IMAGE_USAGE_SAMPLED_BIT;
+	if (usage & VG_TEXTURE_USAGE_UNORDERED_ACCESS) flags |= VK_IMAGE_USAGE_STORAGE_BIT;
+	if (usage & VG_TEXTURE_USAGE_COLOR_ATTACHMENT) flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+	if (usage & VG_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT) flags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	// Transient images may only be combined with attachment usages, so they lose the implicit transfer usages
+	if (usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT) flags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+	else flags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	return flags;
+}
+
+// Lazily allocated memory is only preferred, GPUs without it (most desktop ones) fall back to regular device local memory
+constexpr VmaAllocationCreateInfo TextureAllocationToVk(const VgTextureDesc& desc)
+{
+	const bool transient = desc.usage & VG_TEXTURE_USAGE_TRANSIENT_ATTACHMENT;
+	VmaAllocationCreateFlags flags = 0;
+	if (desc.heap_type == VG_HEAP_TYPE_UPLOAD) flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+	else if (desc.heap_type == VG_HEAP_TYPE_READBACK) flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+	return {
+		.flags = flags,
+		.usage = VMA_MEMORY_USAGE_AUTO,
+		.requiredFlags = 0,
+		.preferredFlags = transient ? static_cast<VkMemoryPropertyFlags>(VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) : 0u,
+		.memoryTypeBits = 0,
+		.pool = VK_NULL_HANDLE,
+		.pUserData = nullptr,
+		.priority = 0.0f
+	};
+}
+
+// Attachment views are plain indices like the RTV and DSV heap slots on D3D12, color and depth stencil views are numbered
+// separately. Entries are written before their index is handed out, so looking them up does not lock
+class VulkanAttachmentViewTable
+{
+public:
+	struct Entry
+	{
+		VkImageView view;
+		VkFormat format;
+		VkExtent2D extent;
+		uint32_t layers;
+	};
+
+	VulkanAttachmentViewTable(uint32_t capacity, const char* name) : _slots(capacity, name), _entries(capacity) {}
+
+	uint32_t Add(const Entry& entry)
+	{
+		const uint32_t index = _slots.Allocate();
+		_entries[index] = entry;
+		return index;
+	}
+	void Remove(uint32_t index) { _slots.Free(index); }
+	const Entry& operator[](uint32_t index) const { return _entries[index]; }
+
+private:
+	DescriptorSlotAllocator _slots;
+	vg::Vector<Entry> _entries;
+};
+
 class VulkanDescriptorManager;
 class VulkanDevice final : public VgDevice_t
 {
 public:
+	// Same as the RTV and DSV heaps on D3D12
+	inline static constexpr uint32_t NumColorAttachmentViews = 50'000;
+	inline static constexpr uint32_t NumDepthStencilAttachmentViews = 50'000;
+
 	VulkanDevice(VulkanAdapter& adapter, VgInitFlags initFlags);
 	~VulkanDevice();
 
@@ -68,6 +136,8 @@ public:
 	VgGraphicsApi Api() const override { return VG_GRAPHICS_API_VULKAN; }
 	const VgMemoryStatistics& GetMemoryStatistics() const override { return _memStats; }
 	VgMemoryStatistics& GetMemoryStatistics() { return _memStats; }
+	void GetMemoryBudget(VgMemoryBudget& budget) override;
+	bool GetDescriptorHeapStatistics(VgDescriptorHeapType type, VgDescriptorHeapStatistics& stats) override;
 
 	VulkanAdapter* Adapter() const override { return _adapter; }
 	VkDevice Device() const { return _device; }
@@ -75,6 +145,47 @@ public:
 	VulkanCore& Core() const { return *_adapter->Core(); }
 	const VkAllocationCallbacks* AllocationCallbacks() const { return Core().Allocator(); }
 	const VolkDeviceTable& Functions() const { return _functions; }
+	VulkanDescriptorManager& DescriptorManager() const { return *_descriptorManager; }
+	VulkanAttachmentViewTable& ColorAttachmentViews() { return _colorAttachmentViews; }
+	VulkanAttachmentViewTable& DepthStencilAttachmentViews() { return _depthStencilAttachmentViews; }
+
+	uint32_t QueueFamily(VgQueue queue) const
+	{
+		switch (queue)
+		{
+		case VG_QUEUE_COMPUTE: return _computeQueueFamily;
+		case VG_QUEUE_TRANSFER: return _transferQueueFamily;
+		default: return _graphicsQueueFamily;
+		}
+	}
+
+	// Distinct families of the queues, resources are shared between them like on D3D12
+	const vg::Vector<uint32_t>& QueueFamilies() const { return _queueFamilies; }
+
+	// Compute and transfer fall back to the graphics queue on devices without separate queue families
+	VkQueue Queue(VgQueue queue) const
+	{
+		switch (queue)
+		{
+		case VG_QUEUE_COMPUTE: return _computeQueue;
+		case VG_QUEUE_TRANSFER: return _transferQueue;
+		default: return _graphicsQueue;
+		}
+	}
+
+	template <class T>
+	void SetObjectName(VkObjectType type, T object, const char* name) const
+	{
+		if (!vkSetDebugUtilsObjectNameEXT) return;
+		const VkDebugUtilsObjectNameInfoEXT nameInfo = {
+			.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+			.pNext = nullptr,
+			.objectType = type,
+			.objectHandle = reinterpret_cast<uint64_t>(object),
+			.pObjectName = name
+		};
+		vkSetDebugUtilsObjectNameEXT(_device, &nameInfo);
+	}
 
 	VgCommandPool CreateCommandPool(VgCommandPoolFlags flags, VgQueue queue) override;
 	void DestroyCommandPool(VgCommandPool pool) override;
@@ -84,6 +195,8 @@ public:
 	void DestroyShaderModule(VgShaderModule module) override;
 	VgPipeline CreateGraphicsPipeline(const VgGraphicsPipelineDesc& desc) override;
 	VgPipeline CreateComputePipeline(VgShaderModule shaderModule) override;
+	VgPipeline CreateGraphicsPipelineLibrary(VgGraphicsPipelineLibraryFlags parts, const VgGraphicsPipelineDesc& desc) override;
+	VgPipeline LinkGraphicsPipeline(uint32_t numLibraries, const VgPipeline* libraries, const VgGraphicsPipelineDesc& desc) override;
 	void DestroyPipeline(VgPipeline pipeline) override;
 	VgFence CreateFence(uint64_t initialValue) override;
 	void DestroyFence(VgFence fence) override;
@@ -116,8 +229,18 @@ private:
 	uint32_t _computeQueueFamily;
 	VkQueue _transferQueue;
 	uint32_t _transferQueueFamily;
+	vg::Vector<uint32_t> _queueFamilies;
+	// VkQueue access has to be externally synchronized
+	std::mutex _queueMutex;
+
+	// Join submits whose command lists span several queues. One timeline per VgQueue, as a timeline
+	// must only be signaled in increasing order, which is only guaranteed on a single VkQueue
+	std::array<VkSemaphore, 3> _joinSemaphores;
+	std::array<uint64_t, 3> _joinValues{};
 
 	VulkanDescriptorManager* _descriptorManager;
+	VulkanAttachmentViewTable _colorAttachmentViews;
+	VulkanAttachmentViewTable _depthStencilAttachmentViews;
 
 	VolkDeviceTable _functions;
 	VgMemoryStatistics _memStats;
@@ -0,0 +1,260 @@
+#include "vktexture.h"
+#include "vkdescriptor_manager.h"
+#include <algorithm>
+
+#if VG_VULKAN_SUPPORTED
+
+VulkanTexture::~VulkanTexture()
+{
+	DestroyViews();
+
+	VmaAllocationInfo allocationInfo;
+	vmaGetAllocationInfo(_device->Allocator(), _allocation, &allocationInfo);
+	_device->GetMemoryStatistics().used_vram -= allocationInfo.size;
+	_device->GetMemoryStatistics().num_textures--;
+
+	vmaDestroyImage(_device->Allocator(), _image, _allocation);
+}
+
+VkImageView VulkanTexture::CreateImageView(VkImageViewType type, VgFormat format, const VkComponentMapping& components,
+	const VkImageSubresourceRange& range)
+{
+	const VkImageViewCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.image = _image,
+		.viewType = type,
+		.format = FormatToVk(format),
+		.components = components,
+		.subresourceRange = range
+	};
+
+	VkImageView view;
+	VkThrowOnError(_device->Functions().vkCreateImageView(_device->Device(), &createInfo, _device->AllocationCallbacks(), &view));
+	return view;
+}
+
+constexpr VkImageViewType AttachmentViewTypeToVk(VgTextureAttachmentViewType type)
+{
+	switch (type)
+	{
+	case VG_TEXTURE_ATTACHMENT_VIEW_TYPE_1D: return VK_IMAGE_VIEW_TYPE_1D;
+	case VG_TEXTURE_ATTACHMENT_VIEW_TYPE_1D_ARRAY: return VK_IMAGE_VIEW_TYPE_1D_ARRAY;
+	case VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D_ARRAY:
+	case VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D_MS_ARRAY:
+	// Slices of 3D images are rendered to through 2D array views, see VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT
+	case VG_TEXTURE_ATTACHMENT_VIEW_TYPE_3D: return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+	default: return VK_IMAGE_VIEW_TYPE_2D;
+	}
+}
+
+uint32_t VulkanTexture::CreateAttachmentView(const VgAttachmentViewDesc& desc)
+{
+	// Like on D3D12 the layers of non-array views are ignored
+	const bool array = desc.type == VG_TEXTURE_ATTACHMENT_VIEW_TYPE_1D_ARRAY || desc.type == VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D_ARRAY
+		|| desc.type == VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D_MS_ARRAY || desc.type == VG_TEXTURE_ATTACHMENT_VIEW_TYPE_3D;
+	const VkImageSubresourceRange range = {
+		.aspectMask = FormatAspectsToVk(FormatToVk(desc.format)),
+		.baseMipLevel = desc.type == VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D_MS || desc.type == VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D_MS_ARRAY ? 0 : desc.mip,
+		.levelCount = 1,
+		.baseArrayLayer = array ? desc.base_array_layer : 0,
+		.layerCount = array ? desc.array_layers : 1
+	};
+	const VkImageView view = CreateImageView(AttachmentViewTypeToVk(desc.type), desc.format, {}, range);
+
+	const VulkanAttachmentViewTable::Entry entry = {
+		.view = view,
+		.format = FormatToVk(desc.format),
+		.extent = { std::max(_desc.width >> range.baseMipLevel, 1u), std::max(_desc.height >> range.baseMipLevel, 1u) },
+		.layers = range.layerCount
+	};
+	const bool depthStencil = FormatIsDepthStencil(desc.format);
+	auto& table = depthStencil ? _device->DepthStencilAttachmentViews() : _device->ColorAttachmentViews();
+	const uint32_t index = table.Add(entry);
+	_attachmentViews.push_back({ depthStencil, index, view });
+	return index;
+}
+
+constexpr VkComponentSwizzle ComponentMappingToVk(VgComponentMapping mapping)
+{
+	switch (mapping)
+	{
+	case VG_COMPONENT_MAPPING_ZERO: return VK_COMPONENT_SWIZZLE_ZERO;
+	case VG_COMPONENT_MAPPING_ONE: return VK_COMPONENT_SWIZZLE_ONE;
+	case VG_COMPONENT_MAPPING_R: return VK_COMPONENT_SWIZZLE_R;
+	case VG_COMPONENT_MAPPING_G: return VK_COMPONENT_SWIZZLE_G;
+	case VG_COMPONENT_MAPPING_B: return VK_COMPONENT_SWIZZLE_B;
+	case VG_COMPONENT_MAPPING_A: return VK_COMPONENT_SWIZZLE_A;
+	default: return VK_COMPONENT_SWIZZLE_IDENTITY;
+	}
+}
+
+constexpr VkImageViewType ViewTypeToVk(VgTextureViewType type)
+{
+	switch (type)
+	{
+	case VG_TEXTURE_VIEW_TYPE_1D: return VK_IMAGE_VIEW_TYPE_1D;
+	case VG_TEXTURE_VIEW_TYPE_1D_ARRAY: return VK_IMAGE_VIEW_TYPE_1D_ARRAY;
+	case VG_TEXTURE_VIEW_TYPE_2D_ARRAY:
+	case VG_TEXTURE_VIEW_TYPE_2D_MS_ARRAY: return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+	case VG_TEXTURE_VIEW_TYPE_3D: return VK_IMAGE_VIEW_TYPE_3D;
+	case VG_TEXTURE_VIEW_TYPE_CUBE: return VK_IMAGE_VIEW_TYPE_CUBE;
+	case VG_TEXTURE_VIEW_TYPE_CUBE_ARRAY: return VK_IMAGE_VIEW_TYPE_CUBE_ARRAY;
+	default: return VK_IMAGE_VIEW_TYPE_2D;
+	}
+}
+
+uint32_t VulkanTexture::CreateView(const VgTextureViewDesc& desc)
+{
+	// Like on D3D12 the layers of non-array views are ignored
+	uint32_t baseLayer = 0;
+	uint32_t layers = 1;
+	switch (desc.type)
+	{
+	case VG_TEXTURE_VIEW_TYPE_1D_ARRAY:
+	case VG_TEXTURE_VIEW_TYPE_2D_ARRAY:
+	case VG_TEXTURE_VIEW_TYPE_2D_MS_ARRAY:
+	case VG_TEXTURE_VIEW_TYPE_CUBE_ARRAY:
+		baseLayer = desc.base_array_layer;
+		layers = desc.array_layers;
+		break;
+	case VG_TEXTURE_VIEW_TYPE_CUBE:
+		layers = 6;
+		break;
+	}
+
+	// Shader views see a single aspect, the stencil formats select the stencil of depth stencil textures
+	VkImageAspectFlags aspect = FormatAspectsToVk(FormatToVk(desc.format));
+	if (desc.format == VG_FORMAT_X24_TYPELESS_G8_UINT || desc.format == VG_FORMAT_X32_TYPELESS_G8X24_UINT) aspect = VK_IMAGE_ASPECT_STENCIL_BIT;
+	else if (aspect & VK_IMAGE_ASPECT_DEPTH_BIT) aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+	const bool multisampled = desc.type == VG_TEXTURE_VIEW_TYPE_2D_MS || desc.type == VG_TEXTURE_VIEW_TYPE_2D_MS_ARRAY;
+	const bool unorderedAccess = desc.descriptor_type == VG_TEXTURE_DESCRIPTOR_TYPE_UAV;
+	const VkImageSubresourceRange range = {
+		.aspectMask = aspect,
+		.baseMipLevel = multisampled ? 0 : desc.base_mip_level,
+		// Unordered access views cover a single mip like on D3D12
+		.levelCount = multisampled || unorderedAccess ? 1 : desc.mip_levels,
+		.baseArrayLayer = baseLayer,
+		.layerCount = layers
+	};
+	const VkComponentMapping components = {
+		.r = ComponentMappingToVk(desc.components.r),
+		.g = ComponentMappingToVk(desc.components.g),
+		.b = ComponentMappingToVk(desc.components.b),
+		.a = ComponentMappingToVk(desc.components.a)
+	};
+	const VkImageView view = CreateImageView(ViewTypeToVk(desc.type), desc.format, unorderedAccess ? VkComponentMapping{} : components, range);
+
+	auto& descriptorManager = _device->DescriptorManager();
+	const uint32_t index = descriptorManager.ResourceSlots().Allocate();
+	if (unorderedAccess)
+		descriptorManager.WriteImage(index, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, view, VK_IMAGE_LAYOUT_GENERAL);
+	else
+		descriptorManager.WriteImage(index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	_views.push_back({ index, view });
+	return index;
+}
+
+void VulkanTexture::DestroyViews()
+{
+	const auto& fn = _device->Functions();
+
+	for (const auto& view : _attachmentViews)
+	{
+		(view.depthStencil ? _device->DepthStencilAttachmentViews() : _device->ColorAttachmentViews()).Remove(view.index);
+		fn.vkDestroyImageView(_device->Device(), view.view, _device->AllocationCallbacks());
+	}
+	_attachmentViews.clear();
+
+	for (const auto& view : _views)
+	{
+		_device->DescriptorManager().ResourceSlots().Free(view.index);
+		fn.vkDestroyImageView(_device->Device(), view.view, _device->AllocationCallbacks());
+	}
+	_views.clear();
+}
+
+// Views of typeless textures may use any format of the same size like on D3D12, which needs VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT
+constexpr bool FormatIsTypeless(VgFormat format)
+{
+	switch (format)
+	{
+	case VG_FORMAT_R32G32B32A32_TYPELESS:
+	case VG_FORMAT_R32G32B32_TYPELESS:
+	case VG_FORMAT_R16G16B16A16_TYPELESS:
+	case VG_FORMAT_R32G32_TYPELESS:
+	case VG_FORMAT_R32G8X24_TYPELESS:
+	case VG_FORMAT_R10G10B10A2_TYPELESS:
+	case VG_FORMAT_R8G8B8A8_TYPELESS:
+	case VG_FORMAT_R16G16_TYPELESS:
+	case VG_FORMAT_R32_TYPELESS:
+	case VG_FORMAT_R24G8_TYPELESS:
+	case VG_FORMAT_R8G8_TYPELESS:
+	case VG_FORMAT_R16_TYPELESS:
+	case VG_FORMAT_R8_TYPELESS:
+	case VG_FORMAT_BC1_TYPELESS:
+	case VG_FORMAT_BC2_TYPELESS:
+	case VG_FORMAT_BC3_TYPELESS:
+	case VG_FORMAT_BC4_TYPELESS:
+	case VG_FORMAT_BC5_TYPELESS:
+	case VG_FORMAT_B8G8R8A8_TYPELESS:
+	case VG_FORMAT_B8G8R8X8_TYPELESS:
+	case VG_FORMAT_BC6H_TYPELESS:
+	case VG_FORMAT_BC7_TYPELESS:
+		return true;
+
+	default: return false;
+	}
+}
+
+constexpr VkImageType TextureTypeToVk(VgTextureType type)
+{
+	switch (type)
+	{
+	case VG_TEXTURE_TYPE_1D: return VK_IMAGE_TYPE_1D;
+	case VG_TEXTURE_TYPE_3D: return VK_IMAGE_TYPE_3D;
+	default: return VK_IMAGE_TYPE_2D;
+	}
+}
+
+VulkanTexture::VulkanTexture(VulkanDevice& device, const VgTextureDesc& desc) : _device(&device), _desc(desc)
+{
+	const bool is3D = desc.type == VG_TEXTURE_TYPE_3D;
+	const uint32_t layers = is3D ? 1 : desc.depth_or_array_layers;
+
+	VkImageCreateFlags flags = 0;
+	if (FormatIsTypeless(desc.format)) flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
+	if (desc.type == VG_TEXTURE_TYPE_2D && desc.width == desc.height && layers % 6 == 0) flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+	if (is3D && (desc.usage & VG_TEXTURE_USAGE_COLOR_ATTACHMENT)) flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
+
+	const auto& queueFamilies = device.QueueFamilies();
+	// Images can only be created undefined, desc.initial_layout is reached with the first barrier
+	const VkImageCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = flags,
+		.imageType = TextureTypeToVk(desc.type),
+		.format = FormatToVk(desc.format),
+		.extent = { desc.width, desc.type == VG_TEXTURE_TYPE_1D ? 1 : desc.height, is3D ? desc.depth_or_array_layers : 1 },
+		.mipLevels = desc.mip_levels,
+		.arrayLayers = layers,
+		.samples = static_cast<VkSampleCountFlagBits>(SampleCount(desc.sample_count)),
+		.tiling = desc.tiling == VG_TEXTURE_TILING_LINEAR ? VK_IMAGE_TILING_LINEAR : VK_IMAGE_TILING_OPTIMAL,
+		.usage = TextureUsageToVk(desc.usage),
+		.sharingMode = queueFamilies.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+		.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size()),
+		.pQueueFamilyIndices = queueFamilies.data(),
+		.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+	};
+	const VmaAllocationCreateInfo allocationCreateInfo = TextureAllocationToVk(desc);
+
+	VmaAllocationInfo allocationInfo;
+	VkThrowOnError(vmaCreateImage(device.Allocator(), &createInfo, &allocationCreateInfo, &_image, &_allocation, &allocationInfo));
+
+	_device->GetMemoryStatistics().used_vram += allocationInfo.size;
+	_device->GetMemoryStatistics().num_textures++;
+}
+
+#endif
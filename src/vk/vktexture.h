@@ -0,0 +1,53 @@
+#pragma once
+
+#include "vkdevice.h"
+
+#if VG_VULKAN_SUPPORTED
+
+class VulkanTexture final : public VgTexture_t
+{
+public:
+	~VulkanTexture();
+
+	void* GetApiObject() const override { return _image; }
+	void SetName(const char* name) override { _device->SetObjectName(VK_OBJECT_TYPE_IMAGE, _image, name); }
+	VulkanDevice* Device() const override { return _device; }
+	const VgTextureDesc& Desc() const override { return _desc; }
+	VkImage Image() const { return _image; }
+	bool OwnedBySwapChain() const override { return _allocation == VK_NULL_HANDLE; }
+
+	uint32_t CreateAttachmentView(const VgAttachmentViewDesc& desc) override;
+	uint32_t CreateView(const VgTextureViewDesc& desc) override;
+	void DestroyViews() override;
+
+private:
+	struct AttachmentView
+	{
+		bool depthStencil;
+		uint32_t index;
+		VkImageView view;
+	};
+
+	struct View
+	{
+		uint32_t index;
+		VkImageView view;
+	};
+
+	VulkanDevice* _device;
+	VgTextureDesc _desc;
+
+	VkImage _image;
+	VmaAllocation _allocation;
+
+	vg::Vector<AttachmentView> _attachmentViews;
+	vg::Vector<View> _views;
+
+	VkImageView CreateImageView(VkImageViewType type, VgFormat format, const VkComponentMapping& components,
+		const VkImageSubresourceRange& range);
+
+	friend VulkanDevice;
+	VulkanTexture(VulkanDevice& device, const VgTextureDesc& desc);
+};
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal assertions for the headless tests: failures are printed and counted, main() returns TestResult()
+inline int& NumFailedChecks()
+{
+	static int numFailed = 0;
+	return numFailed;
+}
+
+#define CHECK(condition) do { \
+	if (!(condition)) { \
+		std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+		NumFailedChecks()++; \
+	} \
+} while (false)
+
+#define CHECK_EQ(a, b) do { \
+	const auto _a = (a); \
+	const auto _b = (b); \
+	if (!(_a == _b)) { \
+		std::fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %llu != %llu\n", __FILE__, __LINE__, #a, #b, \
+			static_cast<unsigned long long>(_a), static_cast<unsigned long long>(_b)); \
+		NumFailedChecks()++; \
+	} \
+} while (false)
+
+inline int TestResult()
+{
+	if (NumFailedChecks() == 0)
+	{
+		std::printf("All checks passed\n");
+		return 0;
+	}
+	std::fprintf(stderr, "%d checks failed\n", NumFailedChecks());
+	return 1;
+}
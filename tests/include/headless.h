@@ -0,0 +1,62 @@
+#pragma once
+
+#include <varyag.h>
+#include <cstdio>
+#include <vector>
+
+// Tests and benchmarks run on a software Vulkan adapter like lavapipe, so they need neither a GPU nor a window
+
+inline VgAdapter FindSoftwareAdapter()
+{
+	uint32_t numAdapters = 0;
+	if (vgEnumerateAdapters(VG_GRAPHICS_API_VULKAN, nullptr, &numAdapters, nullptr) != VG_SUCCESS || numAdapters == 0) return nullptr;
+	std::vector<VgAdapter> adapters(numAdapters);
+	vgEnumerateAdapters(VG_GRAPHICS_API_VULKAN, nullptr, &numAdapters, adapters.data());
+	for (auto adapter : adapters)
+	{
+		VgAdapterProperties properties;
+		if (vgAdapterGetProperties(adapter, &properties) == VG_SUCCESS && properties.type == VG_ADAPTER_TYPE_SOFTWARE) return adapter;
+	}
+	return nullptr;
+}
+
+// Initializes varyag and creates a device on the software adapter, prints why and returns nullptr on failure
+inline VgDevice InitHeadless(const char* application_name, VgAdapter* out_adapter)
+{
+	VgConfig cfg = {};
+	cfg.application_name = application_name;
+	cfg.engine_name = "Varyag";
+	cfg.flags = VG_INIT_ENABLE_MESSAGE_CALLBACK;
+	cfg.message_callback = [](VgMessageSeverity severity, const char* msg)
+	{
+		if (severity != VG_MESSAGE_SEVERITY_DEBUG) std::fprintf(stderr, "VARYAG: (%d) %s\n", static_cast<int>(severity), msg);
+	};
+	if (vgInit(&cfg) != VG_SUCCESS)
+	{
+		std::fprintf(stderr, "Unable to initialize varyag\n");
+		return nullptr;
+	}
+
+	*out_adapter = FindSoftwareAdapter();
+	if (!*out_adapter)
+	{
+		std::fprintf(stderr, "No software Vulkan adapter found, install lavapipe (mesa-vulkan-drivers)\n");
+		vgShutdown();
+		return nullptr;
+	}
+
+	VgDevice device;
+	if (vgAdapterCreateDevice(*out_adapter, &device) != VG_SUCCESS)
+	{
+		std::fprintf(stderr, "Unable to create a device on the software adapter\n");
+		vgShutdown();
+		return nullptr;
+	}
+	return device;
+}
+
+inline void ShutdownHeadless(VgAdapter adapter, VgDevice device)
+{
+	vgAdapterDestroyDevice(adapter, device);
+	vgShutdown();
+}
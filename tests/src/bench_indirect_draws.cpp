@@ -0,0 +1,133 @@
+// CPU cost of recording one call of each native indirect draw, the lists are only recorded and never submitted since
+// Vulkan pipelines can't be created yet. Run with and without the vvalidation option to see what validation costs.
+#include "headless.h"
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+#include <cstdio>
+
+static constexpr uint32_t NumCallsPerList = 10'000;
+static constexpr uint32_t NumRepetitions = 20;
+// Calls cycle through this many argument slots so they don't all read the same offset
+static constexpr uint32_t NumArgumentSlots = 64;
+
+// Best time of NumRepetitions lists, each recording NumCallsPerList calls of record(cmd, slot) in one render pass
+template <class TRecord>
+static double MeasureNanosecondsPerCall(VgCommandPool pool, VgCommandList cmd, const VgRenderingInfo& renderingInfo, VgBuffer indexBuffer,
+	TRecord record)
+{
+	double best = DBL_MAX;
+	for (uint32_t repetition = 0; repetition < NumRepetitions; repetition++)
+	{
+		vgCommandPoolReset(pool);
+		vgCmdBegin(cmd);
+		vgCmdBeginRendering(cmd, &renderingInfo);
+		vgCmdSetIndexBuffer(cmd, VG_INDEX_TYPE_UINT32, 0, indexBuffer);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < NumCallsPerList; i++)
+		{
+			record(cmd, i % NumArgumentSlots);
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		vgCmdEndRendering(cmd);
+		vgCmdEnd(cmd);
+		best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / NumCallsPerList);
+	}
+	return best;
+}
+
+int main()
+{
+	VgAdapter adapter;
+	VgDevice device = InitHeadless("vgbench_indirect_draws", &adapter);
+	if (!device) return 1;
+
+	VgAdapterProperties properties;
+	vgAdapterGetProperties(adapter, &properties);
+	std::printf("Adapter: %s\n", properties.name);
+
+	// The count sits behind the arguments, the arguments are never read since nothing is submitted
+	constexpr uint32_t stride = sizeof(VgDrawIndexedIndirectCommand);
+	constexpr uint64_t countOffset = NumArgumentSlots * stride;
+	const VgBufferDesc argumentBufferDesc = { countOffset + sizeof(uint32_t), VG_BUFFER_USAGE_GENERAL, VG_HEAP_TYPE_GPU };
+	const VgBufferDesc indexBufferDesc = { 3 * sizeof(uint32_t), VG_BUFFER_USAGE_GENERAL, VG_HEAP_TYPE_GPU };
+	VgBuffer argumentBuffer, indexBuffer;
+	if (vgDeviceCreateBuffer(device, &argumentBufferDesc, &argumentBuffer) != VG_SUCCESS ||
+		vgDeviceCreateBuffer(device, &indexBufferDesc, &indexBuffer) != VG_SUCCESS)
+	{
+		std::fprintf(stderr, "Unable to create the buffers\n");
+		return 1;
+	}
+
+	VgTextureDesc targetDesc = {};
+	targetDesc.type = VG_TEXTURE_TYPE_2D;
+	targetDesc.format = VG_FORMAT_R8G8B8A8_UNORM;
+	targetDesc.width = 64;
+	targetDesc.height = 64;
+	targetDesc.depth_or_array_layers = 1;
+	targetDesc.mip_levels = 1;
+	targetDesc.sample_count = VG_SAMPLE_COUNT_1;
+	targetDesc.usage = VG_TEXTURE_USAGE_COLOR_ATTACHMENT;
+	targetDesc.tiling = VG_TEXTURE_TILING_OPTIMAL;
+	targetDesc.initial_layout = VG_TEXTURE_LAYOUT_COLOR_ATTACHMENT;
+	targetDesc.heap_type = VG_HEAP_TYPE_GPU;
+	VgTexture target;
+	const VgAttachmentViewDesc targetViewDesc = { VG_FORMAT_R8G8B8A8_UNORM, VG_TEXTURE_ATTACHMENT_VIEW_TYPE_2D, 0, 0, 1 };
+	VgAttachmentView targetView;
+	if (vgDeviceCreateTexture(device, &targetDesc, &target) != VG_SUCCESS ||
+		vgTextureCreateAttachmentView(target, &targetViewDesc, &targetView) != VG_SUCCESS)
+	{
+		std::fprintf(stderr, "Unable to create the render target\n");
+		return 1;
+	}
+
+	VgAttachmentInfo colorAttachment = {};
+	colorAttachment.view = targetView;
+	colorAttachment.view_layout = VG_TEXTURE_LAYOUT_COLOR_ATTACHMENT;
+	colorAttachment.resolve_view = VG_NO_VIEW;
+	colorAttachment.load_op = VG_ATTACHMENT_OP_DONT_CARE;
+	colorAttachment.store_op = VG_ATTACHMENT_OP_DONT_CARE;
+	VgRenderingInfo renderingInfo = {};
+	renderingInfo.num_color_attachments = 1;
+	renderingInfo.color_attachments = &colorAttachment;
+	renderingInfo.depth_stencil_attachment.view = VG_NO_VIEW;
+
+	VgCommandPool pool;
+	VgCommandList cmd;
+	if (vgDeviceCreateCommandPool(device, VG_COMMAND_POOL_FLAG_TRANSIENT, VG_QUEUE_GRAPHICS, &pool) != VG_SUCCESS ||
+		vgCommandPoolAllocateCommandList(pool, &cmd) != VG_SUCCESS)
+	{
+		std::fprintf(stderr, "Unable to create the command list\n");
+		return 1;
+	}
+
+	const auto measure = [&](const char* name, auto record)
+	{
+		std::printf("%-28s %8.1f ns/call\n", name, MeasureNanosecondsPerCall(pool, cmd, renderingInfo, indexBuffer, record));
+	};
+	measure("vgCmdDrawIndirect", [&](VgCommandList list, uint32_t slot)
+	{
+		vgCmdDrawIndirect(list, argumentBuffer, slot * stride, 1, stride);
+	});
+	measure("vgCmdDrawIndirectCount", [&](VgCommandList list, uint32_t slot)
+	{
+		vgCmdDrawIndirectCount(list, argumentBuffer, slot * stride, argumentBuffer, countOffset, 1, stride);
+	});
+	measure("vgCmdDrawIndexedIndirect", [&](VgCommandList list, uint32_t slot)
+	{
+		vgCmdDrawIndexedIndirect(list, argumentBuffer, slot * stride, 1, stride);
+	});
+	measure("vgCmdDrawIndexedIndirectCount", [&](VgCommandList list, uint32_t slot)
+	{
+		vgCmdDrawIndexedIndirectCount(list, argumentBuffer, slot * stride, argumentBuffer, countOffset, 1, stride);
+	});
+
+	vgDeviceDestroyCommandPool(device, pool);
+	vgDeviceDestroyTexture(device, target);
+	vgDeviceDestroyBuffer(device, indexBuffer);
+	vgDeviceDestroyBuffer(device, argumentBuffer);
+	ShutdownHeadless(adapter, device);
+	return 0;
+}
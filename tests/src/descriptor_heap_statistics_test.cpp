@@ -0,0 +1,105 @@
+// Creates and destroys buffer views to drive the DescriptorSlotAllocator of the resource heap and checks the
+// high-water mark, free list and churn counters reported by vgDeviceGetDescriptorHeapStatistics().
+#include "headless.h"
+#include "check.h"
+#include <array>
+
+static VgDescriptorHeapStatistics ResourceHeapStatistics(VgDevice device)
+{
+	VgDescriptorHeapStatistics stats{};
+	CHECK_EQ(vgDeviceGetDescriptorHeapStatistics(device, VG_DESCRIPTOR_HEAP_TYPE_RESOURCE, &stats), VG_SUCCESS);
+	CHECK_EQ(stats.live_descriptors, stats.total_allocations - stats.total_frees);
+	CHECK(stats.live_descriptors + stats.free_list_length == stats.high_water_mark);
+	CHECK(stats.high_water_mark <= stats.capacity);
+	return stats;
+}
+
+static void CreateViews(VgBuffer buffer, uint32_t count)
+{
+	const VgBufferViewDesc desc = {
+		.descriptor_type = VG_BUFFER_DESCRIPTOR_TYPE_SRV,
+		.view_type = VG_BUFFER_VIEW_TYPE_STRUCTURED_BUFFER,
+		.format = VG_FORMAT_UNKNOWN,
+		.offset = 0,
+		.size = VG_WHOLE_SIZE,
+		.element_size = sizeof(uint32_t)
+	};
+	for (uint32_t i = 0; i < count; i++)
+	{
+		VgView view;
+		CHECK_EQ(vgBufferCreateView(buffer, &desc, &view), VG_SUCCESS);
+	}
+}
+
+int main()
+{
+	VgAdapter adapter;
+	VgDevice device = InitHeadless("vgtest_descriptor_heap_statistics", &adapter);
+	if (!device) return 1;
+
+	std::array<VgBuffer, 3> buffers;
+	for (auto& buffer : buffers)
+	{
+		const VgBufferDesc desc = { 4096, VG_BUFFER_USAGE_GENERAL, VG_HEAP_TYPE_GPU };
+		CHECK_EQ(vgDeviceCreateBuffer(device, &desc, &buffer), VG_SUCCESS);
+	}
+
+	// The device may already hold descriptors of its own, everything below is relative to this
+	const VgDescriptorHeapStatistics base = ResourceHeapStatistics(device);
+	CHECK(base.capacity > 0);
+
+	// Fresh slots are taken from the free list first, then bumped from the high-water mark
+	CreateViews(buffers[0], 4);
+	CreateViews(buffers[1], 4);
+	const uint32_t bumped = base.free_list_length < 8 ? 8 - base.free_list_length : 0;
+	VgDescriptorHeapStatistics stats = ResourceHeapStatistics(device);
+	CHECK_EQ(stats.live_descriptors, base.live_descriptors + 8);
+	CHECK_EQ(stats.high_water_mark, base.high_water_mark + bumped);
+	CHECK_EQ(stats.free_list_length, base.free_list_length + bumped - 8);
+	CHECK_EQ(stats.total_allocations, base.total_allocations + 8);
+	CHECK_EQ(stats.total_frees, base.total_frees);
+	const uint32_t highWaterMark = stats.high_water_mark;
+
+	// Freeing leaves holes below the high-water mark
+	vgBufferDestroyViews(buffers[0]);
+	stats = ResourceHeapStatistics(device);
+	CHECK_EQ(stats.live_descriptors, base.live_descriptors + 4);
+	CHECK_EQ(stats.high_water_mark, highWaterMark);
+	CHECK_EQ(stats.free_list_length, base.free_list_length + bumped - 4);
+	CHECK_EQ(stats.total_frees, base.total_frees + 4);
+
+	// Reallocating reuses the holes without moving the high-water mark
+	CreateViews(buffers[2], 2);
+	stats = ResourceHeapStatistics(device);
+	CHECK_EQ(stats.live_descriptors, base.live_descriptors + 6);
+	CHECK_EQ(stats.high_water_mark, highWaterMark);
+	CHECK_EQ(stats.free_list_length, base.free_list_length + bumped - 6);
+	CHECK_EQ(stats.total_allocations, base.total_allocations + 10);
+
+	// Once the holes are used up the high-water mark grows again
+	const uint32_t holes = stats.free_list_length;
+	CreateViews(buffers[0], holes + 3);
+	stats = ResourceHeapStatistics(device);
+	CHECK_EQ(stats.free_list_length, 0u);
+	CHECK_EQ(stats.high_water_mark, highWaterMark + 3);
+	CHECK_EQ(stats.total_allocations, base.total_allocations + 10 + holes + 3);
+
+	// Churn keeps counting while the live count returns to where it started
+	for (auto buffer : buffers)
+	{
+		vgDeviceDestroyBuffer(device, buffer);
+	}
+	stats = ResourceHeapStatistics(device);
+	CHECK_EQ(stats.live_descriptors, base.live_descriptors);
+	CHECK_EQ(stats.high_water_mark, highWaterMark + 3);
+	CHECK_EQ(stats.total_allocations - base.total_allocations, stats.total_frees - base.total_frees);
+
+	VgDescriptorHeapStatistics samplerStats{};
+	CHECK_EQ(vgDeviceGetDescriptorHeapStatistics(device, VG_DESCRIPTOR_HEAP_TYPE_SAMPLER, &samplerStats), VG_SUCCESS);
+	CHECK(samplerStats.capacity > 0);
+	// Vulkan attachments do not use descriptors
+	CHECK_EQ(vgDeviceGetDescriptorHeapStatistics(device, VG_DESCRIPTOR_HEAP_TYPE_RENDER_TARGET, &samplerStats), VG_API_UNSUPPORTED);
+
+	ShutdownHeadless(adapter, device);
+	return TestResult();
+}
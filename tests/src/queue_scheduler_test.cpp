@@ -0,0 +1,143 @@
+// Schedules a transfer -> compute -> graphics chain through vgDeviceScheduleCommandLists(). Each submit copies the
+// buffer written by the one it depends on, so the data only arrives in the readback buffer if the waits were honored.
+#include "headless.h"
+#include "check.h"
+#include <array>
+#include <cstring>
+
+static constexpr uint32_t NumValues = 1024;
+static constexpr uint64_t BufferSize = NumValues * sizeof(uint32_t);
+
+struct QueueLists
+{
+	VgCommandPool pool;
+	VgCommandList cmd;
+};
+
+static VgBuffer CreateBuffer(VgDevice device, VgHeapType heapType)
+{
+	const VgBufferDesc desc = { BufferSize, VG_BUFFER_USAGE_GENERAL, heapType };
+	VgBuffer buffer = nullptr;
+	CHECK_EQ(vgDeviceCreateBuffer(device, &desc, &buffer), VG_SUCCESS);
+	return buffer;
+}
+
+static VgCommandList RecordCopy(const QueueLists& lists, VgBuffer dst, VgBuffer src)
+{
+	vgCommandPoolReset(lists.pool);
+	vgCmdBegin(lists.cmd);
+	vgCmdCopyBufferToBuffer(lists.cmd, dst, 0, src, 0, BufferSize);
+	vgCmdEnd(lists.cmd);
+	return lists.cmd;
+}
+
+static uint64_t FenceValue(VgDevice device, VgQueueScheduler scheduler, const VgSyncPoint& syncPoint)
+{
+	VgFenceOperation fence;
+	CHECK_EQ(vgDeviceGetSyncPointFence(device, scheduler, &syncPoint, &fence), VG_SUCCESS);
+	uint64_t value = 0;
+	CHECK_EQ(vgDeviceGetFenceValue(device, fence.fence, &value), VG_SUCCESS);
+	return value;
+}
+
+static void WaitSyncPoint(VgDevice device, VgQueueScheduler scheduler, const VgSyncPoint& syncPoint)
+{
+	VgFenceOperation fence;
+	CHECK_EQ(vgDeviceGetSyncPointFence(device, scheduler, &syncPoint, &fence), VG_SUCCESS);
+	vgDeviceWaitFence(device, fence.fence, fence.value);
+}
+
+int main()
+{
+	VgAdapter adapter;
+	VgDevice device = InitHeadless("vgtest_queue_scheduler", &adapter);
+	if (!device) return 1;
+
+	VgQueueScheduler scheduler;
+	CHECK_EQ(vgDeviceCreateQueueScheduler(device, &scheduler), VG_SUCCESS);
+
+	std::array<QueueLists, 3> lists;
+	for (VgQueue queue : { VG_QUEUE_GRAPHICS, VG_QUEUE_COMPUTE, VG_QUEUE_TRANSFER })
+	{
+		CHECK_EQ(vgDeviceCreateCommandPool(device, VG_COMMAND_POOL_FLAG_NONE, queue, &lists[queue].pool), VG_SUCCESS);
+		CHECK_EQ(vgCommandPoolAllocateCommandList(lists[queue].pool, &lists[queue].cmd), VG_SUCCESS);
+	}
+
+	VgBuffer upload = CreateBuffer(device, VG_HEAP_TYPE_UPLOAD);
+	VgBuffer first = CreateBuffer(device, VG_HEAP_TYPE_GPU);
+	VgBuffer second = CreateBuffer(device, VG_HEAP_TYPE_GPU);
+	VgBuffer readback = CreateBuffer(device, VG_HEAP_TYPE_READBACK);
+
+	for (uint64_t round = 1; round <= 3; round++)
+	{
+		uint32_t* uploadData;
+		CHECK_EQ(vgBufferMap(upload, reinterpret_cast<void**>(&uploadData)), VG_SUCCESS);
+		for (uint32_t i = 0; i < NumValues; i++)
+		{
+			uploadData[i] = static_cast<uint32_t>(round * NumValues + i);
+		}
+		vgBufferUnmap(upload);
+
+		// Every queue signals its own timeline once per submit, so the values count the rounds
+		VgCommandList cmd = RecordCopy(lists[VG_QUEUE_TRANSFER], first, upload);
+		VgSyncPoint transferDone;
+		CHECK_EQ(vgDeviceScheduleCommandLists(device, scheduler, 1, &cmd, 0, nullptr, &transferDone), VG_SUCCESS);
+		CHECK_EQ(transferDone.queue, VG_QUEUE_TRANSFER);
+		CHECK_EQ(transferDone.value, round);
+
+		cmd = RecordCopy(lists[VG_QUEUE_COMPUTE], second, first);
+		VgSyncPoint computeDone;
+		CHECK_EQ(vgDeviceScheduleCommandLists(device, scheduler, 1, &cmd, 1, &transferDone, &computeDone), VG_SUCCESS);
+		CHECK_EQ(computeDone.queue, VG_QUEUE_COMPUTE);
+		CHECK_EQ(computeDone.value, round);
+
+		// Waiting for both is redundant, the scheduler has to reduce it to the latest value per queue
+		const std::array graphicsDependencies = { transferDone, computeDone };
+		cmd = RecordCopy(lists[VG_QUEUE_GRAPHICS], readback, second);
+		VgSyncPoint graphicsDone;
+		CHECK_EQ(vgDeviceScheduleCommandLists(device, scheduler, 1, &cmd, static_cast<uint32_t>(graphicsDependencies.size()),
+			graphicsDependencies.data(), &graphicsDone), VG_SUCCESS);
+		CHECK_EQ(graphicsDone.queue, VG_QUEUE_GRAPHICS);
+		CHECK_EQ(graphicsDone.value, round);
+
+		WaitSyncPoint(device, scheduler, graphicsDone);
+		CHECK(FenceValue(device, scheduler, graphicsDone) >= round);
+		// The graphics submit waited for the others, so their fences must have been signaled before
+		CHECK(FenceValue(device, scheduler, computeDone) >= round);
+		CHECK(FenceValue(device, scheduler, transferDone) >= round);
+
+		uint32_t* readbackData;
+		CHECK_EQ(vgBufferMap(readback, reinterpret_cast<void**>(&readbackData)), VG_SUCCESS);
+		for (uint32_t i = 0; i < NumValues; i++)
+		{
+			if (readbackData[i] != round * NumValues + i)
+			{
+				CHECK_EQ(readbackData[i], round * NumValues + i);
+				break;
+			}
+		}
+		vgBufferUnmap(readback);
+	}
+
+	// Sync points which were not handed out yet can't be waited for, value 0 is always complete
+	VgCommandList cmd = RecordCopy(lists[VG_QUEUE_GRAPHICS], readback, second);
+	const VgSyncPoint future = { VG_QUEUE_COMPUTE, 100 };
+	VgSyncPoint syncPoint;
+	CHECK(vgDeviceScheduleCommandLists(device, scheduler, 1, &cmd, 1, &future, &syncPoint) != VG_SUCCESS);
+	const VgSyncPoint initial = { VG_QUEUE_COMPUTE, 0 };
+	CHECK_EQ(vgDeviceScheduleCommandLists(device, scheduler, 1, &cmd, 1, &initial, &syncPoint), VG_SUCCESS);
+	CHECK_EQ(syncPoint.value, 4u);
+	WaitSyncPoint(device, scheduler, syncPoint);
+
+	vgDeviceDestroyQueueScheduler(device, scheduler);
+	for (const auto& queueLists : lists)
+	{
+		vgDeviceDestroyCommandPool(device, queueLists.pool);
+	}
+	for (VgBuffer buffer : { upload, first, second, readback })
+	{
+		vgDeviceDestroyBuffer(device, buffer);
+	}
+	ShutdownHeadless(adapter, device);
+	return TestResult();
+}
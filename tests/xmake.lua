@@ -0,0 +1,36 @@
+-- Headless targets running on a software Vulkan adapter (lavapipe), see include/headless.h
+
+target("vgbench_indirect_draws")
+    set_kind("binary")
+    set_languages("cxx20")
+
+    add_includedirs("include")
+    add_headerfiles("include/**.h")
+    add_files("src/bench_indirect_draws.cpp")
+    add_deps("varyag")
+
+    set_symbols("debug")
+
+target("vgtest_queue_scheduler")
+    set_kind("binary")
+    set_languages("cxx20")
+
+    add_includedirs("include")
+    add_headerfiles("include/**.h")
+    add_files("src/queue_scheduler_test.cpp")
+    add_deps("varyag")
+    add_tests("default")
+
+    set_symbols("debug")
+
+target("vgtest_descriptor_heap_statistics")
+    set_kind("binary")
+    set_languages("cxx20")
+
+    add_includedirs("include")
+    add_headerfiles("include/**.h")
+    add_files("src/descriptor_heap_statistics_test.cpp")
+    add_deps("varyag")
+    add_tests("default")
+
+    set_symbols("debug")
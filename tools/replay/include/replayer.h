@@ -0,0 +1,143 @@
+#pragma once
+
+#include <varyag.h>
+#include <varyag_capture.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ReplayOptions
+{
+	// VG_GRAPHICS_API_AUTO replays on the API the capture was recorded with
+	VgGraphicsApi api = VG_GRAPHICS_API_AUTO;
+	uint32_t adapterIndex = 0;
+	// Waits for the device to go idle on every present, so frame times include all GPU work of the frame
+	bool syncFrames = false;
+	bool printFrames = true;
+};
+
+// Reads the arguments of one record in the order they were written by the capture layer
+class PayloadReader
+{
+public:
+	explicit PayloadReader(std::span<const uint8_t> payload) : _payload(payload) {}
+
+	template <class T>
+	T Get()
+	{
+		T value;
+		std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	uint64_t GetId() { return Get<uint64_t>(); }
+
+	std::string GetString()
+	{
+		const auto length = Get<uint32_t>();
+		return std::string(reinterpret_cast<const char*>(Take(length)), length);
+	}
+
+	std::span<const uint8_t> GetBlob()
+	{
+		const auto size = Get<uint32_t>();
+		return { Take(size), size };
+	}
+
+	template <class T>
+	std::vector<T> GetArray()
+	{
+		std::vector<T> array(Get<uint32_t>());
+		for (auto& element : array) element = Get<T>();
+		return array;
+	}
+
+private:
+	std::span<const uint8_t> _payload;
+	size_t _offset{ 0 };
+
+	const uint8_t* Take(size_t size)
+	{
+		if (_offset + size > _payload.size()) throw std::runtime_error("record payload is truncated");
+		const auto* data = _payload.data() + _offset;
+		_offset += size;
+		return data;
+	}
+};
+
+// Re-executes a capture written with VG_INIT_ENABLE_CAPTURE on a freshly created device.
+// Swap chains are replaced by offscreen textures, presents only mark frame boundaries.
+class Replayer
+{
+public:
+	explicit Replayer(const ReplayOptions& options) : _options(options) {}
+
+	bool Run(const std::filesystem::path& path);
+	void PrintSummary() const;
+
+private:
+	struct SwapChain
+	{
+		VgDevice device;
+		std::vector<VgTexture> backBuffers;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	// Sampled at every present, the last sample is reported by PrintSummary()
+	struct DescriptorHeapUsage
+	{
+		bool sampled{ false };
+		VgDescriptorHeapStatistics last{};
+		uint64_t maxAllocationsPerFrame{ 0 };
+	};
+
+	ReplayOptions _options;
+	VgAdapter _adapter{ nullptr };
+	std::unordered_map<uint64_t, void*> _objects;
+	std::unordered_map<uint64_t, SwapChain> _swapChains;
+	std::unordered_map<uint64_t, void*> _mappedBuffers;
+	// Capture id of the ring buffer of each constant allocator
+	std::unordered_map<uint64_t, uint64_t> _constantAllocatorBuffers;
+	std::unordered_map<uint32_t, uint32_t> _views;
+	std::unordered_map<uint32_t, uint32_t> _attachmentViews;
+	bool _reportedViewMismatch{ false };
+
+	uint64_t _numRecords{ 0 };
+	Clock::time_point _frameStart;
+	std::vector<double> _frameTimes;
+	std::array<DescriptorHeapUsage, 4> _descriptorHeaps;
+	// Summed over all submitted command lists
+	VgCommandListStatistics _commandListStatistics{};
+
+	void Execute(VgCaptureOp op, PayloadReader& reader);
+	void Present(uint64_t swapChainId);
+	void SampleDescriptorHeaps(VgDevice device);
+	void AddCommandListStatistics(VgCommandList cmd);
+	VgDevice CreateDevice(VgGraphicsApi capturedApi, const std::string& capturedAdapter);
+
+	template <class T>
+	T Object(uint64_t id) const
+	{
+		if (id == 0) return nullptr;
+		auto it = _objects.find(id);
+		if (it == _objects.end()) throw std::runtime_error("record references unknown object " + std::to_string(id));
+		return static_cast<T>(it->second);
+	}
+
+	void AddObject(uint64_t id, void* object) { _objects[id] = object; }
+	void RemapView(std::unordered_map<uint32_t, uint32_t>& views, uint32_t captured, uint32_t replayed);
+	uint32_t View(const std::unordered_map<uint32_t, uint32_t>& views, uint32_t captured) const;
+
+	std::vector<VgFenceOperation> ReadFenceOperations(PayloadReader& reader) const;
+	VgReadbackRequest ReadReadbackRequest(PayloadReader& reader) const;
+	VgGraphicsPipelineDesc ReadGraphicsPipelineDesc(PayloadReader& reader, std::vector<VgVertexAttribute>& attributes) const;
+	VgMultiDrawRootConstants ReadMultiDrawRootConstants(PayloadReader& reader) const;
+};
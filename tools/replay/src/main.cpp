@@ -0,0 +1,76 @@
+#include "replayer.h"
+#include <iostream>
+#include <string_view>
+
+#if _WIN32
+extern "C" { __declspec(dllexport) extern const uint32_t D3D12SDKVersion = 614; }
+extern "C" { __declspec(dllexport) extern const char* D3D12SDKPath = ".\\D3D12\\"; }
+#endif
+
+static void PrintUsage()
+{
+	std::cerr << "usage: vgreplay <capture> [--api d3d12|vulkan] [--adapter <index>] [--sync] [--quiet]\n"
+		<< "  --api      replay on another API than the capture was recorded with\n"
+		<< "  --adapter  index of the adapter to replay on, as enumerated by vgEnumerateAdapters\n"
+		<< "  --sync     wait for the device to go idle on every present\n"
+		<< "  --quiet    only print the summary\n";
+}
+
+int main(int argc, char** argv)
+{
+	const char* path = nullptr;
+	ReplayOptions options;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		if (arg == "--api" && i + 1 < argc)
+		{
+			const std::string_view api = argv[++i];
+			if (api == "d3d12") options.api = VG_GRAPHICS_API_D3D12;
+			else if (api == "vulkan") options.api = VG_GRAPHICS_API_VULKAN;
+			else
+			{
+				PrintUsage();
+				return 1;
+			}
+		}
+		else if (arg == "--adapter" && i + 1 < argc) options.adapterIndex = std::stoul(argv[++i]);
+		else if (arg == "--sync") options.syncFrames = true;
+		else if (arg == "--quiet") options.printFrames = false;
+		else if (!path && !arg.starts_with("--")) path = argv[i];
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!path)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	VgConfig cfg = {};
+	cfg.application_name = "vgreplay";
+	cfg.engine_name = "Varyag";
+	cfg.flags = VG_INIT_ENABLE_MESSAGE_CALLBACK;
+	cfg.message_callback = [](VgMessageSeverity severity, const char* msg)
+	{
+		if (severity != VG_MESSAGE_SEVERITY_DEBUG) std::cerr << "VARYAG: (" << severity << ") " << msg << "\n";
+	};
+	if (vgInit(&cfg) != VG_SUCCESS)
+	{
+		std::cerr << "Unable to initialize varyag\n";
+		return 1;
+	}
+
+	bool success;
+	{
+		Replayer replayer(options);
+		success = replayer.Run(path);
+		replayer.PrintSummary();
+	}
+
+	vgShutdown();
+	return success ? 0 : 1;
+}
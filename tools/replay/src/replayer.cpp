@@ -0,0 +1,1181 @@
+#include "replayer.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+static const char* DescriptorHeapName(VgDescriptorHeapType type)
+{
+	switch (type)
+	{
+	case VG_DESCRIPTOR_HEAP_TYPE_RESOURCE: return "resource";
+	case VG_DESCRIPTOR_HEAP_TYPE_SAMPLER: return "sampler";
+	case VG_DESCRIPTOR_HEAP_TYPE_RENDER_TARGET: return "render target";
+	case VG_DESCRIPTOR_HEAP_TYPE_DEPTH_STENCIL: return "depth stencil";
+	default: return "[unknown]";
+	}
+}
+
+static const char* ApiName(VgGraphicsApi api)
+{
+	switch (api)
+	{
+	case VG_GRAPHICS_API_D3D12: return "D3D12";
+	case VG_GRAPHICS_API_VULKAN: return "Vulkan";
+	default: return "[unknown]";
+	}
+}
+
+bool Replayer::Run(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		std::cerr << "Unable to open " << path << "\n";
+		return false;
+	}
+
+	VgCaptureFileHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != VG_CAPTURE_MAGIC)
+	{
+		std::cerr << path << " is not a varyag capture\n";
+		return false;
+	}
+	if (header.version != VG_CAPTURE_VERSION || header.pointer_size != sizeof(void*))
+	{
+		std::cerr << path << ": capture version " << header.version << " (" << header.pointer_size * 8
+			<< "-bit) is not supported by this build, expected " << VG_CAPTURE_VERSION << " (" << sizeof(void*) * 8 << "-bit)\n";
+		return false;
+	}
+
+	std::vector<uint8_t> payload;
+	_frameStart = Clock::now();
+	while (true)
+	{
+		VgCaptureRecordHeader record;
+		if (!file.read(reinterpret_cast<char*>(&record), sizeof(record))) break;
+
+		payload.resize(record.size);
+		if (!file.read(reinterpret_cast<char*>(payload.data()), record.size))
+		{
+			std::cerr << "Capture ends with a truncated record, stopping\n";
+			break;
+		}
+
+		PayloadReader reader(payload);
+		try
+		{
+			Execute(record.op, reader);
+		}
+		catch (const std::exception& ex)
+		{
+			std::cerr << "Record " << _numRecords << " (op " << record.op << "): " << ex.what() << "\n";
+			return false;
+		}
+		_numRecords++;
+	}
+	return true;
+}
+
+void Replayer::PrintSummary() const
+{
+	std::cout << _numRecords << " records, " << _frameTimes.size() << " frames\n";
+	if (_frameTimes.empty()) return;
+
+	auto sorted = _frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+	const double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+	const auto percentile = [&](double p) { return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))]; };
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "frame time ms: avg " << total / sorted.size() << ", min " << sorted.front() << ", median " << percentile(0.5)
+		<< ", p95 " << percentile(0.95) << ", max " << sorted.back() << "\n";
+
+	for (size_t i = 0; i < _descriptorHeaps.size(); i++)
+	{
+		const auto& heap = _descriptorHeaps[i];
+		if (!heap.sampled) continue;
+		const auto& stats = heap.last;
+		std::cout << std::setprecision(1) << DescriptorHeapName(static_cast<VgDescriptorHeapType>(i)) << " descriptors: "
+			<< stats.live_descriptors << " live, peak " << stats.high_water_mark << " of " << stats.capacity
+			<< " (" << 100.0 * stats.high_water_mark / std::max(stats.capacity, 1u) << "%), " << stats.free_list_length
+			<< " on the free list, " << static_cast<double>(stats.total_allocations) / _frameTimes.size()
+			<< " allocations per frame (max " << heap.maxAllocationsPerFrame << ")\n";
+	}
+
+	if (_commandListStatistics.num_state_commands > 0)
+	{
+		std::cout << std::setprecision(1) << "state commands: " << _commandListStatistics.num_state_commands << " recorded, "
+			<< _commandListStatistics.num_filtered_state_commands << " filtered as redundant ("
+			<< 100.0 * _commandListStatistics.num_filtered_state_commands / _commandListStatistics.num_state_commands << "%)\n";
+	}
+}
+
+// Counted when the list is submitted, lists submitted several times without being recorded again count every time
+void Replayer::AddCommandListStatistics(VgCommandList cmd)
+{
+	VgCommandListStatistics statistics;
+	if (vgCommandListGetStatistics(cmd, &statistics) != VG_SUCCESS) return;
+	_commandListStatistics.num_state_commands += statistics.num_state_commands;
+	_commandListStatistics.num_filtered_state_commands += statistics.num_filtered_state_commands;
+}
+
+VgDevice Replayer::CreateDevice(VgGraphicsApi capturedApi, const std::string& capturedAdapter)
+{
+	const auto api = _options.api == VG_GRAPHICS_API_AUTO ? capturedApi : _options.api;
+	if (api != capturedApi)
+	{
+		std::cerr << "Replaying a " << ApiName(capturedApi) << " capture on " << ApiName(api)
+			<< ", shader modules are passed through unchanged\n";
+	}
+
+	uint32_t numAdapters = 0;
+	if (vgEnumerateAdapters(api, nullptr, &numAdapters, nullptr) != VG_SUCCESS || numAdapters == 0)
+	{
+		throw std::runtime_error(std::string("no adapters available for ") + ApiName(api));
+	}
+	std::vector<VgAdapter> adapters(numAdapters);
+	vgEnumerateAdapters(api, nullptr, &numAdapters, adapters.data());
+	if (_options.adapterIndex >= numAdapters)
+	{
+		throw std::runtime_error("adapter index " + std::to_string(_options.adapterIndex) + " is out of range, "
+			+ std::to_string(numAdapters) + " adapters available");
+	}
+	_adapter = adapters[_options.adapterIndex];
+
+	VgAdapterProperties properties;
+	vgAdapterGetProperties(_adapter, &properties);
+	std::cout << "Captured on " << ApiName(capturedApi) << " / " << capturedAdapter
+		<< ", replaying on " << ApiName(api) << " / " << properties.name << "\n";
+
+	VgDevice device;
+	if (vgAdapterCreateDevice(_adapter, &device) != VG_SUCCESS) throw std::runtime_error("unable to create device");
+	return device;
+}
+
+void Replayer::Present(uint64_t swapChainId)
+{
+	auto it = _swapChains.find(swapChainId);
+	if (it == _swapChains.end()) throw std::runtime_error("present on unknown swap chain");
+	if (_options.syncFrames) vgDeviceWaitIdle(it->second.device);
+
+	const auto now = Clock::now();
+	const double frameTime = std::chrono::duration<double, std::milli>(now - _frameStart).count();
+	_frameStart = now;
+	_frameTimes.push_back(frameTime);
+	SampleDescriptorHeaps(it->second.device);
+
+	if (_options.printFrames)
+	{
+		std::cout << "frame " << _frameTimes.size() - 1 << ": " << std::fixed << std::setprecision(3) << frameTime << " ms\n";
+	}
+}
+
+void Replayer::SampleDescriptorHeaps(VgDevice device)
+{
+	for (size_t i = 0; i < _descriptorHeaps.size(); i++)
+	{
+		VgDescriptorHeapStatistics stats;
+		if (vgDeviceGetDescriptorHeapStatistics(device, static_cast<VgDescriptorHeapType>(i), &stats) != VG_SUCCESS) continue;
+
+		auto& heap = _descriptorHeaps[i];
+		heap.maxAllocationsPerFrame = std::max(heap.maxAllocationsPerFrame, stats.total_allocations - heap.last.total_allocations);
+		heap.last = stats;
+		heap.sampled = true;
+	}
+}
+
+void Replayer::RemapView(std::unordered_map<uint32_t, uint32_t>& views, uint32_t captured, uint32_t replayed)
+{
+	views[captured] = replayed;
+	if (captured != replayed && !_reportedViewMismatch)
+	{
+		// Attachment views are remapped, but shaders may read view indices from buffers and root constants
+		std::cerr << "Warning: view index " << replayed << " differs from captured index " << captured
+			<< ", bindless accesses may read wrong descriptors\n";
+		_reportedViewMismatch = true;
+	}
+}
+
+uint32_t Replayer::View(const std::unordered_map<uint32_t, uint32_t>& views, uint32_t captured) const
+{
+	if (captured == VG_NO_VIEW) return VG_NO_VIEW;
+	auto it = views.find(captured);
+	return it != views.end() ? it->second : captured;
+}
+
+std::vector<VgFenceOperation> Replayer::ReadFenceOperations(PayloadReader& reader) const
+{
+	std::vector<VgFenceOperation> operations(reader.Get<uint32_t>());
+	for (auto& operation : operations)
+	{
+		operation.fence = Object<VgFence>(reader.GetId());
+		operation.value = reader.Get<uint64_t>();
+	}
+	return operations;
+}
+
+VgReadbackRequest Replayer::ReadReadbackRequest(PayloadReader& reader) const
+{
+	VgReadbackRequest request = {};
+	request.fence = Object<VgFence>(reader.GetId());
+	request.fence_value = reader.Get<uint64_t>();
+	// The results are not needed, but a callback keeps tickets released by vgDeviceProcessReadbacks() as captured
+	if (reader.Get<bool>()) request.callback = [](void*, VgReadbackTicket, const VgReadbackResult*) {};
+	return request;
+}
+
+// The vertex attributes of the description point into attributes
+VgGraphicsPipelineDesc Replayer::ReadGraphicsPipelineDesc(PayloadReader& reader, std::vector<VgVertexAttribute>& attributes) const
+{
+	VgGraphicsPipelineDesc desc = {};
+	desc.vertex_pipeline_type = reader.Get<VgVertexPipeline>();
+	if (desc.vertex_pipeline_type == VG_VERTEX_PIPELINE_FIXED_FUNCTION)
+	{
+		attributes = reader.GetArray<VgVertexAttribute>();
+		desc.fixed_function.num_vertex_attributes = static_cast<uint32_t>(attributes.size());
+		desc.fixed_function.vertex_attributes = attributes.data();
+		desc.fixed_function.vertex_shader = Object<VgShaderModule>(reader.GetId());
+		desc.fixed_function.hull_shader = Object<VgShaderModule>(reader.GetId());
+		desc.fixed_function.domain_shader = Object<VgShaderModule>(reader.GetId());
+		desc.fixed_function.geometry_shader = Object<VgShaderModule>(reader.GetId());
+	}
+	else
+	{
+		desc.mesh.amplification_shader = Object<VgShaderModule>(reader.GetId());
+		desc.mesh.mesh_shader = Object<VgShaderModule>(reader.GetId());
+	}
+	desc.pixel_shader = Object<VgShaderModule>(reader.GetId());
+	desc.primitive_topology = reader.Get<VgPrimitiveTopology>();
+	desc.primitive_restart_enable = reader.Get<bool>();
+	desc.tesselation_control_points = reader.Get<uint32_t>();
+	desc.rasterization_state = reader.Get<VgRasterizationState>();
+	desc.multisampling_state = reader.Get<VgMultisamplingState>();
+	desc.depth_stencil_state = reader.Get<VgDepthStencilState>();
+	const auto formats = reader.GetArray<VgFormat>();
+	desc.num_color_attachments = static_cast<uint32_t>(std::min<size_t>(formats.size(), vg_num_max_color_attachments));
+	std::copy_n(formats.begin(), desc.num_color_attachments, desc.color_attachment_formats);
+	desc.depth_stencil_format = reader.Get<VgFormat>();
+	desc.blend_state = reader.Get<VgBlendState>();
+	return desc;
+}
+
+// The values point into the payload of the record, which stays alive until the multi draw is recorded
+VgMultiDrawRootConstants Replayer::ReadMultiDrawRootConstants(PayloadReader& reader) const
+{
+	VgMultiDrawRootConstants rootConstants = {};
+	rootConstants.offset_in_32bit_values = reader.Get<uint32_t>();
+	rootConstants.num_32bit_values = reader.Get<uint32_t>();
+	rootConstants.stride = reader.Get<uint32_t>();
+	rootConstants.data = reader.GetBlob().data();
+	return rootConstants;
+}
+
+void Replayer::Execute(VgCaptureOp op, PayloadReader& r)
+{
+	switch (op)
+	{
+	case VG_CAPTURE_OP_ADAPTER_CREATE_DEVICE:
+	{
+		const auto api = r.Get<VgGraphicsApi>();
+		const auto adapterName = r.GetString();
+		AddObject(r.GetId(), CreateDevice(api, adapterName));
+		break;
+	}
+	case VG_CAPTURE_OP_ADAPTER_DESTROY_DEVICE:
+	{
+		const auto id = r.GetId();
+		vgAdapterDestroyDevice(_adapter, Object<VgDevice>(id));
+		_objects.erase(id);
+		break;
+	}
+
+	case VG_CAPTURE_OP_DEVICE_WAIT_QUEUE_IDLE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		vgDeviceWaitQueueIdle(device, r.Get<VgQueue>());
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_WAIT_IDLE:
+		vgDeviceWaitIdle(Object<VgDevice>(r.GetId()));
+		break;
+	case VG_CAPTURE_OP_DEVICE_CREATE_BUFFER:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto desc = r.Get<VgBufferDesc>();
+		VgBuffer buffer;
+		if (vgDeviceCreateBuffer(device, &desc, &buffer) != VG_SUCCESS) throw std::runtime_error("unable to create buffer");
+		AddObject(r.GetId(), buffer);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_BUFFER:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyBuffer(device, Object<VgBuffer>(id));
+		_mappedBuffers.erase(id);
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_SHADER_MODULE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto code = r.GetBlob();
+		VgShaderModule module;
+		if (vgDeviceCreateShaderModule(device, code.data(), code.size(), &module) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to create shader module");
+		}
+		AddObject(r.GetId(), module);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_SHADER_MODULE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyShaderModule(device, Object<VgShaderModule>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_GRAPHICS_PIPELINE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		std::vector<VgVertexAttribute> attributes;
+		const auto desc = ReadGraphicsPipelineDesc(r, attributes);
+
+		VgPipeline pipeline;
+		if (vgDeviceCreateGraphicsPipeline(device, &desc, &pipeline) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to create graphics pipeline");
+		}
+		AddObject(r.GetId(), pipeline);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_GRAPHICS_PIPELINE_LIBRARY:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto parts = r.Get<VgGraphicsPipelineLibraryFlags>();
+		std::vector<VgVertexAttribute> attributes;
+		const auto desc = ReadGraphicsPipelineDesc(r, attributes);
+
+		VgPipeline library;
+		if (vgDeviceCreateGraphicsPipelineLibrary(device, parts, &desc, &library) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to create graphics pipeline library");
+		}
+		AddObject(r.GetId(), library);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_LINK_GRAPHICS_PIPELINE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		std::vector<VgPipeline> libraries(r.Get<uint32_t>());
+		for (auto& library : libraries) library = Object<VgPipeline>(r.GetId());
+
+		VgPipeline pipeline;
+		if (vgDeviceLinkGraphicsPipeline(device, static_cast<uint32_t>(libraries.size()), libraries.data(), &pipeline) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to link graphics pipeline");
+		}
+		AddObject(r.GetId(), pipeline);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_COMPUTE_PIPELINE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		auto module = Object<VgShaderModule>(r.GetId());
+		VgPipeline pipeline;
+		if (vgDeviceCreateComputePipeline(device, module, &pipeline) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to create compute pipeline");
+		}
+		AddObject(r.GetId(), pipeline);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_PIPELINE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyPipeline(device, Object<VgPipeline>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_FENCE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto initialValue = r.Get<uint64_t>();
+		VgFence fence;
+		if (vgDeviceCreateFence(device, initialValue, &fence) != VG_SUCCESS) throw std::runtime_error("unable to create fence");
+		AddObject(r.GetId(), fence);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_FENCE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyFence(device, Object<VgFence>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_COMMAND_POOL:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto flags = r.Get<VgCommandPoolFlags>();
+		const auto queue = r.Get<VgQueue>();
+		VgCommandPool pool;
+		if (vgDeviceCreateCommandPool(device, flags, queue, &pool) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to create command pool");
+		}
+		AddObject(r.GetId(), pool);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_COMMAND_POOL:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyCommandPool(device, Object<VgCommandPool>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_SAMPLER:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto desc = r.Get<VgSamplerDesc>();
+		VgSampler sampler;
+		if (vgDeviceCreateSampler(device, &desc, &sampler) != VG_SUCCESS) throw std::runtime_error("unable to create sampler");
+		AddObject(r.GetId(), sampler);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_SAMPLER:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroySampler(device, Object<VgSampler>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_TEXTURE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto desc = r.Get<VgTextureDesc>();
+		VgTexture texture;
+		if (vgDeviceCreateTexture(device, &desc, &texture) != VG_SUCCESS) throw std::runtime_error("unable to create texture");
+		AddObject(r.GetId(), texture);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_TEXTURE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyTexture(device, Object<VgTexture>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_SUBMIT_COMMAND_LISTS:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto numSubmits = r.Get<uint32_t>();
+
+		std::vector<VgSubmitInfo> submits(numSubmits);
+		std::vector<std::vector<VgFenceOperation>> fenceOperations;
+		std::vector<std::vector<VgCommandList>> commandLists;
+		fenceOperations.reserve(numSubmits * 2);
+		commandLists.reserve(numSubmits);
+		for (auto& submit : submits)
+		{
+			const auto& waits = fenceOperations.emplace_back(ReadFenceOperations(r));
+			const auto& signals = fenceOperations.emplace_back(ReadFenceOperations(r));
+			auto& lists = commandLists.emplace_back(r.Get<uint32_t>());
+			for (auto& list : lists)
+			{
+				list = Object<VgCommandList>(r.GetId());
+				AddCommandListStatistics(list);
+			}
+
+			submit.num_wait_fences = static_cast<uint32_t>(waits.size());
+			submit.wait_fences = const_cast<VgFenceOperation*>(waits.data());
+			submit.num_signal_fences = static_cast<uint32_t>(signals.size());
+			submit.signal_fences = const_cast<VgFenceOperation*>(signals.data());
+			submit.num_command_lists = static_cast<uint32_t>(lists.size());
+			submit.command_lists = lists.data();
+		}
+		vgDeviceSubmitCommandLists(device, numSubmits, submits.data());
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_SIGNAL_FENCE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		auto fence = Object<VgFence>(r.GetId());
+		vgDeviceSignalFence(device, fence, r.Get<uint64_t>());
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_WAIT_FENCE:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		auto fence = Object<VgFence>(r.GetId());
+		vgDeviceWaitFence(device, fence, r.Get<uint64_t>());
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_SWAP_CHAIN:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto width = r.Get<uint32_t>();
+		const auto height = r.Get<uint32_t>();
+		const auto format = r.Get<VgFormat>();
+		const auto bufferCount = r.Get<uint32_t>();
+
+		SwapChain swapChain = { device };
+		const VgTextureDesc desc = { VG_TEXTURE_TYPE_2D, format, width, height, 1, 1, VG_SAMPLE_COUNT_1,
+			VG_TEXTURE_USAGE_COLOR_ATTACHMENT, VG_TEXTURE_TILING_OPTIMAL, VG_TEXTURE_LAYOUT_PRESENT, VG_HEAP_TYPE_GPU };
+		for (uint32_t i = 0; i < bufferCount; i++)
+		{
+			VgTexture texture;
+			if (vgDeviceCreateTexture(device, &desc, &texture) != VG_SUCCESS)
+			{
+				throw std::runtime_error("unable to create offscreen back buffer");
+			}
+			swapChain.backBuffers.push_back(texture);
+		}
+		_swapChains[r.GetId()] = std::move(swapChain);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_SWAP_CHAIN:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		auto it = _swapChains.find(r.GetId());
+		if (it == _swapChains.end()) break;
+		for (auto texture : it->second.backBuffers)
+		{
+			vgDeviceDestroyTexture(device, texture);
+		}
+		_swapChains.erase(it);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_READBACK_POOL:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto size = r.Get<uint64_t>();
+		VgReadbackPool pool;
+		if (vgDeviceCreateReadbackPool(device, size, &pool) != VG_SUCCESS) throw std::runtime_error("unable to create readback pool");
+		AddObject(r.GetId(), pool);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_READBACK_POOL:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyReadbackPool(device, Object<VgReadbackPool>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_RELEASE_READBACK:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		auto pool = Object<VgReadbackPool>(r.GetId());
+		vgDeviceReleaseReadback(device, pool, r.Get<VgReadbackTicket>());
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_PROCESS_READBACKS:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		vgDeviceProcessReadbacks(device, Object<VgReadbackPool>(r.GetId()));
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_CREATE_CONSTANT_ALLOCATOR:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto size = r.Get<uint64_t>();
+		const auto id = r.GetId();
+		VgConstantAllocator allocator;
+		if (vgDeviceCreateConstantAllocator(device, size, &allocator) != VG_SUCCESS) throw std::runtime_error("unable to create constant allocator");
+		AddObject(id, allocator);
+		// The ring buffer is only reachable through an allocation, it is registered by the first one
+		_constantAllocatorBuffers[id] = r.GetId();
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_DESTROY_CONSTANT_ALLOCATOR:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		vgDeviceDestroyConstantAllocator(device, Object<VgConstantAllocator>(id));
+		const auto bufferId = _constantAllocatorBuffers[id];
+		_mappedBuffers.erase(bufferId);
+		_objects.erase(bufferId);
+		_constantAllocatorBuffers.erase(id);
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_ALLOCATE_CONSTANTS:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		const auto id = r.GetId();
+		const auto size = r.Get<uint64_t>();
+		const auto offset = r.Get<uint64_t>();
+		const auto captured = r.Get<uint32_t>();
+		VgConstantAllocation allocation;
+		if (vgDeviceAllocateConstants(device, Object<VgConstantAllocator>(id), size, &allocation) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to allocate constants");
+		}
+		// Frames are reclaimed as the fences of the replay complete, which may place the data elsewhere
+		if (allocation.offset != offset)
+		{
+			throw std::runtime_error("constant allocation offset differs from the capture");
+		}
+		const auto bufferId = _constantAllocatorBuffers[id];
+		if (!_mappedBuffers.contains(bufferId))
+		{
+			AddObject(bufferId, allocation.buffer);
+			_mappedBuffers[bufferId] = static_cast<uint8_t*>(allocation.data) - allocation.offset;
+		}
+		RemapView(_views, captured, allocation.view);
+		break;
+	}
+	case VG_CAPTURE_OP_DEVICE_END_CONSTANT_FRAME:
+	{
+		auto device = Object<VgDevice>(r.GetId());
+		auto allocator = Object<VgConstantAllocator>(r.GetId());
+		auto fence = Object<VgFence>(r.GetId());
+		vgDeviceEndConstantFrame(device, allocator, fence, r.Get<uint64_t>());
+		break;
+	}
+
+	case VG_CAPTURE_OP_COMMAND_POOL_SET_NAME:
+	{
+		auto pool = Object<VgCommandPool>(r.GetId());
+		vgCommandPoolSetName(pool, r.GetString().c_str());
+		break;
+	}
+	case VG_CAPTURE_OP_COMMAND_POOL_ALLOCATE_COMMAND_LIST:
+	{
+		auto pool = Object<VgCommandPool>(r.GetId());
+		VgCommandList cmd;
+		if (vgCommandPoolAllocateCommandList(pool, &cmd) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to allocate command list");
+		}
+		AddObject(r.GetId(), cmd);
+		break;
+	}
+	case VG_CAPTURE_OP_COMMAND_POOL_FREE_COMMAND_LIST:
+	{
+		auto pool = Object<VgCommandPool>(r.GetId());
+		const auto id = r.GetId();
+		vgCommandPoolFreeCommandList(pool, Object<VgCommandList>(id));
+		_objects.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_COMMAND_POOL_RESET:
+		vgCommandPoolReset(Object<VgCommandPool>(r.GetId()));
+		break;
+
+	case VG_CAPTURE_OP_COMMAND_LIST_SET_NAME:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		vgCommandListSetName(cmd, r.GetString().c_str());
+		break;
+	}
+	case VG_CAPTURE_OP_COMMAND_LIST_RESTORE_DESCRIPTOR_STATE:
+		vgCommandListRestoreDescriptorState(Object<VgCommandList>(r.GetId()));
+		break;
+
+	case VG_CAPTURE_OP_CMD_BEGIN:
+		vgCmdBegin(Object<VgCommandList>(r.GetId()));
+		break;
+	case VG_CAPTURE_OP_CMD_END:
+		vgCmdEnd(Object<VgCommandList>(r.GetId()));
+		break;
+	case VG_CAPTURE_OP_CMD_BEGIN_BUNDLE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		VgBundleInheritanceInfo info{};
+		const auto colorFormats = r.GetArray<VgFormat>();
+		if (colorFormats.size() > vg_num_max_color_attachments) throw std::runtime_error("bundle has too many color attachments");
+		info.num_color_attachments = static_cast<uint32_t>(colorFormats.size());
+		std::copy(colorFormats.begin(), colorFormats.end(), info.color_attachment_formats);
+		info.depth_stencil_format = r.Get<VgFormat>();
+		info.sample_count = r.Get<VgSampleCount>();
+		const auto viewports = r.GetArray<VgViewport>();
+		const auto scissors = r.GetArray<VgScissor>();
+		info.num_viewports = static_cast<uint32_t>(std::min(viewports.size(), scissors.size()));
+		info.viewports = viewports.data();
+		info.scissors = scissors.data();
+		vgCmdBeginBundle(cmd, &info);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_SET_VERTEX_BUFFERS:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto startSlot = r.Get<uint32_t>();
+		std::vector<VgVertexBufferView> views(r.Get<uint32_t>());
+		for (auto& view : views)
+		{
+			view.buffer = Object<VgBuffer>(r.GetId());
+			view.offset = r.Get<uint64_t>();
+			view.stride_in_bytes = r.Get<uint32_t>();
+		}
+		vgCmdSetVertexBuffers(cmd, startSlot, static_cast<uint32_t>(views.size()), views.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_SET_INDEX_BUFFER:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto indexType = r.Get<VgIndexType>();
+		const auto offset = r.Get<uint64_t>();
+		vgCmdSetIndexBuffer(cmd, indexType, offset, Object<VgBuffer>(r.GetId()));
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_SET_ROOT_CONSTANTS:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto pipelineType = r.Get<VgPipelineType>();
+		const auto offset = r.Get<uint32_t>();
+		const auto data = r.GetBlob();
+		vgCmdSetRootConstants(cmd, pipelineType, offset, static_cast<uint32_t>(data.size() / sizeof(uint32_t)), data.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_SET_PIPELINE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		vgCmdSetPipeline(cmd, Object<VgPipeline>(r.GetId()));
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_SET_GRAPHICS_STATE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto parts = r.Get<VgGraphicsPipelineLibraryFlags>();
+		std::vector<VgVertexAttribute> attributes;
+		const auto desc = ReadGraphicsPipelineDesc(r, attributes);
+		vgCmdSetGraphicsState(cmd, parts, &desc);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_BARRIER:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto memoryBarriers = r.GetArray<VgMemoryBarrier>();
+		std::vector<VgBufferBarrier> bufferBarriers(r.Get<uint32_t>());
+		for (auto& barrier : bufferBarriers)
+		{
+			barrier.src_stage = r.Get<VgPipelineStageFlags>();
+			barrier.src_access = r.Get<VgAccessFlags>();
+			barrier.dst_stage = r.Get<VgPipelineStageFlags>();
+			barrier.dst_access = r.Get<VgAccessFlags>();
+			barrier.buffer = Object<VgBuffer>(r.GetId());
+		}
+		std::vector<VgTextureBarrier> textureBarriers(r.Get<uint32_t>());
+		for (auto& barrier : textureBarriers)
+		{
+			barrier.src_stage = r.Get<VgPipelineStageFlags>();
+			barrier.src_access = r.Get<VgAccessFlags>();
+			barrier.dst_stage = r.Get<VgPipelineStageFlags>();
+			barrier.dst_access = r.Get<VgAccessFlags>();
+			barrier.old_layout = r.Get<VgTextureLayout>();
+			barrier.new_layout = r.Get<VgTextureLayout>();
+			barrier.texture = Object<VgTexture>(r.GetId());
+			barrier.subresource_range = r.Get<VgTextureSubresourceRange>();
+		}
+
+		const VgDependencyInfo dependencyInfo = {
+			static_cast<uint32_t>(memoryBarriers.size()), memoryBarriers.data(),
+			static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+			static_cast<uint32_t>(textureBarriers.size()), textureBarriers.data()
+		};
+		vgCmdBarrier(cmd, &dependencyInfo);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_TRANSITION:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		std::vector<VgBufferTransition> bufferTransitions(r.Get<uint32_t>());
+		for (auto& transition : bufferTransitions)
+		{
+			transition.stage = r.Get<VgPipelineStageFlags>();
+			transition.access = r.Get<VgAccessFlags>();
+			transition.buffer = Object<VgBuffer>(r.GetId());
+		}
+		std::vector<VgTextureTransition> textureTransitions(r.Get<uint32_t>());
+		for (auto& transition : textureTransitions)
+		{
+			transition.stage = r.Get<VgPipelineStageFlags>();
+			transition.access = r.Get<VgAccessFlags>();
+			transition.layout = r.Get<VgTextureLayout>();
+			transition.texture = Object<VgTexture>(r.GetId());
+			transition.subresource_range = r.Get<VgTextureSubresourceRange>();
+		}
+
+		const VgTransitionInfo transitionInfo = {
+			static_cast<uint32_t>(bufferTransitions.size()), bufferTransitions.data(),
+			static_cast<uint32_t>(textureTransitions.size()), textureTransitions.data()
+		};
+		vgCmdTransition(cmd, &transitionInfo);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_BEGIN_RENDERING:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto colorAttachments = r.GetArray<VgAttachmentInfo>();
+		auto depthStencilAttachment = r.Get<VgAttachmentInfo>();
+		const auto flags = r.Get<VgRenderingFlags>();
+		for (auto* attachment : { &depthStencilAttachment })
+		{
+			attachment->view = View(_attachmentViews, attachment->view);
+			attachment->resolve_view = View(_attachmentViews, attachment->resolve_view);
+		}
+		for (auto& attachment : colorAttachments)
+		{
+			attachment.view = View(_attachmentViews, attachment.view);
+			attachment.resolve_view = View(_attachmentViews, attachment.resolve_view);
+		}
+
+		const VgRenderingInfo info = {
+			static_cast<uint32_t>(colorAttachments.size()),
+			colorAttachments.empty() ? nullptr : colorAttachments.data(),
+			depthStencilAttachment,
+			flags
+		};
+		vgCmdBeginRendering(cmd, &info);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_END_RENDERING:
+		vgCmdEndRendering(Object<VgCommandList>(r.GetId()));
+		break;
+	case VG_CAPTURE_OP_CMD_SET_VIEWPORT:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto first = r.Get<uint32_t>();
+		auto viewports = r.GetArray<VgViewport>();
+		vgCmdSetViewport(cmd, first, static_cast<uint32_t>(viewports.size()), viewports.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_SET_SCISSOR:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto first = r.Get<uint32_t>();
+		auto scissors = r.GetArray<VgScissor>();
+		vgCmdSetScissor(cmd, first, static_cast<uint32_t>(scissors.size()), scissors.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_EXECUTE_BUNDLE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		vgCmdExecuteBundle(cmd, Object<VgCommandList>(r.GetId()));
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DRAW:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto args = r.Get<std::array<uint32_t, 4>>();
+		vgCmdDraw(cmd, args[0], args[1], args[2], args[3]);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DRAW_INDEXED:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto args = r.Get<std::array<uint32_t, 5>>();
+		vgCmdDrawIndexed(cmd, args[0], args[1], args[2], args[3], args[4]);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DRAW_MULTI:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto draws = r.GetArray<VgMultiDrawInfo>();
+		const auto args = r.Get<std::array<uint32_t, 2>>();
+		const auto rootConstants = ReadMultiDrawRootConstants(r);
+		vgCmdDrawMulti(cmd, static_cast<uint32_t>(draws.size()), draws.data(), args[0], args[1],
+			rootConstants.num_32bit_values > 0 ? &rootConstants : nullptr);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DRAW_INDEXED_MULTI:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto draws = r.GetArray<VgMultiDrawIndexedInfo>();
+		const auto args = r.Get<std::array<uint32_t, 2>>();
+		const auto rootConstants = ReadMultiDrawRootConstants(r);
+		vgCmdDrawIndexedMulti(cmd, static_cast<uint32_t>(draws.size()), draws.data(), args[0], args[1],
+			rootConstants.num_32bit_values > 0 ? &rootConstants : nullptr);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DISPATCH:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto groups = r.Get<std::array<uint32_t, 3>>();
+		vgCmdDispatch(cmd, groups[0], groups[1], groups[2]);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DRAW_INDIRECT:
+	case VG_CAPTURE_OP_CMD_DRAW_INDEXED_INDIRECT:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto buffer = Object<VgBuffer>(r.GetId());
+		const auto offset = r.Get<uint64_t>();
+		const auto drawCount = r.Get<uint32_t>();
+		const auto stride = r.Get<uint32_t>();
+		if (op == VG_CAPTURE_OP_CMD_DRAW_INDIRECT) vgCmdDrawIndirect(cmd, buffer, offset, drawCount, stride);
+		else vgCmdDrawIndexedIndirect(cmd, buffer, offset, drawCount, stride);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DRAW_INDIRECT_COUNT:
+	case VG_CAPTURE_OP_CMD_DRAW_INDEXED_INDIRECT_COUNT:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto buffer = Object<VgBuffer>(r.GetId());
+		const auto offset = r.Get<uint64_t>();
+		auto countBuffer = Object<VgBuffer>(r.GetId());
+		const auto countBufferOffset = r.Get<uint64_t>();
+		const auto maxDrawCount = r.Get<uint32_t>();
+		const auto stride = r.Get<uint32_t>();
+		if (op == VG_CAPTURE_OP_CMD_DRAW_INDIRECT_COUNT)
+		{
+			vgCmdDrawIndirectCount(cmd, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+		}
+		else
+		{
+			vgCmdDrawIndexedIndirectCount(cmd, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+		}
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DISPATCH_INDIRECT:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto buffer = Object<VgBuffer>(r.GetId());
+		vgCmdDispatchIndirect(cmd, buffer, r.Get<uint64_t>());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_DISPATCH_MESH:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto groups = r.Get<std::array<uint32_t, 3>>();
+		vgCmdDispatchMesh(cmd, groups[0], groups[1], groups[2]);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_BUFFER:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgBuffer>(r.GetId());
+		const auto dstOffset = r.Get<uint64_t>();
+		auto src = Object<VgBuffer>(r.GetId());
+		const auto srcOffset = r.Get<uint64_t>();
+		vgCmdCopyBufferToBuffer(cmd, dst, dstOffset, src, srcOffset, r.Get<uint64_t>());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_TEXTURE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgTexture>(r.GetId());
+		const auto dstRegion = r.Get<VgRegion>();
+		auto src = Object<VgBuffer>(r.GetId());
+		vgCmdCopyBufferToTexture(cmd, dst, &dstRegion, src, r.Get<uint64_t>());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_BUFFER:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgBuffer>(r.GetId());
+		const auto dstOffset = r.Get<uint64_t>();
+		auto src = Object<VgTexture>(r.GetId());
+		const auto srcRegion = r.Get<VgRegion>();
+		vgCmdCopyTextureToBuffer(cmd, dst, dstOffset, src, &srcRegion);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_TEXTURE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgTexture>(r.GetId());
+		const auto dstRegion = r.Get<VgRegion>();
+		auto src = Object<VgTexture>(r.GetId());
+		const auto srcRegion = r.Get<VgRegion>();
+		vgCmdCopyTextureToTexture(cmd, dst, &dstRegion, src, &srcRegion);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_BUFFER_REGIONS:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgBuffer>(r.GetId());
+		auto src = Object<VgBuffer>(r.GetId());
+		const auto regions = r.GetArray<VgBufferCopyRegion>();
+		vgCmdCopyBufferToBufferRegions(cmd, dst, src, static_cast<uint32_t>(regions.size()), regions.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_BUFFER_TO_TEXTURE_REGIONS:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgTexture>(r.GetId());
+		auto src = Object<VgBuffer>(r.GetId());
+		const auto regions = r.GetArray<VgBufferTextureCopyRegion>();
+		vgCmdCopyBufferToTextureRegions(cmd, dst, src, static_cast<uint32_t>(regions.size()), regions.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_BUFFER_REGIONS:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgBuffer>(r.GetId());
+		auto src = Object<VgTexture>(r.GetId());
+		const auto regions = r.GetArray<VgBufferTextureCopyRegion>();
+		vgCmdCopyTextureToBufferRegions(cmd, dst, src, static_cast<uint32_t>(regions.size()), regions.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_COPY_TEXTURE_TO_TEXTURE_REGIONS:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto dst = Object<VgTexture>(r.GetId());
+		auto src = Object<VgTexture>(r.GetId());
+		const auto regions = r.GetArray<VgTextureCopyRegion>();
+		vgCmdCopyTextureToTextureRegions(cmd, dst, src, static_cast<uint32_t>(regions.size()), regions.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_BEGIN_MARKER:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		const auto name = r.GetString();
+		auto color = r.Get<std::array<float, 3>>();
+		vgCmdBeginMarker(cmd, name.c_str(), color.data());
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_END_MARKER:
+		vgCmdEndMarker(Object<VgCommandList>(r.GetId()));
+		break;
+	case VG_CAPTURE_OP_CMD_READBACK_BUFFER:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto pool = Object<VgReadbackPool>(r.GetId());
+		auto src = Object<VgBuffer>(r.GetId());
+		const auto srcOffset = r.Get<uint64_t>();
+		const auto size = r.Get<uint64_t>();
+		const auto request = ReadReadbackRequest(r);
+		VgReadbackTicket ticket;
+		vgCmdReadbackBuffer(cmd, pool, src, srcOffset, size, &request, &ticket);
+		break;
+	}
+	case VG_CAPTURE_OP_CMD_READBACK_TEXTURE:
+	{
+		auto cmd = Object<VgCommandList>(r.GetId());
+		auto pool = Object<VgReadbackPool>(r.GetId());
+		auto src = Object<VgTexture>(r.GetId());
+		const auto srcRegion = r.Get<VgRegion>();
+		const auto request = ReadReadbackRequest(r);
+		VgReadbackTicket ticket;
+		vgCmdReadbackTexture(cmd, pool, src, &srcRegion, &request, &ticket);
+		break;
+	}
+
+	case VG_CAPTURE_OP_BUFFER_SET_NAME:
+	{
+		auto buffer = Object<VgBuffer>(r.GetId());
+		vgBufferSetName(buffer, r.GetString().c_str());
+		break;
+	}
+	case VG_CAPTURE_OP_BUFFER_CREATE_VIEW:
+	{
+		auto buffer = Object<VgBuffer>(r.GetId());
+		const auto desc = r.Get<VgBufferViewDesc>();
+		const auto captured = r.Get<uint32_t>();
+		VgView view;
+		if (vgBufferCreateView(buffer, &desc, &view) != VG_SUCCESS) throw std::runtime_error("unable to create buffer view");
+		RemapView(_views, captured, view);
+		break;
+	}
+	case VG_CAPTURE_OP_BUFFER_DESTROY_VIEWS:
+		vgBufferDestroyViews(Object<VgBuffer>(r.GetId()));
+		break;
+	case VG_CAPTURE_OP_BUFFER_MAP:
+	{
+		const auto id = r.GetId();
+		void* data;
+		if (vgBufferMap(Object<VgBuffer>(id), &data) != VG_SUCCESS) throw std::runtime_error("unable to map buffer");
+		_mappedBuffers[id] = data;
+		break;
+	}
+	case VG_CAPTURE_OP_BUFFER_UNMAP:
+	{
+		const auto id = r.GetId();
+		vgBufferUnmap(Object<VgBuffer>(id));
+		_mappedBuffers.erase(id);
+		break;
+	}
+	case VG_CAPTURE_OP_BUFFER_DATA:
+	{
+		const auto id = r.GetId();
+		const auto offset = r.Get<uint64_t>();
+		const auto data = r.GetBlob();
+
+		auto it = _mappedBuffers.find(id);
+		if (it != _mappedBuffers.end())
+		{
+			std::memcpy(static_cast<uint8_t*>(it->second) + offset, data.data(), data.size());
+			break;
+		}
+		auto buffer = Object<VgBuffer>(id);
+		void* mapped;
+		if (vgBufferMap(buffer, &mapped) != VG_SUCCESS) throw std::runtime_error("unable to map buffer");
+		std::memcpy(static_cast<uint8_t*>(mapped) + offset, data.data(), data.size());
+		vgBufferUnmap(buffer);
+		break;
+	}
+
+	case VG_CAPTURE_OP_PIPELINE_SET_NAME:
+	{
+		auto pipeline = Object<VgPipeline>(r.GetId());
+		vgPipelineSetName(pipeline, r.GetString().c_str());
+		break;
+	}
+
+	case VG_CAPTURE_OP_TEXTURE_SET_NAME:
+	{
+		auto texture = Object<VgTexture>(r.GetId());
+		vgTextureSetName(texture, r.GetString().c_str());
+		break;
+	}
+	case VG_CAPTURE_OP_TEXTURE_CREATE_ATTACHMENT_VIEW:
+	{
+		auto texture = Object<VgTexture>(r.GetId());
+		const auto desc = r.Get<VgAttachmentViewDesc>();
+		const auto captured = r.Get<uint32_t>();
+		VgAttachmentView view;
+		if (vgTextureCreateAttachmentView(texture, &desc, &view) != VG_SUCCESS)
+		{
+			throw std::runtime_error("unable to create attachment view");
+		}
+		RemapView(_attachmentViews, captured, view);
+		break;
+	}
+	case VG_CAPTURE_OP_TEXTURE_CREATE_VIEW:
+	{
+		auto texture = Object<VgTexture>(r.GetId());
+		const auto desc = r.Get<VgTextureViewDesc>();
+		const auto captured = r.Get<uint32_t>();
+		VgView view;
+		if (vgTextureCreateView(texture, &desc, &view) != VG_SUCCESS) throw std::runtime_error("unable to create texture view");
+		RemapView(_views, captured, view);
+		break;
+	}
+	case VG_CAPTURE_OP_TEXTURE_DESTROY_VIEWS:
+		vgTextureDestroyViews(Object<VgTexture>(r.GetId()));
+		break;
+
+	case VG_CAPTURE_OP_SWAP_CHAIN_ACQUIRE_NEXT_IMAGE:
+		// Offscreen back buffers are always available, the captured index is implied by the recorded commands
+		break;
+	case VG_CAPTURE_OP_SWAP_CHAIN_GET_BACK_BUFFER:
+	{
+		const auto swapChainId = r.GetId();
+		const auto index = r.Get<uint32_t>();
+		auto it = _swapChains.find(swapChainId);
+		if (it == _swapChains.end() || index >= it->second.backBuffers.size())
+		{
+			throw std::runtime_error("back buffer of unknown swap chain");
+		}
+		AddObject(r.GetId(), it->second.backBuffers[index]);
+		break;
+	}
+	case VG_CAPTURE_OP_SWAP_CHAIN_PRESENT:
+		Present(r.GetId());
+		break;
+
+	default:
+		throw std::runtime_error("unknown record");
+	}
+}
@@ -0,0 +1,10 @@
+target("vgreplay")
+    set_kind("binary")
+    set_languages("cxx20")
+
+    add_includedirs("replay/include")
+    add_headerfiles("replay/include/**.h")
+    add_files("replay/src/**.cpp")
+    add_deps("varyag")
+
+    set_symbols("debug")
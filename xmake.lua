@@ -10,6 +10,7 @@ target("varyag")
     set_languages("cxx20")
     add_includedirs("include", { public = true })
     add_headerfiles("include/varyag.h")
+    add_headerfiles("include/varyag_capture.h")
     add_files("src/**.cpp")
     add_headerfiles("src/**.h")
     set_options("vvalidation")
@@ -24,4 +25,6 @@ target("varyag")
     set_symbols("debug")
     add_packages("volk", "vk-bootstrap")
 
-includes("samples")
\ No newline at end of file
+includes("samples")
+includes("tools")
+includes("tests")
\ No newline at end of file